@@ -0,0 +1,234 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmarks.hpp"
+#include "../src/level/EntityStore.hpp"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <SFML/System/Clock.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const std::size_t EntityCount   = 1000000; //!< Entities spread over the level
+static const int         RectQueries   = 50;      //!< Marquees selected, half small and half large
+static const int         LassoQueries  = 20;      //!< Lassos selected, half small and half large
+static const int         LassoVertices = 100;     //!< Vertices of a lasso, a star alternating two radii
+
+
+////////////////////////////////////////////////////////////
+static void scanRect(const EntityStore& store, const sf::FloatRect& area, BitSet& selection)
+{
+	// Same test as the hierarchy: touching edges intersect
+	for (EntityId id = 0; id < store.getCapacity(); id++)
+	{
+		const Entity* entity = store.get(id);
+		if (entity)
+		{
+			const sf::FloatRect& bounds = entity->m_bounds;
+			if (bounds.left <= area.left + area.width && area.left <= bounds.left + bounds.width &&
+			    bounds.top <= area.top + area.height && area.top <= bounds.top + bounds.height)
+			{
+				selection.set(id);
+			}
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+static void scanLasso(const EntityStore& store, const std::vector<sf::Vector2f>& polygon, BitSet& selection)
+{
+	// Even-odd rule on the center, against every edge
+	for (EntityId id = 0; id < store.getCapacity(); id++)
+	{
+		const Entity* entity = store.get(id);
+		if (!entity)
+		{
+			continue;
+		}
+
+		sf::Vector2f center(entity->m_bounds.left + entity->m_bounds.width / 2.f, entity->m_bounds.top + entity->m_bounds.height / 2.f);
+		bool inside = false;
+		for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+		{
+			const sf::Vector2f& a = polygon[i];
+			const sf::Vector2f& b = polygon[j];
+			if ((a.y > center.y) != (b.y > center.y) && center.x < a.x + (center.y - a.y) * (b.x - a.x) / (b.y - a.y))
+			{
+				inside = !inside;
+			}
+		}
+
+		if (inside)
+		{
+			selection.set(id);
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+static bool isSame(const BitSet& left, const BitSet& right)
+{
+	if (left.getCount() != right.getCount())
+	{
+		return false;
+	}
+
+	for (std::size_t i = right.findNext(0); i < right.getSize(); i = right.findNext(i + 1))
+	{
+		if (!left.test(i))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool benchEntityBvh()
+{
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> position(-50000.f, 50000.f);
+	std::uniform_real_distribution<float> size(4.f, 40.f);
+	EntityStore store;
+	for (std::size_t i = 0; i < EntityCount; i++)
+	{
+		store.add(Entity{ sf::FloatRect(position(random), position(random), size(random), size(random)), 0 });
+	}
+
+	// The first selection builds the hierarchy
+	BitSet selection;
+	BitSet expected;
+	sf::Clock clock;
+	store.selectRect(sf::FloatRect(0.f, 0.f, 1.f, 1.f), selection);
+	printf("  build of %zu entities: %.1f ms\n", EntityCount, clock.getElapsedTime().asMicroseconds() / 1000.0);
+
+	bool same = true;
+	double hierarchy[2] = {};
+	double scan[2] = {};
+	for (int query = 0; query < RectQueries; query++)
+	{
+		int large = query * 2 / RectQueries;
+		float width = large ? 40000.f : 2000.f;
+		sf::FloatRect area(position(random), position(random), width, width * 0.6f);
+		selection.resize(store.getCapacity());
+		selection.clear();
+		expected.resize(store.getCapacity());
+		expected.clear();
+
+		clock.restart();
+		store.selectRect(area, selection);
+		hierarchy[large] += clock.getElapsedTime().asMicroseconds() / 1000.0;
+		clock.restart();
+		scanRect(store, area, expected);
+		scan[large] += clock.getElapsedTime().asMicroseconds() / 1000.0;
+		same &= isSame(selection, expected);
+	}
+
+	printf("  marquee 2000 wide:  hierarchy %.3f ms, scan %.3f ms\n", hierarchy[0] * 2 / RectQueries, scan[0] * 2 / RectQueries);
+	printf("  marquee 40000 wide: hierarchy %.3f ms, scan %.3f ms\n", hierarchy[1] * 2 / RectQueries, scan[1] * 2 / RectQueries);
+
+	hierarchy[0] = hierarchy[1] = scan[0] = scan[1] = 0.0;
+	for (int query = 0; query < LassoQueries; query++)
+	{
+		int large = query * 2 / LassoQueries;
+		float radius = large ? 30000.f : 3000.f;
+		sf::Vector2f center(position(random) / 2.f, position(random) / 2.f);
+		std::vector<sf::Vector2f> polygon;
+		for (int i = 0; i < LassoVertices; i++)
+		{
+			float angle = i * 6.2831853f / LassoVertices;
+			float length = i % 2 ? radius / 2.f : radius;
+			polygon.push_back(center + sf::Vector2f(std::cos(angle) * length, std::sin(angle) * length));
+		}
+
+		selection.clear();
+		expected.clear();
+		clock.restart();
+		store.selectLasso(polygon, selection);
+		hierarchy[large] += clock.getElapsedTime().asMicroseconds() / 1000.0;
+		clock.restart();
+		scanLasso(store, polygon, expected);
+		scan[large] += clock.getElapsedTime().asMicroseconds() / 1000.0;
+		same &= isSame(selection, expected);
+	}
+
+	printf("  lasso radius 3000:  hierarchy %.3f ms, scan %.3f ms\n", hierarchy[0] * 2 / LassoQueries, scan[0] * 2 / LassoQueries);
+	printf("  lasso radius 30000: hierarchy %.3f ms, scan %.3f ms\n", hierarchy[1] * 2 / LassoQueries, scan[1] * 2 / LassoQueries);
+
+	// Few moves refit the leaves they touch, many rebuild the hierarchy on the next selection
+	sf::FloatRect area(-10000.f, -10000.f, 20000.f, 20000.f);
+	for (int i = 0; i < 1000; i++)
+	{
+		EntityId id = static_cast<EntityId>(random() % EntityCount);
+		sf::FloatRect bounds = store.get(id)->m_bounds;
+		bounds.left += 300.f;
+		store.move(id, bounds);
+	}
+
+	selection.clear();
+	expected.clear();
+	clock.restart();
+	store.selectRect(area, selection);
+	printf("  marquee after 1000 moves: %.3f ms\n", clock.getElapsedTime().asMicroseconds() / 1000.0);
+	scanRect(store, area, expected);
+	same &= isSame(selection, expected);
+
+	for (std::size_t i = 0; i < EntityCount / 2; i++)
+	{
+		EntityId id = static_cast<EntityId>(random() % EntityCount);
+		sf::FloatRect bounds = store.get(id)->m_bounds;
+		bounds.top += position(random) / 10.f;
+		store.move(id, bounds);
+	}
+
+	selection.clear();
+	expected.clear();
+	clock.restart();
+	store.selectRect(area, selection);
+	printf("  marquee after %zu moves, rebuilding: %.1f ms\n", EntityCount / 2, clock.getElapsedTime().asMicroseconds() / 1000.0);
+	scanRect(store, area, expected);
+	same &= isSame(selection, expected);
+
+	if (!same)
+	{
+		printf("  the hierarchy and the scan selected different entities\n");
+	}
+
+	return same;
+}
+
+} //namespace le
@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmarks.hpp"
+#include "../src/utility/FuzzyMatcher.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <SFML/System/Clock.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const std::size_t TextCount   = 200000; //!< Paths the palette searches
+static const std::size_t MaxResults  = 50;     //!< Matches the palette lists
+static const int         Repetitions = 30;     //!< Times every query is timed, the median is kept
+static const double      Budget      = 2.0;    //!< Milliseconds a keystroke may take
+
+
+////////////////////////////////////////////////////////////
+static bool isSubsequence(const std::string& query, const std::string& text)
+{
+	// Same folding as the matcher: ASCII case is ignored
+	auto fold = [](char byte)
+	{
+		return byte >= 'A' && byte <= 'Z' ? static_cast<char>(byte - 'A' + 'a') : byte;
+	};
+
+	std::size_t found = 0;
+	for (std::size_t i = 0; i < text.size() && found < query.size(); i++)
+	{
+		found += fold(text[i]) == fold(query[found]);
+	}
+
+	return found == query.size();
+}
+
+
+////////////////////////////////////////////////////////////
+static bool check(const FuzzyMatcher& matcher, const std::string& query, const std::vector<FuzzyMatcher::Match>& matches)
+{
+	// The count is compared with a scan, the matches are checked to contain the query and come best first
+	std::size_t count = 0;
+	for (sf::Uint32 index = 0; index < matcher.getCount(); index++)
+	{
+		count += isSubsequence(query, matcher.getText(index));
+	}
+
+	if (count != matcher.getMatchCount() || matches.size() != std::min(count, MaxResults))
+	{
+		return false;
+	}
+
+	for (std::size_t i = 0; i < matches.size(); i++)
+	{
+		if (!isSubsequence(query, matcher.getText(matches[i].m_index)) || (i > 0 && matches[i].m_score > matches[i - 1].m_score))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+static double getMedian(std::vector<double> times)
+{
+	std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+	return times[times.size() / 2];
+}
+
+
+////////////////////////////////////////////////////////////
+bool benchFuzzyMatcher()
+{
+	const char* folders[] = { "sprites", "tiles", "sounds", "music", "levels", "fonts", "shaders", "ui", "characters", "props" };
+	const char* words[] = { "player", "enemy", "grass", "water", "stone", "tree", "house", "door", "chest", "coin",
+	                        "spark", "slime", "bat", "arrow", "shield", "sword", "torch", "wall", "floor", "cloud" };
+	const char* extensions[] = { ".png", ".wav", ".ogg", ".lvl", ".ttf", ".frag" };
+
+	std::mt19937 random(7);
+	FuzzyMatcher matcher;
+	sf::Clock clock;
+	for (std::size_t i = 0; i < TextCount; i++)
+	{
+		std::string path = "assets/" + std::string(folders[random() % 10]) + "/" + words[random() % 20] + "_" + words[random() % 20];
+		matcher.add(path + "_" + std::to_string(random() % 1000) + extensions[random() % 6]);
+	}
+
+	printf("  add of %zu paths: %.1f ms\n", TextCount, clock.getElapsedTime().asMicroseconds() / 1000.0);
+
+	// Typed key by key, every query refines the last one. Cold, every query follows an empty one
+	const char* typed[] = { "s", "sp", "spr", "spri", "sprit", "sprite" };
+	const char* cold[] = { "es", "at", "sp", "spa", "sprite", "a_b", "sprites/pl" };
+
+	bool valid = true;
+	bool fast = true;
+	std::vector<FuzzyMatcher::Match> matches;
+	auto run = [&](const char* label, const std::string& query, const std::vector<double>& times)
+	{
+		double median = getMedian(times);
+		double slowest = *std::max_element(times.begin(), times.end());
+		bool correct = check(matcher, query, matches);
+		printf("  %-6s %-12s median %.3f ms, max %.3f ms, %zu matches%s%s\n", label, query.c_str(), median, slowest, matcher.getMatchCount(),
+		       median <= Budget ? "" : ", over budget", correct ? "" : ", wrong matches");
+		valid &= correct;
+		fast &= median <= Budget;
+	};
+
+	std::vector<std::vector<double>> typedTimes(sizeof(typed) / sizeof(*typed));
+	for (int repetition = 0; repetition < Repetitions; repetition++)
+	{
+		matcher.match("", MaxResults, matches);
+		for (std::size_t i = 0; i < typedTimes.size(); i++)
+		{
+			clock.restart();
+			matcher.match(typed[i], MaxResults, matches);
+			typedTimes[i].push_back(clock.getElapsedTime().asMicroseconds() / 1000.0);
+		}
+	}
+
+	// Every query is typed again key by key before its matches are checked
+	for (std::size_t i = 0; i < typedTimes.size(); i++)
+	{
+		matcher.match("", MaxResults, matches);
+		for (std::size_t j = 0; j <= i; j++)
+		{
+			matcher.match(typed[j], MaxResults, matches);
+		}
+
+		run("typed", typed[i], typedTimes[i]);
+	}
+
+	for (const char* query : cold)
+	{
+		std::vector<double> times;
+		for (int repetition = 0; repetition < Repetitions; repetition++)
+		{
+			matcher.match("", MaxResults, matches);
+			clock.restart();
+			matcher.match(query, MaxResults, matches);
+			times.push_back(clock.getElapsedTime().asMicroseconds() / 1000.0);
+		}
+
+		run("cold", query, times);
+	}
+
+	if (!valid)
+	{
+		printf("  the matcher and the scan found different texts\n");
+	}
+
+	if (!fast)
+	{
+		printf("  a query took longer than %.1f ms\n", Budget);
+	}
+
+	return valid && fast;
+}
+
+} //namespace le
@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmarks.hpp"
+#include <cstdio>
+#include <cstring>
+
+
+int main(int argc, char** argv)
+{
+    // Every benchmark prints its timings, a name given on the command line only runs that one
+    struct Benchmark
+    {
+        const char* name;
+        bool (*run)();
+    };
+
+    const Benchmark benchmarks[] = { { "EntityBvh", le::benchEntityBvh }, { "FuzzyMatcher", le::benchFuzzyMatcher } };
+    int failed = 0;
+    for (const Benchmark& benchmark : benchmarks)
+    {
+        if (argc > 1 && std::strcmp(argv[1], benchmark.name) != 0)
+        {
+            continue;
+        }
+
+        printf("%s\n", benchmark.name);
+        if (!benchmark.run())
+        {
+            printf("Failed %s\n", benchmark.name);
+            failed++;
+        }
+    }
+
+    return failed;
+}
@@ -0,0 +1,573 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "AssetCache.hpp"
+#include "AssetObserver.hpp"
+#include "../utility/FrameScheduler.hpp"
+#include "../utility/UpdateScheduler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const unsigned int PlaceholderSize  = 8;                //!< Size of the placeholder image in pixels
+static const std::size_t  MemoryLimit      = 256 * 1024 * 1024; //!< Bytes cached assets may use by default
+static const std::size_t  UploadBudget     = 8 * 1024 * 1024;  //!< Bytes uploaded per update by default
+static const sf::Time     WatchInterval    = sf::milliseconds(25); //!< Time between two collections of the written files
+
+
+////////////////////////////////////////////////////////////
+static bool readFile(const std::filesystem::path& path, std::vector<char>& data)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		return false;
+	}
+
+	data.resize(static_cast<std::size_t>(file.tellg()));
+	file.seekg(0);
+	return static_cast<bool>(file.read(data.data(), static_cast<std::streamsize>(data.size())));
+}
+
+
+////////////////////////////////////////////////////////////
+static std::string makeKey(const char* kind, const std::filesystem::path& path)
+{
+	// The watcher reports absolute paths, relative ones are resolved the same way to match them
+	std::error_code error;
+	return kind + std::filesystem::absolute(path, error).lexically_normal().generic_string();
+}
+
+
+////////////////////////////////////////////////////////////
+AssetCache::AssetCache(unsigned int workerCount) :
+m_assets     (),
+m_unused     (),
+m_placeholder(),
+m_memory     (0),
+m_memoryLimit(MemoryLimit),
+m_budget     (UploadBudget),
+m_loading    (0),
+m_onLoaded   ([](AssetCache&, const AssetHandle&) {}),
+m_workers    (),
+m_mutex      (),
+m_wake       (),
+m_jobs       (),
+m_results    (),
+m_stopping   (false),
+m_watcher    (),
+m_watchTimer (0)
+{
+	// Magenta and black checks, repeated over whatever part of the texture is shown
+	this->m_placeholder.create(PlaceholderSize, PlaceholderSize);
+	for (unsigned int y = 0; y < PlaceholderSize; y++)
+	{
+		for (unsigned int x = 0; x < PlaceholderSize; x++)
+		{
+			bool odd = ((x / (PlaceholderSize / 2)) ^ (y / (PlaceholderSize / 2))) & 1;
+			this->m_placeholder.setPixel(x, y, odd ? sf::Color(255, 0, 255) : sf::Color::Black);
+		}
+	}
+
+	for (unsigned int i = 0; i < std::max(workerCount, 1u); i++)
+	{
+		this->m_workers.emplace_back(&AssetCache::run, this);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+AssetCache::~AssetCache()
+{
+	TimerWheel::getDefault().cancel(this->m_watchTimer);
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_stopping = true;
+	}
+
+	this->m_wake.notify_all();
+	for (std::thread& worker : this->m_workers)
+	{
+		worker.join();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+AssetCache& AssetCache::getDefault()
+{
+	// The scheduler and the wheel are created first so that they outlive the cache, which leaves them when destroyed
+	UpdateScheduler::getDefault();
+	TimerWheel::getDefault();
+
+	// Decoding mostly waits for the disk, a couple of threads keep it busy without competing with the jobs
+	static AssetCache cache(std::clamp(std::thread::hardware_concurrency() / 2, 1u, 2u));
+	return cache;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureHandle AssetCache::loadTexture(const std::filesystem::path& path)
+{
+	return TextureHandle(*this, request(path, Kind::Texture));
+}
+
+
+////////////////////////////////////////////////////////////
+FontHandle AssetCache::loadFont(const std::filesystem::path& path)
+{
+	return FontHandle(*this, request(path, Kind::Font));
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetCache::reload(const std::filesystem::path& path)
+{
+	bool cached = false;
+	for (const char* kind : { "texture:", "font:" })
+	{
+		auto it = this->m_assets.find(makeKey(kind, path));
+		if (it != this->m_assets.end())
+		{
+			// A file written again while being read is read once more afterwards, by the next write
+			Asset& asset = *it->second;
+			if (!asset.m_queued)
+			{
+				asset.m_state = asset.m_state == State::Failed ? State::Loading : asset.m_state;
+				queue(asset);
+			}
+
+			cached = true;
+		}
+	}
+
+	return cached;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetCache::watch(const std::filesystem::path& directory)
+{
+	TimerWheel::getDefault().cancel(this->m_watchTimer);
+	this->m_watchTimer = 0;
+	if (!this->m_watcher.open(directory))
+	{
+		return false;
+	}
+
+	// The main loop may wait for events, the timer wakes it up to collect the written files
+	this->m_watchTimer = TimerWheel::getDefault().setInterval(WatchInterval, [this]() { collectChanges(); });
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetCache::setMemoryLimit(std::size_t bytes)
+{
+	this->m_memoryLimit = bytes;
+	trim();
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetCache::setUploadBudget(std::size_t bytes)
+{
+	this->m_budget = bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetCache::getMemoryUsage() const
+{
+	return this->m_memory;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetCache::getAssetCount() const
+{
+	return this->m_assets.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetCache::getLoadingCount() const
+{
+	return this->m_loading;
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetCache::setOnLoaded(Event1<AssetCache, const AssetHandle&> onLoaded)
+{
+	this->m_onLoaded = std::move(onLoaded);
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetCache::update()
+{
+	std::size_t uploaded = 0;
+	while (uploaded == 0 || uploaded < this->m_budget)
+	{
+		Result result;
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+			if (this->m_results.empty())
+			{
+				break;
+			}
+
+			result = std::move(this->m_results.front());
+			this->m_results.pop_front();
+		}
+
+		upload(result);
+		uploaded += std::max<std::size_t>(result.m_asset->m_bytes, 1);
+		this->m_onLoaded(*this, AssetHandle(*this, *result.m_asset));
+	}
+
+	if (uploaded > 0)
+	{
+		FrameScheduler::getDefault().invalidate();
+	}
+
+	trim();
+	if (this->m_loading == 0)
+	{
+		unschedule();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+AssetCache::Asset& AssetCache::request(const std::filesystem::path& path, Kind kind)
+{
+	std::string key = makeKey(kind == Kind::Texture ? "texture:" : "font:", path);
+	std::unique_ptr<Asset>& slot = this->m_assets[key];
+	if (!slot)
+	{
+		slot = std::make_unique<Asset>();
+		slot->m_key = key;
+		slot->m_path = path;
+		slot->m_kind = kind;
+		slot->m_state = State::Failed;
+		slot->m_bytes = 0;
+		slot->m_references = 0;
+		slot->m_queued = false;
+		slot->m_unused = this->m_unused.insert(this->m_unused.end(), slot.get());
+		if (kind == Kind::Texture)
+		{
+			slot->m_texture.loadFromImage(this->m_placeholder);
+			slot->m_texture.setRepeated(true);
+		}
+	}
+
+	// Failed files are read again, they may have been fixed since
+	Asset& asset = *slot;
+	if (asset.m_state == State::Failed && !asset.m_queued)
+	{
+		asset.m_state = State::Loading;
+		queue(asset);
+	}
+
+	return asset;
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetCache::queue(Asset& asset)
+{
+	asset.m_queued = true;
+	this->m_loading++;
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_jobs.emplace_back(&asset, asset.m_path);
+	}
+
+	this->m_wake.notify_one();
+	schedule();
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetCache::collectChanges()
+{
+	std::vector<std::filesystem::path> changed;
+	if (this->m_watcher.poll(changed))
+	{
+		for (const std::filesystem::path& path : changed)
+		{
+			reload(path);
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetCache::acquire(Asset& asset)
+{
+	if (asset.m_references++ == 0)
+	{
+		this->m_unused.erase(asset.m_unused);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetCache::release(Asset& asset)
+{
+	if (--asset.m_references == 0)
+	{
+		asset.m_unused = this->m_unused.insert(this->m_unused.end(), &asset);
+		if (this->m_memory > this->m_memoryLimit)
+		{
+			schedule();
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetCache::upload(Result& result)
+{
+	Asset& asset = *result.m_asset;
+	asset.m_queued = false;
+	this->m_loading--;
+
+	std::size_t bytes = 0;
+	const void* resource = nullptr;
+	if (result.m_ok && asset.m_kind == Kind::Texture)
+	{
+		// The texture is updated in place, whatever shows it picks up the new content on the next frame
+		result.m_ok = asset.m_texture.loadFromImage(result.m_image);
+		asset.m_texture.setRepeated(!result.m_ok);
+		bytes = static_cast<std::size_t>(result.m_image.getSize().x) * result.m_image.getSize().y * 4;
+		resource = &asset.m_texture;
+	}
+	else if (result.m_ok)
+	{
+		// The current font is only replaced by one that parsed, it reads its glyphs from the file data
+		sf::Font font;
+		result.m_ok = font.loadFromMemory(result.m_data.data(), result.m_data.size());
+		if (result.m_ok)
+		{
+			asset.m_font = font;
+			asset.m_fontData.swap(result.m_data);
+			bytes = asset.m_fontData.size();
+			resource = &asset.m_font;
+		}
+	}
+
+	if (!result.m_ok)
+	{
+		printf("Failed to load asset %s\n", asset.m_path.generic_string().c_str());
+		if (asset.m_state != State::Ready)
+		{
+			asset.m_state = State::Failed;
+		}
+
+		return;
+	}
+
+	if (asset.m_state == State::Ready)
+	{
+		this->m_memory -= asset.m_bytes;
+	}
+
+	asset.m_state = State::Ready;
+	asset.m_bytes = bytes;
+	this->m_memory += bytes;
+	AssetObserver::notify(resource);
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetCache::trim()
+{
+	// Assets still queued are skipped, a worker writes their result
+	for (auto it = this->m_unused.begin(); it != this->m_unused.end() && this->m_memory > this->m_memoryLimit;)
+	{
+		Asset* asset = *it++;
+		if (!asset->m_queued)
+		{
+			this->m_memory -= asset->m_state == State::Ready ? asset->m_bytes : 0;
+			this->m_unused.erase(asset->m_unused);
+			this->m_assets.erase(asset->m_key);
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetCache::run()
+{
+	for (;;)
+	{
+		std::pair<Asset*, std::filesystem::path> job;
+		{
+			std::unique_lock<std::mutex> lock(this->m_mutex);
+			this->m_wake.wait(lock, [this]() { return this->m_stopping || !this->m_jobs.empty(); });
+			if (this->m_stopping)
+			{
+				return;
+			}
+
+			job = std::move(this->m_jobs.front());
+			this->m_jobs.pop_front();
+		}
+
+		// Only the file is touched here, the asset belongs to the main thread
+		Result result;
+		result.m_asset = job.first;
+		result.m_ok = readFile(job.second, result.m_data);
+		if (result.m_ok && job.first->m_kind == Kind::Texture)
+		{
+			result.m_ok = result.m_image.loadFromMemory(result.m_data.data(), result.m_data.size());
+			result.m_data.clear();
+			result.m_data.shrink_to_fit();
+		}
+
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_results.push_back(std::move(result));
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+AssetHandle::AssetHandle() :
+m_cache(nullptr),
+m_asset(nullptr)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+AssetHandle::AssetHandle(AssetCache& cache, AssetCache::Asset& asset) :
+m_cache(&cache),
+m_asset(&asset)
+{
+	this->m_cache->acquire(*this->m_asset);
+}
+
+
+////////////////////////////////////////////////////////////
+AssetHandle::AssetHandle(const AssetHandle& other) :
+m_cache(other.m_cache),
+m_asset(other.m_asset)
+{
+	if (this->m_asset)
+	{
+		this->m_cache->acquire(*this->m_asset);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+AssetHandle::AssetHandle(AssetHandle&& other) noexcept :
+m_cache(other.m_cache),
+m_asset(other.m_asset)
+{
+	other.m_asset = nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+AssetHandle& AssetHandle::operator=(AssetHandle other) noexcept
+{
+	std::swap(this->m_cache, other.m_cache);
+	std::swap(this->m_asset, other.m_asset);
+	return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+AssetHandle::~AssetHandle()
+{
+	if (this->m_asset)
+	{
+		this->m_cache->release(*this->m_asset);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetHandle::isValid() const
+{
+	return this->m_asset != nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+AssetCache::State AssetHandle::getState() const
+{
+	return this->m_asset ? this->m_asset->m_state : AssetCache::State::Failed;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetHandle::isReady() const
+{
+	return getState() == AssetCache::State::Ready;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::filesystem::path& AssetHandle::getPath() const
+{
+	static const std::filesystem::path empty;
+	return this->m_asset ? this->m_asset->m_path : empty;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetHandle::operator==(const AssetHandle& other) const
+{
+	return this->m_asset == other.m_asset;
+}
+
+
+////////////////////////////////////////////////////////////
+const sf::Texture& TextureHandle::get() const
+{
+	return this->m_asset->m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const sf::Font& FontHandle::get() const
+{
+	return this->m_asset->m_font;
+}
+
+} //namespace le
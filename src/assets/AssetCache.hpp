@@ -0,0 +1,481 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_ASSET_CACHE_HPP
+#define LEVEL_EDITOR_ASSET_CACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../ui/interfaces/Updatable.hpp"
+#include "../utility/Config.hpp"
+#include "../utility/FileWatcher.hpp"
+#include "../utility/TimerWheel.hpp"
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+class AssetHandle;
+class TextureHandle;
+class FontHandle;
+
+////////////////////////////////////////////////////////////
+/// \brief Reference counted textures and fonts loaded in the background
+///
+/// Files are read and images decoded by worker threads, the main
+/// thread uploads at most a budget of bytes per update so loading
+/// never stalls a frame. Until then a texture shows a checkered
+/// placeholder and a font draws nothing. Textures and fonts keep
+/// their address once requested, so controls taking them by
+/// reference pick up the loaded content without being rebuilt.
+///
+/// Assets stay cached while no handle refers to them and are
+/// evicted, least recently released first, once the cache holds
+/// more than its memory limit. Handles and the cache belong to
+/// the main thread.
+///
+/// While a directory is watched, written files are decoded again
+/// and swapped into their texture or font between two frames.
+/// Only the AssetObservers of a changed asset are notified.
+///
+////////////////////////////////////////////////////////////
+class AssetCache : public Updatable, sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Loading state of an asset
+	///
+	////////////////////////////////////////////////////////////
+	enum class State
+	{
+		Loading, //!< File is being read, the placeholder is shown
+		Ready,   //!< Asset is loaded
+		Failed   //!< File could not be loaded, the placeholder is kept
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param workerCount Amount of threads decoding files
+	///
+	////////////////////////////////////////////////////////////
+	explicit AssetCache(unsigned int workerCount);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Waits for the workers to stop, handles must not outlive the cache.
+	///
+	////////////////////////////////////////////////////////////
+	~AssetCache();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the cache used by the application
+	///
+	////////////////////////////////////////////////////////////
+	static AssetCache& getDefault();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a texture, loading it if it is not cached
+	///
+	/// \param path Path of the image file
+	///
+	////////////////////////////////////////////////////////////
+	TextureHandle loadTexture(const std::filesystem::path& path);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a font, loading it if it is not cached
+	///
+	/// \param path Path of the font file
+	///
+	////////////////////////////////////////////////////////////
+	FontHandle loadFont(const std::filesystem::path& path);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Read a cached file again
+	///
+	/// The current content is shown until the file is decoded,
+	/// and kept if it can no longer be.
+	///
+	/// \param path Path of the image or font file
+	///
+	/// \return False if the file is not cached
+	///
+	////////////////////////////////////////////////////////////
+	bool reload(const std::filesystem::path& path);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Reload the cached files written within a directory tree
+	///
+	/// \param directory Path of the directory, typically the project
+	///
+	/// \return False if the directory could not be watched
+	///
+	////////////////////////////////////////////////////////////
+	bool watch(const std::filesystem::path& directory);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the amount of bytes cached assets may use
+	///
+	/// Assets referred to by a handle are never evicted, so the
+	/// cache may stay above its limit while they are in use.
+	///
+	/// \param bytes Memory limit
+	///
+	////////////////////////////////////////////////////////////
+	void setMemoryLimit(std::size_t bytes);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the amount of bytes uploaded per update
+	///
+	/// At least one asset is uploaded per update, however large.
+	///
+	/// \param bytes Upload budget
+	///
+	////////////////////////////////////////////////////////////
+	void setUploadBudget(std::size_t bytes);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of bytes used by the cached assets
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getMemoryUsage() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of cached assets
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getAssetCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of assets still loading
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getLoadingCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the function raised whenever an asset finished loading
+	///
+	/// Raised for failed assets and reloads as well, with their state set.
+	///
+	/// \param onLoaded Function to raise
+	///
+	////////////////////////////////////////////////////////////
+	void setOnLoaded(Event1<AssetCache, const AssetHandle&> onLoaded);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Upload the decoded assets within the budget and evict unused ones
+	///
+	////////////////////////////////////////////////////////////
+	virtual void update() override;
+
+private:
+
+	friend class AssetHandle;
+	friend class TextureHandle;
+	friend class FontHandle;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Kind of file an asset is loaded from
+	///
+	////////////////////////////////////////////////////////////
+	enum class Kind
+	{
+		Texture, //!< Image decoded to a texture
+		Font     //!< Font file kept in memory
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Cached texture or font
+	///
+	////////////////////////////////////////////////////////////
+	struct Asset
+	{
+		std::string                  m_key;        //!< Key within the cache
+		std::filesystem::path        m_path;       //!< Path of the file
+		Kind                         m_kind;       //!< Kind of file
+		State                        m_state;      //!< Loading state
+		sf::Texture                  m_texture;    //!< Texture, the placeholder until ready
+		sf::Font                     m_font;       //!< Font, empty until ready
+		std::vector<char>            m_fontData;   //!< File the font reads its glyphs from
+		std::size_t                  m_bytes;      //!< Memory used once ready
+		std::size_t                  m_references; //!< Amount of handles referring to the asset
+		bool                         m_queued;     //!< A worker has the file to read, the asset must stay
+		std::list<Asset*>::iterator  m_unused;     //!< Position within the unused assets, while no handle refers to it
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief File read by a worker, waiting to be uploaded
+	///
+	////////////////////////////////////////////////////////////
+	struct Result
+	{
+		Asset*            m_asset; //!< Asset the file belongs to
+		bool              m_ok;    //!< File could be read and decoded
+		sf::Image         m_image; //!< Decoded image of a texture
+		std::vector<char> m_data;  //!< Content of a font file
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find or create an asset and start loading it
+	///
+	/// \param path Path of the file
+	/// \param kind Kind of file
+	///
+	////////////////////////////////////////////////////////////
+	Asset& request(const std::filesystem::path& path, Kind kind);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Hand the file of an asset to the workers
+	///
+	/// \param asset Asset to load
+	///
+	////////////////////////////////////////////////////////////
+	void queue(Asset& asset);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Reload the files the watcher reported
+	///
+	////////////////////////////////////////////////////////////
+	void collectChanges();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a handle to an asset
+	///
+	/// \param asset Asset referred to
+	///
+	////////////////////////////////////////////////////////////
+	void acquire(Asset& asset);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove a handle from an asset
+	///
+	/// \param asset Asset no longer referred to
+	///
+	////////////////////////////////////////////////////////////
+	void release(Asset& asset);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Turn a decoded file into its texture or font
+	///
+	/// \param result Decoded file
+	///
+	////////////////////////////////////////////////////////////
+	void upload(Result& result);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Evict unused assets until the memory limit is met
+	///
+	////////////////////////////////////////////////////////////
+	void trim();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Loop of the worker threads
+	///
+	////////////////////////////////////////////////////////////
+	void run();
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::unordered_map<std::string, std::unique_ptr<Asset>> m_assets;       //!< Cached assets by kind and path
+	std::list<Asset*>                                       m_unused;       //!< Assets no handle refers to, least recently released first
+	sf::Image                                               m_placeholder;  //!< Image shown by textures until they are ready
+	std::size_t                                             m_memory;       //!< Bytes used by the ready assets
+	std::size_t                                             m_memoryLimit;  //!< Bytes the cached assets may use
+	std::size_t                                             m_budget;       //!< Bytes uploaded per update
+	std::size_t                                             m_loading;      //!< Assets waiting for their file
+	Event1<AssetCache, const AssetHandle&>                  m_onLoaded;     //!< Raised when an asset finished loading
+	std::vector<std::thread>                                m_workers;      //!< Threads decoding files
+	std::mutex                                              m_mutex;        //!< Protects the queues
+	std::condition_variable                                 m_wake;         //!< Signals a new file or stopping to the workers
+	std::deque<std::pair<Asset*, std::filesystem::path>>    m_jobs;         //!< Files to decode, with the asset they belong to
+	std::deque<Result>                                      m_results;      //!< Decoded files waiting to be uploaded
+	bool                                                    m_stopping;     //!< Workers have to exit
+	FileWatcher                                             m_watcher;      //!< Reports the written files of the watched directory
+	TimerWheel::Id                                          m_watchTimer;   //!< Timer collecting the written files
+};
+
+
+////////////////////////////////////////////////////////////
+/// \brief Reference to a cached asset, keeping it from eviction
+///
+////////////////////////////////////////////////////////////
+class AssetHandle
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// This constructor creates a handle referring to no asset
+	///
+	////////////////////////////////////////////////////////////
+	AssetHandle();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Copy constructor
+	///
+	////////////////////////////////////////////////////////////
+	AssetHandle(const AssetHandle& other);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move constructor
+	///
+	////////////////////////////////////////////////////////////
+	AssetHandle(AssetHandle&& other) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Assignment operator
+	///
+	////////////////////////////////////////////////////////////
+	AssetHandle& operator=(AssetHandle other) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	////////////////////////////////////////////////////////////
+	~AssetHandle();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether the handle refers to an asset
+	///
+	////////////////////////////////////////////////////////////
+	bool isValid() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the loading state of the asset
+	///
+	////////////////////////////////////////////////////////////
+	AssetCache::State getState() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether the asset is loaded
+	///
+	////////////////////////////////////////////////////////////
+	bool isReady() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the path of the asset's file
+	///
+	////////////////////////////////////////////////////////////
+	const std::filesystem::path& getPath() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether two handles refer to the same asset
+	///
+	////////////////////////////////////////////////////////////
+	bool operator==(const AssetHandle& other) const;
+
+protected:
+
+	friend class AssetCache;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Create a handle referring to an asset
+	///
+	/// \param cache Cache holding the asset
+	/// \param asset Asset referred to
+	///
+	////////////////////////////////////////////////////////////
+	AssetHandle(AssetCache& cache, AssetCache::Asset& asset);
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	AssetCache*        m_cache; //!< Cache holding the asset
+	AssetCache::Asset* m_asset; //!< Asset referred to, null for an empty handle
+};
+
+
+////////////////////////////////////////////////////////////
+/// \brief Reference to a cached texture
+///
+////////////////////////////////////////////////////////////
+class TextureHandle : public AssetHandle
+{
+public:
+
+	using AssetHandle::AssetHandle;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the texture, the placeholder while it is not ready
+	///
+	/// The reference stays valid as long as a handle refers to
+	/// the texture. Must not be called on an empty handle.
+	///
+	////////////////////////////////////////////////////////////
+	const sf::Texture& get() const;
+
+private:
+
+	friend class AssetCache;
+};
+
+
+////////////////////////////////////////////////////////////
+/// \brief Reference to a cached font
+///
+////////////////////////////////////////////////////////////
+class FontHandle : public AssetHandle
+{
+public:
+
+	using AssetHandle::AssetHandle;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the font, without glyphs while it is not ready
+	///
+	/// The reference stays valid as long as a handle refers to
+	/// the font. Must not be called on an empty handle.
+	///
+	////////////////////////////////////////////////////////////
+	const sf::Font& get() const;
+
+private:
+
+	friend class AssetCache;
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_ASSET_CACHE_HPP
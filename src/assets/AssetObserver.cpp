@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "AssetObserver.hpp"
+#include <unordered_map>
+#include <vector>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static std::unordered_map<const void*, std::vector<AssetObserver*>> observers; //!< Observers of every observed resource
+
+
+////////////////////////////////////////////////////////////
+AssetObserver::AssetObserver() :
+m_resource(nullptr),
+m_index   (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+AssetObserver::AssetObserver(const AssetObserver& other) :
+m_resource(nullptr),
+m_index   (0)
+{
+	observe(other.m_resource);
+}
+
+
+////////////////////////////////////////////////////////////
+AssetObserver& AssetObserver::operator=(const AssetObserver& other)
+{
+	observe(other.m_resource);
+	return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+AssetObserver::~AssetObserver()
+{
+	observe(nullptr);
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetObserver::notify(const void* resource)
+{
+	auto it = observers.find(resource);
+	if (it == observers.end())
+	{
+		return;
+	}
+
+	// Observers may start or stop observing while being notified
+	std::vector<AssetObserver*> notified = it->second;
+	for (AssetObserver* observer : notified)
+	{
+		observer->onAssetChanged();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetObserver::observe(const void* resource)
+{
+	if (resource == this->m_resource)
+	{
+		return;
+	}
+
+	// The last observer takes the place of the removed one
+	if (this->m_resource)
+	{
+		auto it = observers.find(this->m_resource);
+		std::vector<AssetObserver*>& list = it->second;
+		list[this->m_index] = list.back();
+		list[this->m_index]->m_index = this->m_index;
+		list.pop_back();
+		if (list.empty())
+		{
+			observers.erase(it);
+		}
+	}
+
+	this->m_resource = resource;
+	if (resource)
+	{
+		std::vector<AssetObserver*>& list = observers[resource];
+		this->m_index = list.size();
+		list.push_back(this);
+	}
+}
+
+} //namespace le
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_ASSET_OBSERVER_HPP
+#define LEVEL_EDITOR_ASSET_OBSERVER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Interface, representing an object showing a texture or a font
+///
+/// An observer is notified when the content of the resource it
+/// observes changes, typically when the asset cache loaded or
+/// reloaded it, so that only the objects showing a changed asset
+/// are redrawn. Observers of a resource are found in constant
+/// time, none is visited for unrelated resources.
+///
+////////////////////////////////////////////////////////////
+class AssetObserver
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	AssetObserver();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Copy constructor
+	///
+	/// The copy observes the same resource as the source.
+	///
+	////////////////////////////////////////////////////////////
+	AssetObserver(const AssetObserver& other);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Copy assignment
+	///
+	/// The object observes the same resource as the source.
+	///
+	////////////////////////////////////////////////////////////
+	AssetObserver& operator=(const AssetObserver& other);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Virtual destructor
+	///
+	/// Stops observing.
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~AssetObserver();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Notify the observers of a resource that its content changed
+	///
+	/// \param resource Texture or font whose content changed
+	///
+	////////////////////////////////////////////////////////////
+	static void notify(const void* resource);
+
+protected:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Observe a resource instead of the current one
+	///
+	/// \param resource Texture or font, null to stop observing
+	///
+	////////////////////////////////////////////////////////////
+	void observe(const void* resource);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Called when the content of the observed resource changed
+	///
+	////////////////////////////////////////////////////////////
+	virtual void onAssetChanged() = 0;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	const void* m_resource; //!< Observed resource, null if none
+	std::size_t m_index;    //!< Index among the observers of the resource
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_ASSET_OBSERVER_HPP
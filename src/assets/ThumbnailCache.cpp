@@ -0,0 +1,569 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "ThumbnailCache.hpp"
+#include "../utility/BoxFilter.hpp"
+#include "../utility/Crc32.hpp"
+#include "../utility/Varint.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <SFML/Graphics/Image.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const char        Magic[]         = "LETHUMB1";   //!< Start of the index file
+static const std::size_t MagicSize       = 8;            //!< Length of the start of the index file
+static const sf::Uint32  NoSlot          = 0xFFFFFFFF;   //!< Slot of the files that could not be decoded
+static const std::size_t MaxPageTextures = 16;           //!< Pages kept uploaded at most, once trimmed
+static const std::size_t CompactMinimum  = 1024;         //!< Superseded records above which the index is rewritten
+
+
+////////////////////////////////////////////////////////////
+static void writeRecord(std::vector<char>& output, const std::string& key, sf::Uint64 size, sf::Int64 modified, sf::Uint64 hash, sf::Uint32 slot)
+{
+	// Slots are stored plus one, zero marks the files that could not be decoded
+	Varint::write(output, key.size());
+	output.insert(output.end(), key.begin(), key.end());
+	Varint::write(output, size);
+	Varint::write(output, static_cast<sf::Uint64>(modified));
+	Varint::write(output, hash);
+	Varint::write(output, slot == NoSlot ? 0 : static_cast<sf::Uint64>(slot) + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+static bool readFile(const std::filesystem::path& path, std::vector<char>& data)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		return false;
+	}
+
+	data.resize(static_cast<std::size_t>(file.tellg()));
+	file.seekg(0);
+	return static_cast<bool>(file.read(data.data(), static_cast<std::streamsize>(data.size())));
+}
+
+
+////////////////////////////////////////////////////////////
+ThumbnailCache::ThumbnailCache(unsigned int workerCount) :
+m_directory  (),
+m_size       (0),
+m_slotCount  (0),
+m_records    (),
+m_slots      (),
+m_pages      (),
+m_index      (),
+m_pageFile   (),
+m_useClock   (0),
+m_pending    (),
+m_onGenerated([](ThumbnailCache&, const std::filesystem::path&) {}),
+m_workers    (),
+m_mutex      (),
+m_wake       (),
+m_jobs       (),
+m_results    (),
+m_stopping   (false)
+{
+	for (unsigned int i = 0; i < std::max(workerCount, 1u); i++)
+	{
+		this->m_workers.emplace_back(&ThumbnailCache::run, this);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+ThumbnailCache::~ThumbnailCache()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_stopping = true;
+	}
+
+	this->m_wake.notify_all();
+	for (std::thread& worker : this->m_workers)
+	{
+		worker.join();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool ThumbnailCache::open(const std::filesystem::path& directory, unsigned int thumbnailSize)
+{
+	this->m_index.close();
+	this->m_pageFile.close();
+	this->m_pages.clear();
+	this->m_records.clear();
+	this->m_pending.clear();
+	this->m_directory = directory / std::to_string(thumbnailSize);
+	this->m_slotCount = 0;
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_size = std::clamp(thumbnailSize, 1u, PageSize);
+		this->m_jobs.clear();
+		this->m_slots.clear();
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories(this->m_directory, error);
+
+	// Slots are only counted while whole, the last page may end with a slot that was being written
+	std::size_t slotBytes = static_cast<std::size_t>(this->m_size) * this->m_size * 4;
+	for (std::size_t page = 0;; page++)
+	{
+		std::uintmax_t bytes = std::filesystem::file_size(getPagePath(page), error);
+		if (error)
+		{
+			break;
+		}
+
+		sf::Uint32 slots = static_cast<sf::Uint32>(std::min<std::uintmax_t>(bytes / slotBytes, getSlotsPerPage()));
+		this->m_slotCount += slots;
+		if (slots < getSlotsPerPage())
+		{
+			break;
+		}
+	}
+
+	// Later records of a file replace the earlier ones, records of slots that were lost are dropped
+	std::filesystem::path indexPath = this->m_directory / "index.bin";
+	std::size_t recordCount = 0;
+	bool valid = false;
+	{
+		MappedFile index;
+		index.open(indexPath);
+		const sf::Uint8* data = reinterpret_cast<const sf::Uint8*>(index.getData());
+		const sf::Uint8* end = data + index.getSize();
+		sf::Uint64 size = 0;
+		valid = index.getSize() > MagicSize && std::memcmp(data, Magic, MagicSize) == 0;
+		data += valid ? MagicSize : 0;
+		valid = valid && Varint::read(data, end, size) && size == this->m_size;
+
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		const sf::Uint8* parsed = data;
+		while (valid && data < end)
+		{
+			sf::Uint64 length = 0;
+			if (!Varint::read(data, end, length) || length > static_cast<sf::Uint64>(end - data))
+			{
+				break;
+			}
+
+			std::string key(reinterpret_cast<const char*>(data), static_cast<std::size_t>(length));
+			data += length;
+
+			sf::Uint64 fileSize = 0;
+			sf::Uint64 modified = 0;
+			sf::Uint64 hash = 0;
+			sf::Uint64 slot = 0;
+			if (!Varint::read(data, end, fileSize) || !Varint::read(data, end, modified) || !Varint::read(data, end, hash) || !Varint::read(data, end, slot))
+			{
+				break;
+			}
+
+			parsed = data;
+			recordCount++;
+			if (slot > this->m_slotCount)
+			{
+				this->m_records.erase(key);
+				continue;
+			}
+
+			Record record = { fileSize, static_cast<sf::Int64>(modified), hash, slot == 0 ? NoSlot : static_cast<sf::Uint32>(slot - 1) };
+			this->m_records[key] = record;
+			if (record.m_slot != NoSlot)
+			{
+				this->m_slots[hash] = record.m_slot;
+			}
+		}
+
+		// Records appended after a partly written one could not be read back
+		valid = valid && parsed == end;
+	}
+
+	if (valid && recordCount <= this->m_records.size() * 2 + CompactMinimum)
+	{
+		this->m_index.open(indexPath, std::ios::binary | std::ios::app);
+		return this->m_index.good();
+	}
+
+	// A new, foreign or mostly superseded index is written again from the records kept
+	std::vector<char> output(Magic, Magic + MagicSize);
+	Varint::write(output, this->m_size);
+	for (const auto& [key, record] : this->m_records)
+	{
+		writeRecord(output, key, record.m_size, record.m_modified, record.m_hash, record.m_slot);
+	}
+
+	std::filesystem::path temporary = indexPath;
+	temporary += ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		if (!file.write(output.data(), static_cast<std::streamsize>(output.size())))
+		{
+			return false;
+		}
+	}
+
+	std::filesystem::rename(temporary, indexPath, error);
+	this->m_index.open(indexPath, std::ios::binary | std::ios::app);
+	return !error && this->m_index.good();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ThumbnailCache::getThumbnailSize() const
+{
+	return this->m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ThumbnailCache::getThumbnail(const std::filesystem::path& path, sf::Uint64 size, sf::Int64 modified, const sf::Texture*& texture, sf::IntRect& rect)
+{
+	std::string key = path.generic_string();
+	auto it = this->m_records.find(key);
+	if (it == this->m_records.end())
+	{
+		request(key, path, size, modified);
+		return false;
+	}
+
+	const Record& record = it->second;
+	if (record.m_size != size || record.m_modified != modified)
+	{
+		request(key, path, size, modified);
+	}
+
+	return record.m_slot != NoSlot && show(record.m_slot, texture, rect);
+}
+
+
+////////////////////////////////////////////////////////////
+void ThumbnailCache::trim()
+{
+	std::size_t uploaded = 0;
+	for (const std::unique_ptr<Page>& page : this->m_pages)
+	{
+		uploaded += page && page->m_texture ? 1 : 0;
+	}
+
+	// The mapping goes with the texture, it is only needed to upload the slots
+	for (; uploaded > MaxPageTextures; uploaded--)
+	{
+		Page* oldest = nullptr;
+		for (const std::unique_ptr<Page>& page : this->m_pages)
+		{
+			if (page && page->m_texture && (!oldest || page->m_lastUse < oldest->m_lastUse))
+			{
+				oldest = page.get();
+			}
+		}
+
+		oldest->m_texture.reset();
+		oldest->m_uploaded.clear();
+		oldest->m_file.close();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ThumbnailCache::getPendingCount() const
+{
+	return this->m_pending.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void ThumbnailCache::setOnGenerated(Event1<ThumbnailCache, const std::filesystem::path&> onGenerated)
+{
+	this->m_onGenerated = std::move(onGenerated);
+}
+
+
+////////////////////////////////////////////////////////////
+void ThumbnailCache::update()
+{
+	std::deque<Result> results;
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		results.swap(this->m_results);
+	}
+
+	std::size_t slotBytes = static_cast<std::size_t>(this->m_size) * this->m_size * 4;
+	std::vector<char> output;
+	for (Result& result : results)
+	{
+		const Job& job = result.m_job;
+		this->m_pending.erase(job.m_key);
+
+		// Files that could not be decoded are recorded too, so that they are only read again once modified
+		Record record = { job.m_size, job.m_modified, result.m_hash, NoSlot };
+		if (result.m_ok)
+		{
+			auto slot = this->m_slots.find(result.m_hash);
+			if (slot != this->m_slots.end())
+			{
+				record.m_slot = slot->second;
+			}
+			else if (result.m_pixels.size() == slotBytes)
+			{
+				record.m_slot = append(result.m_pixels);
+				std::lock_guard<std::mutex> lock(this->m_mutex);
+				this->m_slots[result.m_hash] = record.m_slot;
+			}
+			else
+			{
+				// Generated before the cache was opened again, the file is requested again when looked up
+				continue;
+			}
+		}
+
+		this->m_records[job.m_key] = record;
+		writeRecord(output, job.m_key, record.m_size, record.m_modified, record.m_hash, record.m_slot);
+		if (result.m_ok)
+		{
+			this->m_onGenerated(*this, job.m_path);
+		}
+	}
+
+	// Pixels are written before the records pointing at them
+	if (!output.empty())
+	{
+		this->m_pageFile.flush();
+		this->m_index.write(output.data(), static_cast<std::streamsize>(output.size()));
+		this->m_index.flush();
+	}
+
+	if (this->m_pending.empty())
+	{
+		unschedule();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool ThumbnailCache::show(sf::Uint32 slot, const sf::Texture*& texture, sf::IntRect& rect)
+{
+	std::size_t index = slot / getSlotsPerPage();
+	std::size_t local = slot % getSlotsPerPage();
+	unsigned int columns = PageSize / this->m_size;
+	Page& page = getPage(index);
+	page.m_lastUse = ++this->m_useClock;
+	texture = page.m_texture.get();
+	rect = sf::IntRect(static_cast<int>(local % columns * this->m_size), static_cast<int>(local / columns * this->m_size), static_cast<int>(this->m_size), static_cast<int>(this->m_size));
+	if (page.m_uploaded.test(local))
+	{
+		return true;
+	}
+
+	// The mapping is made again when it does not cover the slot, which was appended since
+	std::size_t slotBytes = static_cast<std::size_t>(this->m_size) * this->m_size * 4;
+	std::size_t offset = local * slotBytes;
+	if (page.m_file.getSize() < offset + slotBytes)
+	{
+		this->m_pageFile.flush();
+		page.m_file.open(getPagePath(index));
+	}
+
+	if (page.m_file.getSize() < offset + slotBytes)
+	{
+		return false;
+	}
+
+	page.m_texture->update(reinterpret_cast<const sf::Uint8*>(page.m_file.getData() + offset), this->m_size, this->m_size,
+		static_cast<unsigned int>(rect.left), static_cast<unsigned int>(rect.top));
+	page.m_uploaded.set(local);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 ThumbnailCache::append(const std::vector<sf::Uint8>& pixels)
+{
+	sf::Uint32 slot = this->m_slotCount++;
+	std::size_t index = slot / getSlotsPerPage();
+	std::size_t local = slot % getSlotsPerPage();
+	std::size_t slotBytes = pixels.size();
+
+	// Windows does not let a mapped file grow, the page is mapped again when a slot is looked up
+	Page& page = getPage(index);
+	page.m_file.close();
+	if (local == 0 || !this->m_pageFile.is_open())
+	{
+		// A slot left partly written by a previous session is overwritten
+		std::error_code error;
+		this->m_pageFile.close();
+		this->m_pageFile.clear();
+		if (local > 0)
+		{
+			std::filesystem::resize_file(getPagePath(index), local * slotBytes, error);
+		}
+
+		this->m_pageFile.open(getPagePath(index), std::ios::binary | std::ios::app);
+	}
+
+	this->m_pageFile.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(slotBytes));
+
+	// The page being filled is likely shown, its new slot is uploaded right away
+	unsigned int columns = PageSize / this->m_size;
+	page.m_texture->update(pixels.data(), this->m_size, this->m_size, static_cast<unsigned int>(local % columns * this->m_size), static_cast<unsigned int>(local / columns * this->m_size));
+	page.m_uploaded.set(local);
+	return slot;
+}
+
+
+////////////////////////////////////////////////////////////
+ThumbnailCache::Page& ThumbnailCache::getPage(std::size_t index)
+{
+	if (index >= this->m_pages.size())
+	{
+		this->m_pages.resize(index + 1);
+	}
+
+	std::unique_ptr<Page>& page = this->m_pages[index];
+	if (!page)
+	{
+		page = std::make_unique<Page>();
+		page->m_lastUse = 0;
+	}
+
+	if (!page->m_texture)
+	{
+		page->m_texture = std::make_unique<sf::Texture>();
+		page->m_texture->create(PageSize, PageSize);
+		page->m_uploaded.resize(getSlotsPerPage());
+	}
+
+	return *page;
+}
+
+
+////////////////////////////////////////////////////////////
+std::filesystem::path ThumbnailCache::getPagePath(std::size_t index) const
+{
+	return this->m_directory / ("page" + std::to_string(index) + ".bin");
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 ThumbnailCache::getSlotsPerPage() const
+{
+	sf::Uint32 columns = PageSize / this->m_size;
+	return columns * columns;
+}
+
+
+////////////////////////////////////////////////////////////
+void ThumbnailCache::request(const std::string& key, const std::filesystem::path& path, sf::Uint64 size, sf::Int64 modified)
+{
+	if (!this->m_pending.insert(key).second)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_jobs.push_back(Job{ key, path, size, modified });
+	}
+
+	this->m_wake.notify_one();
+	schedule();
+}
+
+
+////////////////////////////////////////////////////////////
+void ThumbnailCache::run()
+{
+	for (;;)
+	{
+		Job job;
+		unsigned int size = 0;
+		{
+			std::unique_lock<std::mutex> lock(this->m_mutex);
+			this->m_wake.wait(lock, [this]() { return this->m_stopping || !this->m_jobs.empty(); });
+			if (this->m_stopping)
+			{
+				return;
+			}
+
+			// The files requested last are the ones shown now, those scrolled past wait
+			job = std::move(this->m_jobs.back());
+			this->m_jobs.pop_back();
+			size = this->m_size;
+		}
+
+		Result result;
+		result.m_job = std::move(job);
+		result.m_hash = 0;
+
+		std::vector<char> data;
+		result.m_ok = readFile(result.m_job.m_path, data);
+		if (result.m_ok)
+		{
+			result.m_hash = static_cast<sf::Uint64>(Crc32::compute(data.data(), data.size())) << 32 | (data.size() & 0xFFFFFFFF);
+		}
+
+		// A file whose content already has a thumbnail is not decoded
+		bool known = false;
+		if (result.m_ok)
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+			known = this->m_slots.count(result.m_hash) > 0;
+		}
+
+		sf::Image image;
+		if (result.m_ok && !known)
+		{
+			result.m_ok = image.loadFromMemory(data.data(), data.size());
+		}
+
+		if (result.m_ok && !known)
+		{
+			// The image is fitted within the slot, keeping its proportions, and centred
+			sf::Vector2u source = image.getSize();
+			float scale = std::min(static_cast<float>(size) / source.x, static_cast<float>(size) / source.y);
+			sf::Vector2u fitted(std::clamp(static_cast<unsigned int>(std::lround(source.x * scale)), 1u, size),
+				std::clamp(static_cast<unsigned int>(std::lround(source.y * scale)), 1u, size));
+			std::size_t offset = (static_cast<std::size_t>(size - fitted.y) / 2 * size + (size - fitted.x) / 2) * 4;
+			result.m_pixels.assign(static_cast<std::size_t>(size) * size * 4, 0);
+			BoxFilter::downscale(image.getPixelsPtr(), source, result.m_pixels.data() + offset, fitted, size);
+		}
+
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_results.push_back(std::move(result));
+	}
+}
+
+} //namespace le
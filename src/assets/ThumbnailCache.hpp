@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_THUMBNAIL_CACHE_HPP
+#define LEVEL_EDITOR_THUMBNAIL_CACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../ui/interfaces/Updatable.hpp"
+#include "../utility/BitSet.hpp"
+#include "../utility/Config.hpp"
+#include "../utility/MappedFile.hpp"
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Persistent cache of the thumbnails of image files
+///
+/// Thumbnails are packed into atlas pages stored on disk next to
+/// an append-only index. The index maps a file, recognized by its
+/// size and modification time, to the hash of its content, and
+/// each hash to a slot of a page. Files already seen are shown
+/// without being read, identical files share a slot.
+///
+/// Pages are mapped into memory and only the slots looked up are
+/// uploaded to the page's texture. Missing thumbnails are decoded
+/// and shrunk by worker threads, then appended by the main thread.
+///
+////////////////////////////////////////////////////////////
+class ThumbnailCache : public Updatable, sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Size of the side of a page in pixels
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr unsigned int PageSize = 1024;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param workerCount Amount of threads generating thumbnails
+	///
+	////////////////////////////////////////////////////////////
+	explicit ThumbnailCache(unsigned int workerCount);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Waits for the thumbnails being generated, their results are dropped.
+	///
+	////////////////////////////////////////////////////////////
+	~ThumbnailCache();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Open the cache stored in a directory, creating it if needed
+	///
+	/// Thumbnails of different sizes are stored apart.
+	///
+	/// \param directory     Directory of the cache
+	/// \param thumbnailSize Size of the side of a thumbnail in pixels
+	///
+	/// \return False if the directory could not be written, thumbnails then only last while uploaded
+	///
+	////////////////////////////////////////////////////////////
+	bool open(const std::filesystem::path& directory, unsigned int thumbnailSize);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the size of the side of a thumbnail in pixels
+	///
+	////////////////////////////////////////////////////////////
+	unsigned int getThumbnailSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the thumbnail of a file, generating it if missing
+	///
+	/// The previous thumbnail of a modified file is returned until
+	/// the new one is generated. Paths are stored as given, so
+	/// paths relative to the project keep the cache valid when the
+	/// project moves.
+	///
+	/// \param path     Path of the image file
+	/// \param size     Size of the file in bytes
+	/// \param modified Time of the last write of the file
+	/// \param texture  Receives the texture of the page holding the thumbnail
+	/// \param rect     Receives the area of the thumbnail within the texture
+	///
+	/// \return False if the file has no thumbnail yet or could not be decoded
+	///
+	////////////////////////////////////////////////////////////
+	bool getThumbnail(const std::filesystem::path& path, sf::Uint64 size, sf::Int64 modified, const sf::Texture*& texture, sf::IntRect& rect);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Release the textures of the pages used least recently
+	///
+	/// Called before looking up the thumbnails of a frame, so that
+	/// no texture returned since is released while being drawn.
+	///
+	////////////////////////////////////////////////////////////
+	void trim();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of thumbnails being generated
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getPendingCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the event raised when the thumbnail of a file was generated
+	///
+	/// \param onGenerated Event raised with the path of the file
+	///
+	////////////////////////////////////////////////////////////
+	void setOnGenerated(Event1<ThumbnailCache, const std::filesystem::path&> onGenerated);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Store the generated thumbnails
+	///
+	/// Scheduled while thumbnails are being generated.
+	///
+	////////////////////////////////////////////////////////////
+	virtual void update() override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class recognizing a file and its thumbnail
+	///
+	////////////////////////////////////////////////////////////
+	struct Record
+	{
+		sf::Uint64 m_size;     //!< Size of the file in bytes
+		sf::Int64  m_modified; //!< Time of the last write of the file
+		sf::Uint64 m_hash;     //!< Hash of the content and size of the file
+		sf::Uint32 m_slot;     //!< Slot of the thumbnail, NoSlot if the file could not be decoded
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Atlas page, uploaded one slot at a time
+	///
+	////////////////////////////////////////////////////////////
+	struct Page
+	{
+		MappedFile                   m_file;     //!< Pixels of the slots written, slot after slot
+		std::unique_ptr<sf::Texture> m_texture;  //!< Texture of the page, only while used
+		BitSet                       m_uploaded; //!< Bit per slot uploaded to the texture
+		sf::Uint64                   m_lastUse;  //!< Time the page was last looked up
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Thumbnail to generate
+	///
+	////////////////////////////////////////////////////////////
+	struct Job
+	{
+		std::string           m_key;      //!< Path of the file as stored
+		std::filesystem::path m_path;     //!< Path of the file
+		sf::Uint64            m_size;     //!< Size of the file in bytes
+		sf::Int64             m_modified; //!< Time of the last write of the file
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Thumbnail generated by a worker
+	///
+	////////////////////////////////////////////////////////////
+	struct Result
+	{
+		Job                    m_job;    //!< Job the result is for
+		bool                   m_ok;     //!< File was read and decoded
+		sf::Uint64             m_hash;   //!< Hash of the content and size of the file
+		std::vector<sf::Uint8> m_pixels; //!< RGBA pixels of the thumbnail, empty if the hash already had a slot
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Upload a slot to the texture of its page if needed
+	///
+	/// \param slot    Slot of the thumbnail
+	/// \param texture Receives the texture of the page
+	/// \param rect    Receives the area of the slot within the texture
+	///
+	/// \return False if the slot could not be read
+	///
+	////////////////////////////////////////////////////////////
+	bool show(sf::Uint32 slot, const sf::Texture*& texture, sf::IntRect& rect);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Append a thumbnail to the last page
+	///
+	/// \param pixels RGBA pixels of the thumbnail
+	///
+	/// \return Slot of the thumbnail
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint32 append(const std::vector<sf::Uint8>& pixels);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a page, creating it and its texture if needed
+	///
+	/// \param index Index of the page
+	///
+	////////////////////////////////////////////////////////////
+	Page& getPage(std::size_t index);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the path of the file of a page
+	///
+	/// \param index Index of the page
+	///
+	////////////////////////////////////////////////////////////
+	std::filesystem::path getPagePath(std::size_t index) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of slots of a page
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint32 getSlotsPerPage() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Generate the thumbnail of a file
+	///
+	/// \param key      Path of the file as stored
+	/// \param path     Path of the file
+	/// \param size     Size of the file in bytes
+	/// \param modified Time of the last write of the file
+	///
+	////////////////////////////////////////////////////////////
+	void request(const std::string& key, const std::filesystem::path& path, sf::Uint64 size, sf::Int64 modified);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Loop of a worker thread
+	///
+	////////////////////////////////////////////////////////////
+	void run();
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::filesystem::path                                  m_directory;   //!< Directory of the pages and index
+	unsigned int                                           m_size;        //!< Size of the side of a thumbnail in pixels
+	sf::Uint32                                             m_slotCount;   //!< Amount of slots written
+	std::unordered_map<std::string, Record>                m_records;     //!< Record of every file seen
+	std::unordered_map<sf::Uint64, sf::Uint32>             m_slots;       //!< Slot of every hash
+	std::vector<std::unique_ptr<Page>>                     m_pages;       //!< Pages looked up or written
+	std::ofstream                                          m_index;       //!< Index the records are appended to
+	std::ofstream                                          m_pageFile;    //!< Last page, the slots are appended to
+	sf::Uint64                                             m_useClock;    //!< Counter ordering the page lookups
+	std::unordered_set<std::string>                        m_pending;     //!< Files whose thumbnail is being generated
+	Event1<ThumbnailCache, const std::filesystem::path&>   m_onGenerated; //!< Event raised when the thumbnail of a file was generated
+	std::vector<std::thread>                               m_workers;     //!< Threads generating the thumbnails
+	std::mutex                                             m_mutex;       //!< Protects the jobs, results, stopping flag and the slots written by the main thread
+	std::condition_variable                                m_wake;        //!< Signals the workers a job or the stop
+	std::deque<Job>                                        m_jobs;        //!< Thumbnails to generate, the last requested first
+	std::deque<Result>                                     m_results;     //!< Thumbnails generated, waiting for the main thread
+	bool                                                   m_stopping;    //!< Workers have to exit
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_THUMBNAIL_CACHE_HPP
@@ -0,0 +1,411 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "AutoTiler.hpp"
+#include "../utility/JobSystem.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Dirty tiles of a chunk and the tiles picked for them
+///
+////////////////////////////////////////////////////////////
+struct DirtyChunk
+{
+	sf::Vector2i                            m_key;        //!< Coordinates of the chunk
+	std::array<sf::Uint32, TileChunk::Size> m_dirty;      //!< Bit per dirty tile, a word per row
+	std::array<const TileChunk*, 9>         m_neighbours; //!< The chunk and those around it row by row, nullptr where no tile was set
+	std::array<TileId, TileChunk::Area>     m_tiles;      //!< Tile picked for every tile, Tileset::Empty where the tile stays
+};
+
+
+////////////////////////////////////////////////////////////
+static const int         PatternBits[9] = { 7, 0, 1, 6, -1, 2, 5, 4, 3 }; //!< Neighbour bit of every cell of a pattern, row by row
+static const std::size_t BatchSize      = 1024;                           //!< Amount of chunks retiled at once, which bounds the memory of a full retiling
+
+
+////////////////////////////////////////////////////////////
+static bool parsePattern(const std::string& pattern, sf::Uint8& required, sf::Uint8& checked)
+{
+	required = 0;
+	checked = 0;
+	int cell = 0;
+	for (char character : pattern)
+	{
+		if (character == ' ' || character == '\t' || character == '\r')
+		{
+			continue;
+		}
+
+		if (cell == 9 || (character != '1' && character != '0' && character != '*') || (cell == 4 && character == '0'))
+		{
+			return false;
+		}
+
+		if (cell != 4 && character != '*')
+		{
+			checked |= 1 << PatternBits[cell];
+			required |= (character == '1') << PatternBits[cell];
+		}
+
+		cell++;
+	}
+
+	return cell == 9;
+}
+
+
+////////////////////////////////////////////////////////////
+static void retileChunk(DirtyChunk& chunk, const BitSet& terrain, const std::array<TileId, 256>& table)
+{
+	// Terrain of the chunk and of a one tile border around it, bit x + 1 of row y + 1
+	std::array<sf::Uint64, TileChunk::Size + 2> rows = {};
+	for (int y = -1; y <= TileChunk::Size; y++)
+	{
+		for (int x = -1; x <= TileChunk::Size; x++)
+		{
+			int neighbour = (y < 0 ? 0 : y < TileChunk::Size ? 3 : 6) + (x < 0 ? 0 : x < TileChunk::Size ? 1 : 2);
+			const TileChunk* source = chunk.m_neighbours[neighbour];
+			int index = (y + TileChunk::Size) % TileChunk::Size * TileChunk::Size + (x + TileChunk::Size) % TileChunk::Size;
+			if (source && terrain.test(source->getTiles()[index]))
+			{
+				rows[y + 1] |= sf::Uint64(1) << (x + 1);
+			}
+		}
+	}
+
+	const TileChunk& center = *chunk.m_neighbours[4];
+	chunk.m_tiles.fill(Tileset::Empty);
+	for (int y = 0; y < TileChunk::Size; y++)
+	{
+		for (int x = 0; x < TileChunk::Size; x++)
+		{
+			if ((chunk.m_dirty[y] >> x & 1) == 0 || (rows[y + 1] >> (x + 1) & 1) == 0)
+			{
+				continue;
+			}
+
+			// Neighbours clockwise from the north
+			sf::Uint8 mask = static_cast<sf::Uint8>(
+				(rows[y] >> (x + 1) & 1)          | (rows[y] >> (x + 2) & 1) << 1 |
+				(rows[y + 1] >> (x + 2) & 1) << 2 | (rows[y + 2] >> (x + 2) & 1) << 3 |
+				(rows[y + 2] >> (x + 1) & 1) << 4 | (rows[y + 2] >> x & 1) << 5 |
+				(rows[y + 1] >> x & 1) << 6       | (rows[y] >> x & 1) << 7);
+
+			int index = y * TileChunk::Size + x;
+			TileId tile = table[mask];
+			chunk.m_tiles[index] = tile != center.getTiles()[index] ? tile : Tileset::Empty;
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+AutoTiler::AutoTiler(TileLayer& layer) :
+m_layer   (&layer),
+m_rules   (),
+m_table   (),
+m_terrain (),
+m_dirty   (),
+m_applying(false)
+{
+	this->m_table.fill(Tileset::Empty);
+	this->m_terrain.resize(std::size_t(1) << (sizeof(TileId) * 8));
+}
+
+
+////////////////////////////////////////////////////////////
+TileLayer& AutoTiler::getLayer() const
+{
+	return *this->m_layer;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AutoTiler::addRule(TileId tile, const std::string& pattern)
+{
+	Rule rule = { tile, 0, 0 };
+	if (tile == Tileset::Empty || !parsePattern(pattern, rule.m_required, rule.m_checked))
+	{
+		return false;
+	}
+
+	this->m_rules.push_back(rule);
+	compile();
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AutoTiler::loadRules(const std::filesystem::path& path)
+{
+	std::ifstream file(path);
+	if (!file)
+	{
+		printf("Failed to open auto-tiling rules \"%s\"\n", path.string().c_str());
+		return false;
+	}
+
+	std::vector<Rule> rules;
+	std::string line;
+	for (int number = 1; std::getline(file, line); number++)
+	{
+		std::size_t first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos || line[first] == '#')
+		{
+			continue;
+		}
+
+		std::istringstream stream(line);
+		unsigned int tile = 0;
+		std::string pattern;
+		Rule rule = { 0, 0, 0 };
+		if (!(stream >> tile) || tile == Tileset::Empty || tile > 0xFFFF || !std::getline(stream, pattern) || !parsePattern(pattern, rule.m_required, rule.m_checked))
+		{
+			printf("Malformed rule at line %d of \"%s\"\n", number, path.string().c_str());
+			return false;
+		}
+
+		rule.m_tile = static_cast<TileId>(tile);
+		rules.push_back(rule);
+	}
+
+	this->m_rules = std::move(rules);
+	compile();
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AutoTiler::isTerrain(TileId tile) const
+{
+	return this->m_terrain.test(tile);
+}
+
+
+////////////////////////////////////////////////////////////
+TileId AutoTiler::getTile(sf::Uint8 neighbours) const
+{
+	return this->m_table[neighbours];
+}
+
+
+////////////////////////////////////////////////////////////
+void AutoTiler::invalidate(const TileLayer::TileChange& change)
+{
+	if (this->m_applying)
+	{
+		return;
+	}
+
+	// Tiles entering or leaving the terrain change the masks around them, other tiles only need their own
+	const sf::Vector2i& position = change.m_position;
+	bool wasTerrain = isTerrain(change.m_previousTile);
+	bool isNowTerrain = isTerrain(change.m_tile);
+	if (wasTerrain != isNowTerrain)
+	{
+		for (int y = position.y - 1; y <= position.y + 1; y++)
+		{
+			markDirty(TileLayer::Span{ y, position.x - 1, position.x + change.m_length + 1 });
+		}
+	}
+	else if (isNowTerrain)
+	{
+		markDirty(TileLayer::Span{ position.y, position.x, position.x + change.m_length });
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void AutoTiler::invalidateChunk(const sf::Vector2i& key)
+{
+	// The masks of the tiles around the chunk read its tiles too
+	sf::Vector2i origin = key * TileChunk::Size;
+	for (int y = origin.y - 1; y <= origin.y + TileChunk::Size; y++)
+	{
+		markDirty(TileLayer::Span{ y, origin.x - 1, origin.x + TileChunk::Size + 1 });
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AutoTiler::update()
+{
+	if (this->m_dirty.isEmpty())
+	{
+		return 0;
+	}
+
+	std::vector<CoordMap<std::array<sf::Uint32, TileChunk::Size>>::Entry> dirty(this->m_dirty.getEntries().begin(), this->m_dirty.getEntries().end());
+	this->m_dirty.clear();
+
+	// Retiling keeps tiles within the terrain, so a batch never changes the masks read by the next one
+	std::vector<DirtyChunk> chunks;
+	std::size_t changed = 0;
+	this->m_applying = true;
+	for (std::size_t batch = 0; batch < dirty.size(); batch += BatchSize)
+	{
+		// Chunks are resolved here, the workers must not load them lazily
+		chunks.clear();
+		for (std::size_t i = batch; i < std::min(batch + BatchSize, dirty.size()); i++)
+		{
+			// A chunk that is not held in memory is retiled entirely once it loads
+			const sf::Vector2i& key = dirty[i].m_key;
+			if (!this->m_layer->isChunkLoaded(key.x, key.y))
+			{
+				continue;
+			}
+
+			DirtyChunk& chunk = chunks.emplace_back();
+			chunk.m_key = key;
+			chunk.m_dirty = dirty[i].m_value;
+			for (int j = 0; j < 9; j++)
+			{
+				sf::Vector2i neighbour(key.x + j % 3 - 1, key.y + j / 3 - 1);
+				bool loaded = this->m_layer->isChunkLoaded(neighbour.x, neighbour.y);
+				chunk.m_neighbours[j] = loaded ? this->m_layer->getChunk(neighbour.x, neighbour.y) : nullptr;
+
+				// Tiles bordering a chunk that exists but is not loaded are retiled when it loads
+				if (!loaded && this->m_layer->hasChunk(neighbour.x, neighbour.y))
+				{
+					sf::Uint32 columns = j % 3 == 0 ? 1 : j % 3 == 2 ? sf::Uint32(1) << (TileChunk::Size - 1) : ~sf::Uint32(0);
+					int top = j / 3 == 2 ? TileChunk::Size - 1 : 0;
+					int bottom = j / 3 == 0 ? 1 : TileChunk::Size;
+					for (int y = top; y < bottom; y++)
+					{
+						chunk.m_dirty[y] &= ~columns;
+					}
+				}
+			}
+		}
+
+		JobSystem::getDefault().parallelFor(chunks.size(), [&](std::size_t i)
+		{
+			retileChunk(chunks[i], this->m_terrain, this->m_table);
+		});
+
+		for (const DirtyChunk& chunk : chunks)
+		{
+			const TileChunk& center = *chunk.m_neighbours[4];
+			sf::Vector2i origin = chunk.m_key * TileChunk::Size;
+			for (int y = 0; y < TileChunk::Size; y++)
+			{
+				for (int x = 0; x < TileChunk::Size;)
+				{
+					int index = y * TileChunk::Size + x;
+					TileId tile = chunk.m_tiles[index];
+					sf::Uint8 flags = center.getFlags()[index];
+					int end = x + 1;
+					while (end < TileChunk::Size && chunk.m_tiles[index + end - x] == tile && center.getFlags()[index + end - x] == flags)
+					{
+						end++;
+					}
+
+					if (tile != Tileset::Empty)
+					{
+						changed += this->m_layer->fillSpan(TileLayer::Span{ origin.y + y, origin.x + x, origin.x + end }, tile, flags);
+					}
+
+					x = end;
+				}
+			}
+		}
+	}
+
+	this->m_applying = false;
+	return changed;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AutoTiler::retileLoaded()
+{
+	for (const TileLayer::ChunkEntry& entry : this->m_layer->getChunks())
+	{
+		if (entry.m_value)
+		{
+			this->m_dirty[entry.m_key].fill(~sf::Uint32(0));
+		}
+	}
+
+	return update();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AutoTiler::retileAll()
+{
+	this->m_layer->loadChunks(this->m_layer->getChunkBounds());
+	return retileLoaded();
+}
+
+
+////////////////////////////////////////////////////////////
+void AutoTiler::compile()
+{
+	this->m_table.fill(Tileset::Empty);
+	for (std::size_t mask = 0; mask < this->m_table.size(); mask++)
+	{
+		for (const Rule& rule : this->m_rules)
+		{
+			if ((mask & rule.m_checked) == rule.m_required)
+			{
+				this->m_table[mask] = rule.m_tile;
+				break;
+			}
+		}
+	}
+
+	this->m_terrain.clear();
+	for (const Rule& rule : this->m_rules)
+	{
+		this->m_terrain.set(rule.m_tile);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void AutoTiler::markDirty(const TileLayer::Span& span)
+{
+	for (int x = span.m_left; x < span.m_right;)
+	{
+		sf::Vector2i key = TileLayer::getChunkCoords(sf::Vector2i(x, span.m_y));
+		int left = x - key.x * TileChunk::Size;
+		int right = std::min(span.m_right - key.x * TileChunk::Size, TileChunk::Size);
+		sf::Uint32 bits = right - left == TileChunk::Size ? ~sf::Uint32(0) : ((sf::Uint32(1) << (right - left)) - 1) << left;
+		this->m_dirty[key][span.m_y - key.y * TileChunk::Size] |= bits;
+		x = key.x * TileChunk::Size + right;
+	}
+}
+
+} //namespace le
@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_AUTO_TILER_HPP
+#define LEVEL_EDITOR_AUTO_TILER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "TileLayer.hpp"
+#include "../utility/BitSet.hpp"
+#include "../utility/CoordMap.hpp"
+#include <array>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Picks the tiles of a terrain from their neighbours
+///
+/// Rules map the terrain around a tile to the tile drawn there.
+/// Each rule is a 3x3 pattern read row by row, where '1' requires
+/// the neighbour to belong to the terrain, '0' requires it not to
+/// and '*' accepts both, the center being the tile itself. Every
+/// tile id used by a rule belongs to the terrain. Rules cover both
+/// edge-only (Wang) and full bitmask (blob) tilesets, the first
+/// matching rule wins. They are compiled into a table indexed by
+/// the 8 bit mask of the neighbours, so picking a tile is a lookup.
+///
+/// Only the tiles around edited tiles are retiled. Tiles entering
+/// or leaving the terrain mark their 3x3 neighbourhood dirty, the
+/// dirty tiles are retiled chunk by chunk in parallel on update.
+///
+////////////////////////////////////////////////////////////
+class AutoTiler : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param layer Layer whose terrain is retiled
+	///
+	////////////////////////////////////////////////////////////
+	explicit AutoTiler(TileLayer& layer);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the layer whose terrain is retiled
+	///
+	////////////////////////////////////////////////////////////
+	TileLayer& getLayer() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a rule after the existing ones
+	///
+	/// \param tile    Tile drawn where the rule matches
+	/// \param pattern Nine characters among '1', '0' and '*', spaces are ignored
+	///
+	/// \return False if the tile is empty or the pattern malformed
+	///
+	////////////////////////////////////////////////////////////
+	bool addRule(TileId tile, const std::string& pattern);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Replace the rules by those of a file
+	///
+	/// Every line holds a tile id followed by its pattern, lines
+	/// starting with '#' are comments.
+	///
+	/// \param path Path of the rules file
+	///
+	/// \return False if the file could not be read or holds a malformed rule
+	///
+	////////////////////////////////////////////////////////////
+	bool loadRules(const std::filesystem::path& path);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a tile belongs to the terrain
+	///
+	/// \param tile Tile id
+	///
+	////////////////////////////////////////////////////////////
+	bool isTerrain(TileId tile) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the tile the rules pick for a neighbourhood
+	///
+	/// \param neighbours Bit per neighbour belonging to the terrain, clockwise from the north
+	///
+	/// \return Tile id, Tileset::Empty if no rule matches
+	///
+	////////////////////////////////////////////////////////////
+	TileId getTile(sf::Uint8 neighbours) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark the tiles around a change for retiling
+	///
+	/// Meant to be called from the tile changed event of the layer.
+	/// Changes made by the tiler itself are ignored.
+	///
+	/// \param change Previous and new state of the tiles
+	///
+	////////////////////////////////////////////////////////////
+	void invalidate(const TileLayer::TileChange& change);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark a chunk and the tiles bordering it for retiling
+	///
+	/// Meant to be called from the chunk loaded event of the layer,
+	/// so that chunks are retiled as they load.
+	///
+	/// \param key Coordinates of the chunk
+	///
+	////////////////////////////////////////////////////////////
+	void invalidateChunk(const sf::Vector2i& key);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Retile the dirty tiles
+	///
+	/// Chunks are never loaded: dirty chunks that are not held in
+	/// memory are skipped, and tiles bordering them are left until
+	/// they load.
+	///
+	/// \return Amount of tiles that changed
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t update();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Retile every chunk held in memory
+	///
+	/// \return Amount of tiles that changed
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t retileLoaded();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Retile every tile of the layer, typically after loading rules
+	///
+	/// Every chunk of the layer is loaded first.
+	///
+	/// \return Amount of tiles that changed
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t retileAll();
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class describing a rule
+	///
+	////////////////////////////////////////////////////////////
+	struct Rule
+	{
+		TileId    m_tile;     //!< Tile drawn where the rule matches
+		sf::Uint8 m_required; //!< Neighbours that must belong to the terrain
+		sf::Uint8 m_checked;  //!< Neighbours whose state matters
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Rebuild the lookup table and the terrain from the rules
+	///
+	////////////////////////////////////////////////////////////
+	void compile();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark a span of tiles dirty
+	///
+	/// \param span Tiles to mark
+	///
+	////////////////////////////////////////////////////////////
+	void markDirty(const TileLayer::Span& span);
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	TileLayer*                                        m_layer;    //!< Layer whose terrain is retiled
+	std::vector<Rule>                                 m_rules;    //!< Rules in order of priority
+	std::array<TileId, 256>                           m_table;    //!< Tile picked for every neighbourhood
+	BitSet                                            m_terrain;  //!< Bit per tile id belonging to the terrain
+	CoordMap<std::array<sf::Uint32, TileChunk::Size>> m_dirty;    //!< Bit per dirty tile, a word per row of a chunk
+	bool                                              m_applying; //!< Tiles are being set by the tiler
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_AUTO_TILER_HPP
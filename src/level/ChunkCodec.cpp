@@ -0,0 +1,330 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "ChunkCodec.hpp"
+#include "../utility/Varint.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const std::size_t RawSize = TileChunk::Area * (sizeof(TileId) + sizeof(sf::Uint8));         //!< Size of a raw payload
+static const std::size_t MaxRunsSize = TileChunk::Area * (sizeof(TileId) + sizeof(sf::Uint8) + 2); //!< Largest run-length encoding of a chunk, a run for every tile
+static const std::size_t MinMatch = 4;                                                             //!< Shortest repetition the LZ pass encodes
+static const std::size_t MaxOffset = 0xFFFF;                                                       //!< Farthest distance a repetition may reach back
+static const unsigned int HashBits = 12;                                                           //!< Size of the table finding repetitions, as a power of two
+static const std::size_t NoPosition = std::numeric_limits<std::size_t>::max();                     //!< Empty entry of the table finding repetitions
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+static void encodeRuns(const T* values, std::vector<char>& output)
+{
+	for (std::size_t i = 0; i < TileChunk::Area;)
+	{
+		std::size_t run = 1;
+		while (i + run < TileChunk::Area && values[i + run] == values[i])
+		{
+			run++;
+		}
+
+		Varint::write(output, run);
+		for (std::size_t byte = 0; byte < sizeof(T); byte++)
+		{
+			output.push_back(static_cast<char>(values[i] >> (8 * byte)));
+		}
+
+		i += run;
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+static bool decodeRuns(const sf::Uint8*& data, const sf::Uint8* end, T* values)
+{
+	for (std::size_t i = 0; i < TileChunk::Area;)
+	{
+		sf::Uint64 run = 0;
+		if (!Varint::read(data, end, run) || run == 0 || run > static_cast<sf::Uint64>(TileChunk::Area - i) || static_cast<std::size_t>(end - data) < sizeof(T))
+		{
+			return false;
+		}
+
+		T value = 0;
+		for (std::size_t byte = 0; byte < sizeof(T); byte++)
+		{
+			value = static_cast<T>(value | data[byte] << (8 * byte));
+		}
+
+		data += sizeof(T);
+		std::fill_n(values + i, static_cast<std::size_t>(run), value);
+		i += static_cast<std::size_t>(run);
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+static void writeLength(std::vector<char>& output, std::size_t length)
+{
+	for (; length >= 255; length -= 255)
+	{
+		output.push_back(static_cast<char>(255));
+	}
+
+	output.push_back(static_cast<char>(length));
+}
+
+
+////////////////////////////////////////////////////////////
+static bool readLength(const sf::Uint8*& data, const sf::Uint8* end, std::size_t& length)
+{
+	while (data < end)
+	{
+		sf::Uint8 byte = *data++;
+		length += byte;
+		if (byte != 255)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+////////////////////////////////////////////////////////////
+static void writeSequence(std::vector<char>& output, const char* literals, std::size_t literalCount, std::size_t offset, std::size_t matchLength)
+{
+	// The token holds both lengths in a nibble each, longer ones continue after it
+	std::size_t extraMatch = matchLength > 0 ? matchLength - MinMatch : 0;
+	output.push_back(static_cast<char>(std::min<std::size_t>(literalCount, 15) << 4 | std::min<std::size_t>(extraMatch, 15)));
+	if (literalCount >= 15)
+	{
+		writeLength(output, literalCount - 15);
+	}
+
+	output.insert(output.end(), literals, literals + literalCount);
+	if (matchLength == 0)
+	{
+		return;
+	}
+
+	output.push_back(static_cast<char>(offset & 0xFF));
+	output.push_back(static_cast<char>(offset >> 8));
+	if (extraMatch >= 15)
+	{
+		writeLength(output, extraMatch - 15);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+static sf::Uint32 read32(const char* data)
+{
+	sf::Uint32 value;
+	std::memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+
+////////////////////////////////////////////////////////////
+ChunkCodec::Encoding ChunkCodec::encode(const TileChunk& chunk, std::vector<char>& payload)
+{
+	std::vector<char> runs;
+	runs.reserve(RawSize);
+	encodeRuns(chunk.getTiles().data(), runs);
+	encodeRuns(chunk.getFlags().data(), runs);
+
+	payload.clear();
+	Varint::write(payload, runs.size());
+	compress(runs.data(), runs.size(), payload);
+	if (payload.size() < RawSize)
+	{
+		return Compressed;
+	}
+
+	payload.resize(RawSize);
+	std::memcpy(payload.data(), chunk.getTiles().data(), TileChunk::Area * sizeof(TileId));
+	std::memcpy(payload.data() + TileChunk::Area * sizeof(TileId), chunk.getFlags().data(), TileChunk::Area);
+	return Raw;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ChunkCodec::decode(const char* payload, std::size_t size, sf::Uint16 encoding, TileChunk& chunk)
+{
+	std::array<TileId, TileChunk::Area> tiles;
+	std::array<sf::Uint8, TileChunk::Area> flags;
+
+	if (encoding == Raw)
+	{
+		if (size != RawSize)
+		{
+			return false;
+		}
+
+		std::memcpy(tiles.data(), payload, TileChunk::Area * sizeof(TileId));
+		std::memcpy(flags.data(), payload + TileChunk::Area * sizeof(TileId), TileChunk::Area);
+	}
+	else if (encoding == Compressed)
+	{
+		const sf::Uint8* data = reinterpret_cast<const sf::Uint8*>(payload);
+		const sf::Uint8* end = data + size;
+		sf::Uint64 runsSize = 0;
+		if (!Varint::read(data, end, runsSize) || runsSize > static_cast<sf::Uint64>(MaxRunsSize))
+		{
+			return false;
+		}
+
+		std::vector<char> runs(static_cast<std::size_t>(runsSize));
+		if (!decompress(reinterpret_cast<const char*>(data), static_cast<std::size_t>(end - data), runs))
+		{
+			return false;
+		}
+
+		const sf::Uint8* position = reinterpret_cast<const sf::Uint8*>(runs.data());
+		const sf::Uint8* runsEnd = position + runs.size();
+		if (!decodeRuns(position, runsEnd, tiles.data()) || !decodeRuns(position, runsEnd, flags.data()) || position != runsEnd)
+		{
+			return false;
+		}
+	}
+	else
+	{
+		return false;
+	}
+
+	chunk.assign(tiles.data(), flags.data());
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkCodec::compress(const char* data, std::size_t size, std::vector<char>& output)
+{
+	// Greedy parse, the table remembers the last position of every hashed 4 byte sequence
+	std::array<std::size_t, std::size_t(1) << HashBits> table;
+	table.fill(NoPosition);
+
+	std::size_t anchor = 0;
+	std::size_t position = 0;
+	while (position + MinMatch <= size)
+	{
+		sf::Uint32 sequence = read32(data + position);
+		std::size_t& entry = table[(sequence * 2654435761u) >> (32 - HashBits)];
+		std::size_t candidate = entry;
+		entry = position;
+
+		if (candidate == NoPosition || position - candidate > MaxOffset || read32(data + candidate) != sequence)
+		{
+			position++;
+			continue;
+		}
+
+		std::size_t length = MinMatch;
+		while (position + length < size && data[candidate + length] == data[position + length])
+		{
+			length++;
+		}
+
+		writeSequence(output, data + anchor, position - anchor, position - candidate, length);
+		position += length;
+		anchor = position;
+	}
+
+	// The last sequence only holds literals, the decoder recognizes it by the end of the block
+	writeSequence(output, data + anchor, size - anchor, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ChunkCodec::decompress(const char* data, std::size_t size, std::vector<char>& output)
+{
+	const sf::Uint8* position = reinterpret_cast<const sf::Uint8*>(data);
+	const sf::Uint8* end = position + size;
+	std::size_t written = 0;
+
+	while (position < end)
+	{
+		sf::Uint8 token = *position++;
+		std::size_t literalCount = token >> 4;
+		if (literalCount == 15 && !readLength(position, end, literalCount))
+		{
+			return false;
+		}
+
+		if (literalCount > static_cast<std::size_t>(end - position) || literalCount > output.size() - written)
+		{
+			return false;
+		}
+
+		std::memcpy(output.data() + written, position, literalCount);
+		position += literalCount;
+		written += literalCount;
+		if (position == end)
+		{
+			break;
+		}
+
+		if (end - position < 2)
+		{
+			return false;
+		}
+
+		std::size_t offset = static_cast<std::size_t>(position[0] | position[1] << 8);
+		std::size_t length = (token & 0x0F) + MinMatch;
+		position += 2;
+		if ((token & 0x0F) == 15 && !readLength(position, end, length))
+		{
+			return false;
+		}
+
+		if (offset == 0 || offset > written || length > output.size() - written)
+		{
+			return false;
+		}
+
+		// Copied byte by byte, a repetition may overlap the bytes it produces
+		for (std::size_t i = 0; i < length; i++, written++)
+		{
+			output[written] = output[written - offset];
+		}
+	}
+
+	return written == output.size();
+}
+
+} //namespace le
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_CHUNK_CODEC_HPP
+#define LEVEL_EDITOR_CHUNK_CODEC_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "TileChunk.hpp"
+#include <vector>
+#include <SFML/Config.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Turns the tiles of a chunk into a compact payload and back
+///
+/// Tile ids and flags are first run-length encoded, which removes
+/// the long runs of a single tile, then an LZ pass removes the
+/// patterns repeating across rows. Every chunk is encoded on its
+/// own so it can be decoded without its neighbours. The functions
+/// only touch their arguments and may run on any thread.
+///
+////////////////////////////////////////////////////////////
+class ChunkCodec
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Ways the tiles can be laid out in a payload
+	///
+	////////////////////////////////////////////////////////////
+	enum Encoding : sf::Uint16
+	{
+		Raw        = 0, //!< Tile ids followed by the tile flags
+		Compressed = 1  //!< Run-length encoded tiles compressed by the LZ pass
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Encode a chunk
+	///
+	/// The chunk is stored raw when compressing does not make it
+	/// smaller.
+	///
+	/// \param chunk   Chunk to encode
+	/// \param payload Buffer receiving the encoded tiles
+	///
+	/// \return Encoding of the payload
+	///
+	////////////////////////////////////////////////////////////
+	static Encoding encode(const TileChunk& chunk, std::vector<char>& payload);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Decode a payload into a chunk
+	///
+	/// \param payload  Encoded tiles
+	/// \param size     Size of the payload in bytes
+	/// \param encoding Encoding of the payload
+	/// \param chunk    Chunk receiving the tiles, left untouched on failure
+	///
+	/// \return False if the encoding is unknown or the payload malformed
+	///
+	////////////////////////////////////////////////////////////
+	static bool decode(const char* payload, std::size_t size, sf::Uint16 encoding, TileChunk& chunk);
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Compress a block with the LZ pass
+	///
+	/// \param data   Data to compress
+	/// \param size   Size of the data in bytes
+	/// \param output Buffer the compressed block is appended to
+	///
+	////////////////////////////////////////////////////////////
+	static void compress(const char* data, std::size_t size, std::vector<char>& output);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Decompress a block of the LZ pass
+	///
+	/// \param data   Compressed block
+	/// \param size   Size of the compressed block in bytes
+	/// \param output Buffer sized to the exact size of the decompressed data
+	///
+	/// \return False if the block is malformed or does not fill the output
+	///
+	////////////////////////////////////////////////////////////
+	static bool decompress(const char* data, std::size_t size, std::vector<char>& output);
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_CHUNK_CODEC_HPP
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_CHUNK_SOURCE_HPP
+#define LEVEL_EDITOR_CHUNK_SOURCE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace le
+{
+class TileChunk;
+
+////////////////////////////////////////////////////////////
+/// \brief Interface of the storages tile layers load their chunks from
+///
+/// A layer attached to a source only knows which chunks exist,
+/// a chunk is loaded the first time it is accessed.
+///
+////////////////////////////////////////////////////////////
+class ChunkSource
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~ChunkSource() {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Load the tiles of a chunk
+	///
+	/// Chunks are loaded in parallel, the function may be called
+	/// from several threads at once.
+	///
+	/// \param layer Index of the layer within the source
+	/// \param key   Coordinates of the chunk
+	/// \param chunk Chunk to fill
+	///
+	/// \return True if the chunk was loaded
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool loadChunk(std::size_t layer, const sf::Vector2i& key, TileChunk& chunk) const = 0;
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_CHUNK_SOURCE_HPP
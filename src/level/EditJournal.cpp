@@ -0,0 +1,427 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "EditJournal.hpp"
+#include "../utility/Crc32.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Standard layout class at the start of every journal
+///
+////////////////////////////////////////////////////////////
+struct JournalHeader
+{
+	char       m_magic[4];   //!< Identifies journals
+	sf::Uint16 m_version;    //!< Version of the format the journal was written with
+	sf::Uint16 m_reserved;   //!< Zero
+	sf::Uint64 m_generation; //!< Save of the level file the edits apply to
+};
+
+
+////////////////////////////////////////////////////////////
+/// \brief Standard layout class preceding every batch of edits
+///
+////////////////////////////////////////////////////////////
+struct BatchHeader
+{
+	sf::Uint32 m_count; //!< Amount of edits in the batch
+	sf::Uint32 m_crc;   //!< Checksum of the edits
+};
+
+
+////////////////////////////////////////////////////////////
+static const char       Magic[4]       = { 'L', 'E', 'V', 'J' }; //!< First bytes of every journal
+static const int        MaxExtent      = 255;                    //!< Largest amount of following tiles a record extends over
+static const sf::Uint32 DuplicateLayer = 0xFFFFFFFF;             //!< Layer of the records duplicating the layer of their column
+
+
+////////////////////////////////////////////////////////////
+EditJournal::EditJournal() :
+m_path       (),
+m_file       (nullptr),
+m_level      (nullptr),
+m_output     (),
+m_writer     (),
+m_mutex      (),
+m_wake       (),
+m_written    (),
+m_queue      (),
+m_recorded   (0),
+m_durable    (0),
+m_saved      (0),
+m_writing    (false),
+m_flushing   (false),
+m_stopping   (false),
+m_failed     (false),
+m_commitDelay(sf::milliseconds(20)),
+m_idleDelay  (sf::seconds(10.f)),
+m_idleClock  (),
+m_idleTimer  (0)
+{
+	static_assert(sizeof(Record) == 16 && sizeof(JournalHeader) == 16 && sizeof(BatchHeader) == 8, "Journal records must not be padded");
+}
+
+
+////////////////////////////////////////////////////////////
+EditJournal::~EditJournal()
+{
+	close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool EditJournal::open(const std::filesystem::path& path, LevelFile& file, Level& level)
+{
+	close();
+	this->m_path = path;
+	this->m_file = &file;
+	this->m_level = &level;
+
+	// Recovered edits are saved right away, the journal then starts empty against the new save
+	std::size_t replayed = replay();
+	if (replayed > 0)
+	{
+		printf("Recovered %u edits from \"%s\"\n", static_cast<unsigned int>(replayed), path.string().c_str());
+		if (!file.save(level))
+		{
+			return false;
+		}
+	}
+
+	if (!reset())
+	{
+		return false;
+	}
+
+	this->m_stopping = false;
+	this->m_writer = std::thread(&EditJournal::run, this);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void EditJournal::close()
+{
+	if (!isOpen())
+	{
+		return;
+	}
+
+	TimerWheel::getDefault().cancel(this->m_idleTimer);
+	this->m_idleTimer = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_stopping = true;
+	}
+
+	this->m_wake.notify_one();
+	this->m_writer.join();
+	this->m_output.close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool EditJournal::isOpen() const
+{
+	return this->m_writer.joinable();
+}
+
+
+////////////////////////////////////////////////////////////
+bool EditJournal::compact()
+{
+	if (!isOpen() || !this->m_file->save(*this->m_level))
+	{
+		return false;
+	}
+
+	// The edits stay in the journal if it cannot be emptied, replaying them again is harmless
+	reset();
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void EditJournal::flush()
+{
+	std::unique_lock<std::mutex> lock(this->m_mutex);
+	if (!isOpen())
+	{
+		return;
+	}
+
+	this->m_flushing = true;
+	this->m_wake.notify_one();
+	this->m_written.wait(lock, [this]() { return this->m_durable == this->m_recorded; });
+	this->m_flushing = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void EditJournal::setCommitDelay(sf::Time delay)
+{
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	this->m_commitDelay = delay;
+}
+
+
+////////////////////////////////////////////////////////////
+void EditJournal::setIdleDelay(sf::Time delay)
+{
+	this->m_idleDelay = delay;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint64 EditJournal::getUnsavedCount() const
+{
+	return this->m_recorded - this->m_saved;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t EditJournal::replay()
+{
+	std::ifstream stream(this->m_path, std::ios::binary);
+	if (!stream)
+	{
+		return 0;
+	}
+
+	std::vector<char> content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+	JournalHeader header = {};
+	if (content.size() >= sizeof(JournalHeader))
+	{
+		std::memcpy(&header, content.data(), sizeof(JournalHeader));
+	}
+
+	if (std::memcmp(header.m_magic, Magic, sizeof(Magic)) != 0 || header.m_version > Version)
+	{
+		printf("\"%s\" is not an edit journal, it is discarded\n", this->m_path.string().c_str());
+		return 0;
+	}
+
+	// A journal of another save either holds edits that were saved since or belongs to an older state
+	if (header.m_generation != this->m_file->getGeneration())
+	{
+		return 0;
+	}
+
+	std::size_t replayed = 0;
+	std::size_t position = sizeof(JournalHeader);
+	while (content.size() - position >= sizeof(BatchHeader))
+	{
+		BatchHeader batch;
+		std::memcpy(&batch, content.data() + position, sizeof(BatchHeader));
+		position += sizeof(BatchHeader);
+
+		std::size_t size = static_cast<std::size_t>(batch.m_count) * sizeof(Record);
+		if (size > content.size() - position || Crc32::compute(content.data() + position, size) != batch.m_crc)
+		{
+			break;
+		}
+
+		for (std::size_t i = 0; i < batch.m_count; i++, position += sizeof(Record))
+		{
+			Record record;
+			std::memcpy(&record, content.data() + position, sizeof(Record));
+			if (record.m_layer == DuplicateLayer && static_cast<sf::Uint32>(record.m_x) < this->m_level->getLayerCount())
+			{
+				this->m_level->duplicateLayer(static_cast<std::size_t>(record.m_x));
+				replayed++;
+			}
+			else if (record.m_layer < this->m_level->getLayerCount())
+			{
+				TileLayer::Span span = { record.m_y, record.m_x, record.m_x + record.m_extent + 1 };
+				this->m_level->getLayer(record.m_layer).fillSpan(span, record.m_tile, record.m_flags);
+				replayed++;
+			}
+		}
+	}
+
+	return replayed;
+}
+
+
+////////////////////////////////////////////////////////////
+bool EditJournal::reset()
+{
+	std::unique_lock<std::mutex> lock(this->m_mutex);
+	this->m_written.wait(lock, [this]() { return !this->m_writing; });
+	this->m_queue.clear();
+	this->m_durable = this->m_recorded;
+	this->m_saved = this->m_recorded;
+
+	JournalHeader header = {};
+	std::memcpy(header.m_magic, Magic, sizeof(Magic));
+	header.m_version = Version;
+	header.m_generation = this->m_file->getGeneration();
+
+	bool written = this->m_output.open(this->m_path) && this->m_output.write(&header, sizeof(JournalHeader)) && this->m_output.sync();
+	if (!written)
+	{
+		printf("Failed to write edit journal \"%s\"\n", this->m_path.string().c_str());
+	}
+
+	this->m_failed = !written;
+	return written;
+}
+
+
+////////////////////////////////////////////////////////////
+void EditJournal::record(const Level::TileChange& change)
+{
+	if (!isOpen())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		// Long runs are split, a record extends over at most 256 tiles
+		const TileLayer::TileChange& tile = change.m_change;
+		for (int x = 0; x < tile.m_length; x += MaxExtent + 1)
+		{
+			sf::Uint8 extent = static_cast<sf::Uint8>(std::min(tile.m_length - x - 1, MaxExtent));
+			this->m_queue.push_back(Record{ tile.m_position.x + x, tile.m_position.y, static_cast<sf::Uint32>(change.m_layer), tile.m_tile, tile.m_flags, extent });
+			++this->m_recorded;
+		}
+	}
+
+	onRecorded();
+}
+
+
+////////////////////////////////////////////////////////////
+void EditJournal::recordDuplicate(std::size_t layer)
+{
+	if (!isOpen())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_queue.push_back(Record{ static_cast<sf::Int32>(layer), 0, DuplicateLayer, Tileset::Empty, 0, 0 });
+		++this->m_recorded;
+	}
+
+	onRecorded();
+}
+
+
+////////////////////////////////////////////////////////////
+void EditJournal::onRecorded()
+{
+	this->m_wake.notify_one();
+
+	// A single timer is kept pending, it checks the time of the last edit when it fires
+	this->m_idleClock.restart();
+	if (!TimerWheel::getDefault().isPending(this->m_idleTimer))
+	{
+		this->m_idleTimer = TimerWheel::getDefault().setTimeout(this->m_idleDelay, [this]() { onIdle(); });
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void EditJournal::onIdle()
+{
+	sf::Time idle = this->m_idleClock.getElapsedTime();
+	if (idle < this->m_idleDelay)
+	{
+		this->m_idleTimer = TimerWheel::getDefault().setTimeout(this->m_idleDelay - idle, [this]() { onIdle(); });
+		return;
+	}
+
+	this->m_idleTimer = 0;
+	if (getUnsavedCount() > 0)
+	{
+		compact();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void EditJournal::run()
+{
+	std::vector<Record> batch;
+	std::unique_lock<std::mutex> lock(this->m_mutex);
+	while (true)
+	{
+		this->m_wake.wait(lock, [this]() { return this->m_stopping || !this->m_queue.empty(); });
+		if (this->m_queue.empty())
+		{
+			return;
+		}
+
+		// Edits arriving meanwhile join the batch, so a stroke costs one sync instead of one per tile
+		if (!this->m_stopping && !this->m_flushing)
+		{
+			std::chrono::microseconds delay(this->m_commitDelay.asMicroseconds());
+			this->m_wake.wait_for(lock, delay, [this]() { return this->m_stopping || this->m_flushing; });
+		}
+
+		// Emptied by a reset during the delay
+		if (this->m_queue.empty())
+		{
+			continue;
+		}
+
+		batch.clear();
+		batch.swap(this->m_queue);
+		sf::Uint64 recorded = this->m_recorded;
+		this->m_writing = true;
+		lock.unlock();
+
+		BatchHeader header = { static_cast<sf::Uint32>(batch.size()), Crc32::compute(batch.data(), batch.size() * sizeof(Record)) };
+		bool written = this->m_output.write(&header, sizeof(BatchHeader)) && this->m_output.write(batch.data(), batch.size() * sizeof(Record)) && this->m_output.sync();
+
+		lock.lock();
+		if (!written && !this->m_failed)
+		{
+			printf("Failed to write edit journal \"%s\"\n", this->m_path.string().c_str());
+			this->m_failed = true;
+		}
+
+		this->m_writing = false;
+		this->m_durable = recorded;
+		this->m_written.notify_all();
+	}
+}
+
+} //namespace le
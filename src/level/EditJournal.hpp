@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_EDIT_JOURNAL_HPP
+#define LEVEL_EDITOR_EDIT_JOURNAL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Level.hpp"
+#include "LevelFile.hpp"
+#include "../utility/DurableFile.hpp"
+#include "../utility/TimerWheel.hpp"
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Write-ahead log of the tile edits made since the level was saved
+///
+/// Every recorded tile change is queued in memory, a
+/// background thread appends the queued edits to the journal in
+/// batches and syncs each batch to disk once, so an edit costs no
+/// disk access on the main thread. After a crash, opening the
+/// journal against the same save of the level file replays the
+/// edits. Once no edit was made for a while, the level is saved
+/// into its file and the journal emptied.
+///
+/// The journal must be destroyed before the level and the file.
+///
+////////////////////////////////////////////////////////////
+class EditJournal : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Version of the format written by this editor
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr sf::Uint16 Version = 3;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	EditJournal();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Writes the queued edits before returning.
+	///
+	////////////////////////////////////////////////////////////
+	~EditJournal();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Recover the edits of a journal and start recording
+	///
+	/// A journal written against the current save of the file is
+	/// replayed into the level, which is then saved. Journals of
+	/// other saves are discarded.
+	///
+	/// \param path  Path of the journal
+	/// \param file  Opened file the level is saved to
+	/// \param level Level the edits apply to
+	///
+	/// \return True if the journal records the level's edits
+	///
+	////////////////////////////////////////////////////////////
+	bool open(const std::filesystem::path& path, LevelFile& file, Level& level);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Write the queued edits and stop recording
+	///
+	////////////////////////////////////////////////////////////
+	void close();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether edits are being recorded
+	///
+	////////////////////////////////////////////////////////////
+	bool isOpen() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Queue a tile change for the writer
+	///
+	/// Returns without waiting for the disk, typically called from
+	/// the level's tile changed event.
+	///
+	/// \param change Change to record
+	///
+	////////////////////////////////////////////////////////////
+	void record(const Level::TileChange& change);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Queue the duplication of a layer for the writer
+	///
+	/// Called right after Level::duplicateLayer, so that the edits
+	/// of the new layer replay onto a copy of the source layer.
+	///
+	/// \param layer Index of the duplicated layer
+	///
+	////////////////////////////////////////////////////////////
+	void recordDuplicate(std::size_t layer);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Save the level into its file and empty the journal
+	///
+	/// \return True if the level was saved
+	///
+	////////////////////////////////////////////////////////////
+	bool compact();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Wait until every recorded edit is on disk
+	///
+	////////////////////////////////////////////////////////////
+	void flush();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set how long the writer gathers edits before syncing them
+	///
+	/// \param delay Longest time an edit waits for the disk
+	///
+	////////////////////////////////////////////////////////////
+	void setCommitDelay(sf::Time delay);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set how long no edit must be made before the journal is compacted
+	///
+	/// \param delay Idle time
+	///
+	////////////////////////////////////////////////////////////
+	void setIdleDelay(sf::Time delay);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of edits recorded since the level was saved
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint64 getUnsavedCount() const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class describing an edit as stored in the journal
+	///
+	////////////////////////////////////////////////////////////
+	struct Record
+	{
+		sf::Int32  m_x;        //!< Column of the first tile, or index of the duplicated layer
+		sf::Int32  m_y;        //!< Row of the tile
+		sf::Uint32 m_layer;    //!< Index of the layer, 0xFFFFFFFF if the layer of m_x was duplicated, since version 3
+		TileId     m_tile;     //!< Tile id, Tileset::Empty if the tile was erased
+		sf::Uint8  m_flags;    //!< Tile flags
+		sf::Uint8  m_extent;   //!< Amount of following tiles of the row edited the same way, always zero in version 1
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Wake the writer and wait for idleness once records are queued
+	///
+	////////////////////////////////////////////////////////////
+	void onRecorded();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Apply the edits of a journal file to the level
+	///
+	/// Reading stops at the first incomplete or corrupted batch,
+	/// which was being written when the editor stopped.
+	///
+	/// \return Amount of replayed edits
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t replay();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Empty the journal, the level being saved as of now
+	///
+	/// \return True if the emptied journal is on disk
+	///
+	////////////////////////////////////////////////////////////
+	bool reset();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Compact the journal if no edit was made during the idle delay
+	///
+	////////////////////////////////////////////////////////////
+	void onIdle();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Loop of the writer thread
+	///
+	////////////////////////////////////////////////////////////
+	void run();
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::filesystem::path   m_path;        //!< Path of the journal
+	LevelFile*              m_file;        //!< File the level is saved to
+	Level*                  m_level;       //!< Level the edits apply to
+	DurableFile             m_output;      //!< Journal file, written by the writer thread
+	std::thread             m_writer;      //!< Thread appending the queued edits
+	std::mutex              m_mutex;       //!< Protects the queue and the counters
+	std::condition_variable m_wake;        //!< Signals queued edits, flushes and stopping to the writer
+	std::condition_variable m_written;     //!< Signals a batch reaching the disk
+	std::vector<Record>     m_queue;       //!< Edits not handed to the writer yet
+	sf::Uint64              m_recorded;    //!< Amount of edits recorded since the journal was opened
+	sf::Uint64              m_durable;     //!< Amount of recorded edits that are on disk or saved
+	sf::Uint64              m_saved;       //!< Amount of recorded edits when the level was last saved
+	bool                    m_writing;     //!< The writer is writing a batch
+	bool                    m_flushing;    //!< A caller waits for the queued edits
+	bool                    m_stopping;    //!< The writer has to exit once the queue is empty
+	bool                    m_failed;      //!< Writing failed, reported once
+	sf::Time                m_commitDelay; //!< Longest time an edit waits for the disk
+	sf::Time                m_idleDelay;   //!< Time without edits before the journal is compacted
+	sf::Clock               m_idleClock;   //!< Time since the last edit
+	TimerWheel::Id          m_idleTimer;   //!< Timer checking for idleness, 0 if none is pending
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_EDIT_JOURNAL_HPP
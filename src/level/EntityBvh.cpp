@@ -0,0 +1,479 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "EntityBvh.hpp"
+#include "EntityStore.hpp"
+#include "../utility/JobSystem.hpp"
+#include <algorithm>
+#include <limits>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const std::size_t LeafSize = 8;                                       //!< Amount of entities per leaf
+static const std::size_t Branching = 4;                                      //!< Amount of children per node
+static const std::size_t BlockSize = 4096;                                   //!< Amount of entities or nodes handled by a job
+static const std::size_t MinPending = 256;                                   //!< Amount of added entities always tested one by one
+static const std::size_t MaxBands = 256;                                     //!< Amount of horizontal bands the edges of a lasso are sorted into
+static const sf::Uint32 NoPosition = std::numeric_limits<sf::Uint32>::max(); //!< Position of an entity missing from the hierarchy
+static const float Infinity = std::numeric_limits<float>::infinity();        //!< Bound of an empty box
+
+
+////////////////////////////////////////////////////////////
+static sf::Uint32 spreadBits(sf::Uint32 value)
+{
+	// Moves the 16 lower bits to the even positions
+	value &= 0xFFFF;
+	value = (value | (value << 8)) & 0x00FF00FF;
+	value = (value | (value << 4)) & 0x0F0F0F0F;
+	value = (value | (value << 2)) & 0x33333333;
+	value = (value | (value << 1)) & 0x55555555;
+	return value;
+}
+
+
+////////////////////////////////////////////////////////////
+static sf::Vector2f getCenter(const sf::FloatRect& bounds)
+{
+	return sf::Vector2f(bounds.left + bounds.width / 2.f, bounds.top + bounds.height / 2.f);
+}
+
+
+////////////////////////////////////////////////////////////
+static bool isCrossing(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& min, const sf::Vector2f& max)
+{
+	if (std::max(a.x, b.x) < min.x || std::min(a.x, b.x) > max.x || std::max(a.y, b.y) < min.y || std::min(a.y, b.y) > max.y)
+	{
+		return false;
+	}
+
+	// The segment's line crosses the box unless every corner lies on the same side of it
+	const sf::Vector2f corners[4] = { min, sf::Vector2f(max.x, min.y), max, sf::Vector2f(min.x, max.y) };
+	bool positive = false;
+	bool negative = false;
+	for (const sf::Vector2f& corner : corners)
+	{
+		float side = (b.x - a.x) * (corner.y - a.y) - (b.y - a.y) * (corner.x - a.x);
+		positive |= side >= 0.f;
+		negative |= side <= 0.f;
+	}
+
+	return positive && negative;
+}
+
+
+////////////////////////////////////////////////////////////
+EntityBvh::EntityBvh() :
+m_items      (),
+m_bounds     (),
+m_live       (),
+m_positions  (),
+m_levels     (),
+m_pending    (),
+m_dirtyLeaves(),
+m_dirty      ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityBvh::build(const EntityStore& store)
+{
+	this->m_items.clear();
+	this->m_bounds.clear();
+	this->m_live.resize(0);
+	this->m_levels.clear();
+	this->m_pending.clear();
+	this->m_dirtyLeaves.clear();
+	this->m_positions.assign(store.getCapacity(), NoPosition);
+
+	Box extent = { sf::Vector2f(Infinity, Infinity), sf::Vector2f(-Infinity, -Infinity) };
+	for (EntityId id = 0; id < store.getCapacity(); id++)
+	{
+		if (const Entity* entity = store.get(id))
+		{
+			sf::Vector2f center = getCenter(entity->m_bounds);
+			extent.m_min = sf::Vector2f(std::min(extent.m_min.x, center.x), std::min(extent.m_min.y, center.y));
+			extent.m_max = sf::Vector2f(std::max(extent.m_max.x, center.x), std::max(extent.m_max.y, center.y));
+			this->m_items.push_back(id);
+		}
+	}
+
+	std::size_t count = this->m_items.size();
+	this->m_dirty.resize((count + LeafSize - 1) / LeafSize);
+	this->m_dirty.clear();
+	if (count == 0)
+	{
+		return;
+	}
+
+	// Keys hold the Morton code of the center above the identifier, so sorting them orders the entities along the curve
+	JobSystem& jobs = JobSystem::getDefault();
+	std::vector<sf::Uint64> keys(count);
+	sf::Vector2f scale(65535.f / std::max(extent.m_max.x - extent.m_min.x, 1.f), 65535.f / std::max(extent.m_max.y - extent.m_min.y, 1.f));
+	jobs.parallelFor((count + BlockSize - 1) / BlockSize, [&](std::size_t block)
+	{
+		for (std::size_t i = block * BlockSize; i < std::min(count, (block + 1) * BlockSize); i++)
+		{
+			sf::Vector2f center = getCenter(store.get(this->m_items[i])->m_bounds);
+			sf::Uint32 x = static_cast<sf::Uint32>((center.x - extent.m_min.x) * scale.x);
+			sf::Uint32 y = static_cast<sf::Uint32>((center.y - extent.m_min.y) * scale.y);
+			keys[i] = static_cast<sf::Uint64>(spreadBits(x) | (spreadBits(y) << 1)) << 32 | this->m_items[i];
+		}
+	});
+
+	// Every thread sorts a run, runs are then merged pairwise
+	std::size_t runSize = (count + jobs.getWorkerCount()) / (jobs.getWorkerCount() + 1);
+	jobs.parallelFor((count + runSize - 1) / runSize, [&](std::size_t run)
+	{
+		std::sort(keys.begin() + run * runSize, keys.begin() + std::min(count, (run + 1) * runSize));
+	});
+
+	for (std::size_t width = runSize; width < count; width *= 2)
+	{
+		jobs.parallelFor((count + width * 2 - 1) / (width * 2), [&](std::size_t pair)
+		{
+			std::size_t middle = std::min(count, pair * width * 2 + width);
+			std::inplace_merge(keys.begin() + pair * width * 2, keys.begin() + middle, keys.begin() + std::min(count, (pair + 1) * width * 2));
+		});
+	}
+
+	for (std::size_t i = 0; i < count; i++)
+	{
+		this->m_items[i] = static_cast<EntityId>(keys[i]);
+		this->m_positions[this->m_items[i]] = static_cast<sf::Uint32>(i);
+	}
+
+	this->m_bounds.resize(count);
+	this->m_live.resize(count);
+
+	// Leaves are fitted to their entities, then every level above to the level below. Blocks of leaves span whole
+	// words of m_live, so that jobs never write to the same word
+	this->m_levels.emplace_back((count + LeafSize - 1) / LeafSize);
+	jobs.parallelFor((this->m_levels[0].size() + BlockSize - 1) / BlockSize, [&](std::size_t block)
+	{
+		for (std::size_t leaf = block * BlockSize; leaf < std::min(this->m_levels[0].size(), (block + 1) * BlockSize); leaf++)
+		{
+			fitLeaf(store, leaf);
+		}
+	});
+
+	while (this->m_levels.back().size() > 1)
+	{
+		std::size_t level = this->m_levels.size();
+		std::size_t nodeCount = (this->m_levels.back().size() + Branching - 1) / Branching;
+		this->m_levels.emplace_back(nodeCount);
+		jobs.parallelFor((nodeCount + BlockSize - 1) / BlockSize, [&](std::size_t block)
+		{
+			for (std::size_t node = block * BlockSize; node < std::min(nodeCount, (block + 1) * BlockSize); node++)
+			{
+				fitNode(level, node);
+			}
+		});
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityBvh::invalidate(EntityId id)
+{
+	if (id >= this->m_positions.size() || this->m_positions[id] == NoPosition)
+	{
+		this->m_pending.push_back(id);
+		return;
+	}
+
+	std::size_t leaf = this->m_positions[id] / LeafSize;
+	if (!this->m_dirty.test(leaf))
+	{
+		this->m_dirty.set(leaf);
+		this->m_dirtyLeaves.push_back(leaf);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityBvh::update(const EntityStore& store)
+{
+	std::sort(this->m_pending.begin(), this->m_pending.end());
+	this->m_pending.erase(std::unique(this->m_pending.begin(), this->m_pending.end()), this->m_pending.end());
+
+	// Refitting keeps the hierarchy correct, but boxes grow loose as many entities move away from their neighbours
+	std::size_t leafCount = this->m_levels.empty() ? 0 : this->m_levels[0].size();
+	if (this->m_pending.size() > MinPending + this->m_items.size() / 64 || this->m_dirtyLeaves.size() > MinPending / LeafSize + leafCount / 4)
+	{
+		build(store);
+		return;
+	}
+
+	std::vector<std::size_t> nodes;
+	nodes.swap(this->m_dirtyLeaves);
+	for (std::size_t leaf : nodes)
+	{
+		fitLeaf(store, leaf);
+		this->m_dirty.set(leaf, false);
+	}
+
+	for (std::size_t level = 1; level < this->m_levels.size() && !nodes.empty(); level++)
+	{
+		for (std::size_t& node : nodes)
+		{
+			node /= Branching;
+		}
+
+		nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+		for (std::size_t node : nodes)
+		{
+			fitNode(level, node);
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityBvh::selectRect(const EntityStore& store, const sf::FloatRect& area, BitSet& selection) const
+{
+	sf::Vector2f min(area.left, area.top);
+	sf::Vector2f max(area.left + area.width, area.top + area.height);
+	auto classify = [&](const Box& box)
+	{
+		if (box.m_min.x > max.x || box.m_max.x < min.x || box.m_min.y > max.y || box.m_max.y < min.y)
+		{
+			return 0;
+		}
+
+		return box.m_min.x >= min.x && box.m_max.x <= max.x && box.m_min.y >= min.y && box.m_max.y <= max.y ? 1 : 2;
+	};
+
+	auto accept = [&](const sf::FloatRect& bounds)
+	{
+		return bounds.left <= max.x && min.x <= bounds.left + bounds.width && bounds.top <= max.y && min.y <= bounds.top + bounds.height;
+	};
+
+	select(store, classify, accept, selection);
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityBvh::selectLasso(const EntityStore& store, const std::vector<sf::Vector2f>& polygon, BitSet& selection) const
+{
+	if (polygon.size() < 3)
+	{
+		return;
+	}
+
+	Box extent = { polygon[0], polygon[0] };
+	for (const sf::Vector2f& point : polygon)
+	{
+		extent.m_min = sf::Vector2f(std::min(extent.m_min.x, point.x), std::min(extent.m_min.y, point.y));
+		extent.m_max = sf::Vector2f(std::max(extent.m_max.x, point.x), std::max(extent.m_max.y, point.y));
+	}
+
+	// Edges are sorted into horizontal bands, a point or a box only looks at the edges of the bands it overlaps
+	std::vector<std::vector<std::size_t>> bands(std::min<std::size_t>(polygon.size(), MaxBands));
+	float bandHeight = std::max((extent.m_max.y - extent.m_min.y) / bands.size(), std::numeric_limits<float>::min());
+	auto getBand = [&](float y)
+	{
+		return static_cast<std::size_t>(std::clamp((y - extent.m_min.y) / bandHeight, 0.f, static_cast<float>(bands.size() - 1)));
+	};
+
+	for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+	{
+		for (std::size_t band = getBand(std::min(polygon[i].y, polygon[j].y)); band <= getBand(std::max(polygon[i].y, polygon[j].y)); band++)
+		{
+			bands[band].push_back(i);
+		}
+	}
+
+	// Even-odd rule, counting the edges crossed by a ray going right
+	auto isInside = [&](const sf::Vector2f& point)
+	{
+		bool inside = false;
+		if (point.y < extent.m_min.y || point.y > extent.m_max.y)
+		{
+			return inside;
+		}
+
+		for (std::size_t i : bands[getBand(point.y)])
+		{
+			const sf::Vector2f& a = polygon[i];
+			const sf::Vector2f& b = polygon[i == 0 ? polygon.size() - 1 : i - 1];
+			if ((a.y > point.y) != (b.y > point.y) && point.x < a.x + (point.y - a.y) * (b.x - a.x) / (b.y - a.y))
+			{
+				inside = !inside;
+			}
+		}
+
+		return inside;
+	};
+
+	// A box crossed by no edge lies entirely inside or outside the polygon, testing its center tells which
+	auto classify = [&](const Box& box)
+	{
+		if (box.m_min.x > extent.m_max.x || box.m_max.x < extent.m_min.x || box.m_min.y > extent.m_max.y || box.m_max.y < extent.m_min.y)
+		{
+			return 0;
+		}
+
+		for (std::size_t band = getBand(box.m_min.y); band <= getBand(box.m_max.y); band++)
+		{
+			for (std::size_t i : bands[band])
+			{
+				if (isCrossing(polygon[i == 0 ? polygon.size() - 1 : i - 1], polygon[i], box.m_min, box.m_max))
+				{
+					return 2;
+				}
+			}
+		}
+
+		return isInside((box.m_min + box.m_max) / 2.f) ? 1 : 0;
+	};
+
+	auto accept = [&](const sf::FloatRect& bounds)
+	{
+		return isInside(getCenter(bounds));
+	};
+
+	select(store, classify, accept, selection);
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityBvh::fitLeaf(const EntityStore& store, std::size_t leaf)
+{
+	Box box = { sf::Vector2f(Infinity, Infinity), sf::Vector2f(-Infinity, -Infinity) };
+	for (std::size_t i = leaf * LeafSize; i < std::min(this->m_items.size(), (leaf + 1) * LeafSize); i++)
+	{
+		// Removed entities stay in their leaf until the next build but no longer count
+		const Entity* entity = store.get(this->m_items[i]);
+		this->m_live.set(i, entity != nullptr);
+		if (entity)
+		{
+			const sf::FloatRect& bounds = entity->m_bounds;
+			this->m_bounds[i] = bounds;
+			box.m_min = sf::Vector2f(std::min(box.m_min.x, bounds.left), std::min(box.m_min.y, bounds.top));
+			box.m_max = sf::Vector2f(std::max(box.m_max.x, bounds.left + bounds.width), std::max(box.m_max.y, bounds.top + bounds.height));
+		}
+	}
+
+	this->m_levels[0][leaf] = box;
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityBvh::fitNode(std::size_t level, std::size_t node)
+{
+	const std::vector<Box>& children = this->m_levels[level - 1];
+	Box box = { sf::Vector2f(Infinity, Infinity), sf::Vector2f(-Infinity, -Infinity) };
+	for (std::size_t i = node * Branching; i < std::min(children.size(), (node + 1) * Branching); i++)
+	{
+		box.m_min = sf::Vector2f(std::min(box.m_min.x, children[i].m_min.x), std::min(box.m_min.y, children[i].m_min.y));
+		box.m_max = sf::Vector2f(std::max(box.m_max.x, children[i].m_max.x), std::max(box.m_max.y, children[i].m_max.y));
+	}
+
+	this->m_levels[level][node] = box;
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityBvh::selectNode(std::size_t level, std::size_t node, BitSet& selection) const
+{
+	std::size_t span = LeafSize;
+	for (std::size_t i = 0; i < level; i++)
+	{
+		span *= Branching;
+	}
+
+	for (std::size_t i = node * span; i < std::min(this->m_items.size(), (node + 1) * span); i++)
+	{
+		if (this->m_live.test(i))
+		{
+			selection.set(this->m_items[i]);
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename C, typename A>
+void EntityBvh::select(const EntityStore& store, C classify, A accept, BitSet& selection) const
+{
+	if (selection.getSize() < store.getCapacity())
+	{
+		selection.resize(store.getCapacity());
+	}
+
+	for (EntityId id : this->m_pending)
+	{
+		const Entity* entity = store.get(id);
+		if (entity && accept(entity->m_bounds))
+		{
+			selection.set(id);
+		}
+	}
+
+	if (this->m_levels.empty())
+	{
+		return;
+	}
+
+	std::vector<std::pair<std::size_t, std::size_t>> stack = { { this->m_levels.size() - 1, 0 } };
+	while (!stack.empty())
+	{
+		auto [level, node] = stack.back();
+		stack.pop_back();
+
+		const Box& box = this->m_levels[level][node];
+		int inside = box.m_min.x <= box.m_max.x ? classify(box) : 0;
+		if (inside == 1)
+		{
+			selectNode(level, node, selection);
+		}
+		else if (inside == 2 && level == 0)
+		{
+			for (std::size_t i = node * LeafSize; i < std::min(this->m_items.size(), (node + 1) * LeafSize); i++)
+			{
+				if (this->m_live.test(i) && accept(this->m_bounds[i]))
+				{
+					selection.set(this->m_items[i]);
+				}
+			}
+		}
+		else if (inside == 2)
+		{
+			for (std::size_t child = node * Branching; child < std::min(this->m_levels[level - 1].size(), (node + 1) * Branching); child++)
+			{
+				stack.emplace_back(level - 1, child);
+			}
+		}
+	}
+}
+
+} //namespace le
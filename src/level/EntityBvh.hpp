@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_ENTITY_BVH_HPP
+#define LEVEL_EDITOR_ENTITY_BVH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../utility/BitSet.hpp"
+#include <vector>
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+class EntityStore;
+using EntityId = sf::Uint32;
+
+////////////////////////////////////////////////////////////
+/// \brief Bounding volume hierarchy over the entities of a store
+///
+/// Entities are sorted along a Morton curve and grouped into
+/// leaves of consecutive entities, each level above merges four
+/// nodes of the level below. A node therefore covers a contiguous
+/// range of entities, which region selection takes as a whole
+/// once the node is inside the region.
+///
+/// Moved entities are refit along the path of their leaf, added
+/// entities are tested one by one until the hierarchy is rebuilt.
+/// The hierarchy is rebuilt in parallel once too many entities
+/// changed for refitting to keep the nodes tight.
+///
+////////////////////////////////////////////////////////////
+class EntityBvh : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// This constructor creates an empty hierarchy
+	///
+	////////////////////////////////////////////////////////////
+	EntityBvh();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Rebuild the hierarchy from every entity of a store
+	///
+	/// \param store Store holding the entities
+	///
+	////////////////////////////////////////////////////////////
+	void build(const EntityStore& store);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Record that an entity was added, moved or removed
+	///
+	/// \param id Identifier of the entity
+	///
+	////////////////////////////////////////////////////////////
+	void invalidate(EntityId id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Apply the recorded changes, refitting or rebuilding the hierarchy
+	///
+	/// \param store Store holding the entities
+	///
+	////////////////////////////////////////////////////////////
+	void update(const EntityStore& store);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Select the entities intersecting a rectangle
+	///
+	/// \param store     Store holding the entities, the hierarchy must be up to date
+	/// \param area      Rectangle in level coordinates
+	/// \param selection Set receiving a bit per selected entity identifier
+	///
+	////////////////////////////////////////////////////////////
+	void selectRect(const EntityStore& store, const sf::FloatRect& area, BitSet& selection) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Select the entities whose center lies inside a polygon
+	///
+	/// \param store     Store holding the entities, the hierarchy must be up to date
+	/// \param polygon   Vertices of the polygon in level coordinates, closed implicitly
+	/// \param selection Set receiving a bit per selected entity identifier
+	///
+	////////////////////////////////////////////////////////////
+	void selectLasso(const EntityStore& store, const std::vector<sf::Vector2f>& polygon, BitSet& selection) const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class describing an axis aligned box
+	///
+	////////////////////////////////////////////////////////////
+	struct Box
+	{
+		sf::Vector2f m_min; //!< Smallest coordinates, above m_max if the box is empty
+		sf::Vector2f m_max; //!< Largest coordinates
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Recompute the box of a leaf from its entities
+	///
+	/// \param store Store holding the entities
+	/// \param leaf  Index of the leaf
+	///
+	////////////////////////////////////////////////////////////
+	void fitLeaf(const EntityStore& store, std::size_t leaf);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Recompute the box of a node from its children
+	///
+	/// \param level Level of the node, above the leaves
+	/// \param node  Index of the node in its level
+	///
+	////////////////////////////////////////////////////////////
+	void fitNode(std::size_t level, std::size_t node);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Select every entity of the range covered by a node
+	///
+	/// \param level     Level of the node
+	/// \param node      Index of the node in its level
+	/// \param selection Set receiving the entities
+	///
+	////////////////////////////////////////////////////////////
+	void selectNode(std::size_t level, std::size_t node, BitSet& selection) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Walk the hierarchy, classifying nodes against a region
+	///
+	/// \param store     Store holding the entities
+	/// \param classify  Function returning 0 for a box outside the region, 1 for a box inside it, 2 otherwise
+	/// \param accept    Function telling whether an entity is selected from its bounds
+	/// \param selection Set receiving the selected entities
+	///
+	////////////////////////////////////////////////////////////
+	template <typename C, typename A>
+	void select(const EntityStore& store, C classify, A accept, BitSet& selection) const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::vector<EntityId>         m_items;       //!< Indexed entities in Morton order, leaves cover consecutive ranges
+	std::vector<sf::FloatRect>    m_bounds;      //!< Bounds of the indexed entities, copied so that selections read them in order
+	BitSet                        m_live;        //!< Bit per indexed entity telling whether it still exists
+	std::vector<sf::Uint32>       m_positions;   //!< Position of each entity identifier in m_items
+	std::vector<std::vector<Box>> m_levels;      //!< Boxes of each level, from the leaves up to the root
+	std::vector<EntityId>         m_pending;     //!< Entities added since the last build, tested one by one
+	std::vector<std::size_t>      m_dirtyLeaves; //!< Leaves holding moved entities
+	BitSet                        m_dirty;       //!< Bit per leaf telling whether it is in m_dirtyLeaves
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_ENTITY_BVH_HPP
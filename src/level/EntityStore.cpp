@@ -0,0 +1,331 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "EntityStore.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+EntityStore::EntityStore(float cellSize) :
+m_cellSize(cellSize),
+m_slots   (),
+m_free    (),
+m_cells   (),
+m_large   (),
+m_bvh     ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+EntityId EntityStore::add(const Entity& entity)
+{
+	EntityId id = static_cast<EntityId>(this->m_slots.size());
+	if (!this->m_free.empty())
+	{
+		id = this->m_free.back();
+		this->m_free.pop_back();
+	}
+	else
+	{
+		this->m_slots.emplace_back();
+	}
+
+	Slot& slot = this->m_slots[id];
+	slot.m_entity = entity;
+	slot.m_used = true;
+	link(id);
+	this->m_bvh.invalidate(id);
+	return id;
+}
+
+
+////////////////////////////////////////////////////////////
+bool EntityStore::remove(EntityId id)
+{
+	if (!get(id))
+	{
+		return false;
+	}
+
+	unlink(id);
+	this->m_slots[id].m_used = false;
+	this->m_free.push_back(id);
+	this->m_bvh.invalidate(id);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool EntityStore::move(EntityId id, const sf::FloatRect& bounds)
+{
+	if (!get(id))
+	{
+		return false;
+	}
+
+	// Moving within a cell, the common case while dragging, leaves the grid untouched
+	Slot& slot = this->m_slots[id];
+	bool large = isLarge(bounds);
+	if (large != slot.m_large || (!large && getCell(bounds) != slot.m_cell))
+	{
+		unlink(id);
+		slot.m_entity.m_bounds = bounds;
+		link(id);
+	}
+	else
+	{
+		slot.m_entity.m_bounds = bounds;
+	}
+
+	this->m_bvh.invalidate(id);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Entity* EntityStore::get(EntityId id) const
+{
+	return id < this->m_slots.size() && this->m_slots[id].m_used ? &this->m_slots[id].m_entity : nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t EntityStore::getCount() const
+{
+	return this->m_slots.size() - this->m_free.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t EntityStore::getCapacity() const
+{
+	return this->m_slots.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityStore::clear()
+{
+	this->m_slots.clear();
+	this->m_free.clear();
+	this->m_cells.clear();
+	this->m_large.clear();
+	this->m_bvh.build(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityStore::queryPoint(const sf::Vector2f& point, std::vector<EntityId>& result) const
+{
+	forEachCandidate(sf::FloatRect(point, sf::Vector2f(0.f, 0.f)), [&](EntityId id, const Entity& entity)
+	{
+		const sf::FloatRect& bounds = entity.m_bounds;
+		if (point.x >= bounds.left && point.x < bounds.left + bounds.width && point.y >= bounds.top && point.y < bounds.top + bounds.height)
+		{
+			result.push_back(id);
+		}
+	});
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityStore::queryRect(const sf::FloatRect& area, std::vector<EntityId>& result) const
+{
+	forEachCandidate(area, [&](EntityId id, const Entity& entity)
+	{
+		const sf::FloatRect& bounds = entity.m_bounds;
+		if (bounds.left <= area.left + area.width && area.left <= bounds.left + bounds.width &&
+			bounds.top <= area.top + area.height && area.top <= bounds.top + bounds.height)
+		{
+			result.push_back(id);
+		}
+	});
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityStore::queryRadius(const sf::Vector2f& center, float radius, std::vector<EntityId>& result) const
+{
+	sf::FloatRect area(center.x - radius, center.y - radius, radius * 2.f, radius * 2.f);
+	forEachCandidate(area, [&](EntityId id, const Entity& entity)
+	{
+		// Distance from the center to the closest point of the bounds
+		const sf::FloatRect& bounds = entity.m_bounds;
+		float dx = center.x - std::clamp(center.x, bounds.left, bounds.left + bounds.width);
+		float dy = center.y - std::clamp(center.y, bounds.top, bounds.top + bounds.height);
+		if (dx * dx + dy * dy <= radius * radius)
+		{
+			result.push_back(id);
+		}
+	});
+}
+
+
+////////////////////////////////////////////////////////////
+EntityId EntityStore::pick(const sf::Vector2f& point) const
+{
+	EntityId picked = NoEntity;
+	float pickedArea = 0.f;
+	forEachCandidate(sf::FloatRect(point, sf::Vector2f(0.f, 0.f)), [&](EntityId id, const Entity& entity)
+	{
+		const sf::FloatRect& bounds = entity.m_bounds;
+		float area = bounds.width * bounds.height;
+		if (point.x >= bounds.left && point.x < bounds.left + bounds.width && point.y >= bounds.top && point.y < bounds.top + bounds.height &&
+			(picked == NoEntity || area < pickedArea || (area == pickedArea && id > picked)))
+		{
+			picked = id;
+			pickedArea = area;
+		}
+	});
+
+	return picked;
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityStore::selectRect(const sf::FloatRect& area, BitSet& selection) const
+{
+	this->m_bvh.update(*this);
+	this->m_bvh.selectRect(*this, area, selection);
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityStore::selectLasso(const std::vector<sf::Vector2f>& polygon, BitSet& selection) const
+{
+	this->m_bvh.update(*this);
+	this->m_bvh.selectLasso(*this, polygon, selection);
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityStore::link(EntityId id)
+{
+	Slot& slot = this->m_slots[id];
+	slot.m_large = isLarge(slot.m_entity.m_bounds);
+	if (slot.m_large)
+	{
+		slot.m_index = static_cast<sf::Uint32>(this->m_large.size());
+		this->m_large.push_back(id);
+		return;
+	}
+
+	slot.m_cell = getCell(slot.m_entity.m_bounds);
+	std::vector<EntityId>& cell = this->m_cells[slot.m_cell];
+	slot.m_index = static_cast<sf::Uint32>(cell.size());
+	cell.push_back(id);
+}
+
+
+////////////////////////////////////////////////////////////
+void EntityStore::unlink(EntityId id)
+{
+	// The last entity of the cell takes the place of the removed one
+	const Slot& slot = this->m_slots[id];
+	std::vector<EntityId>& cell = slot.m_large ? this->m_large : *this->m_cells.find(slot.m_cell);
+	EntityId last = cell.back();
+	cell[slot.m_index] = last;
+	this->m_slots[last].m_index = slot.m_index;
+	cell.pop_back();
+
+	if (cell.empty() && !slot.m_large)
+	{
+		this->m_cells.erase(slot.m_cell);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Vector2i EntityStore::getCell(const sf::FloatRect& bounds) const
+{
+	float x = std::floor((bounds.left + bounds.width / 2.f) / this->m_cellSize);
+	float y = std::floor((bounds.top + bounds.height / 2.f) / this->m_cellSize);
+	return sf::Vector2i(static_cast<int>(x), static_cast<int>(y));
+}
+
+
+////////////////////////////////////////////////////////////
+bool EntityStore::isLarge(const sf::FloatRect& bounds) const
+{
+	return bounds.width > this->m_cellSize || bounds.height > this->m_cellSize;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void EntityStore::forEachCandidate(const sf::FloatRect& area, F function) const
+{
+	for (EntityId id : this->m_large)
+	{
+		function(id, this->m_slots[id].m_entity);
+	}
+
+	// An entity smaller than a cell reaches at most half a cell beyond the cell holding its center
+	float margin = this->m_cellSize / 2.f;
+	sf::Vector2i first(static_cast<int>(std::floor((area.left - margin) / this->m_cellSize)), static_cast<int>(std::floor((area.top - margin) / this->m_cellSize)));
+	sf::Vector2i last(static_cast<int>(std::floor((area.left + area.width + margin) / this->m_cellSize)), static_cast<int>(std::floor((area.top + area.height + margin) / this->m_cellSize)));
+
+	// Areas spanning more cells than exist, such as a box selection zoomed out, walk the existing cells instead
+	double cellCount = (static_cast<double>(last.x) - first.x + 1) * (static_cast<double>(last.y) - first.y + 1);
+	if (cellCount > static_cast<double>(this->m_cells.getSize()))
+	{
+		for (const CoordMap<std::vector<EntityId>>::Entry& entry : this->m_cells.getEntries())
+		{
+			if (entry.m_key.x >= first.x && entry.m_key.x <= last.x && entry.m_key.y >= first.y && entry.m_key.y <= last.y)
+			{
+				for (EntityId id : entry.m_value)
+				{
+					function(id, this->m_slots[id].m_entity);
+				}
+			}
+		}
+
+		return;
+	}
+
+	for (int y = first.y; y <= last.y; y++)
+	{
+		for (int x = first.x; x <= last.x; x++)
+		{
+			if (const std::vector<EntityId>* cell = this->m_cells.find(sf::Vector2i(x, y)))
+			{
+				for (EntityId id : *cell)
+				{
+					function(id, this->m_slots[id].m_entity);
+				}
+			}
+		}
+	}
+}
+
+} //namespace le
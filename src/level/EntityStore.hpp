@@ -0,0 +1,281 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_ENTITY_STORE_HPP
+#define LEVEL_EDITOR_ENTITY_STORE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "EntityBvh.hpp"
+#include "../utility/CoordMap.hpp"
+#include <limits>
+#include <vector>
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Identifier of an entity, reused once the entity is removed
+///
+////////////////////////////////////////////////////////////
+using EntityId = sf::Uint32;
+
+////////////////////////////////////////////////////////////
+/// \brief Standard layout class describing an entity of a level
+///
+////////////////////////////////////////////////////////////
+struct Entity
+{
+	sf::FloatRect m_bounds; //!< Area covered in level coordinates
+	sf::Uint32    m_type;   //!< Kind of entity, such as a spawner, a trigger or a prop
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Entities of a level indexed by a loose grid
+///
+/// An entity is stored in the cell holding the center of its
+/// bounds, so moving it within a cell only updates its bounds.
+/// Since entities smaller than a cell extend at most half a cell
+/// beyond it, queries look at the cells overlapping the queried
+/// area grown by half a cell. The few entities larger than a cell
+/// are kept aside and tested one by one.
+///
+/// Selections over large areas go through a bounding volume
+/// hierarchy instead, which is kept up to date lazily.
+///
+////////////////////////////////////////////////////////////
+class EntityStore : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Identifier standing for no entity
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr EntityId NoEntity = std::numeric_limits<EntityId>::max();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param cellSize Size of a grid cell in level units, ideally about the size of the larger entities
+	///
+	////////////////////////////////////////////////////////////
+	explicit EntityStore(float cellSize = 64.f);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add an entity
+	///
+	/// \param entity Entity to add
+	///
+	/// \return Identifier of the entity
+	///
+	////////////////////////////////////////////////////////////
+	EntityId add(const Entity& entity);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove an entity
+	///
+	/// \param id Identifier of the entity
+	///
+	/// \return True if the entity existed
+	///
+	////////////////////////////////////////////////////////////
+	bool remove(EntityId id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move or resize an entity
+	///
+	/// \param id     Identifier of the entity
+	/// \param bounds New area covered in level coordinates
+	///
+	/// \return True if the entity existed
+	///
+	////////////////////////////////////////////////////////////
+	bool move(EntityId id, const sf::FloatRect& bounds);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get an entity
+	///
+	/// \param id Identifier of the entity
+	///
+	/// \return The entity, or nullptr if there is none
+	///
+	////////////////////////////////////////////////////////////
+	const Entity* get(EntityId id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of entities
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of identifiers handed out, every identifier is lower
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getCapacity() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove every entity
+	///
+	////////////////////////////////////////////////////////////
+	void clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the entities containing a point
+	///
+	/// \param point  Point in level coordinates
+	/// \param result Vector the identifiers are appended to
+	///
+	////////////////////////////////////////////////////////////
+	void queryPoint(const sf::Vector2f& point, std::vector<EntityId>& result) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the entities intersecting a rectangle
+	///
+	/// \param area   Rectangle in level coordinates
+	/// \param result Vector the identifiers are appended to
+	///
+	////////////////////////////////////////////////////////////
+	void queryRect(const sf::FloatRect& area, std::vector<EntityId>& result) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the entities intersecting a circle
+	///
+	/// \param center Center of the circle in level coordinates
+	/// \param radius Radius of the circle
+	/// \param result Vector the identifiers are appended to
+	///
+	////////////////////////////////////////////////////////////
+	void queryRadius(const sf::Vector2f& center, float radius, std::vector<EntityId>& result) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the entity a click on a point refers to
+	///
+	/// The smallest entity containing the point wins, so that
+	/// entities lying on large triggers remain reachable.
+	///
+	/// \param point Point in level coordinates
+	///
+	/// \return Identifier of the entity, NoEntity if none contains the point
+	///
+	////////////////////////////////////////////////////////////
+	EntityId pick(const sf::Vector2f& point) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Select the entities intersecting a rectangle
+	///
+	/// \param area      Rectangle in level coordinates
+	/// \param selection Set receiving a bit per selected entity identifier
+	///
+	////////////////////////////////////////////////////////////
+	void selectRect(const sf::FloatRect& area, BitSet& selection) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Select the entities whose center lies inside a polygon
+	///
+	/// \param polygon   Vertices of the polygon in level coordinates, closed implicitly
+	/// \param selection Set receiving a bit per selected entity identifier
+	///
+	////////////////////////////////////////////////////////////
+	void selectLasso(const std::vector<sf::Vector2f>& polygon, BitSet& selection) const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class holding an entity and its place in the grid
+	///
+	////////////////////////////////////////////////////////////
+	struct Slot
+	{
+		Entity       m_entity; //!< Entity
+		sf::Vector2i m_cell;   //!< Cell holding the entity
+		sf::Uint32   m_index;  //!< Position in the cell, or in the large entities if m_large is set
+		bool         m_large;  //!< Entity is larger than a cell
+		bool         m_used;   //!< Slot holds an entity, free slots are reused by add
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Insert an entity into the cell its bounds belong to
+	///
+	/// \param id Identifier of the entity
+	///
+	////////////////////////////////////////////////////////////
+	void link(EntityId id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove an entity from its cell
+	///
+	/// \param id Identifier of the entity
+	///
+	////////////////////////////////////////////////////////////
+	void unlink(EntityId id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the cell holding the center of bounds
+	///
+	/// \param bounds Bounds in level coordinates
+	///
+	////////////////////////////////////////////////////////////
+	sf::Vector2i getCell(const sf::FloatRect& bounds) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether bounds are too large to be stored in a cell
+	///
+	/// \param bounds Bounds in level coordinates
+	///
+	////////////////////////////////////////////////////////////
+	bool isLarge(const sf::FloatRect& bounds) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Call a function for every entity that may intersect an area
+	///
+	/// \param area     Area in level coordinates
+	/// \param function Function receiving the identifier and the entity
+	///
+	////////////////////////////////////////////////////////////
+	template <typename F>
+	void forEachCandidate(const sf::FloatRect& area, F function) const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	float                           m_cellSize; //!< Size of a grid cell in level units
+	std::vector<Slot>               m_slots;    //!< Entities indexed by identifier
+	std::vector<EntityId>           m_free;     //!< Identifiers of the free slots
+	CoordMap<std::vector<EntityId>> m_cells;    //!< Entities of each cell, only cells holding entities exist
+	std::vector<EntityId>           m_large;    //!< Entities larger than a cell
+	mutable EntityBvh               m_bvh;      //!< Hierarchy used by selections, updated by them
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_ENTITY_STORE_HPP
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "FillCommand.hpp"
+#include "../utility/Varint.hpp"
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+FillCommand::FillCommand(Level& level, std::size_t layer, const std::vector<TileLayer::Span>& spans, TileId previousTile, sf::Uint8 previousFlags, TileId tile, sf::Uint8 flags) :
+m_level        (&level),
+m_layer        (layer),
+m_previousTile (previousTile),
+m_previousFlags(previousFlags),
+m_tile         (tile),
+m_flags        (flags),
+m_packed       (),
+m_spanCount    (spans.size()),
+m_tileCount    (0)
+{
+	// Rows follow each other and spans mostly start near the one above, so the deltas take a byte or two
+	TileLayer::Span origin = { 0, 0, 0 };
+	for (const TileLayer::Span& span : spans)
+	{
+		Varint::write(this->m_packed, Varint::toZigzag(static_cast<sf::Int64>(span.m_y) - origin.m_y));
+		Varint::write(this->m_packed, Varint::toZigzag(static_cast<sf::Int64>(span.m_left) - origin.m_left));
+		Varint::write(this->m_packed, static_cast<sf::Uint64>(span.m_right - span.m_left));
+		this->m_tileCount += static_cast<std::size_t>(span.m_right - span.m_left);
+		origin = span;
+	}
+
+	this->m_packed.shrink_to_fit();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FillCommand::getTileCount() const
+{
+	return this->m_tileCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void FillCommand::undo()
+{
+	apply(this->m_previousTile, this->m_previousFlags);
+}
+
+
+////////////////////////////////////////////////////////////
+void FillCommand::redo()
+{
+	apply(this->m_tile, this->m_flags);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FillCommand::getMemoryUsage() const
+{
+	return sizeof(FillCommand) + this->m_packed.capacity();
+}
+
+
+////////////////////////////////////////////////////////////
+void FillCommand::spill(std::vector<char>& data)
+{
+	data.insert(data.end(), this->m_packed.begin(), this->m_packed.end());
+	this->m_packed.clear();
+	this->m_packed.shrink_to_fit();
+}
+
+
+////////////////////////////////////////////////////////////
+bool FillCommand::restore(const char* data, std::size_t size)
+{
+	this->m_packed.assign(data, data + size);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void FillCommand::apply(TileId tile, sf::Uint8 flags)
+{
+	if (this->m_layer >= this->m_level->getLayerCount())
+	{
+		return;
+	}
+
+	TileLayer& layer = this->m_level->getLayer(this->m_layer);
+	const sf::Uint8* data = reinterpret_cast<const sf::Uint8*>(this->m_packed.data());
+	const sf::Uint8* end = data + this->m_packed.size();
+	TileLayer::Span span = { 0, 0, 0 };
+	for (std::size_t i = 0; i < this->m_spanCount; i++)
+	{
+		sf::Uint64 y = 0, left = 0, length = 0;
+		if (!Varint::read(data, end, y) || !Varint::read(data, end, left) || !Varint::read(data, end, length) || length > static_cast<sf::Uint64>(this->m_tileCount))
+		{
+			printf("Failed to unpack filled spans\n");
+			return;
+		}
+
+		span.m_y += static_cast<int>(Varint::fromZigzag(y));
+		span.m_left += static_cast<int>(Varint::fromZigzag(left));
+		span.m_right = span.m_left + static_cast<int>(length);
+		layer.fillSpan(span, tile, flags);
+	}
+}
+
+} //namespace le
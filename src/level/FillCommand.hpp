@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_FILL_COMMAND_HPP
+#define LEVEL_EDITOR_FILL_COMMAND_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Level.hpp"
+#include "../utility/Command.hpp"
+#include <vector>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Command reverting and reapplying a bucket fill
+///
+/// Every tile of a filled region had the same state before the
+/// fill and received the same new one, so only the spans of the
+/// region are kept, each placed relative to the previous one.
+/// Spans are set a chunk at a time, undoing a fill over millions
+/// of tiles costs as little as applying it.
+///
+////////////////////////////////////////////////////////////
+class FillCommand : public Command
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param level         Level the fill is made to
+	/// \param layer         Index of the filled layer
+	/// \param spans         Spans of the region, sorted by row and then by column
+	/// \param previousTile  Tile id of the region before the fill
+	/// \param previousFlags Tile flags of the region before the fill
+	/// \param tile          Tile id the region is filled with
+	/// \param flags         Tile flags the region is filled with
+	///
+	////////////////////////////////////////////////////////////
+	FillCommand(Level& level, std::size_t layer, const std::vector<TileLayer::Span>& spans, TileId previousTile, sf::Uint8 previousFlags, TileId tile, sf::Uint8 flags);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of tiles covered by the fill
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getTileCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Restore the region's previous tile
+	///
+	////////////////////////////////////////////////////////////
+	virtual void undo() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Fill the region again
+	///
+	////////////////////////////////////////////////////////////
+	virtual void redo() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of memory held by the command in bytes
+	///
+	////////////////////////////////////////////////////////////
+	virtual std::size_t getMemoryUsage() const override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move the packed spans out of memory
+	///
+	/// \param data Buffer the spans are appended to
+	///
+	////////////////////////////////////////////////////////////
+	virtual void spill(std::vector<char>& data) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Restore the spans moved out by spill
+	///
+	/// \param data Data returned by spill
+	/// \param size Size of the data in bytes
+	///
+	/// \return Always true, the spans are checked when applied
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool restore(const char* data, std::size_t size) override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set every tile of the region
+	///
+	/// \param tile  Tile id
+	/// \param flags Tile flags
+	///
+	////////////////////////////////////////////////////////////
+	void apply(TileId tile, sf::Uint8 flags);
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	Level*            m_level;         //!< Level the fill is made to
+	std::size_t       m_layer;         //!< Index of the filled layer
+	TileId            m_previousTile;  //!< Tile id of the region before the fill
+	sf::Uint8         m_previousFlags; //!< Tile flags of the region before the fill
+	TileId            m_tile;          //!< Tile id the region is filled with
+	sf::Uint8         m_flags;         //!< Tile flags the region is filled with
+	std::vector<char> m_packed;        //!< Packed spans
+	std::size_t       m_spanCount;     //!< Amount of packed spans
+	std::size_t       m_tileCount;     //!< Amount of tiles covered by the spans
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_FILL_COMMAND_HPP
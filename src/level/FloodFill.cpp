@@ -0,0 +1,452 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "FloodFill.hpp"
+#include "../utility/JobSystem.hpp"
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Components found within a chunk by the parallel pass
+///
+////////////////////////////////////////////////////////////
+struct ChunkLabels
+{
+	const TileChunk*             m_chunk;  //!< Chunk, nullptr where no tile was set
+	sf::IntRect                  m_area;   //!< Tiles of the chunk within the bounds, in chunk coordinates
+	std::vector<sf::Uint16>      m_labels; //!< Component of every tile counted from 1, 0 where the tile does not match, empty if the whole area matches
+	std::vector<sf::Uint32>      m_sizes;  //!< Amount of tiles of every component
+	sf::Uint32                   m_first;  //!< Index of the first component among those of every chunk
+	std::vector<TileLayer::Span> m_spans;  //!< Spans of the region within the chunk, row by row
+};
+
+
+////////////////////////////////////////////////////////////
+static const std::size_t LargeFill = 1 << 16; //!< Amount of tiles past which the region is labeled in parallel
+
+
+////////////////////////////////////////////////////////////
+static bool matches(const TileChunk* chunk, int index, TileId tile, sf::Uint8 flags)
+{
+	if (!chunk)
+	{
+		return tile == Tileset::Empty && flags == TileFlags::None;
+	}
+
+	return chunk->getTiles()[index] == tile && chunk->getFlags()[index] == flags;
+}
+
+
+////////////////////////////////////////////////////////////
+static void labelChunk(ChunkLabels& chunk, TileId tile, sf::Uint8 flags)
+{
+	const sf::IntRect& area = chunk.m_area;
+	int count = 0;
+	for (int y = area.top; y < area.top + area.height; y++)
+	{
+		for (int x = area.left; x < area.left + area.width; x++)
+		{
+			count += matches(chunk.m_chunk, y * TileChunk::Size + x, tile, flags);
+		}
+	}
+
+	// Chunks matching nowhere or everywhere, such as the void around islands, need no labels
+	if (count == area.width * area.height)
+	{
+		chunk.m_sizes.push_back(static_cast<sf::Uint32>(count));
+	}
+
+	if (count == 0 || count == area.width * area.height)
+	{
+		return;
+	}
+
+	chunk.m_labels.assign(TileChunk::Area, 0);
+	std::vector<int> stack;
+	for (int y = area.top; y < area.top + area.height; y++)
+	{
+		for (int x = area.left; x < area.left + area.width; x++)
+		{
+			int index = y * TileChunk::Size + x;
+			if (chunk.m_labels[index] != 0 || !matches(chunk.m_chunk, index, tile, flags))
+			{
+				continue;
+			}
+
+			sf::Uint16 label = static_cast<sf::Uint16>(chunk.m_sizes.size() + 1);
+			sf::Uint32 size = 0;
+			chunk.m_labels[index] = label;
+			stack.push_back(index);
+			while (!stack.empty())
+			{
+				int current = stack.back();
+				stack.pop_back();
+				size++;
+
+				sf::Vector2i position(current % TileChunk::Size, current / TileChunk::Size);
+				const sf::Vector2i neighbours[4] = { position - sf::Vector2i(1, 0), position + sf::Vector2i(1, 0), position - sf::Vector2i(0, 1), position + sf::Vector2i(0, 1) };
+				for (const sf::Vector2i& neighbour : neighbours)
+				{
+					int next = neighbour.y * TileChunk::Size + neighbour.x;
+					if (area.contains(neighbour) && chunk.m_labels[next] == 0 && matches(chunk.m_chunk, next, tile, flags))
+					{
+						chunk.m_labels[next] = label;
+						stack.push_back(next);
+					}
+				}
+			}
+
+			chunk.m_sizes.push_back(size);
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+static sf::Uint32 getLabel(const ChunkLabels& chunk, int x, int y)
+{
+	if (chunk.m_sizes.empty() || !chunk.m_area.contains(x, y))
+	{
+		return 0;
+	}
+
+	return chunk.m_labels.empty() ? 1 : chunk.m_labels[y * TileChunk::Size + x];
+}
+
+
+////////////////////////////////////////////////////////////
+static sf::Uint32 findRoot(std::vector<sf::Uint32>& parents, sf::Uint32 component)
+{
+	while (parents[component] != component)
+	{
+		parents[component] = parents[parents[component]];
+		component = parents[component];
+	}
+
+	return component;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FloodFill::compute(const TileLayer& layer, const sf::Vector2i& seed, const sf::IntRect& bounds, std::vector<TileLayer::Span>& spans)
+{
+	spans.clear();
+	if (!bounds.contains(seed))
+	{
+		return false;
+	}
+
+	if (!scan(layer, seed, bounds, spans))
+	{
+		spans.clear();
+		return label(layer, seed, bounds, spans);
+	}
+
+	std::sort(spans.begin(), spans.end(), [](const TileLayer::Span& left, const TileLayer::Span& right)
+	{
+		return left.m_y != right.m_y ? left.m_y < right.m_y : left.m_left < right.m_left;
+	});
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FloodFill::scan(const TileLayer& layer, const sf::Vector2i& seed, const sf::IntRect& bounds, std::vector<TileLayer::Span>& spans)
+{
+	TileId tile = layer.getTile(seed.x, seed.y);
+	sf::Uint8 flags = layer.getFlags(seed.x, seed.y);
+
+	// Neighbouring tiles mostly share their chunk, the last one looked up is kept
+	sf::Vector2i cachedKey;
+	const TileChunk* cached = nullptr;
+	bool isCached = false;
+	auto isMatching = [&](int x, int y)
+	{
+		if (!bounds.contains(x, y))
+		{
+			return false;
+		}
+
+		sf::Vector2i key = TileLayer::getChunkCoords(sf::Vector2i(x, y));
+		if (!isCached || key != cachedKey)
+		{
+			cached = layer.getChunk(key.x, key.y);
+			cachedKey = key;
+			isCached = true;
+		}
+
+		return matches(cached, (y - key.y * TileChunk::Size) * TileChunk::Size + x - key.x * TileChunk::Size, tile, flags);
+	};
+
+	// A bit per visited tile, a word per row of a chunk
+	CoordMap<std::array<sf::Uint32, TileChunk::Size>> visited;
+	auto isVisited = [&](int x, int y)
+	{
+		sf::Vector2i key = TileLayer::getChunkCoords(sf::Vector2i(x, y));
+		const std::array<sf::Uint32, TileChunk::Size>* rows = visited.find(key);
+		return rows && ((*rows)[y - key.y * TileChunk::Size] >> (x - key.x * TileChunk::Size) & 1) != 0;
+	};
+
+	std::size_t count = 0;
+	std::vector<sf::Vector2i> stack(1, seed);
+	while (!stack.empty())
+	{
+		sf::Vector2i start = stack.back();
+		stack.pop_back();
+		if (isVisited(start.x, start.y))
+		{
+			continue;
+		}
+
+		// Spans are maximal, so a span reached twice is skipped as a whole
+		int y = start.y;
+		int left = start.x;
+		int right = start.x + 1;
+		while (isMatching(left - 1, y))
+		{
+			left--;
+		}
+
+		while (isMatching(right, y))
+		{
+			right++;
+		}
+
+		for (int x = left; x < right; x++)
+		{
+			sf::Vector2i key = TileLayer::getChunkCoords(sf::Vector2i(x, y));
+			visited[key][y - key.y * TileChunk::Size] |= sf::Uint32(1) << (x - key.x * TileChunk::Size);
+		}
+
+		spans.push_back(TileLayer::Span{ y, left, right });
+		count += static_cast<std::size_t>(right - left);
+		if (count > LargeFill)
+		{
+			return false;
+		}
+
+		// One seed per run of matching tiles above and below the span
+		for (int row : { y - 1, y + 1 })
+		{
+			for (int x = left; x < right; x++)
+			{
+				if (isMatching(x, row) && !isVisited(x, row))
+				{
+					stack.push_back(sf::Vector2i(x, row));
+					while (x + 1 < right && isMatching(x + 1, row))
+					{
+						x++;
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FloodFill::label(const TileLayer& layer, const sf::Vector2i& seed, const sf::IntRect& bounds, std::vector<TileLayer::Span>& spans)
+{
+	long long area = static_cast<long long>(bounds.width) * bounds.height;
+	if (area > MaxTiles)
+	{
+		printf("Fill bounds of %lld tiles exceed the limit of %lld tiles\n", area, MaxTiles);
+		return false;
+	}
+
+	TileId tile = layer.getTile(seed.x, seed.y);
+	sf::Uint8 flags = layer.getFlags(seed.x, seed.y);
+	sf::Vector2i first = TileLayer::getChunkCoords(sf::Vector2i(bounds.left, bounds.top));
+	sf::Vector2i last = TileLayer::getChunkCoords(sf::Vector2i(bounds.left + bounds.width - 1, bounds.top + bounds.height - 1));
+	sf::IntRect range(first, last - first + sf::Vector2i(1, 1));
+
+	// Chunks are resolved here, the workers must not load them lazily
+	layer.loadChunks(range);
+	std::vector<ChunkLabels> chunks(static_cast<std::size_t>(range.width) * range.height);
+	for (int y = 0; y < range.height; y++)
+	{
+		for (int x = 0; x < range.width; x++)
+		{
+			ChunkLabels& chunk = chunks[static_cast<std::size_t>(y) * range.width + x];
+			sf::Vector2i origin = (range.getPosition() + sf::Vector2i(x, y)) * TileChunk::Size;
+			int left = std::max(bounds.left - origin.x, 0);
+			int top = std::max(bounds.top - origin.y, 0);
+			int right = std::min(bounds.left + bounds.width - origin.x, TileChunk::Size);
+			int bottom = std::min(bounds.top + bounds.height - origin.y, TileChunk::Size);
+			chunk.m_chunk = layer.getChunk(range.left + x, range.top + y);
+			chunk.m_area = sf::IntRect(left, top, right - left, bottom - top);
+		}
+	}
+
+	JobSystem::getDefault().parallelFor(chunks.size(), [&](std::size_t i)
+	{
+		labelChunk(chunks[i], tile, flags);
+	});
+
+	sf::Uint32 componentCount = 0;
+	for (ChunkLabels& chunk : chunks)
+	{
+		chunk.m_first = componentCount;
+		componentCount += static_cast<sf::Uint32>(chunk.m_sizes.size());
+	}
+
+	// Components touching across a chunk border are merged
+	std::vector<sf::Uint32> parents(componentCount);
+	std::iota(parents.begin(), parents.end(), 0);
+	auto merge = [&](const ChunkLabels& chunk, const sf::Vector2i& position, const ChunkLabels& neighbour, const sf::Vector2i& neighbourPosition)
+	{
+		sf::Uint32 label = getLabel(chunk, position.x, position.y);
+		sf::Uint32 neighbourLabel = getLabel(neighbour, neighbourPosition.x, neighbourPosition.y);
+		if (label != 0 && neighbourLabel != 0)
+		{
+			parents[findRoot(parents, chunk.m_first + label - 1)] = findRoot(parents, neighbour.m_first + neighbourLabel - 1);
+		}
+	};
+
+	for (int y = 0; y < range.height; y++)
+	{
+		for (int x = 0; x < range.width; x++)
+		{
+			const ChunkLabels& chunk = chunks[static_cast<std::size_t>(y) * range.width + x];
+			if (chunk.m_sizes.empty())
+			{
+				continue;
+			}
+
+			for (int i = 0; i < TileChunk::Size; i++)
+			{
+				if (x + 1 < range.width)
+				{
+					merge(chunk, sf::Vector2i(TileChunk::Size - 1, i), chunks[static_cast<std::size_t>(y) * range.width + x + 1], sf::Vector2i(0, i));
+				}
+
+				if (y + 1 < range.height)
+				{
+					merge(chunk, sf::Vector2i(i, TileChunk::Size - 1), chunks[static_cast<std::size_t>(y + 1) * range.width + x], sf::Vector2i(i, 0));
+				}
+			}
+		}
+	}
+
+	// Every component points straight at its root from here on, the workers only read them
+	long long size = 0;
+	sf::Vector2i seedChunk = TileLayer::getChunkCoords(seed) - range.getPosition();
+	const ChunkLabels& seedLabels = chunks[static_cast<std::size_t>(seedChunk.y) * range.width + seedChunk.x];
+	sf::Vector2i seedTile = seed - TileLayer::getChunkCoords(seed) * TileChunk::Size;
+	sf::Uint32 root = findRoot(parents, seedLabels.m_first + getLabel(seedLabels, seedTile.x, seedTile.y) - 1);
+	for (sf::Uint32 i = 0; i < componentCount; i++)
+	{
+		parents[i] = findRoot(parents, i);
+	}
+
+	for (const ChunkLabels& chunk : chunks)
+	{
+		for (std::size_t i = 0; i < chunk.m_sizes.size(); i++)
+		{
+			size += parents[chunk.m_first + i] == root ? chunk.m_sizes[i] : 0;
+		}
+	}
+
+	if (size > MaxTiles)
+	{
+		printf("Fill of %lld tiles exceeds the limit of %lld tiles\n", size, MaxTiles);
+		return false;
+	}
+
+	JobSystem::getDefault().parallelFor(chunks.size(), [&](std::size_t i)
+	{
+		ChunkLabels& chunk = chunks[i];
+		if (chunk.m_sizes.empty())
+		{
+			return;
+		}
+
+		sf::Vector2i origin = (range.getPosition() + sf::Vector2i(static_cast<int>(i % range.width), static_cast<int>(i / range.width))) * TileChunk::Size;
+		const sf::IntRect& area = chunk.m_area;
+		for (int y = area.top; y < area.top + area.height; y++)
+		{
+			int start = area.left;
+			for (int x = area.left; x <= area.left + area.width; x++)
+			{
+				sf::Uint32 label = x < area.left + area.width ? getLabel(chunk, x, y) : 0;
+				if (label != 0 && parents[chunk.m_first + label - 1] == root)
+				{
+					continue;
+				}
+
+				if (start < x)
+				{
+					chunk.m_spans.push_back(TileLayer::Span{ origin.y + y, origin.x + start, origin.x + x });
+				}
+
+				start = x + 1;
+			}
+		}
+
+		chunk.m_labels = std::vector<sf::Uint16>();
+	});
+
+	// Chunks are walked row by row, which joins the spans continuing into the next chunk
+	std::vector<std::size_t> cursors(range.width);
+	for (int y = 0; y < range.height; y++)
+	{
+		std::fill(cursors.begin(), cursors.end(), 0);
+		for (int row = 0; row < TileChunk::Size; row++)
+		{
+			int tileRow = (range.top + y) * TileChunk::Size + row;
+			for (int x = 0; x < range.width; x++)
+			{
+				const std::vector<TileLayer::Span>& chunkSpans = chunks[static_cast<std::size_t>(y) * range.width + x].m_spans;
+				for (std::size_t& i = cursors[x]; i < chunkSpans.size() && chunkSpans[i].m_y == tileRow; i++)
+				{
+					const TileLayer::Span& span = chunkSpans[i];
+					if (!spans.empty() && spans.back().m_y == span.m_y && spans.back().m_right == span.m_left)
+					{
+						spans.back().m_right = span.m_right;
+					}
+					else
+					{
+						spans.push_back(span);
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+} //namespace le
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_FLOOD_FILL_HPP
+#define LEVEL_EDITOR_FLOOD_FILL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "TileLayer.hpp"
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Finds the region of connected tiles a bucket fill covers
+///
+/// The region holds the tiles sharing the id and the flags of the
+/// seed that can be reached from it through the four neighbours
+/// of each tile, crossing chunk borders. Small regions are walked
+/// row by row with an explicit stack of seeds. Once a region grows
+/// past a threshold, every chunk of the bounds is labeled on its
+/// own in parallel and the labels are merged along the chunk
+/// borders, so no tile is ever visited recursively.
+///
+////////////////////////////////////////////////////////////
+class FloodFill
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Largest amount of tiles a region or its bounds may cover
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr long long MaxTiles = 1ll << 26;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the region connected to a tile
+	///
+	/// \param layer  Layer to search, chunks held by its source are loaded
+	/// \param seed   Coordinates of the tile the region starts from
+	/// \param bounds Tiles the region is limited to
+	/// \param spans  Spans covering the region, sorted by row and then by column
+	///
+	/// \return False if the seed is outside the bounds or the region is too large
+	///
+	////////////////////////////////////////////////////////////
+	static bool compute(const TileLayer& layer, const sf::Vector2i& seed, const sf::IntRect& bounds, std::vector<TileLayer::Span>& spans);
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Walk the region row by row from the seed
+	///
+	/// \param layer  Layer to search
+	/// \param seed   Coordinates of the tile the region starts from
+	/// \param bounds Tiles the region is limited to
+	/// \param spans  Spans covering the region, in the order they were found
+	///
+	/// \return False if the region grew past the threshold of the parallel pass
+	///
+	////////////////////////////////////////////////////////////
+	static bool scan(const TileLayer& layer, const sf::Vector2i& seed, const sf::IntRect& bounds, std::vector<TileLayer::Span>& spans);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Label the chunks of the bounds in parallel and gather the seed's component
+	///
+	/// \param layer  Layer to search
+	/// \param seed   Coordinates of the tile the region starts from
+	/// \param bounds Tiles the region is limited to
+	/// \param spans  Spans covering the region, sorted by row and then by column
+	///
+	/// \return False if the bounds or the region are too large
+	///
+	////////////////////////////////////////////////////////////
+	static bool label(const TileLayer& layer, const sf::Vector2i& seed, const sf::IntRect& bounds, std::vector<TileLayer::Span>& spans);
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_FLOOD_FILL_HPP
@@ -0,0 +1,395 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "ImpostorCache.hpp"
+#include "TileLayer.hpp"
+#include "../utility/FrameScheduler.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static void appendQuad(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rect, const sf::FloatRect& texture, const sf::Color& color = sf::Color::White)
+{
+	sf::Vertex topLeft(sf::Vector2f(rect.left, rect.top), color, sf::Vector2f(texture.left, texture.top));
+	sf::Vertex topRight(sf::Vector2f(rect.left + rect.width, rect.top), color, sf::Vector2f(texture.left + texture.width, texture.top));
+	sf::Vertex bottomLeft(sf::Vector2f(rect.left, rect.top + rect.height), color, sf::Vector2f(texture.left, texture.top + texture.height));
+	sf::Vertex bottomRight(sf::Vector2f(rect.left + rect.width, rect.top + rect.height), color, sf::Vector2f(texture.left + texture.width, texture.top + texture.height));
+
+	vertices.insert(vertices.end(), { topLeft, topRight, bottomLeft, bottomLeft, topRight, bottomRight });
+}
+
+
+////////////////////////////////////////////////////////////
+static void clearRect(sf::RenderTarget& target, const sf::FloatRect& rect)
+{
+	std::vector<sf::Vertex> vertices;
+	appendQuad(vertices, rect, sf::FloatRect(), sf::Color::Transparent);
+	target.draw(vertices.data(), vertices.size(), sf::Triangles, sf::RenderStates(sf::BlendNone));
+}
+
+
+////////////////////////////////////////////////////////////
+ImpostorCache::ImpostorCache(const TileLayer& layer) :
+m_layer  (&layer),
+m_cells  (),
+m_visible(),
+m_batches()
+{
+	for (const TileLayer::ChunkEntry& entry : layer.getChunks())
+	{
+		invalidate(entry.m_key);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+ImpostorCache::~ImpostorCache()
+{
+	for (int level = 0; level < LevelCount; level++)
+	{
+		for (const CoordMap<Cell>::Entry& entry : this->m_cells[level].getEntries())
+		{
+			if (entry.m_value.m_slot != NoSlot)
+			{
+				ImpostorPool::getDefault().free(entry.m_value.m_slot, level);
+			}
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void ImpostorCache::invalidate(const sf::Vector2i& chunk)
+{
+	for (int level = 0; level < LevelCount; level++)
+	{
+		sf::Vector2i key(chunk.x >> level, chunk.y >> level);
+		sf::Uint8 quarter = 1;
+		if (level > 0)
+		{
+			quarter = static_cast<sf::Uint8>(1 << (((chunk.x >> (level - 1)) & 1) | (((chunk.y >> (level - 1)) & 1) << 1)));
+		}
+
+		// A dirty cell implies dirty ancestors, so the rest of the path is already scheduled
+		Cell& cell = this->m_cells[level][key];
+		if (cell.m_dirty & quarter)
+		{
+			break;
+		}
+
+		cell.m_dirty |= quarter;
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+int ImpostorCache::getLevel(float pixelsPerTile)
+{
+	float chunkPixels = pixelsPerTile * TileChunk::Size;
+	if (chunkPixels <= 0.f)
+	{
+		return LevelCount - 1;
+	}
+
+	// Highest resolution whose cells still hold at least one texel per screen pixel
+	int level = static_cast<int>(std::floor(std::log2(CellSize / chunkPixels)));
+	return std::clamp(level, 0, LevelCount - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void ImpostorCache::draw(sf::RenderTarget& target, const sf::RenderStates& states, const sf::IntRect& chunks, int level)
+{
+	ImpostorPool& pool = ImpostorPool::getDefault();
+	int left = chunks.left >> level;
+	int top = chunks.top >> level;
+	int right = (chunks.left + chunks.width - 1) >> level;
+	int bottom = (chunks.top + chunks.height - 1) >> level;
+	sf::IntRect range(left, top, right - left + 1, bottom - top + 1);
+
+	// Keys are collected first since rebuilding removes cells that lost their content
+	CoordMap<Cell>& cells = this->m_cells[level];
+	this->m_visible.clear();
+	if (static_cast<long long>(range.width) * range.height > static_cast<long long>(cells.getSize()))
+	{
+		for (const CoordMap<Cell>::Entry& entry : cells.getEntries())
+		{
+			if (range.contains(entry.m_key))
+			{
+				this->m_visible.push_back(entry.m_key);
+			}
+		}
+	}
+	else
+	{
+		for (int y = range.top; y < range.top + range.height; y++)
+		{
+			for (int x = range.left; x < range.left + range.width; x++)
+			{
+				if (cells.find(sf::Vector2i(x, y)))
+				{
+					this->m_visible.push_back(sf::Vector2i(x, y));
+				}
+			}
+		}
+	}
+
+	bool complete = true;
+	for (const sf::Vector2i& key : this->m_visible)
+	{
+		complete = build(level, key) && complete;
+	}
+
+	this->m_batches.resize(pool.getPageCount());
+	for (std::vector<sf::Vertex>& batch : this->m_batches)
+	{
+		batch.clear();
+	}
+
+	sf::Vector2f cellSize = sf::Vector2f(this->m_layer->getTileset().getTileSize()) * static_cast<float>(TileChunk::Size << level);
+	for (const sf::Vector2i& key : this->m_visible)
+	{
+		const Cell* cell = cells.find(key);
+		if (!cell || cell->m_slot == NoSlot)
+		{
+			continue;
+		}
+
+		pool.touch(cell->m_slot);
+
+		// Inset by half a texel so that smoothing does not pick up neighbouring cells
+		sf::FloatRect texture = ImpostorPool::getSlotRect(cell->m_slot);
+		texture = sf::FloatRect(texture.left + 0.5f, texture.top + 0.5f, texture.width - 1.f, texture.height - 1.f);
+		appendQuad(this->m_batches[ImpostorPool::getPage(cell->m_slot)], sf::FloatRect(key.x * cellSize.x, key.y * cellSize.y, cellSize.x, cellSize.y), texture);
+	}
+
+	for (std::size_t page = 0; page < this->m_batches.size(); page++)
+	{
+		if (!this->m_batches[page].empty())
+		{
+			sf::RenderStates pageStates = states;
+			pageStates.texture = &pool.getTexture(page);
+			target.draw(this->m_batches[page].data(), this->m_batches[page].size(), sf::Triangles, pageStates);
+		}
+	}
+
+	if (!complete)
+	{
+		FrameScheduler::getDefault().invalidate();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImpostorCache::build(int level, const sf::Vector2i& key)
+{
+	Cell* cell = this->m_cells[level].find(key);
+	if (!cell)
+	{
+		return true;
+	}
+
+	ImpostorPool& pool = ImpostorPool::getDefault();
+	bool full = cell->m_slot == NoSlot;
+	if (!full && cell->m_dirty == 0)
+	{
+		pool.touch(cell->m_slot);
+		return true;
+	}
+
+	if (!pool.canRebuild())
+	{
+		return false;
+	}
+
+	if (level == 0)
+	{
+		if (!this->m_layer->getChunk(key.x, key.y))
+		{
+			release(level, key);
+			return true;
+		}
+
+		if (!renderChunk(*cell, key))
+		{
+			return false;
+		}
+
+		pool.spendRebuild();
+		cell->m_dirty = 0;
+		return true;
+	}
+
+	// Children are brought up to date first, those that cannot be keep their quarter dirty
+	sf::Uint8 pending = full ? 0xF : cell->m_dirty;
+	bool complete = true;
+	bool empty = true;
+	for (int quarter = 0; quarter < 4; quarter++)
+	{
+		sf::Vector2i child(key.x * 2 + (quarter & 1), key.y * 2 + (quarter >> 1));
+		if ((pending & (1 << quarter)) && !build(level - 1, child))
+		{
+			pending &= ~(1 << quarter);
+			complete = false;
+		}
+
+		empty = empty && !this->m_cells[level - 1].find(child);
+	}
+
+	if (empty)
+	{
+		release(level, key);
+		return true;
+	}
+
+	if (pending == 0 || !pool.canRebuild() || !renderQuarters(level, *cell, key, pending))
+	{
+		return false;
+	}
+
+	pool.spendRebuild();
+	cell->m_dirty = (full ? 0xF : cell->m_dirty) & ~pending;
+	return complete;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImpostorCache::renderChunk(Cell& cell, const sf::Vector2i& key)
+{
+	ImpostorPool& pool = ImpostorPool::getDefault();
+	if (cell.m_slot == NoSlot)
+	{
+		cell.m_slot = pool.allocate(*this, 0, key);
+		if (cell.m_slot == NoSlot)
+		{
+			return false;
+		}
+	}
+
+	const Tileset& tileset = this->m_layer->getTileset();
+	sf::Vector2f area = sf::Vector2f(tileset.getTileSize()) * static_cast<float>(TileChunk::Size);
+	sf::RenderTexture& page = pool.beginSlot(cell.m_slot, area);
+
+	clearRect(page, sf::FloatRect(0.f, 0.f, area.x, area.y));
+	this->m_layer->getChunk(key.x, key.y)->draw(page, sf::RenderStates::Default, tileset);
+	page.display();
+
+	pool.touch(cell.m_slot);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImpostorCache::renderQuarters(int level, Cell& cell, const sf::Vector2i& key, sf::Uint8 quarters)
+{
+	ImpostorPool& pool = ImpostorPool::getDefault();
+	bool full = cell.m_slot == NoSlot;
+	if (full)
+	{
+		cell.m_slot = pool.allocate(*this, level, key);
+		if (cell.m_slot == NoSlot)
+		{
+			return false;
+		}
+	}
+
+	float cellSize = static_cast<float>(CellSize);
+	float half = cellSize / 2.f;
+	sf::RenderTexture& page = pool.beginSlot(cell.m_slot, sf::Vector2f(cellSize, cellSize));
+
+	// The slot may still hold the image of an evicted cell
+	if (full)
+	{
+		clearRect(page, sf::FloatRect(0.f, 0.f, cellSize, cellSize));
+	}
+
+	for (int quarter = 0; quarter < 4; quarter++)
+	{
+		if (!(quarters & (1 << quarter)))
+		{
+			continue;
+		}
+
+		sf::FloatRect rect((quarter & 1) * half, (quarter >> 1) * half, half, half);
+		const Cell* child = this->m_cells[level - 1].find(sf::Vector2i(key.x * 2 + (quarter & 1), key.y * 2 + (quarter >> 1)));
+		if (child && child->m_slot != NoSlot)
+		{
+			// Children live on pages of the other parity, the page being drawn to is never sampled
+			std::vector<sf::Vertex> vertices;
+			appendQuad(vertices, rect, ImpostorPool::getSlotRect(child->m_slot));
+
+			sf::RenderStates states(sf::BlendNone);
+			states.texture = &pool.getTexture(ImpostorPool::getPage(child->m_slot));
+			page.draw(vertices.data(), vertices.size(), sf::Triangles, states);
+		}
+		else
+		{
+			clearRect(page, rect);
+		}
+	}
+
+	page.display();
+
+	pool.touch(cell.m_slot);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImpostorCache::release(int level, const sf::Vector2i& key)
+{
+	const Cell* cell = this->m_cells[level].find(key);
+	if (!cell)
+	{
+		return;
+	}
+
+	if (cell->m_slot != NoSlot)
+	{
+		ImpostorPool::getDefault().free(cell->m_slot, level);
+	}
+
+	this->m_cells[level].erase(key);
+}
+
+
+////////////////////////////////////////////////////////////
+void ImpostorCache::evict(int level, const sf::Vector2i& key)
+{
+	Cell* cell = this->m_cells[level].find(key);
+	if (cell)
+	{
+		cell->m_slot = NoSlot;
+	}
+}
+
+} //namespace le
@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_IMPOSTOR_CACHE_HPP
+#define LEVEL_EDITOR_IMPOSTOR_CACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "ImpostorPool.hpp"
+#include "../utility/CoordMap.hpp"
+#include <array>
+#include <vector>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+class TileLayer;
+
+////////////////////////////////////////////////////////////
+/// \brief Low resolution images of a tile layer used when zoomed out
+///
+/// Level 0 holds one cell per chunk, each following level halves
+/// the resolution by merging 2x2 cells of the level below. Cells
+/// are rendered once into the pages of the ImpostorPool and
+/// are only refreshed along the path of a changed chunk. Rebuilding
+/// is spread over frames by a budget, so zooming out over a large
+/// layer never stalls the frame.
+///
+////////////////////////////////////////////////////////////
+class ImpostorCache : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Size of a cell in texture pixels
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr unsigned int CellSize = 32;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Amount of resolution levels
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr int LevelCount = 16;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// Every existing chunk of the layer is scheduled for rendering.
+	///
+	/// \param layer Layer the impostors are made of
+	///
+	////////////////////////////////////////////////////////////
+	explicit ImpostorCache(const TileLayer& layer);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Gives the texture space of the cells back to the pool.
+	///
+	////////////////////////////////////////////////////////////
+	~ImpostorCache();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Schedule the cells covering a chunk for rendering
+	///
+	/// \param chunk Coordinates of the chunk that was created, edited or erased
+	///
+	////////////////////////////////////////////////////////////
+	void invalidate(const sf::Vector2i& chunk);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the level matching a zoom factor
+	///
+	/// \param pixelsPerTile Size of a tile on screen
+	///
+	////////////////////////////////////////////////////////////
+	static int getLevel(float pixelsPerTile);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the cells covering a range of chunks
+	///
+	/// Dirty cells are rebuilt within the frame's budget, cells
+	/// that could not be rebuilt keep their previous image and
+	/// request another frame.
+	///
+	/// \param target Render target to draw to
+	/// \param states Render states including the layer's transform
+	/// \param chunks Chunk coordinates and amount of chunks to draw
+	/// \param level  Resolution level
+	///
+	////////////////////////////////////////////////////////////
+	void draw(sf::RenderTarget& target, const sf::RenderStates& states, const sf::IntRect& chunks, int level);
+
+private:
+
+	friend class ImpostorPool;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Index of a cell without texture space
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr std::size_t NoSlot = ImpostorPool::NoSlot;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class describing the state of a cell
+	///
+	////////////////////////////////////////////////////////////
+	struct Cell
+	{
+		std::size_t m_slot  = NoSlot; //!< Texture space holding the image, NoSlot if the image has to be rendered from scratch
+		sf::Uint8   m_dirty = 0;      //!< Quarters whose content changed since the image was rendered
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Bring a cell up to date
+	///
+	/// \param level Level of the cell
+	/// \param key   Coordinates of the cell
+	///
+	/// \return False if the budget ran out before the cell was complete
+	///
+	////////////////////////////////////////////////////////////
+	bool build(int level, const sf::Vector2i& key);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Render a chunk into the image of a level 0 cell
+	///
+	/// \param cell Cell to render into
+	/// \param key  Coordinates of the chunk
+	///
+	/// \return False if no texture space was available
+	///
+	////////////////////////////////////////////////////////////
+	bool renderChunk(Cell& cell, const sf::Vector2i& key);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Merge the images of the cells below into a cell
+	///
+	/// \param level    Level of the cell
+	/// \param cell     Cell to render into
+	/// \param key      Coordinates of the cell
+	/// \param quarters Quarters to redraw
+	///
+	/// \return False if no texture space was available
+	///
+	////////////////////////////////////////////////////////////
+	bool renderQuarters(int level, Cell& cell, const sf::Vector2i& key, sf::Uint8 quarters);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove a cell and give its texture space back
+	///
+	/// \param level Level of the cell
+	/// \param key   Coordinates of the cell
+	///
+	////////////////////////////////////////////////////////////
+	void release(int level, const sf::Vector2i& key);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Take the texture space of a cell away
+	///
+	/// Called by the pool, the cell keeps its dirty quarters and is
+	/// rendered from scratch when drawn again.
+	///
+	/// \param level Level of the cell
+	/// \param key   Coordinates of the cell
+	///
+	////////////////////////////////////////////////////////////
+	void evict(int level, const sf::Vector2i& key);
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	const TileLayer*                       m_layer;   //!< Layer the impostors are made of
+	std::array<CoordMap<Cell>, LevelCount> m_cells;   //!< Cells of each level, only those covering content exist
+	std::vector<sf::Vector2i>              m_visible; //!< Cells collected by the current draw
+	std::vector<std::vector<sf::Vertex>>   m_batches; //!< Quads of the current draw by page
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_IMPOSTOR_CACHE_HPP
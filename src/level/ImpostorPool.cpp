@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "ImpostorPool.hpp"
+#include "ImpostorCache.hpp"
+#include "../utility/FrameScheduler.hpp"
+#include <algorithm>
+#include <cstdio>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const unsigned int PageSize = 1024;                                               //!< Size of a texture page in pixels
+static const unsigned int SlotsPerRow = PageSize / ImpostorCache::CellSize;              //!< Amount of cells in a row of a page
+static const std::size_t SlotsPerPage = SlotsPerRow * SlotsPerRow;                       //!< Amount of cells a page holds
+static const std::size_t PageMemory = static_cast<std::size_t>(PageSize) * PageSize * 4; //!< Memory occupied by a page
+
+
+////////////////////////////////////////////////////////////
+static sf::Uint64 getFrame()
+{
+	return FrameScheduler::getDefault().getStatistics().m_rendered;
+}
+
+
+////////////////////////////////////////////////////////////
+ImpostorPool::ImpostorPool() :
+m_pages        (),
+m_pageParities (),
+m_slots        (),
+m_freeSlots    (),
+m_memoryBudget (64 << 20),
+m_rebuildBudget(64),
+m_rebuildsLeft (0),
+m_budgetFrame  (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+ImpostorPool& ImpostorPool::getDefault()
+{
+	static ImpostorPool pool;
+	return pool;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImpostorPool::allocate(ImpostorCache& owner, int level, const sf::Vector2i& key)
+{
+	int parity = level & 1;
+	std::vector<std::size_t>& available = this->m_freeSlots[parity];
+	if (available.empty())
+	{
+		// A parity without any page could never be drawn, so it gets one even over budget
+		bool hasPage = std::find(this->m_pageParities.begin(), this->m_pageParities.end(), parity) != this->m_pageParities.end();
+		if (!hasPage || getMemoryUsage() + PageMemory <= this->m_memoryBudget)
+		{
+			createPage(parity);
+		}
+	}
+
+	sf::Uint64 frame = getFrame();
+	if (available.empty())
+	{
+		// Evict the least recently used cell that is not needed by the current frame
+		std::size_t victim = NoSlot;
+		for (std::size_t slot = 0; slot < this->m_slots.size(); slot++)
+		{
+			const Slot& candidate = this->m_slots[slot];
+			if (candidate.m_owner && this->m_pageParities[getPage(slot)] == parity && candidate.m_lastUse < frame &&
+				(victim == NoSlot || candidate.m_lastUse < this->m_slots[victim].m_lastUse))
+			{
+				victim = slot;
+			}
+		}
+
+		if (victim == NoSlot)
+		{
+			return NoSlot;
+		}
+
+		// The evicted cell keeps its dirty quarters and is rendered from scratch when drawn again
+		const Slot& evicted = this->m_slots[victim];
+		evicted.m_owner->evict(evicted.m_level, evicted.m_key);
+		available.push_back(victim);
+	}
+
+	std::size_t slot = available.back();
+	available.pop_back();
+	this->m_slots[slot] = Slot{ &owner, level, key, frame };
+	return slot;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImpostorPool::free(std::size_t slot, int level)
+{
+	this->m_slots[slot].m_owner = nullptr;
+	this->m_freeSlots[level & 1].push_back(slot);
+}
+
+
+////////////////////////////////////////////////////////////
+void ImpostorPool::touch(std::size_t slot)
+{
+	this->m_slots[slot].m_lastUse = getFrame();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImpostorPool::canRebuild()
+{
+	sf::Uint64 frame = getFrame();
+	if (this->m_budgetFrame != frame)
+	{
+		this->m_budgetFrame = frame;
+		this->m_rebuildsLeft = this->m_rebuildBudget;
+	}
+
+	return this->m_rebuildsLeft > 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImpostorPool::spendRebuild()
+{
+	if (this->m_rebuildsLeft > 0)
+	{
+		--this->m_rebuildsLeft;
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+sf::RenderTexture& ImpostorPool::beginSlot(std::size_t slot, const sf::Vector2f& area)
+{
+	sf::RenderTexture& page = *this->m_pages[getPage(slot)];
+	sf::FloatRect rect = getSlotRect(slot);
+
+	sf::View view(sf::FloatRect(0.f, 0.f, area.x, area.y));
+	view.setViewport(sf::FloatRect(rect.left / PageSize, rect.top / PageSize, rect.width / PageSize, rect.height / PageSize));
+	page.setView(view);
+	return page;
+}
+
+
+////////////////////////////////////////////////////////////
+const sf::Texture& ImpostorPool::getTexture(std::size_t page) const
+{
+	return this->m_pages[page]->getTexture();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImpostorPool::getPageCount() const
+{
+	return this->m_pages.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImpostorPool::getPage(std::size_t slot)
+{
+	return slot / SlotsPerPage;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::FloatRect ImpostorPool::getSlotRect(std::size_t slot)
+{
+	std::size_t index = slot % SlotsPerPage;
+	return sf::FloatRect(static_cast<float>(index % SlotsPerRow * ImpostorCache::CellSize), static_cast<float>(index / SlotsPerRow * ImpostorCache::CellSize),
+		static_cast<float>(ImpostorCache::CellSize), static_cast<float>(ImpostorCache::CellSize));
+}
+
+
+////////////////////////////////////////////////////////////
+void ImpostorPool::setRebuildBudget(unsigned int cells)
+{
+	this->m_rebuildBudget = cells;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImpostorPool::setMemoryBudget(std::size_t bytes)
+{
+	this->m_memoryBudget = bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImpostorPool::getMemoryUsage() const
+{
+	return this->m_pages.size() * PageMemory;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImpostorPool::release()
+{
+	// Cells lose their slots first, so that no cache refers to a destroyed page
+	for (const Slot& slot : this->m_slots)
+	{
+		if (slot.m_owner)
+		{
+			slot.m_owner->evict(slot.m_level, slot.m_key);
+		}
+	}
+
+	this->m_pages.clear();
+	this->m_pageParities.clear();
+	this->m_slots.clear();
+	this->m_freeSlots[0].clear();
+	this->m_freeSlots[1].clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void ImpostorPool::createPage(int parity)
+{
+	std::unique_ptr<sf::RenderTexture> page = std::make_unique<sf::RenderTexture>();
+	if (!page->create(PageSize, PageSize))
+	{
+		printf("Failed to create impostor page\n");
+		return;
+	}
+
+	page->setSmooth(true);
+	page->clear(sf::Color::Transparent);
+	page->display();
+
+	std::size_t first = this->m_slots.size();
+	this->m_pages.push_back(std::move(page));
+	this->m_pageParities.push_back(parity);
+	this->m_slots.resize(first + SlotsPerPage, Slot{ nullptr, 0, sf::Vector2i(), 0 });
+
+	// Handed out in order, so consecutive cells tend to share a page
+	for (std::size_t slot = first + SlotsPerPage; slot > first; slot--)
+	{
+		this->m_freeSlots[parity].push_back(slot - 1);
+	}
+}
+
+} //namespace le
@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_IMPOSTOR_POOL_HPP
+#define LEVEL_EDITOR_IMPOSTOR_POOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <limits>
+#include <memory>
+#include <vector>
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+class ImpostorCache;
+
+////////////////////////////////////////////////////////////
+/// \brief Texture pages holding the impostors of every layer
+///
+/// Pages are split in slots of one cell each. Pages are created
+/// on demand until the memory budget is reached, then the least
+/// recently drawn cells are evicted. Every page holds levels of a
+/// single parity, so a cell is never merged from its own page.
+///
+/// The pages are OpenGL resources, release has to be called
+/// before the window is closed.
+///
+////////////////////////////////////////////////////////////
+class ImpostorPool : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Index meaning no slot
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr std::size_t NoSlot = std::numeric_limits<std::size_t>::max();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	ImpostorPool();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the pool shared by the layers of the application
+	///
+	////////////////////////////////////////////////////////////
+	static ImpostorPool& getDefault();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a slot for a cell, evicting another one if needed
+	///
+	/// \param owner Cache the cell belongs to
+	/// \param level Level of the cell
+	/// \param key   Coordinates of the cell
+	///
+	/// \return Slot index, NoSlot if every slot is in use this frame
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t allocate(ImpostorCache& owner, int level, const sf::Vector2i& key);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Give a slot back
+	///
+	/// \param slot  Slot index
+	/// \param level Level of the cell that used it
+	///
+	////////////////////////////////////////////////////////////
+	void free(std::size_t slot, int level);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark a slot as used by the current frame
+	///
+	/// \param slot Slot index
+	///
+	////////////////////////////////////////////////////////////
+	void touch(std::size_t slot);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether another cell may be rebuilt this frame
+	///
+	////////////////////////////////////////////////////////////
+	bool canRebuild();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Count a rebuilt cell against the budget of the frame
+	///
+	////////////////////////////////////////////////////////////
+	void spendRebuild();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the page of a slot ready to render into it
+	///
+	/// \param slot Slot index
+	/// \param area Size of the area drawn, mapped to the slot
+	///
+	////////////////////////////////////////////////////////////
+	sf::RenderTexture& beginSlot(std::size_t slot, const sf::Vector2f& area);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the texture of a page
+	///
+	/// \param page Page index
+	///
+	////////////////////////////////////////////////////////////
+	const sf::Texture& getTexture(std::size_t page) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of pages
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getPageCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the page of a slot
+	///
+	/// \param slot Slot index
+	///
+	////////////////////////////////////////////////////////////
+	static std::size_t getPage(std::size_t slot);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the area of a slot in its page, in pixels
+	///
+	/// \param slot Slot index
+	///
+	////////////////////////////////////////////////////////////
+	static sf::FloatRect getSlotRect(std::size_t slot);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the amount of cells rebuilt per frame by all caches
+	///
+	/// \param cells Amount of cells
+	///
+	////////////////////////////////////////////////////////////
+	void setRebuildBudget(unsigned int cells);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the amount of memory the pages may occupy
+	///
+	/// The least recently drawn cells are evicted once the budget
+	/// is exceeded.
+	///
+	/// \param bytes Memory budget in bytes
+	///
+	////////////////////////////////////////////////////////////
+	void setMemoryBudget(std::size_t bytes);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of memory occupied by the pages
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getMemoryUsage() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destroy every page
+	///
+	/// The cells using them are rendered again when drawn.
+	///
+	////////////////////////////////////////////////////////////
+	void release();
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class describing who uses a slot
+	///
+	////////////////////////////////////////////////////////////
+	struct Slot
+	{
+		ImpostorCache* m_owner;   //!< Cache the cell belongs to, nullptr if the slot is free
+		int            m_level;   //!< Level of the cell
+		sf::Vector2i   m_key;     //!< Coordinates of the cell
+		sf::Uint64     m_lastUse; //!< Last frame the cell was drawn or rendered in
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a page and make its slots available
+	///
+	/// \param parity Parity of the levels the page holds
+	///
+	////////////////////////////////////////////////////////////
+	void createPage(int parity);
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::vector<std::unique_ptr<sf::RenderTexture>> m_pages;         //!< Texture pages
+	std::vector<int>                                m_pageParities;  //!< Parity of the levels each page holds
+	std::vector<Slot>                               m_slots;         //!< Users of the slots of every page
+	std::vector<std::size_t>                        m_freeSlots[2];  //!< Unused slots by the parity of their page
+	std::size_t                                     m_memoryBudget;  //!< Amount of memory the pages may occupy
+	unsigned int                                    m_rebuildBudget; //!< Amount of cells rebuilt per frame
+	unsigned int                                    m_rebuildsLeft;  //!< Amount of cells that may still be rebuilt this frame
+	sf::Uint64                                      m_budgetFrame;   //!< Frame the remaining rebuilds belong to
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_IMPOSTOR_POOL_HPP
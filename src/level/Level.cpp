@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Level.hpp"
+#include "../utility/FrameScheduler.hpp"
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+Level::Level(const Tileset& tileset) :
+m_tileset      (&tileset),
+m_layers       (),
+m_entities     (),
+m_onTileChanged([](Level&, const TileChange&) {}),
+m_onChunkLoaded([](Level&, const ChunkLoad&) {})
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const Tileset& Level::getTileset() const
+{
+	return *this->m_tileset;
+}
+
+
+////////////////////////////////////////////////////////////
+void Level::setTileset(const Tileset& tileset)
+{
+	this->m_tileset = &tileset;
+	for (const std::unique_ptr<TileLayer>& layer : this->m_layers)
+	{
+		layer->setTileset(tileset);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+TileLayer& Level::addLayer()
+{
+	this->m_layers.push_back(std::make_unique<TileLayer>(*this->m_tileset));
+	this->m_layers.back()->setOnTileChanged([this](TileLayer& layer, const TileLayer::TileChange& change)
+	{
+		this->m_onTileChanged(*this, TileChange{ getIndex(layer), change });
+	});
+
+	this->m_layers.back()->setOnChunkLoaded([this](const TileLayer& layer, const sf::Vector2i& chunk)
+	{
+		this->m_onChunkLoaded(*this, ChunkLoad{ getIndex(layer), chunk });
+	});
+
+	FrameScheduler::getDefault().invalidate();
+	return *this->m_layers.back();
+}
+
+
+////////////////////////////////////////////////////////////
+TileLayer& Level::duplicateLayer(std::size_t index)
+{
+	const TileLayer& source = *this->m_layers[index];
+	TileLayer& layer = addLayer();
+	layer.share(source);
+	layer.setVisible(source.isVisible());
+	layer.setPosition(source.getPosition());
+	layer.setRotation(source.getRotation());
+	layer.setScale(source.getScale());
+	layer.setOrigin(source.getOrigin());
+	return layer;
+}
+
+
+////////////////////////////////////////////////////////////
+void Level::removeLayer(std::size_t index)
+{
+	this->m_layers.erase(this->m_layers.begin() + index);
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Level::getLayerCount() const
+{
+	return this->m_layers.size();
+}
+
+
+////////////////////////////////////////////////////////////
+TileLayer& Level::getLayer(std::size_t index)
+{
+	return *this->m_layers[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const TileLayer& Level::getLayer(std::size_t index) const
+{
+	return *this->m_layers[index];
+}
+
+
+////////////////////////////////////////////////////////////
+EntityStore& Level::getEntities()
+{
+	return this->m_entities;
+}
+
+
+////////////////////////////////////////////////////////////
+const EntityStore& Level::getEntities() const
+{
+	return this->m_entities;
+}
+
+
+////////////////////////////////////////////////////////////
+void Level::setOnTileChanged(Event1<Level, const TileChange&> onTileChanged)
+{
+	this->m_onTileChanged = std::move(onTileChanged);
+}
+
+
+////////////////////////////////////////////////////////////
+void Level::setOnChunkLoaded(Event1<Level, const ChunkLoad&> onChunkLoaded)
+{
+	this->m_onChunkLoaded = std::move(onChunkLoaded);
+}
+
+
+////////////////////////////////////////////////////////////
+void Level::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	for (const std::unique_ptr<TileLayer>& layer : this->m_layers)
+	{
+		target.draw(*layer, states);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Level::getIndex(const TileLayer& layer) const
+{
+	std::size_t index = 0;
+	while (this->m_layers[index].get() != &layer)
+	{
+		index++;
+	}
+
+	return index;
+}
+
+} //namespace le
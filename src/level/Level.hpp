@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_LEVEL_HPP
+#define LEVEL_EDITOR_LEVEL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "EntityStore.hpp"
+#include "TileLayer.hpp"
+#include <memory>
+#include <vector>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Level document, a stack of tile layers sharing one tileset
+/// and the entities placed over them
+///
+////////////////////////////////////////////////////////////
+class Level : public sf::Drawable, sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class describing how a run of tiles of a layer changed
+	///
+	////////////////////////////////////////////////////////////
+	struct TileChange
+	{
+		std::size_t           m_layer;  //!< Index of the layer
+		TileLayer::TileChange m_change; //!< Previous and new state of the tiles
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class describing a chunk of a layer loaded from its source
+	///
+	////////////////////////////////////////////////////////////
+	struct ChunkLoad
+	{
+		std::size_t  m_layer; //!< Index of the layer
+		sf::Vector2i m_chunk; //!< Coordinates of the chunk
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param tileset Tileset the tile ids refer to
+	///
+	////////////////////////////////////////////////////////////
+	explicit Level(const Tileset& tileset);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the tileset the tile ids refer to
+	///
+	////////////////////////////////////////////////////////////
+	const Tileset& getTileset() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Change the tileset of the level and of its layers
+	///
+	/// Typically called once a tileset that was loading is ready,
+	/// or was reloaded.
+	///
+	/// \param tileset Tileset the tile ids refer to
+	///
+	////////////////////////////////////////////////////////////
+	void setTileset(const Tileset& tileset);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a layer on top of the existing ones
+	///
+	/// \return The new layer
+	///
+	////////////////////////////////////////////////////////////
+	TileLayer& addLayer();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a copy of a layer on top of the existing ones
+	///
+	/// The copy shares the tiles of the layer, so duplicating is
+	/// immediate and costs no memory until either layer is edited.
+	///
+	/// \param index Index of the layer to copy, 0 being the bottom one
+	///
+	/// \return The new layer
+	///
+	////////////////////////////////////////////////////////////
+	TileLayer& duplicateLayer(std::size_t index);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove a layer
+	///
+	/// \param index Index of the layer, 0 being the bottom one
+	///
+	////////////////////////////////////////////////////////////
+	void removeLayer(std::size_t index);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of layers
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getLayerCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a layer
+	///
+	/// \param index Index of the layer, 0 being the bottom one
+	///
+	////////////////////////////////////////////////////////////
+	TileLayer& getLayer(std::size_t index);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a layer
+	///
+	/// \param index Index of the layer, 0 being the bottom one
+	///
+	////////////////////////////////////////////////////////////
+	const TileLayer& getLayer(std::size_t index) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the entities placed in the level
+	///
+	////////////////////////////////////////////////////////////
+	EntityStore& getEntities();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the entities placed in the level
+	///
+	////////////////////////////////////////////////////////////
+	const EntityStore& getEntities() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the function raised whenever a tile of any layer changes
+	///
+	/// \param onTileChanged Event receiving the previous and the new state of the tiles
+	///
+	////////////////////////////////////////////////////////////
+	void setOnTileChanged(Event1<Level, const TileChange&> onTileChanged);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the function raised whenever a chunk of any layer is loaded from its source
+	///
+	/// \param onChunkLoaded Event receiving the layer and the coordinates of the chunk
+	///
+	////////////////////////////////////////////////////////////
+	void setOnChunkLoaded(Event1<Level, const ChunkLoad&> onChunkLoaded);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the layers from bottom to top
+	///
+	/// \param target Render target to draw to
+	/// \param states Current render states
+	///
+	////////////////////////////////////////////////////////////
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the index of a layer of the level
+	///
+	/// Layers can be removed, so their index is looked up when
+	/// one of them raises an event.
+	///
+	/// \param layer Layer of the level
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getIndex(const TileLayer& layer) const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	const Tileset*                          m_tileset;       //!< Tileset the tile ids refer to
+	std::vector<std::unique_ptr<TileLayer>> m_layers;        //!< Layers from bottom to top
+	EntityStore                             m_entities;      //!< Entities placed in the level
+	Event1<Level, const TileChange&>        m_onTileChanged; //!< Event raised whenever a tile of any layer changes
+	Event1<Level, const ChunkLoad&>         m_onChunkLoaded; //!< Event raised whenever a chunk of any layer is loaded
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_LEVEL_HPP
@@ -0,0 +1,602 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "LevelFile.hpp"
+#include "ChunkCodec.hpp"
+#include "../utility/Crc32.hpp"
+#include "../utility/DurableFile.hpp"
+#include "../utility/JobSystem.hpp"
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Standard layout class at the start of every level file
+///
+////////////////////////////////////////////////////////////
+struct FileHeader
+{
+	char       m_magic[4];    //!< Identifies level files
+	sf::Uint16 m_version;     //!< Version of the format the file was written with
+	sf::Uint16 m_headerSize;  //!< Size of this header in bytes
+	sf::Uint32 m_chunkSize;   //!< Amount of tiles per chunk side
+	sf::Uint32 m_layerCount;  //!< Amount of layer records in the index
+	sf::Uint64 m_indexOffset; //!< Position of the index from the start of the file
+	sf::Uint64 m_chunkCount;  //!< Amount of chunk records in the index
+	sf::Uint32 m_indexCrc;    //!< Checksum of the index
+	sf::Uint32 m_reserved;    //!< Zero
+	sf::Uint64 m_garbageSize; //!< Bytes taken by superseded payloads and indices
+	sf::Uint64 m_generation;  //!< Amount of times the file was saved
+	sf::Uint32 m_padding;     //!< Zero
+	sf::Uint32 m_headerCrc;   //!< Checksum of the preceding fields
+};
+
+
+////////////////////////////////////////////////////////////
+/// \brief Standard layout class describing a layer in the index
+///
+////////////////////////////////////////////////////////////
+struct LayerRecord
+{
+	sf::Uint32 m_flags;    //!< Combination of layer flags
+	sf::Uint32 m_reserved; //!< Zero
+};
+
+
+////////////////////////////////////////////////////////////
+/// \brief Standard layout class locating a chunk in the index
+///
+////////////////////////////////////////////////////////////
+struct ChunkRecord
+{
+	sf::Int32  m_x;        //!< Column of the chunk
+	sf::Int32  m_y;        //!< Row of the chunk
+	sf::Uint32 m_layer;    //!< Index of the layer
+	sf::Uint16 m_encoding; //!< Way the tiles are encoded in the payload
+	sf::Uint16 m_reserved; //!< Zero
+	sf::Uint64 m_offset;   //!< Position of the payload from the start of the file
+	sf::Uint32 m_size;     //!< Size of the payload in bytes
+	sf::Uint32 m_crc;      //!< Checksum of the payload
+};
+
+static_assert(sizeof(FileHeader) == 64 && sizeof(LayerRecord) == 8 && sizeof(ChunkRecord) == 32, "Level file records must not be padded");
+
+
+////////////////////////////////////////////////////////////
+static const char Magic[4] = { 'L', 'E', 'V', 'L' }; //!< First bytes of every level file
+static const sf::Uint64 Alignment = 64;              //!< Payloads and indices start on cache line boundaries so they can be read in place
+static const sf::Uint32 LayerVisible = 1 << 0;       //!< Layer flag set for visible layers
+
+
+////////////////////////////////////////////////////////////
+static sf::Uint64 align(sf::Uint64 offset)
+{
+	return (offset + Alignment - 1) / Alignment * Alignment;
+}
+
+
+////////////////////////////////////////////////////////////
+static sf::Uint32 getHeaderCrc(const FileHeader& header)
+{
+	return Crc32::compute(&header, offsetof(FileHeader, m_headerCrc));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+static void appendRecord(std::vector<char>& blob, const T& record)
+{
+	const char* bytes = reinterpret_cast<const char*>(&record);
+	blob.insert(blob.end(), bytes, bytes + sizeof(T));
+}
+
+
+////////////////////////////////////////////////////////////
+static bool writeAt(std::ostream& stream, sf::Uint64 offset, const void* data, std::size_t size)
+{
+	stream.seekp(static_cast<std::streamoff>(offset));
+	stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+	return stream.good();
+}
+
+
+////////////////////////////////////////////////////////////
+LevelFile::LevelFile() :
+m_path       (),
+m_file       (),
+m_index      (),
+m_layerFlags (),
+m_indexSize  (0),
+m_garbageSize(0),
+m_generation (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelFile::open(const std::filesystem::path& path, Level& level)
+{
+	if (!map(path))
+	{
+		return false;
+	}
+
+	while (level.getLayerCount() > 0)
+	{
+		level.removeLayer(level.getLayerCount() - 1);
+	}
+
+	for (std::size_t i = 0; i < this->m_index.size(); i++)
+	{
+		TileLayer& layer = level.addLayer();
+		layer.setVisible((this->m_layerFlags[i] & LayerVisible) != 0);
+		layer.setSource(this, i);
+
+		for (const CoordMap<Location>::Entry& entry : this->m_index[i].getEntries())
+		{
+			layer.addSourceChunk(entry.m_key);
+		}
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelFile::save(Level& level)
+{
+	if (!isOpen())
+	{
+		printf("No level file is opened\n");
+		return false;
+	}
+
+	if (!isAttached(level) || this->m_garbageSize * 2 > this->m_file.getSize())
+	{
+		return rewrite(this->m_path, level);
+	}
+
+	return append(level);
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelFile::saveAs(const std::filesystem::path& path, Level& level)
+{
+	return rewrite(path, level);
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelFile::isOpen() const
+{
+	return this->m_file.isOpen();
+}
+
+
+////////////////////////////////////////////////////////////
+const std::filesystem::path& LevelFile::getPath() const
+{
+	return this->m_path;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint64 LevelFile::getGarbageSize() const
+{
+	return this->m_garbageSize;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint64 LevelFile::getGeneration() const
+{
+	return this->m_generation;
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelFile::loadChunk(std::size_t layer, const sf::Vector2i& key, TileChunk& chunk) const
+{
+	if (layer >= this->m_index.size())
+	{
+		return false;
+	}
+
+	const Location* location = this->m_index[layer].find(key);
+	std::size_t size = this->m_file.getSize();
+	if (!location || location->m_offset > size || location->m_size > size - location->m_offset)
+	{
+		return false;
+	}
+
+	const char* payload = this->m_file.getData() + location->m_offset;
+	if (Crc32::compute(payload, location->m_size) != location->m_crc)
+	{
+		printf("Chunk %d, %d of layer %u is corrupted\n", key.x, key.y, static_cast<unsigned int>(layer));
+		return false;
+	}
+
+	return ChunkCodec::decode(payload, location->m_size, location->m_encoding, chunk);
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelFile::map(const std::filesystem::path& path)
+{
+	// The current file stays opened until the new one is known to be valid
+	MappedFile file;
+	if (!file.open(path))
+	{
+		printf("Failed to open level file \"%s\"\n", path.string().c_str());
+		return false;
+	}
+
+	const char* data = file.getData();
+	std::size_t size = file.getSize();
+
+	FileHeader header = {};
+	if (size >= sizeof(FileHeader))
+	{
+		std::memcpy(&header, data, sizeof(FileHeader));
+	}
+
+	if (std::memcmp(header.m_magic, Magic, sizeof(Magic)) != 0 || header.m_headerSize != sizeof(FileHeader) || getHeaderCrc(header) != header.m_headerCrc)
+	{
+		printf("\"%s\" is not a level file or its header is corrupted\n", path.string().c_str());
+		return false;
+	}
+
+	if (header.m_version > Version || header.m_chunkSize != static_cast<sf::Uint32>(TileChunk::Size))
+	{
+		printf("\"%s\" was written by an unsupported version of the editor\n", path.string().c_str());
+		return false;
+	}
+
+	sf::Uint64 available = header.m_indexOffset <= size ? size - header.m_indexOffset : 0;
+	sf::Uint64 layersSize = static_cast<sf::Uint64>(header.m_layerCount) * sizeof(LayerRecord);
+	if (layersSize > available || header.m_chunkCount > (available - layersSize) / sizeof(ChunkRecord))
+	{
+		printf("The index of \"%s\" is truncated\n", path.string().c_str());
+		return false;
+	}
+
+	const char* index = data + header.m_indexOffset;
+	sf::Uint64 indexSize = layersSize + header.m_chunkCount * sizeof(ChunkRecord);
+	if (Crc32::compute(index, static_cast<std::size_t>(indexSize)) != header.m_indexCrc)
+	{
+		printf("The index of \"%s\" is corrupted\n", path.string().c_str());
+		return false;
+	}
+
+	std::vector<CoordMap<Location>> locations(header.m_layerCount);
+	std::vector<sf::Uint32> layerFlags(header.m_layerCount);
+	for (sf::Uint32 i = 0; i < header.m_layerCount; i++)
+	{
+		LayerRecord record;
+		std::memcpy(&record, index + i * sizeof(LayerRecord), sizeof(LayerRecord));
+		layerFlags[i] = record.m_flags;
+	}
+
+	const char* chunks = index + layersSize;
+	for (sf::Uint64 i = 0; i < header.m_chunkCount; i++)
+	{
+		ChunkRecord record;
+		std::memcpy(&record, chunks + i * sizeof(ChunkRecord), sizeof(ChunkRecord));
+		if (record.m_layer >= header.m_layerCount || record.m_offset > size || record.m_size > size - record.m_offset)
+		{
+			printf("The index of \"%s\" points outside of the file\n", path.string().c_str());
+			return false;
+		}
+
+		locations[record.m_layer][sf::Vector2i(record.m_x, record.m_y)] = Location{ record.m_offset, record.m_size, record.m_crc, record.m_encoding };
+	}
+
+	file.close();
+	if (!this->m_file.open(path))
+	{
+		printf("Failed to open level file \"%s\"\n", path.string().c_str());
+		return false;
+	}
+
+	this->m_path = path;
+	this->m_index = std::move(locations);
+	this->m_layerFlags = std::move(layerFlags);
+	this->m_indexSize = indexSize;
+	this->m_garbageSize = header.m_garbageSize;
+	this->m_generation = header.m_generation;
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelFile::isAttached(const Level& level) const
+{
+	if (level.getLayerCount() != this->m_index.size())
+	{
+		return false;
+	}
+
+	for (std::size_t i = 0; i < level.getLayerCount(); i++)
+	{
+		const TileLayer& layer = level.getLayer(i);
+		if (layer.getSource() != this || layer.getSourceLayer() != i)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelFile::append(Level& level)
+{
+	std::fstream stream(this->m_path, std::ios::in | std::ios::out | std::ios::binary);
+	if (!stream)
+	{
+		printf("Failed to write level file \"%s\"\n", this->m_path.string().c_str());
+		return false;
+	}
+
+	std::vector<Payload> payloads;
+	for (std::size_t i = 0; i < level.getLayerCount(); i++)
+	{
+		TileLayer& layer = level.getLayer(i);
+		CoordMap<Location>& index = this->m_index[i];
+		this->m_layerFlags[i] = layer.isVisible() ? LayerVisible : 0;
+
+		for (const CoordMap<bool>::Entry& entry : layer.getModifiedChunks())
+		{
+			if (const Location* previous = index.find(entry.m_key))
+			{
+				this->m_garbageSize += previous->m_size;
+			}
+
+			const TileChunk* chunk = layer.getChunk(entry.m_key.x, entry.m_key.y);
+			if (!chunk)
+			{
+				index.erase(entry.m_key);
+				continue;
+			}
+
+			payloads.push_back(Payload{ i, entry.m_key, chunk, nullptr, {}, {} });
+		}
+	}
+
+	// Everything is written past the current data, the file is only switched over by the header
+	sf::Uint64 end = this->m_file.getSize();
+	encodePayloads(payloads);
+	bool written = writePayloads(stream, payloads, end);
+	if (written)
+	{
+		for (const Payload& payload : payloads)
+		{
+			this->m_index[payload.m_layer][payload.m_key] = payload.m_location;
+		}
+	}
+
+	sf::Uint64 indexSize = 0;
+	sf::Uint64 garbageSize = this->m_garbageSize + this->m_indexSize;
+	written = written && writeIndex(stream, this->m_path, align(end), this->m_layerFlags, this->m_index, garbageSize, this->m_generation + 1, indexSize);
+	stream.close();
+
+	// Remapping makes the appended payloads readable
+	this->m_file.open(this->m_path);
+	if (!written)
+	{
+		printf("Failed to write level file \"%s\"\n", this->m_path.string().c_str());
+		return false;
+	}
+
+	this->m_indexSize = indexSize;
+	this->m_garbageSize = garbageSize;
+	++this->m_generation;
+	for (std::size_t i = 0; i < level.getLayerCount(); i++)
+	{
+		level.getLayer(i).clearModified();
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelFile::rewrite(const std::filesystem::path& path, Level& level)
+{
+	std::filesystem::path temporary = path;
+	temporary += ".tmp";
+
+	std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+	if (!stream)
+	{
+		printf("Failed to write level file \"%s\"\n", temporary.string().c_str());
+		return false;
+	}
+
+	std::vector<sf::Uint32> layerFlags(level.getLayerCount());
+	std::vector<Payload> payloads;
+	for (std::size_t i = 0; i < level.getLayerCount(); i++)
+	{
+		const TileLayer& layer = level.getLayer(i);
+		layerFlags[i] = layer.isVisible() ? LayerVisible : 0;
+
+		for (const TileLayer::ChunkEntry& entry : layer.getChunks())
+		{
+			// Chunks that were never loaded from this file are copied without being decoded
+			const Location* stored = nullptr;
+			if (!entry.m_value && layer.getSource() == this && layer.getSourceLayer() < this->m_index.size())
+			{
+				stored = this->m_index[layer.getSourceLayer()].find(entry.m_key);
+			}
+
+			if (stored && stored->m_offset <= this->m_file.getSize() && stored->m_size <= this->m_file.getSize() - stored->m_offset)
+			{
+				payloads.push_back(Payload{ i, entry.m_key, nullptr, this->m_file.getData() + stored->m_offset, {}, *stored });
+			}
+			else if (const TileChunk* chunk = layer.getChunk(entry.m_key.x, entry.m_key.y))
+			{
+				payloads.push_back(Payload{ i, entry.m_key, chunk, nullptr, {}, {} });
+			}
+		}
+	}
+
+	sf::Uint64 end = sizeof(FileHeader);
+	encodePayloads(payloads);
+	bool written = writePayloads(stream, payloads, end);
+
+	std::vector<CoordMap<Location>> locations(level.getLayerCount());
+	for (const Payload& payload : payloads)
+	{
+		locations[payload.m_layer][payload.m_key] = payload.m_location;
+	}
+
+	sf::Uint64 indexSize = 0;
+	written = written && writeIndex(stream, temporary, align(end), layerFlags, locations, 0, this->m_generation + 1, indexSize);
+	stream.close();
+
+	// The mapping has to be released before its file can be replaced
+	std::error_code error;
+	if (written)
+	{
+		this->m_file.close();
+		std::filesystem::rename(temporary, path, error);
+	}
+
+	if (!written || error)
+	{
+		printf("Failed to write level file \"%s\"\n", path.string().c_str());
+		std::filesystem::remove(temporary, error);
+		if (!this->m_path.empty() && !this->m_file.isOpen())
+		{
+			this->m_file.open(this->m_path);
+		}
+
+		return false;
+	}
+
+	this->m_path = path;
+	this->m_file.open(path);
+	this->m_index = std::move(locations);
+	this->m_layerFlags = std::move(layerFlags);
+	this->m_indexSize = indexSize;
+	this->m_garbageSize = 0;
+	++this->m_generation;
+
+	for (std::size_t i = 0; i < level.getLayerCount(); i++)
+	{
+		TileLayer& layer = level.getLayer(i);
+		layer.setSource(this, i);
+		layer.clearModified();
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void LevelFile::encodePayloads(std::vector<Payload>& payloads)
+{
+	JobSystem::getDefault().parallelFor(payloads.size(), [&payloads](std::size_t i)
+	{
+		Payload& payload = payloads[i];
+		if (payload.m_chunk)
+		{
+			sf::Uint16 encoding = ChunkCodec::encode(*payload.m_chunk, payload.m_encoded);
+			sf::Uint32 size = static_cast<sf::Uint32>(payload.m_encoded.size());
+			payload.m_data = payload.m_encoded.data();
+			payload.m_location = Location{ 0, size, Crc32::compute(payload.m_data, size), encoding };
+		}
+	});
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelFile::writePayloads(std::ostream& stream, std::vector<Payload>& payloads, sf::Uint64& end)
+{
+	for (Payload& payload : payloads)
+	{
+		payload.m_location.m_offset = align(end);
+		if (!writeAt(stream, payload.m_location.m_offset, payload.m_data, payload.m_location.m_size))
+		{
+			return false;
+		}
+
+		end = payload.m_location.m_offset + payload.m_location.m_size;
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelFile::writeIndex(std::ostream& stream, const std::filesystem::path& path, sf::Uint64 offset, const std::vector<sf::Uint32>& layerFlags,
+	const std::vector<CoordMap<Location>>& index, sf::Uint64 garbageSize, sf::Uint64 generation, sf::Uint64& indexSize)
+{
+	std::vector<char> blob;
+	for (sf::Uint32 flags : layerFlags)
+	{
+		appendRecord(blob, LayerRecord{ flags, 0 });
+	}
+
+	sf::Uint64 chunkCount = 0;
+	for (std::size_t i = 0; i < index.size(); i++)
+	{
+		for (const CoordMap<Location>::Entry& entry : index[i].getEntries())
+		{
+			const Location& location = entry.m_value;
+			appendRecord(blob, ChunkRecord{ entry.m_key.x, entry.m_key.y, static_cast<sf::Uint32>(i), location.m_encoding, 0, location.m_offset, location.m_size, location.m_crc });
+			++chunkCount;
+		}
+	}
+
+	FileHeader header = {};
+	std::memcpy(header.m_magic, Magic, sizeof(Magic));
+	header.m_version = Version;
+	header.m_headerSize = sizeof(FileHeader);
+	header.m_chunkSize = TileChunk::Size;
+	header.m_layerCount = static_cast<sf::Uint32>(layerFlags.size());
+	header.m_indexOffset = offset;
+	header.m_chunkCount = chunkCount;
+	header.m_indexCrc = Crc32::compute(blob.data(), blob.size());
+	header.m_garbageSize = garbageSize;
+	header.m_generation = generation;
+	header.m_headerCrc = getHeaderCrc(header);
+
+	// The header is written last and alone once the rest is on disk, until then the file still describes its previous state
+	indexSize = blob.size();
+	return writeAt(stream, offset, blob.data(), blob.size()) && stream.flush().good() && DurableFile::sync(path) &&
+		writeAt(stream, 0, &header, sizeof(FileHeader)) && stream.flush().good() && DurableFile::sync(path);
+}
+
+} //namespace le
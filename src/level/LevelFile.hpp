@@ -0,0 +1,275 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_LEVEL_FILE_HPP
+#define LEVEL_EDITOR_LEVEL_FILE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "ChunkSource.hpp"
+#include "Level.hpp"
+#include "../utility/CoordMap.hpp"
+#include "../utility/MappedFile.hpp"
+#include <filesystem>
+#include <ostream>
+#include <vector>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Binary level file, mapped into memory and loaded chunk by chunk
+///
+/// The file starts with a fixed size header pointing to an index
+/// of every chunk, the chunk payloads are aligned so that they can
+/// be read in place from the mapping. Opening reads the header and
+/// the index only, chunks are decoded when a layer first accesses
+/// them. Saving appends the edited chunks and a new index, then
+/// rewrites the header, so the previous state stays valid until
+/// the header points to the new one. The whole file is rewritten
+/// once superseded payloads make up half of it. Every chunk is
+/// compressed on its own by ChunkCodec, encoding and decoding run
+/// in parallel on the job system. Values are stored little endian
+/// and checksummed with CRC-32.
+///
+/// The layers of an opened level load their chunks from the file,
+/// so the file must outlive the level.
+///
+////////////////////////////////////////////////////////////
+class LevelFile : public ChunkSource, sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Version of the format written by this editor
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr sf::Uint16 Version = 2;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	LevelFile();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Open a file and attach its layers to a level
+	///
+	/// The existing layers of the level are removed.
+	///
+	/// \param path  Path of the file
+	/// \param level Level to fill
+	///
+	/// \return True if the file was opened
+	///
+	////////////////////////////////////////////////////////////
+	bool open(const std::filesystem::path& path, Level& level);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Save a level to the opened file
+	///
+	/// Only the chunks edited since the last save are written if
+	/// the level was opened from or saved to this file.
+	///
+	/// \param level Level to save
+	///
+	/// \return True if the level was saved
+	///
+	////////////////////////////////////////////////////////////
+	bool save(Level& level);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Write a level to a new file and open it
+	///
+	/// \param path  Path of the file, replaced if it exists
+	/// \param level Level to save
+	///
+	/// \return True if the level was saved
+	///
+	////////////////////////////////////////////////////////////
+	bool saveAs(const std::filesystem::path& path, Level& level);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a file is opened
+	///
+	////////////////////////////////////////////////////////////
+	bool isOpen() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the path of the opened file
+	///
+	////////////////////////////////////////////////////////////
+	const std::filesystem::path& getPath() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of bytes taken by superseded payloads and indices
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint64 getGarbageSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of times the opened file was saved
+	///
+	/// Identifies the state of the file, the edit journal uses it
+	/// to tell whether its edits were saved since.
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint64 getGeneration() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Load the tiles of a chunk from the mapped file
+	///
+	/// \param layer Index of the layer within the file
+	/// \param key   Coordinates of the chunk
+	/// \param chunk Chunk to fill
+	///
+	/// \return False if the chunk is missing or its checksum does not match
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool loadChunk(std::size_t layer, const sf::Vector2i& key, TileChunk& chunk) const override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class locating a chunk payload in the file
+	///
+	////////////////////////////////////////////////////////////
+	struct Location
+	{
+		sf::Uint64 m_offset;   //!< Position of the payload from the start of the file
+		sf::Uint32 m_size;     //!< Size of the payload in bytes
+		sf::Uint32 m_crc;      //!< Checksum of the payload
+		sf::Uint16 m_encoding; //!< Way the tiles are encoded in the payload
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Chunk payload waiting to be written by a save
+	///
+	////////////////////////////////////////////////////////////
+	struct Payload
+	{
+		std::size_t       m_layer;    //!< Index of the layer
+		sf::Vector2i      m_key;      //!< Coordinates of the chunk
+		const TileChunk*  m_chunk;    //!< Chunk to encode, nullptr if the payload is copied from the opened file
+		const char*       m_data;     //!< Bytes to write
+		std::vector<char> m_encoded;  //!< Encoded tiles of the chunk
+		Location          m_location; //!< Size, checksum and encoding of the bytes, the offset is set once written
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Map a file and read its index
+	///
+	/// \param path Path of the file
+	///
+	/// \return True if the file is a valid level file
+	///
+	////////////////////////////////////////////////////////////
+	bool map(const std::filesystem::path& path);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether every layer of a level loads from this file in order
+	///
+	/// \param level Level to check
+	///
+	////////////////////////////////////////////////////////////
+	bool isAttached(const Level& level) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Append the edited chunks and a new index to the file
+	///
+	/// \param level Level to save, attached to this file
+	///
+	/// \return True if the level was saved
+	///
+	////////////////////////////////////////////////////////////
+	bool append(Level& level);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Write every chunk of a level to a new file
+	///
+	/// \param path  Path of the file
+	/// \param level Level to save
+	///
+	/// \return True if the level was saved
+	///
+	////////////////////////////////////////////////////////////
+	bool rewrite(const std::filesystem::path& path, Level& level);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Encode the chunks of payloads in parallel
+	///
+	/// \param payloads Payloads whose chunk has to be encoded
+	///
+	////////////////////////////////////////////////////////////
+	static void encodePayloads(std::vector<Payload>& payloads);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Write payloads one after the other
+	///
+	/// \param stream   Stream of the file
+	/// \param payloads Payloads to write, receive their offset
+	/// \param end      Position after which to write, receives the end of the last payload
+	///
+	/// \return True if every payload was written
+	///
+	////////////////////////////////////////////////////////////
+	static bool writePayloads(std::ostream& stream, std::vector<Payload>& payloads, sf::Uint64& end);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Write an index and the header pointing to it
+	///
+	/// \param stream      Stream of the file
+	/// \param path        Path of the file, to force the data to disk
+	/// \param offset      Position of the index, aligned
+	/// \param layerFlags  Flags of each layer
+	/// \param index       Payload locations of each layer's chunks
+	/// \param garbageSize Bytes taken by superseded payloads and indices
+	/// \param generation  Amount of times the file was saved, including this save
+	/// \param indexSize   Receives the size of the index in bytes
+	///
+	/// \return True if both were written
+	///
+	////////////////////////////////////////////////////////////
+	static bool writeIndex(std::ostream& stream, const std::filesystem::path& path, sf::Uint64 offset, const std::vector<sf::Uint32>& layerFlags,
+		const std::vector<CoordMap<Location>>& index, sf::Uint64 garbageSize, sf::Uint64 generation, sf::Uint64& indexSize);
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::filesystem::path           m_path;        //!< Path of the opened file
+	MappedFile                      m_file;        //!< Mapping of the opened file
+	std::vector<CoordMap<Location>> m_index;       //!< Payload locations of each layer's chunks
+	std::vector<sf::Uint32>         m_layerFlags;  //!< Flags of each layer as stored in the file
+	sf::Uint64                      m_indexSize;   //!< Size of the current index in bytes
+	sf::Uint64                      m_garbageSize; //!< Bytes taken by superseded payloads and indices
+	sf::Uint64                      m_generation;  //!< Amount of times the opened file was saved
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_LEVEL_FILE_HPP
@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "StampCommand.hpp"
+#include "ChunkCodec.hpp"
+#include "../utility/Varint.hpp"
+#include <algorithm>
+
+
+namespace le
+{
+static const std::size_t PayloadSize = TileChunk::Area * (sizeof(TileId) + sizeof(sf::Uint8)); //!< Memory held by the tiles of a chunk that shares them with no other
+
+
+////////////////////////////////////////////////////////////
+StampCommand::StampCommand(Level& level, std::size_t layer, const TileStamp& stamp, const sf::Vector2i& position) :
+m_level  (&level),
+m_layer  (layer),
+m_changes()
+{
+	if (layer >= level.getLayerCount() || stamp.isEmpty())
+	{
+		return;
+	}
+
+	const TileLayer& target = level.getLayer(layer);
+	sf::Vector2i first = TileLayer::getChunkCoords(position);
+	sf::Vector2i last = TileLayer::getChunkCoords(position + stamp.getSize() - sf::Vector2i(1, 1));
+	target.loadChunks(sf::IntRect(first, last - first + sf::Vector2i(1, 1)));
+
+	for (int y = first.y; y <= last.y; y++)
+	{
+		for (int x = first.x; x <= last.x; x++)
+		{
+			Change change = { sf::Vector2i(x, y), nullptr, nullptr };
+			compose(target, stamp, position, change);
+
+			// Chunks the paste leaves as they are still share the tiles of the layer
+			const TileChunk* previous = change.m_previous.get();
+			const TileChunk* next = change.m_next.get();
+			if (previous ? next && previous->getTiles().data() == next->getTiles().data() : !next)
+			{
+				continue;
+			}
+
+			this->m_changes.push_back(std::move(change));
+		}
+	}
+
+	this->m_changes.shrink_to_fit();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t StampCommand::getChunkCount() const
+{
+	return this->m_changes.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void StampCommand::undo()
+{
+	apply(false);
+}
+
+
+////////////////////////////////////////////////////////////
+void StampCommand::redo()
+{
+	apply(true);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t StampCommand::getMemoryUsage() const
+{
+	std::size_t usage = sizeof(StampCommand) + this->m_changes.capacity() * sizeof(Change);
+	for (const Change& change : this->m_changes)
+	{
+		for (const TileChunk* chunk : { change.m_previous.get(), change.m_next.get() })
+		{
+			if (chunk)
+			{
+				usage += sizeof(TileChunk) + (chunk->isShared() ? 0 : PayloadSize);
+			}
+		}
+	}
+
+	return usage;
+}
+
+
+////////////////////////////////////////////////////////////
+void StampCommand::spill(std::vector<char>& data)
+{
+	std::vector<char> payload;
+	for (Change& change : this->m_changes)
+	{
+		for (std::unique_ptr<TileChunk>* chunk : { &change.m_previous, &change.m_next })
+		{
+			if (!*chunk)
+			{
+				Varint::write(data, 0);
+				continue;
+			}
+
+			// The encoding is shifted by one, 0 stands for a missing chunk
+			payload.clear();
+			ChunkCodec::Encoding encoding = ChunkCodec::encode(**chunk, payload);
+			Varint::write(data, static_cast<sf::Uint64>(encoding) + 1);
+			Varint::write(data, payload.size());
+			data.insert(data.end(), payload.begin(), payload.end());
+			chunk->reset();
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool StampCommand::restore(const char* data, std::size_t size)
+{
+	const sf::Uint8* cursor = reinterpret_cast<const sf::Uint8*>(data);
+	const sf::Uint8* end = cursor + size;
+	for (Change& change : this->m_changes)
+	{
+		for (std::unique_ptr<TileChunk>* chunk : { &change.m_previous, &change.m_next })
+		{
+			sf::Uint64 encoding = 0, length = 0;
+			if (!Varint::read(cursor, end, encoding))
+			{
+				return false;
+			}
+
+			if (encoding == 0)
+			{
+				continue;
+			}
+
+			if (!Varint::read(cursor, end, length) || encoding > 0x10000 || length > static_cast<sf::Uint64>(end - cursor))
+			{
+				return false;
+			}
+
+			*chunk = std::make_unique<TileChunk>();
+			if (!ChunkCodec::decode(reinterpret_cast<const char*>(cursor), static_cast<std::size_t>(length), static_cast<sf::Uint16>(encoding - 1), **chunk))
+			{
+				return false;
+			}
+
+			cursor += length;
+		}
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void StampCommand::compose(const TileLayer& layer, const TileStamp& stamp, const sf::Vector2i& position, Change& change)
+{
+	if (const TileChunk* current = layer.getChunk(change.m_coords.x, change.m_coords.y))
+	{
+		change.m_previous = std::make_unique<TileChunk>();
+		change.m_previous->share(*current);
+	}
+
+	// Position of the chunk's first tile within the stamp's chunk grid
+	sf::Vector2i origin = change.m_coords * TileChunk::Size;
+	sf::Vector2i grid = origin - position + stamp.getOffset();
+	if (grid.x % TileChunk::Size == 0 && grid.y % TileChunk::Size == 0 && stamp.isChunkCovered(grid.x / TileChunk::Size, grid.y / TileChunk::Size))
+	{
+		if (const TileChunk* source = stamp.getChunk(grid.x / TileChunk::Size, grid.y / TileChunk::Size))
+		{
+			change.m_next = std::make_unique<TileChunk>();
+			change.m_next->share(*source);
+		}
+
+		return;
+	}
+
+	// Otherwise the tiles of the chunk are copied, only those the stamp covers are replaced
+	change.m_next = std::make_unique<TileChunk>();
+	if (change.m_previous)
+	{
+		change.m_next->share(*change.m_previous);
+	}
+
+	int left = std::max(position.x - origin.x, 0);
+	int right = std::min(position.x + stamp.getSize().x - origin.x, TileChunk::Size);
+	int top = std::max(position.y - origin.y, 0);
+	int bottom = std::min(position.y + stamp.getSize().y - origin.y, TileChunk::Size);
+	for (int y = top; y < bottom; y++)
+	{
+		int row = grid.y + y;
+		for (int x = left; x < right;)
+		{
+			int column = (grid.x + x) % TileChunk::Size;
+			int end = std::min(right, x + TileChunk::Size - column);
+			const TileChunk* source = stamp.getChunk((grid.x + x) / TileChunk::Size, row / TileChunk::Size);
+			for (; x < end; x++, column++)
+			{
+				TileId tile = source ? source->getTile(column, row % TileChunk::Size) : Tileset::Empty;
+				sf::Uint8 flags = source ? source->getFlags(column, row % TileChunk::Size) : sf::Uint8(TileFlags::None);
+				change.m_next->setTile(x, y, tile, flags);
+			}
+		}
+	}
+
+	if (change.m_next->isEmpty())
+	{
+		change.m_next.reset();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void StampCommand::apply(bool next)
+{
+	if (this->m_layer >= this->m_level->getLayerCount())
+	{
+		return;
+	}
+
+	TileLayer& layer = this->m_level->getLayer(this->m_layer);
+	for (const Change& change : this->m_changes)
+	{
+		layer.setChunk(change.m_coords, next ? change.m_next.get() : change.m_previous.get());
+	}
+}
+
+} //namespace le
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_STAMP_COMMAND_HPP
+#define LEVEL_EDITOR_STAMP_COMMAND_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Level.hpp"
+#include "TileStamp.hpp"
+#include "../utility/Command.hpp"
+#include <memory>
+#include <vector>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Command pasting a stamp over a layer
+///
+/// Every tile of the stamp's rectangle is replaced, including the
+/// empty ones. The command keeps each affected chunk before and
+/// after the paste, sharing their tiles with the layer and the
+/// stamp, so it costs almost no memory until they are edited.
+/// Chunks the stamp covers entirely are shared as they are when
+/// the paste position is aligned with the stamp's chunk grid.
+///
+////////////////////////////////////////////////////////////
+class StampCommand : public Command
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// The layer is left untouched until redo is called.
+	///
+	/// \param level    Level the stamp is pasted to
+	/// \param layer    Index of the layer
+	/// \param stamp    Stamp to paste
+	/// \param position Coordinates of the tile receiving the stamp's first tile
+	///
+	////////////////////////////////////////////////////////////
+	StampCommand(Level& level, std::size_t layer, const TileStamp& stamp, const sf::Vector2i& position);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of chunks the paste changes
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getChunkCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Restore the chunks as they were before the paste
+	///
+	////////////////////////////////////////////////////////////
+	virtual void undo() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Paste the stamp again
+	///
+	////////////////////////////////////////////////////////////
+	virtual void redo() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of memory held by the command in bytes
+	///
+	/// Tiles shared with other chunks are not counted.
+	///
+	////////////////////////////////////////////////////////////
+	virtual std::size_t getMemoryUsage() const override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move the chunks out of memory
+	///
+	/// \param data Buffer the encoded chunks are appended to
+	///
+	////////////////////////////////////////////////////////////
+	virtual void spill(std::vector<char>& data) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Restore the chunks moved out by spill
+	///
+	/// \param data Data returned by spill
+	/// \param size Size of the data in bytes
+	///
+	/// \return False if a chunk could not be decoded
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool restore(const char* data, std::size_t size) override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class holding a chunk before and after the paste
+	///
+	////////////////////////////////////////////////////////////
+	struct Change
+	{
+		sf::Vector2i               m_coords;   //!< Coordinates of the chunk
+		std::unique_ptr<TileChunk> m_previous; //!< Chunk before the paste, nullptr if it did not exist
+		std::unique_ptr<TileChunk> m_next;     //!< Chunk after the paste, nullptr if it is erased
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Compute a chunk of the layer after the paste
+	///
+	/// \param layer    Layer the stamp is pasted to
+	/// \param stamp    Stamp to paste
+	/// \param position Coordinates of the tile receiving the stamp's first tile
+	/// \param change   Change whose chunks are filled
+	///
+	////////////////////////////////////////////////////////////
+	static void compose(const TileLayer& layer, const TileStamp& stamp, const sf::Vector2i& position, Change& change);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Replace the chunks of the layer
+	///
+	/// \param next True to apply the chunks after the paste, false for those before
+	///
+	////////////////////////////////////////////////////////////
+	void apply(bool next);
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	Level*              m_level;   //!< Level the stamp is pasted to
+	std::size_t         m_layer;   //!< Index of the layer
+	std::vector<Change> m_changes; //!< Chunks changed by the paste
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_STAMP_COMMAND_HPP
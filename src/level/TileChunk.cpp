@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "TileChunk.hpp"
+#include <algorithm>
+#include <utility>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+TileChunk::TileChunk() :
+m_payload      (std::make_shared<Payload>()),
+m_buffer       (sf::Triangles, sf::VertexBuffer::Static),
+m_vertices     (),
+m_vertexCount  (0),
+m_builtTileset (nullptr),
+m_builtLayout  (0),
+m_geometryDirty(true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TileId TileChunk::getTile(int x, int y) const
+{
+	return this->m_payload->m_tiles[y * Size + x];
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint8 TileChunk::getFlags(int x, int y) const
+{
+	return this->m_payload->m_flags[y * Size + x];
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileChunk::setTile(int x, int y, TileId tile, sf::Uint8 flags)
+{
+	int index = y * Size + x;
+	TileId previous = this->m_payload->m_tiles[index];
+	if (previous == tile && this->m_payload->m_flags[index] == flags)
+	{
+		return false;
+	}
+
+	detach();
+	this->m_payload->m_count += (tile != Tileset::Empty) - (previous != Tileset::Empty);
+	this->m_payload->m_tiles[index] = tile;
+	this->m_payload->m_flags[index] = flags;
+	this->m_geometryDirty = true;
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileChunk::assign(const TileId* tiles, const sf::Uint8* flags)
+{
+	// Every tile is overwritten, so shared tiles are released rather than copied
+	if (isShared())
+	{
+		this->m_payload = std::make_shared<Payload>();
+	}
+
+	Payload& payload = *this->m_payload;
+	std::copy(tiles, tiles + Area, payload.m_tiles.begin());
+	std::copy(flags, flags + Area, payload.m_flags.begin());
+	payload.m_count = static_cast<int>(Area - std::count(payload.m_tiles.begin(), payload.m_tiles.end(), Tileset::Empty));
+	this->m_geometryDirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileChunk::share(const TileChunk& chunk)
+{
+	if (this->m_payload != chunk.m_payload)
+	{
+		this->m_payload = chunk.m_payload;
+		this->m_geometryDirty = true;
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileChunk::isShared() const
+{
+	return this->m_payload.use_count() > 1;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::array<TileId, TileChunk::Area>& TileChunk::getTiles() const
+{
+	return this->m_payload->m_tiles;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::array<sf::Uint8, TileChunk::Area>& TileChunk::getFlags() const
+{
+	return this->m_payload->m_flags;
+}
+
+
+////////////////////////////////////////////////////////////
+int TileChunk::getTileCount() const
+{
+	return this->m_payload->m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileChunk::isEmpty() const
+{
+	return this->m_payload->m_count == 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileChunk::draw(sf::RenderTarget& target, sf::RenderStates states, const Tileset& tileset) const
+{
+	if (this->m_payload->m_count == 0)
+	{
+		return;
+	}
+
+	if (this->m_geometryDirty || this->m_builtTileset != &tileset || this->m_builtLayout != tileset.getLayout())
+	{
+		buildGeometry(tileset);
+	}
+
+	states.texture = tileset.getTexture();
+	if (sf::VertexBuffer::isAvailable())
+	{
+		target.draw(this->m_buffer, 0, this->m_vertexCount, states);
+	}
+	else
+	{
+		target.draw(this->m_vertices.data(), this->m_vertexCount, sf::Triangles, states);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void TileChunk::buildGeometry(const Tileset& tileset) const
+{
+	sf::Vector2f tileSize = sf::Vector2f(tileset.getTileSize());
+	TileId tileCount = tileset.getTileCount();
+
+	this->m_vertices.clear();
+	this->m_vertices.reserve(static_cast<std::size_t>(this->m_payload->m_count) * 6);
+
+	for (int y = 0; y < Size; y++)
+	{
+		for (int x = 0; x < Size; x++)
+		{
+			TileId tile = this->m_payload->m_tiles[y * Size + x];
+			if (tile == Tileset::Empty || tile > tileCount)
+			{
+				continue;
+			}
+
+			sf::FloatRect rect = sf::FloatRect(tileset.getTextureRect(tile));
+			sf::Vector2f topLeft = sf::Vector2f(rect.left, rect.top);
+			sf::Vector2f topRight = sf::Vector2f(rect.left + rect.width, rect.top);
+			sf::Vector2f bottomRight = sf::Vector2f(rect.left + rect.width, rect.top + rect.height);
+			sf::Vector2f bottomLeft = sf::Vector2f(rect.left, rect.top + rect.height);
+
+			sf::Uint8 flags = this->m_payload->m_flags[y * Size + x];
+			if (flags & TileFlags::FlipDiagonal)
+			{
+				std::swap(topRight, bottomLeft);
+			}
+
+			if (flags & TileFlags::FlipHorizontal)
+			{
+				std::swap(topLeft, topRight);
+				std::swap(bottomLeft, bottomRight);
+			}
+
+			if (flags & TileFlags::FlipVertical)
+			{
+				std::swap(topLeft, bottomLeft);
+				std::swap(topRight, bottomRight);
+			}
+
+			float left = x * tileSize.x;
+			float top = y * tileSize.y;
+			float right = left + tileSize.x;
+			float bottom = top + tileSize.y;
+
+			this->m_vertices.emplace_back(sf::Vector2f(left, top), topLeft);
+			this->m_vertices.emplace_back(sf::Vector2f(right, top), topRight);
+			this->m_vertices.emplace_back(sf::Vector2f(right, bottom), bottomRight);
+			this->m_vertices.emplace_back(sf::Vector2f(left, top), topLeft);
+			this->m_vertices.emplace_back(sf::Vector2f(right, bottom), bottomRight);
+			this->m_vertices.emplace_back(sf::Vector2f(left, bottom), bottomLeft);
+		}
+	}
+
+	this->m_vertexCount = this->m_vertices.size();
+	this->m_builtTileset = &tileset;
+	this->m_builtLayout = tileset.getLayout();
+	this->m_geometryDirty = false;
+
+	if (sf::VertexBuffer::isAvailable() && this->m_vertexCount > 0)
+	{
+		// The buffer only grows, so repeated edits of the same chunk do not reallocate it
+		if (this->m_buffer.getVertexCount() < this->m_vertexCount)
+		{
+			this->m_buffer.create(this->m_vertexCount);
+		}
+
+		this->m_buffer.update(this->m_vertices.data(), this->m_vertexCount, 0);
+		this->m_vertices.clear();
+		this->m_vertices.shrink_to_fit();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void TileChunk::detach()
+{
+	if (isShared())
+	{
+		this->m_payload = std::make_shared<Payload>(*this->m_payload);
+	}
+}
+
+} //namespace le
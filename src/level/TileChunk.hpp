@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_TILE_CHUNK_HPP
+#define LEVEL_EDITOR_TILE_CHUNK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Tileset.hpp"
+#include <array>
+#include <memory>
+#include <vector>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Flags altering how a tile is displayed
+///
+////////////////////////////////////////////////////////////
+struct TileFlags
+{
+	enum : sf::Uint8
+	{
+		None           = 0,      //!< Tile is displayed as in the tileset
+		FlipHorizontal = 1 << 0, //!< Tile is mirrored horizontally
+		FlipVertical   = 1 << 1, //!< Tile is mirrored vertically
+		FlipDiagonal   = 1 << 2  //!< Tile is mirrored along its top-left to bottom-right diagonal, applied before the other flips
+	};
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Square block of tiles, the unit of storage and rendering of a tile layer
+///
+/// Tile ids and flags are kept in separate arrays, so that
+/// passes touching only ids stay dense in memory. The geometry
+/// is built lazily into a static vertex buffer and rebuilt only
+/// after the chunk has been edited. Chunks can share their tiles,
+/// which are copied only once one of the sharing chunks is edited,
+/// so copies of large regions cost no memory until they diverge.
+///
+////////////////////////////////////////////////////////////
+class TileChunk : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Amount of tiles per chunk side
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr int Size = 32;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Amount of tiles per chunk
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr int Area = Size * Size;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// This constructor creates a chunk of empty tiles
+	///
+	////////////////////////////////////////////////////////////
+	TileChunk();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a tile
+	///
+	/// \param x Column within the chunk
+	/// \param y Row within the chunk
+	///
+	////////////////////////////////////////////////////////////
+	TileId getTile(int x, int y) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the flags of a tile
+	///
+	/// \param x Column within the chunk
+	/// \param y Row within the chunk
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint8 getFlags(int x, int y) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set a tile
+	///
+	/// \param x     Column within the chunk
+	/// \param y     Row within the chunk
+	/// \param tile  Tile id
+	/// \param flags Tile flags
+	///
+	/// \return True if the tile changed
+	///
+	////////////////////////////////////////////////////////////
+	bool setTile(int x, int y, TileId tile, sf::Uint8 flags = TileFlags::None);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Replace every tile at once
+	///
+	/// \param tiles Area tile ids, row by row
+	/// \param flags Area tile flags, row by row
+	///
+	////////////////////////////////////////////////////////////
+	void assign(const TileId* tiles, const sf::Uint8* flags);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Share the tiles of another chunk
+	///
+	/// No tile is copied, the chunk that is edited first takes
+	/// its own copy. Sharing is thread-safe as long as the chunks
+	/// are only edited from one thread.
+	///
+	/// \param chunk Chunk whose tiles are shared
+	///
+	////////////////////////////////////////////////////////////
+	void share(const TileChunk& chunk);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether the tiles are shared with another chunk
+	///
+	////////////////////////////////////////////////////////////
+	bool isShared() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the dense array of tile ids, row by row
+	///
+	////////////////////////////////////////////////////////////
+	const std::array<TileId, Area>& getTiles() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the dense array of tile flags, row by row
+	///
+	////////////////////////////////////////////////////////////
+	const std::array<sf::Uint8, Area>& getFlags() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of tiles that are not empty
+	///
+	////////////////////////////////////////////////////////////
+	int getTileCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether every tile is empty
+	///
+	////////////////////////////////////////////////////////////
+	bool isEmpty() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the chunk to a render target
+	///
+	/// \param target  Render target to draw to
+	/// \param states  Render states, transform places the chunk's top-left tile
+	/// \param tileset Tileset the tile ids refer to
+	///
+	////////////////////////////////////////////////////////////
+	void draw(sf::RenderTarget& target, sf::RenderStates states, const Tileset& tileset) const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Rebuild the geometry of the chunk
+	///
+	/// \param tileset Tileset the tile ids refer to
+	///
+	////////////////////////////////////////////////////////////
+	void buildGeometry(const Tileset& tileset) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Take a copy of the tiles if they are shared, before editing them
+	///
+	////////////////////////////////////////////////////////////
+	void detach();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class holding the tiles, shared between chunks
+	///
+	////////////////////////////////////////////////////////////
+	struct Payload
+	{
+		std::array<TileId, Area>    m_tiles; //!< Tile ids, row by row
+		std::array<sf::Uint8, Area> m_flags; //!< Tile flags, row by row
+		int                         m_count; //!< Amount of tiles that are not empty
+	};
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::shared_ptr<Payload>          m_payload;       //!< Tiles, shared with the chunks they were copied to
+	mutable sf::VertexBuffer          m_buffer;        //!< Geometry uploaded to the graphics card
+	mutable std::vector<sf::Vertex>   m_vertices;      //!< Geometry kept on the CPU if vertex buffers are unavailable
+	mutable std::size_t               m_vertexCount;   //!< Amount of vertices of the current geometry
+	mutable const Tileset*            m_builtTileset;  //!< Tileset the geometry was built for
+	mutable unsigned int              m_builtLayout;   //!< Layout revision of the tileset the geometry was built for
+	mutable bool                      m_geometryDirty; //!< Geometry has to be rebuilt before drawing
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_TILE_CHUNK_HPP
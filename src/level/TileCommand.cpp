@@ -0,0 +1,311 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "TileCommand.hpp"
+#include "../utility/Varint.hpp"
+#include <algorithm>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+TileCommand::TileCommand(Level& level) :
+m_level    (&level),
+m_changes  (),
+m_packed   (),
+m_tileCount(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TileCommand::add(const Level::TileChange& change)
+{
+	const TileLayer::TileChange& tile = change.m_change;
+	for (int i = 0; i < tile.m_length; i++)
+	{
+		this->m_changes.push_back(Change{ static_cast<sf::Uint32>(change.m_layer), tile.m_position + sf::Vector2i(i, 0), tile.m_previousTile, tile.m_previousFlags, tile.m_tile, tile.m_flags });
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileCommand::finish()
+{
+	std::vector<Change> changes;
+	unpack(changes);
+	changes.insert(changes.end(), this->m_changes.begin(), this->m_changes.end());
+	pack(changes);
+
+	this->m_changes.clear();
+	this->m_changes.shrink_to_fit();
+	return this->m_tileCount > 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TileCommand::getTileCount() const
+{
+	return this->m_tileCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileCommand::undo()
+{
+	apply(true);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileCommand::redo()
+{
+	apply(false);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileCommand::merge(Command& next)
+{
+	TileCommand* other = dynamic_cast<TileCommand*>(&next);
+	if (!other || other->m_level != this->m_level)
+	{
+		return false;
+	}
+
+	std::vector<Change> changes;
+	if (!unpack(changes) || !other->unpack(changes))
+	{
+		return false;
+	}
+
+	pack(changes);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TileCommand::getMemoryUsage() const
+{
+	return sizeof(TileCommand) + this->m_changes.capacity() * sizeof(Change) + this->m_packed.capacity();
+}
+
+
+////////////////////////////////////////////////////////////
+void TileCommand::spill(std::vector<char>& data)
+{
+	data.insert(data.end(), this->m_packed.begin(), this->m_packed.end());
+	this->m_packed.clear();
+	this->m_packed.shrink_to_fit();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileCommand::restore(const char* data, std::size_t size)
+{
+	this->m_packed.assign(data, data + size);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileCommand::pack(std::vector<Change>& changes)
+{
+	// Sorting keeps the order of the changes made to a same tile, the first holds its previous state and the last its new one
+	std::stable_sort(changes.begin(), changes.end(), [](const Change& left, const Change& right)
+	{
+		if (left.m_layer != right.m_layer)
+		{
+			return left.m_layer < right.m_layer;
+		}
+
+		return left.m_position.y != right.m_position.y ? left.m_position.y < right.m_position.y : left.m_position.x < right.m_position.x;
+	});
+
+	std::vector<Change> folded;
+	folded.reserve(changes.size());
+	for (const Change& change : changes)
+	{
+		if (!folded.empty() && folded.back().m_layer == change.m_layer && folded.back().m_position == change.m_position)
+		{
+			folded.back().m_tile = change.m_tile;
+			folded.back().m_flags = change.m_flags;
+		}
+		else
+		{
+			folded.push_back(change);
+		}
+	}
+
+	folded.erase(std::remove_if(folded.begin(), folded.end(), [](const Change& change)
+	{
+		return change.m_previousTile == change.m_tile && change.m_previousFlags == change.m_flags;
+	}), folded.end());
+
+	auto writeStates = [this](const Change* begin, const Change* end, bool previous)
+	{
+		for (const Change* run = begin; run < end;)
+		{
+			TileId tile = previous ? run->m_previousTile : run->m_tile;
+			sf::Uint8 flags = previous ? run->m_previousFlags : run->m_flags;
+			const Change* next = run + 1;
+			while (next < end && (previous ? next->m_previousTile : next->m_tile) == tile && (previous ? next->m_previousFlags : next->m_flags) == flags)
+			{
+				++next;
+			}
+
+			Varint::write(this->m_packed, static_cast<sf::Uint64>(next - run));
+			this->m_packed.push_back(static_cast<char>(tile & 0xFF));
+			this->m_packed.push_back(static_cast<char>(tile >> 8));
+			this->m_packed.push_back(static_cast<char>(flags));
+			run = next;
+		}
+	};
+
+	// Rows of adjacent tiles are stored as runs placed relative to the previous one
+	this->m_packed.clear();
+	Varint::write(this->m_packed, folded.size());
+	sf::Vector2i origin(0, 0);
+	for (std::size_t i = 0; i < folded.size();)
+	{
+		const Change& first = folded[i];
+		std::size_t length = 1;
+		while (i + length < folded.size() && folded[i + length].m_layer == first.m_layer &&
+			folded[i + length].m_position == first.m_position + sf::Vector2i(static_cast<int>(length), 0))
+		{
+			length++;
+		}
+
+		Varint::write(this->m_packed, first.m_layer);
+		Varint::write(this->m_packed, Varint::toZigzag(static_cast<sf::Int64>(first.m_position.y) - origin.y));
+		Varint::write(this->m_packed, Varint::toZigzag(static_cast<sf::Int64>(first.m_position.x) - origin.x));
+		Varint::write(this->m_packed, length);
+		writeStates(&first, &first + length, true);
+		writeStates(&first, &first + length, false);
+
+		origin = first.m_position;
+		i += length;
+	}
+
+	this->m_packed.shrink_to_fit();
+	this->m_tileCount = folded.size();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileCommand::unpack(std::vector<Change>& changes) const
+{
+	const sf::Uint8* data = reinterpret_cast<const sf::Uint8*>(this->m_packed.data());
+	const sf::Uint8* end = data + this->m_packed.size();
+	sf::Uint64 count = 0;
+	if (this->m_packed.empty())
+	{
+		return this->m_tileCount == 0;
+	}
+
+	if (!Varint::read(data, end, count) || count > this->m_packed.size() * 255)
+	{
+		return false;
+	}
+
+	auto readStates = [&](std::size_t first, std::size_t length, bool previous)
+	{
+		for (std::size_t i = 0; i < length;)
+		{
+			sf::Uint64 run = 0;
+			if (!Varint::read(data, end, run) || run == 0 || run > length - i || end - data < 3)
+			{
+				return false;
+			}
+
+			TileId tile = static_cast<TileId>(data[0] | data[1] << 8);
+			sf::Uint8 flags = data[2];
+			data += 3;
+			for (std::size_t j = first + i; j < first + i + run; j++)
+			{
+				(previous ? changes[j].m_previousTile : changes[j].m_tile) = tile;
+				(previous ? changes[j].m_previousFlags : changes[j].m_flags) = flags;
+			}
+
+			i += static_cast<std::size_t>(run);
+		}
+
+		return true;
+	};
+
+	changes.reserve(changes.size() + static_cast<std::size_t>(count));
+	sf::Vector2i origin(0, 0);
+	for (sf::Uint64 unpacked = 0; unpacked < count;)
+	{
+		sf::Uint64 layer = 0, y = 0, x = 0, length = 0;
+		if (!Varint::read(data, end, layer) || !Varint::read(data, end, y) || !Varint::read(data, end, x) || !Varint::read(data, end, length) || length == 0 || length > count - unpacked)
+		{
+			return false;
+		}
+
+		origin += sf::Vector2i(static_cast<int>(Varint::fromZigzag(x)), static_cast<int>(Varint::fromZigzag(y)));
+		std::size_t first = changes.size();
+		for (sf::Uint64 i = 0; i < length; i++)
+		{
+			changes.push_back(Change{ static_cast<sf::Uint32>(layer), origin + sf::Vector2i(static_cast<int>(i), 0), 0, 0, 0, 0 });
+		}
+
+		if (!readStates(first, static_cast<std::size_t>(length), true) || !readStates(first, static_cast<std::size_t>(length), false))
+		{
+			return false;
+		}
+
+		unpacked += length;
+	}
+
+	return data == end;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileCommand::apply(bool previous)
+{
+	std::vector<Change> changes;
+	if (!unpack(changes))
+	{
+		printf("Failed to unpack tile changes\n");
+		return;
+	}
+
+	for (const Change& change : changes)
+	{
+		if (change.m_layer < this->m_level->getLayerCount())
+		{
+			TileLayer& layer = this->m_level->getLayer(change.m_layer);
+			layer.setTile(change.m_position.x, change.m_position.y, previous ? change.m_previousTile : change.m_tile, previous ? change.m_previousFlags : change.m_flags);
+		}
+	}
+}
+
+} //namespace le
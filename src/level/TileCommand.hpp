@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_TILE_COMMAND_HPP
+#define LEVEL_EDITOR_TILE_COMMAND_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Level.hpp"
+#include "../utility/Command.hpp"
+#include <vector>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Command reverting and reapplying tile changes of a level
+///
+/// Changes are gathered while the edit is made, typically from
+/// the level's tile changed event, then packed into horizontal
+/// runs whose previous and new tiles are run-length encoded. A
+/// flood fill over thousands of tiles costs a few bytes per row.
+///
+////////////////////////////////////////////////////////////
+class TileCommand : public Command
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param level Level the changes are made to
+	///
+	////////////////////////////////////////////////////////////
+	explicit TileCommand(Level& level);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a change made by the edit
+	///
+	/// \param change Change to add
+	///
+	////////////////////////////////////////////////////////////
+	void add(const Level::TileChange& change);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Pack the added changes, to be called before pushing the command
+	///
+	/// \return False if the edit did not change any tile in the end
+	///
+	////////////////////////////////////////////////////////////
+	bool finish();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of tiles changed by the command
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getTileCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Restore the previous state of the changed tiles
+	///
+	////////////////////////////////////////////////////////////
+	virtual void undo() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the changed tiles to their new state again
+	///
+	////////////////////////////////////////////////////////////
+	virtual void redo() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Absorb the changes of a following tile command of the same level
+	///
+	/// \param next Command following this one
+	///
+	/// \return True if the changes were absorbed
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool merge(Command& next) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of memory held by the command in bytes
+	///
+	////////////////////////////////////////////////////////////
+	virtual std::size_t getMemoryUsage() const override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move the packed changes out of memory
+	///
+	/// \param data Buffer the changes are appended to
+	///
+	////////////////////////////////////////////////////////////
+	virtual void spill(std::vector<char>& data) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Restore the packed changes
+	///
+	/// \param data Data returned by spill
+	/// \param size Size of the data in bytes
+	///
+	/// \return True if the changes were restored
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool restore(const char* data, std::size_t size) override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class describing a change while it is unpacked
+	///
+	////////////////////////////////////////////////////////////
+	struct Change
+	{
+		sf::Uint32   m_layer;         //!< Index of the layer
+		sf::Vector2i m_position;      //!< Coordinates of the tile
+		TileId       m_previousTile;  //!< Tile id before the change
+		sf::Uint8    m_previousFlags; //!< Tile flags before the change
+		TileId       m_tile;          //!< Tile id after the change
+		sf::Uint8    m_flags;         //!< Tile flags after the change
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Pack changes, replacing the packed ones
+	///
+	/// Repeated changes of a tile are folded into one, changes
+	/// that restored the previous state are dropped.
+	///
+	/// \param changes Changes in the order they were made, sorted by the function
+	///
+	////////////////////////////////////////////////////////////
+	void pack(std::vector<Change>& changes);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Unpack the packed changes
+	///
+	/// \param changes Vector the changes are appended to
+	///
+	/// \return False if the packed data is malformed
+	///
+	////////////////////////////////////////////////////////////
+	bool unpack(std::vector<Change>& changes) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set every changed tile to one of its states
+	///
+	/// \param previous True for the state before the change
+	///
+	////////////////////////////////////////////////////////////
+	void apply(bool previous);
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	Level*              m_level;     //!< Level the changes are made to
+	std::vector<Change> m_changes;   //!< Changes added since the command was finished
+	std::vector<char>   m_packed;    //!< Packed changes
+	std::size_t         m_tileCount; //!< Amount of packed changes
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_TILE_COMMAND_HPP
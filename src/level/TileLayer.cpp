@@ -0,0 +1,681 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "TileLayer.hpp"
+#include "../utility/FrameScheduler.hpp"
+#include "../utility/JobSystem.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static int floorDiv(int value, int divisor)
+{
+	return value / divisor - (value % divisor < 0);
+}
+
+
+////////////////////////////////////////////////////////////
+static int floorMod(int value, int divisor)
+{
+	return value - floorDiv(value, divisor) * divisor;
+}
+
+
+////////////////////////////////////////////////////////////
+TileLayer::TileLayer(const Tileset& tileset) :
+m_tileset          (&tileset),
+m_visible          (true),
+m_chunks           (),
+m_modified         (),
+m_source           (nullptr),
+m_sourceLayer      (0),
+m_impostorThreshold(1.f),
+m_impostors        (),
+m_onTileChanged    ([](TileLayer&, const TileChange&) {}),
+m_onChunkLoaded    ([](const TileLayer&, const sf::Vector2i&) {})
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const Tileset& TileLayer::getTileset() const
+{
+	return *this->m_tileset;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::setTileset(const Tileset& tileset)
+{
+	this->m_tileset = &tileset;
+	evictImpostors();
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::setVisible(bool visible)
+{
+	this->m_visible = visible;
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileLayer::isVisible() const
+{
+	return this->m_visible;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::setImpostorThreshold(float pixelsPerTile)
+{
+	this->m_impostorThreshold = pixelsPerTile;
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::evictImpostors()
+{
+	this->m_impostors.reset();
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::setOnTileChanged(Event1<TileLayer, const TileChange&> onTileChanged)
+{
+	this->m_onTileChanged = std::move(onTileChanged);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::setOnChunkLoaded(Event1<const TileLayer, const sf::Vector2i&> onChunkLoaded)
+{
+	this->m_onChunkLoaded = std::move(onChunkLoaded);
+}
+
+
+////////////////////////////////////////////////////////////
+TileId TileLayer::getTile(int x, int y) const
+{
+	sf::Vector2i coords = getChunkCoords(sf::Vector2i(x, y));
+	const TileChunk* chunk = getChunk(coords.x, coords.y);
+	return chunk ? chunk->getTile(floorMod(x, TileChunk::Size), floorMod(y, TileChunk::Size)) : Tileset::Empty;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint8 TileLayer::getFlags(int x, int y) const
+{
+	sf::Vector2i coords = getChunkCoords(sf::Vector2i(x, y));
+	const TileChunk* chunk = getChunk(coords.x, coords.y);
+	return chunk ? chunk->getFlags(floorMod(x, TileChunk::Size), floorMod(y, TileChunk::Size)) : sf::Uint8(TileFlags::None);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileLayer::setTile(int x, int y, TileId tile, sf::Uint8 flags)
+{
+	sf::Vector2i coords = getChunkCoords(sf::Vector2i(x, y));
+	std::unique_ptr<TileChunk>* chunk = this->m_chunks.find(coords);
+	if (!chunk)
+	{
+		if (tile == Tileset::Empty)
+		{
+			return false;
+		}
+
+		chunk = &this->m_chunks[coords];
+		*chunk = std::make_unique<TileChunk>();
+	}
+	else if (!*chunk)
+	{
+		loadChunk(coords, *chunk);
+	}
+
+	sf::Vector2i local(floorMod(x, TileChunk::Size), floorMod(y, TileChunk::Size));
+	TileChange change = { sf::Vector2i(x, y), (*chunk)->getTile(local.x, local.y), (*chunk)->getFlags(local.x, local.y), tile, flags, 1 };
+	bool changed = (*chunk)->setTile(local.x, local.y, tile, flags);
+	if (changed)
+	{
+		if ((*chunk)->isEmpty())
+		{
+			this->m_chunks.erase(coords);
+		}
+
+		this->m_modified[coords] = true;
+		if (this->m_impostors)
+		{
+			this->m_impostors->invalidate(coords);
+		}
+
+		FrameScheduler::getDefault().invalidate();
+		this->m_onTileChanged(*this, change);
+	}
+
+	return changed;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TileLayer::fillSpan(const Span& span, TileId tile, sf::Uint8 flags)
+{
+	std::size_t changed = 0;
+	std::vector<TileChange> runs;
+	for (int x = span.m_left; x < span.m_right;)
+	{
+		sf::Vector2i coords = getChunkCoords(sf::Vector2i(x, span.m_y));
+		int end = std::min(span.m_right, (coords.x + 1) * TileChunk::Size);
+		std::unique_ptr<TileChunk>* chunk = this->m_chunks.find(coords);
+		if (!chunk)
+		{
+			if (tile == Tileset::Empty)
+			{
+				x = end;
+				continue;
+			}
+
+			chunk = &this->m_chunks[coords];
+			*chunk = std::make_unique<TileChunk>();
+		}
+		else if (!*chunk)
+		{
+			loadChunk(coords, *chunk);
+		}
+
+		// Changes are gathered first, the event must not see a chunk that is about to be erased
+		runs.clear();
+		int row = floorMod(span.m_y, TileChunk::Size);
+		for (; x < end; x++)
+		{
+			int column = floorMod(x, TileChunk::Size);
+			TileId previousTile = (*chunk)->getTile(column, row);
+			sf::Uint8 previousFlags = (*chunk)->getFlags(column, row);
+			if (!(*chunk)->setTile(column, row, tile, flags))
+			{
+				continue;
+			}
+
+			TileChange* run = runs.empty() ? nullptr : &runs.back();
+			if (run && run->m_position.x + run->m_length == x && run->m_previousTile == previousTile && run->m_previousFlags == previousFlags)
+			{
+				run->m_length++;
+			}
+			else
+			{
+				runs.push_back(TileChange{ sf::Vector2i(x, span.m_y), previousTile, previousFlags, tile, flags, 1 });
+			}
+		}
+
+		if (runs.empty())
+		{
+			continue;
+		}
+
+		if ((*chunk)->isEmpty())
+		{
+			this->m_chunks.erase(coords);
+		}
+
+		this->m_modified[coords] = true;
+		if (this->m_impostors)
+		{
+			this->m_impostors->invalidate(coords);
+		}
+
+		for (const TileChange& run : runs)
+		{
+			changed += static_cast<std::size_t>(run.m_length);
+			this->m_onTileChanged(*this, run);
+		}
+	}
+
+	if (changed > 0)
+	{
+		FrameScheduler::getDefault().invalidate();
+	}
+
+	return changed;
+}
+
+
+////////////////////////////////////////////////////////////
+const TileChunk* TileLayer::getChunk(int x, int y) const
+{
+	sf::Vector2i key(x, y);
+	std::unique_ptr<TileChunk>* chunk = this->m_chunks.find(key);
+	if (!chunk)
+	{
+		return nullptr;
+	}
+
+	if (!*chunk)
+	{
+		loadChunk(key, *chunk);
+	}
+
+	return (*chunk)->isEmpty() ? nullptr : chunk->get();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TileLayer::setChunk(const sf::Vector2i& coords, const TileChunk* chunk)
+{
+	std::unique_ptr<TileChunk>* current = this->m_chunks.find(coords);
+	if (current && !*current)
+	{
+		loadChunk(coords, *current);
+	}
+
+	const TileChunk* previous = current ? current->get() : nullptr;
+	previous = previous && !previous->isEmpty() ? previous : nullptr;
+	chunk = chunk && !chunk->isEmpty() ? chunk : nullptr;
+	if (!previous && !chunk)
+	{
+		return 0;
+	}
+
+	if (previous && chunk && previous->getTiles().data() == chunk->getTiles().data())
+	{
+		return 0;
+	}
+
+	// Changes are gathered first, the event must not see the chunk that is replaced
+	std::vector<TileChange> runs;
+	sf::Vector2i origin = coords * TileChunk::Size;
+	for (int y = 0; y < TileChunk::Size; y++)
+	{
+		for (int x = 0; x < TileChunk::Size; x++)
+		{
+			TileId previousTile = previous ? previous->getTile(x, y) : Tileset::Empty;
+			sf::Uint8 previousFlags = previous ? previous->getFlags(x, y) : sf::Uint8(TileFlags::None);
+			TileId tile = chunk ? chunk->getTile(x, y) : Tileset::Empty;
+			sf::Uint8 flags = chunk ? chunk->getFlags(x, y) : sf::Uint8(TileFlags::None);
+			if (previousTile == tile && previousFlags == flags)
+			{
+				continue;
+			}
+
+			TileChange* run = runs.empty() ? nullptr : &runs.back();
+			if (run && run->m_position.y == origin.y + y && run->m_position.x + run->m_length == origin.x + x &&
+				run->m_previousTile == previousTile && run->m_previousFlags == previousFlags && run->m_tile == tile && run->m_flags == flags)
+			{
+				run->m_length++;
+			}
+			else
+			{
+				runs.push_back(TileChange{ origin + sf::Vector2i(x, y), previousTile, previousFlags, tile, flags, 1 });
+			}
+		}
+	}
+
+	if (runs.empty())
+	{
+		return 0;
+	}
+
+	if (chunk)
+	{
+		std::unique_ptr<TileChunk>& slot = this->m_chunks[coords];
+		if (!slot)
+		{
+			slot = std::make_unique<TileChunk>();
+		}
+
+		slot->share(*chunk);
+	}
+	else
+	{
+		this->m_chunks.erase(coords);
+	}
+
+	this->m_modified[coords] = true;
+	if (this->m_impostors)
+	{
+		this->m_impostors->invalidate(coords);
+	}
+
+	FrameScheduler::getDefault().invalidate();
+
+	std::size_t changed = 0;
+	for (const TileChange& run : runs)
+	{
+		changed += static_cast<std::size_t>(run.m_length);
+		this->m_onTileChanged(*this, run);
+	}
+
+	return changed;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::share(const TileLayer& layer)
+{
+	if (&layer == this)
+	{
+		return;
+	}
+
+	// Chunks the other layer has not loaded stay unloaded here too and come from the same source
+	this->m_chunks.clear();
+	this->m_source = layer.m_source;
+	this->m_sourceLayer = layer.m_sourceLayer;
+	for (const ChunkEntry& entry : layer.getChunks())
+	{
+		std::unique_ptr<TileChunk>& chunk = this->m_chunks[entry.m_key];
+		if (entry.m_value)
+		{
+			chunk = std::make_unique<TileChunk>();
+			chunk->share(*entry.m_value);
+		}
+	}
+
+	this->m_impostors.reset();
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileLayer::isChunkLoaded(int x, int y) const
+{
+	const std::unique_ptr<TileChunk>* chunk = this->m_chunks.find(sf::Vector2i(x, y));
+	return chunk && *chunk;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileLayer::hasChunk(int x, int y) const
+{
+	return this->m_chunks.find(sf::Vector2i(x, y)) != nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::loadChunks(const sf::IntRect& range) const
+{
+	if (!this->m_source)
+	{
+		return;
+	}
+
+	// Chunks are created here, their vertex buffers must not be constructed by the workers
+	std::vector<std::pair<sf::Vector2i, TileChunk*>> pending;
+	auto addPending = [&](const sf::Vector2i& key, std::unique_ptr<TileChunk>& chunk)
+	{
+		if (!chunk && range.contains(key))
+		{
+			chunk = std::make_unique<TileChunk>();
+			pending.emplace_back(key, chunk.get());
+		}
+	};
+
+	long long cells = static_cast<long long>(range.width) * range.height;
+	if (cells > static_cast<long long>(this->m_chunks.getSize()))
+	{
+		for (ChunkEntry& entry : this->m_chunks.getEntries())
+		{
+			addPending(entry.m_key, entry.m_value);
+		}
+	}
+	else
+	{
+		for (int y = range.top; y < range.top + range.height; y++)
+		{
+			for (int x = range.left; x < range.left + range.width; x++)
+			{
+				if (std::unique_ptr<TileChunk>* chunk = this->m_chunks.find(sf::Vector2i(x, y)))
+				{
+					addPending(sf::Vector2i(x, y), *chunk);
+				}
+			}
+		}
+	}
+
+	JobSystem::getDefault().parallelFor(pending.size(), [&](std::size_t i)
+	{
+		const sf::Vector2i& key = pending[i].first;
+		if (!this->m_source->loadChunk(this->m_sourceLayer, key, *pending[i].second))
+		{
+			printf("Failed to load chunk %d, %d\n", key.x, key.y);
+		}
+	});
+
+	// The event is raised once every chunk is filled, on the calling thread
+	for (const std::pair<sf::Vector2i, TileChunk*>& chunk : pending)
+	{
+		this->m_onChunkLoaded(*this, chunk.first);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TileLayer::getChunkCount() const
+{
+	return this->m_chunks.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<TileLayer::ChunkEntry>& TileLayer::getChunks() const
+{
+	return this->m_chunks.getEntries();
+}
+
+
+////////////////////////////////////////////////////////////
+sf::IntRect TileLayer::getChunkBounds() const
+{
+	const std::vector<ChunkEntry>& chunks = getChunks();
+	if (chunks.empty())
+	{
+		return sf::IntRect();
+	}
+
+	// Entries are sorted by row, so only the columns have to be searched
+	int left = chunks.front().m_key.x;
+	int right = left;
+	for (const ChunkEntry& entry : chunks)
+	{
+		left = std::min(left, entry.m_key.x);
+		right = std::max(right, entry.m_key.x);
+	}
+
+	int top = chunks.front().m_key.y;
+	int bottom = chunks.back().m_key.y;
+	return sf::IntRect(left, top, right - left + 1, bottom - top + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::setSource(const ChunkSource* source, std::size_t layer)
+{
+	this->m_source = source;
+	this->m_sourceLayer = layer;
+}
+
+
+////////////////////////////////////////////////////////////
+const ChunkSource* TileLayer::getSource() const
+{
+	return this->m_source;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TileLayer::getSourceLayer() const
+{
+	return this->m_sourceLayer;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::addSourceChunk(const sf::Vector2i& chunk)
+{
+	this->m_chunks[chunk].reset();
+	if (this->m_impostors)
+	{
+		this->m_impostors->invalidate(chunk);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<CoordMap<bool>::Entry>& TileLayer::getModifiedChunks() const
+{
+	return this->m_modified.getEntries();
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::clearModified()
+{
+	this->m_modified.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Vector2i TileLayer::getChunkCoords(const sf::Vector2i& tile)
+{
+	return sf::Vector2i(floorDiv(tile.x, TileChunk::Size), floorDiv(tile.y, TileChunk::Size));
+}
+
+
+////////////////////////////////////////////////////////////
+sf::IntRect TileLayer::getVisibleChunks(const sf::RenderTarget& target, const sf::Transform& transform) const
+{
+	// Bounding box of the whole view in layer space, which also covers rotated views and layers
+	sf::FloatRect world = target.getView().getInverseTransform().transformRect(sf::FloatRect(-1.f, -1.f, 2.f, 2.f));
+	sf::FloatRect local = (transform * getTransform()).getInverse().transformRect(world);
+
+	sf::Vector2f chunkSize = sf::Vector2f(this->m_tileset->getTileSize()) * static_cast<float>(TileChunk::Size);
+	int left = static_cast<int>(std::floor(local.left / chunkSize.x));
+	int top = static_cast<int>(std::floor(local.top / chunkSize.y));
+	int right = static_cast<int>(std::floor((local.left + local.width) / chunkSize.x)) + 1;
+	int bottom = static_cast<int>(std::floor((local.top + local.height) / chunkSize.y)) + 1;
+
+	return sf::IntRect(left, top, right - left, bottom - top);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	if (!this->m_visible || this->m_chunks.isEmpty())
+	{
+		return;
+	}
+
+	sf::IntRect visible = getVisibleChunks(target, states.transform);
+	states.transform *= getTransform();
+
+	float pixelsPerTile = getPixelsPerTile(target, states.transform);
+	if (pixelsPerTile < this->m_impostorThreshold)
+	{
+		if (!this->m_impostors)
+		{
+			this->m_impostors = std::make_unique<ImpostorCache>(*this);
+		}
+
+		this->m_impostors->draw(target, states, visible, ImpostorCache::getLevel(pixelsPerTile));
+		return;
+	}
+
+	loadChunks(visible);
+	sf::Vector2f chunkSize = sf::Vector2f(this->m_tileset->getTileSize()) * static_cast<float>(TileChunk::Size);
+	auto drawChunk = [&](const TileChunk& chunk, int x, int y)
+	{
+		sf::RenderStates chunkStates = states;
+		chunkStates.transform.translate(x * chunkSize.x, y * chunkSize.y);
+		chunk.draw(target, chunkStates, *this->m_tileset);
+	};
+
+	// Looking up every visible coordinate is cheaper until the view covers more cells than there are chunks
+	long long cells = static_cast<long long>(visible.width) * visible.height;
+	if (cells > static_cast<long long>(this->m_chunks.getSize()))
+	{
+		for (const ChunkEntry& entry : getChunks())
+		{
+			const TileChunk* chunk = visible.contains(entry.m_key) ? getChunk(entry.m_key.x, entry.m_key.y) : nullptr;
+			if (chunk)
+			{
+				drawChunk(*chunk, entry.m_key.x, entry.m_key.y);
+			}
+		}
+	}
+	else
+	{
+		for (int y = visible.top; y < visible.top + visible.height; y++)
+		{
+			for (int x = visible.left; x < visible.left + visible.width; x++)
+			{
+				if (const TileChunk* chunk = getChunk(x, y))
+				{
+					drawChunk(*chunk, x, y);
+				}
+			}
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+float TileLayer::getPixelsPerTile(const sf::RenderTarget& target, const sf::Transform& transform) const
+{
+	const sf::View& view = target.getView();
+	sf::IntRect viewport = target.getViewport(view);
+	if (viewport.width == 0 || view.getSize().x == 0.f)
+	{
+		return 0.f;
+	}
+
+	// Length of a tile's edge in view units, which also accounts for scaled and rotated layers
+	sf::Vector2f edge = transform.transformPoint(static_cast<float>(this->m_tileset->getTileSize().x), 0.f) - transform.transformPoint(0.f, 0.f);
+	float viewUnits = std::sqrt(edge.x * edge.x + edge.y * edge.y);
+	return viewUnits * viewport.width / std::abs(view.getSize().x);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileLayer::loadChunk(const sf::Vector2i& key, std::unique_ptr<TileChunk>& chunk) const
+{
+	chunk = std::make_unique<TileChunk>();
+	if (!this->m_source || !this->m_source->loadChunk(this->m_sourceLayer, key, *chunk))
+	{
+		printf("Failed to load chunk %d, %d\n", key.x, key.y);
+	}
+
+	this->m_onChunkLoaded(*this, key);
+}
+
+} //namespace le
@@ -0,0 +1,423 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_TILE_LAYER_HPP
+#define LEVEL_EDITOR_TILE_LAYER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "ChunkSource.hpp"
+#include "ImpostorCache.hpp"
+#include "TileChunk.hpp"
+#include "../utility/Config.hpp"
+#include "../utility/CoordMap.hpp"
+#include <memory>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Unbounded grid of tiles stored as sparse chunks
+///
+/// Only chunks containing at least one tile exist, a chunk is
+/// released as soon as its last tile is erased, so memory scales
+/// with the content rather than with the extent of the layer.
+/// Drawing costs only the chunks overlapping the target's view,
+/// editing a tile rebuilds only the geometry of its chunk. Once
+/// tiles shrink below a threshold on screen, the layer is drawn
+/// from low resolution impostors instead of its chunks. A layer
+/// attached to a ChunkSource loads its chunks on first access.
+///
+////////////////////////////////////////////////////////////
+class TileLayer : public sf::Drawable, public sf::Transformable, sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Chunk paired with its coordinates, the chunk is nullptr
+	///        while it has not been loaded from the layer's source
+	///
+	////////////////////////////////////////////////////////////
+	using ChunkEntry = CoordMap<std::unique_ptr<TileChunk>>::Entry;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class describing how a run of tiles changed
+	///
+	/// Every tile of the run had the same previous state and
+	/// received the same new state.
+	///
+	////////////////////////////////////////////////////////////
+	struct TileChange
+	{
+		sf::Vector2i m_position;      //!< Coordinates of the first tile of the run
+		TileId       m_previousTile;  //!< Tile id before the change
+		sf::Uint8    m_previousFlags; //!< Tile flags before the change
+		TileId       m_tile;          //!< Tile id, Tileset::Empty if the tiles were erased
+		sf::Uint8    m_flags;         //!< Tile flags
+		int          m_length;        //!< Amount of tiles of the row changed, starting at m_position
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class describing a horizontal run of tiles
+	///
+	////////////////////////////////////////////////////////////
+	struct Span
+	{
+		int m_y;     //!< Row of the tiles
+		int m_left;  //!< Column of the first tile
+		int m_right; //!< Column following the last tile
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param tileset Tileset the tile ids refer to
+	///
+	////////////////////////////////////////////////////////////
+	explicit TileLayer(const Tileset& tileset);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the tileset the tile ids refer to
+	///
+	////////////////////////////////////////////////////////////
+	const Tileset& getTileset() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Change the tileset the tile ids refer to
+	///
+	/// The tile ids are kept and the impostors are released. Also
+	/// called after the texture of the tileset changed, the chunks
+	/// only rebuild their geometry if the tiles moved.
+	///
+	/// \param tileset Tileset the tile ids refer to
+	///
+	////////////////////////////////////////////////////////////
+	void setTileset(const Tileset& tileset);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Show or hide the layer
+	///
+	/// \param visible Visible
+	///
+	////////////////////////////////////////////////////////////
+	void setVisible(bool visible);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether the layer is visible
+	///
+	////////////////////////////////////////////////////////////
+	bool isVisible() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the size of a tile on screen below which impostors are drawn
+	///
+	/// \param pixelsPerTile Threshold in pixels, 0 disables impostors
+	///
+	////////////////////////////////////////////////////////////
+	void setImpostorThreshold(float pixelsPerTile);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Release the impostors, they are recreated when zoomed out again
+	///
+	////////////////////////////////////////////////////////////
+	void evictImpostors();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the function raised whenever a tile changes
+	///
+	/// \param onTileChanged Event receiving the previous and the new state of the tiles
+	///
+	////////////////////////////////////////////////////////////
+	void setOnTileChanged(Event1<TileLayer, const TileChange&> onTileChanged);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the function raised whenever a chunk is loaded from the source
+	///
+	/// Raised once the tiles of the chunk are set, loading does not
+	/// raise the tile changed event.
+	///
+	/// \param onChunkLoaded Event receiving the coordinates of the chunk
+	///
+	////////////////////////////////////////////////////////////
+	void setOnChunkLoaded(Event1<const TileLayer, const sf::Vector2i&> onChunkLoaded);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a tile
+	///
+	/// \param x Column of the tile
+	/// \param y Row of the tile
+	///
+	/// \return Tile id, Tileset::Empty where no tile was set
+	///
+	////////////////////////////////////////////////////////////
+	TileId getTile(int x, int y) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the flags of a tile
+	///
+	/// \param x Column of the tile
+	/// \param y Row of the tile
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint8 getFlags(int x, int y) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set a tile
+	///
+	/// \param x     Column of the tile
+	/// \param y     Row of the tile
+	/// \param tile  Tile id, Tileset::Empty erases the tile
+	/// \param flags Tile flags
+	///
+	/// \return True if the tile changed
+	///
+	////////////////////////////////////////////////////////////
+	bool setTile(int x, int y, TileId tile, sf::Uint8 flags = TileFlags::None);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set every tile of a span
+	///
+	/// Works a chunk at a time, which is much faster than setting
+	/// the tiles one by one. The tile changed event is raised once
+	/// per run of tiles sharing their previous state.
+	///
+	/// \param span  Tiles to set
+	/// \param tile  Tile id, Tileset::Empty erases the tiles
+	/// \param flags Tile flags
+	///
+	/// \return Amount of tiles that changed
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t fillSpan(const Span& span, TileId tile, sf::Uint8 flags = TileFlags::None);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a chunk
+	///
+	/// \param x Column of the chunk
+	/// \param y Row of the chunk
+	///
+	/// \return The chunk, or nullptr if no tile was set within it
+	///
+	////////////////////////////////////////////////////////////
+	const TileChunk* getChunk(int x, int y) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Replace every tile of a chunk by those of another chunk
+	///
+	/// The tiles are shared rather than copied, see TileChunk::share.
+	/// The tile changed event is raised once per run of tiles that
+	/// changed, as with fillSpan.
+	///
+	/// \param coords Coordinates of the chunk
+	/// \param chunk  Chunk whose tiles are shared, nullptr erases the chunk
+	///
+	/// \return Amount of tiles that changed
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t setChunk(const sf::Vector2i& coords, const TileChunk* chunk);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Replace the tiles of the layer by those of another layer
+	///
+	/// Meant for duplicating a layer, the tiles are shared rather
+	/// than copied and the chunks the other layer has not loaded
+	/// yet are loaded from its source. Like loading, this does not
+	/// raise the tile changed event.
+	///
+	/// \param layer Layer whose tiles are shared
+	///
+	////////////////////////////////////////////////////////////
+	void share(const TileLayer& layer);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a chunk is held in memory
+	///
+	/// \param x Column of the chunk
+	/// \param y Row of the chunk
+	///
+	////////////////////////////////////////////////////////////
+	bool isChunkLoaded(int x, int y) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a chunk exists, held in memory or not
+	///
+	/// Unlike getChunk, this never loads the chunk.
+	///
+	/// \param x Column of the chunk
+	/// \param y Row of the chunk
+	///
+	////////////////////////////////////////////////////////////
+	bool hasChunk(int x, int y) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Load every chunk of a range that is not held in memory
+	///
+	/// The chunks are decoded in parallel on the job system,
+	/// which is faster than loading them one by one on access.
+	///
+	/// \param range Chunk coordinates and amount of chunks to load
+	///
+	////////////////////////////////////////////////////////////
+	void loadChunks(const sf::IntRect& range) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of existing chunks
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getChunkCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get every existing chunk, sorted by row and then by column
+	///
+	////////////////////////////////////////////////////////////
+	const std::vector<ChunkEntry>& getChunks() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the range of existing chunks
+	///
+	/// \return Chunk coordinates and amount of chunks, empty if the layer is empty
+	///
+	////////////////////////////////////////////////////////////
+	sf::IntRect getChunkBounds() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Attach the layer to the storage its chunks are loaded from
+	///
+	/// The source must outlive the layer or be replaced.
+	///
+	/// \param source Source, nullptr to detach the layer
+	/// \param layer  Index of the layer within the source
+	///
+	////////////////////////////////////////////////////////////
+	void setSource(const ChunkSource* source, std::size_t layer);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the storage the chunks are loaded from
+	///
+	////////////////////////////////////////////////////////////
+	const ChunkSource* getSource() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the index of the layer within its source
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getSourceLayer() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Declare a chunk held by the source without loading it
+	///
+	/// \param chunk Coordinates of the chunk
+	///
+	////////////////////////////////////////////////////////////
+	void addSourceChunk(const sf::Vector2i& chunk);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the chunks edited since the modifications were last cleared
+	///
+	/// Erased chunks are included, they no longer exist in the layer.
+	///
+	////////////////////////////////////////////////////////////
+	const std::vector<CoordMap<bool>::Entry>& getModifiedChunks() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Forget the edited chunks, typically once they were saved
+	///
+	////////////////////////////////////////////////////////////
+	void clearModified();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the chunk containing a tile
+	///
+	/// \param tile Coordinates of the tile
+	///
+	////////////////////////////////////////////////////////////
+	static sf::Vector2i getChunkCoords(const sf::Vector2i& tile);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the range of chunks overlapping a view
+	///
+	/// \param target    Render target the view belongs to
+	/// \param transform Parent transform of the layer
+	///
+	/// \return Chunk coordinates and amount of chunks
+	///
+	////////////////////////////////////////////////////////////
+	sf::IntRect getVisibleChunks(const sf::RenderTarget& target, const sf::Transform& transform) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the visible chunks of the layer
+	///
+	/// \param target Render target to draw to
+	/// \param states Current render states
+	///
+	////////////////////////////////////////////////////////////
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the size of a tile on screen
+	///
+	/// \param target    Render target the layer is drawn to
+	/// \param transform Combined transform of the layer
+	///
+	////////////////////////////////////////////////////////////
+	float getPixelsPerTile(const sf::RenderTarget& target, const sf::Transform& transform) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Load a chunk from the source
+	///
+	/// An empty chunk is kept if loading fails, so that the chunk
+	/// is not requested again.
+	///
+	/// \param key   Coordinates of the chunk
+	/// \param chunk Slot of the chunk to fill
+	///
+	////////////////////////////////////////////////////////////
+	void loadChunk(const sf::Vector2i& key, std::unique_ptr<TileChunk>& chunk) const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	const Tileset*                               m_tileset;           //!< Tileset the tile ids refer to
+	bool                                         m_visible;           //!< Layer is drawn
+	mutable CoordMap<std::unique_ptr<TileChunk>> m_chunks;            //!< Existing chunks by their coordinates, loaded on first access
+	CoordMap<bool>                               m_modified;          //!< Chunks edited since the modifications were last cleared
+	const ChunkSource*                           m_source;            //!< Storage the chunks are loaded from
+	std::size_t                                  m_sourceLayer;       //!< Index of the layer within its source
+	float                                        m_impostorThreshold; //!< Size of a tile on screen below which impostors are drawn
+	mutable std::unique_ptr<ImpostorCache>       m_impostors;         //!< Impostors, created the first time the layer is drawn zoomed out
+	Event1<TileLayer, const TileChange&>         m_onTileChanged;     //!< Event raised whenever a tile changes
+	Event1<const TileLayer, const sf::Vector2i&> m_onChunkLoaded;     //!< Event raised whenever a chunk is loaded from the source
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_TILE_LAYER_HPP
@@ -0,0 +1,278 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "TileStamp.hpp"
+#include "ChunkCodec.hpp"
+#include "../utility/Base64.hpp"
+#include "../utility/Varint.hpp"
+#include <algorithm>
+
+
+namespace le
+{
+static const std::string Prefix   = "level-editor-tiles:"; //!< Start of the text form, tells stamps apart from other clipboard content
+static const int         MaxSide  = 1 << 20;              //!< Amount of tiles per side above which a decoded stamp is rejected
+
+
+////////////////////////////////////////////////////////////
+TileStamp::TileStamp() :
+m_size  (0, 0),
+m_offset(0, 0),
+m_chunks()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TileStamp::capture(const TileLayer& layer, const sf::IntRect& tiles)
+{
+	this->m_chunks.clear();
+	this->m_size = sf::Vector2i(std::max(tiles.width, 0), std::max(tiles.height, 0));
+	sf::Vector2i first = TileLayer::getChunkCoords(tiles.getPosition());
+	this->m_offset = tiles.getPosition() - first * TileChunk::Size;
+	if (isEmpty())
+	{
+		return;
+	}
+
+	sf::Vector2i last = TileLayer::getChunkCoords(tiles.getPosition() + this->m_size - sf::Vector2i(1, 1));
+	sf::IntRect range(first, last - first + sf::Vector2i(1, 1));
+	layer.loadChunks(range);
+
+	std::array<TileId, TileChunk::Area> maskedTiles;
+	std::array<sf::Uint8, TileChunk::Area> maskedFlags;
+	auto addChunk = [&](const sf::Vector2i& coords, const TileChunk& chunk)
+	{
+		sf::Vector2i key = coords - first;
+		if (isChunkCovered(key.x, key.y))
+		{
+			std::unique_ptr<TileChunk>& copy = this->m_chunks[key];
+			copy = std::make_unique<TileChunk>();
+			copy->share(chunk);
+			return;
+		}
+
+		// Border chunks are copied without the tiles lying outside of the rectangle
+		maskedTiles.fill(Tileset::Empty);
+		maskedFlags.fill(TileFlags::None);
+		sf::Vector2i origin = coords * TileChunk::Size;
+		int left = std::max(tiles.left - origin.x, 0);
+		int right = std::min(tiles.left + tiles.width - origin.x, TileChunk::Size);
+		int top = std::max(tiles.top - origin.y, 0);
+		int bottom = std::min(tiles.top + tiles.height - origin.y, TileChunk::Size);
+		bool empty = true;
+		for (int y = top; y < bottom; y++)
+		{
+			int row = y * TileChunk::Size;
+			std::copy(chunk.getTiles().begin() + row + left, chunk.getTiles().begin() + row + right, maskedTiles.begin() + row + left);
+			std::copy(chunk.getFlags().begin() + row + left, chunk.getFlags().begin() + row + right, maskedFlags.begin() + row + left);
+			empty = empty && std::all_of(maskedTiles.begin() + row + left, maskedTiles.begin() + row + right, [](TileId tile) { return tile == Tileset::Empty; });
+		}
+
+		if (!empty)
+		{
+			std::unique_ptr<TileChunk>& copy = this->m_chunks[key];
+			copy = std::make_unique<TileChunk>();
+			copy->assign(maskedTiles.data(), maskedFlags.data());
+		}
+	};
+
+	// Looking up every coordinate is cheaper until the rectangle covers more chunks than the layer holds
+	long long cells = static_cast<long long>(range.width) * range.height;
+	if (cells > static_cast<long long>(layer.getChunkCount()))
+	{
+		for (const TileLayer::ChunkEntry& entry : layer.getChunks())
+		{
+			const TileChunk* chunk = range.contains(entry.m_key) ? layer.getChunk(entry.m_key.x, entry.m_key.y) : nullptr;
+			if (chunk)
+			{
+				addChunk(entry.m_key, *chunk);
+			}
+		}
+	}
+	else
+	{
+		for (int y = range.top; y < range.top + range.height; y++)
+		{
+			for (int x = range.left; x < range.left + range.width; x++)
+			{
+				if (const TileChunk* chunk = layer.getChunk(x, y))
+				{
+					addChunk(sf::Vector2i(x, y), *chunk);
+				}
+			}
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+const sf::Vector2i& TileStamp::getSize() const
+{
+	return this->m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+const sf::Vector2i& TileStamp::getOffset() const
+{
+	return this->m_offset;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileStamp::isEmpty() const
+{
+	return this->m_size.x == 0 || this->m_size.y == 0;
+}
+
+
+////////////////////////////////////////////////////////////
+TileId TileStamp::getTile(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= this->m_size.x || y >= this->m_size.y)
+	{
+		return Tileset::Empty;
+	}
+
+	x += this->m_offset.x;
+	y += this->m_offset.y;
+	const TileChunk* chunk = getChunk(x / TileChunk::Size, y / TileChunk::Size);
+	return chunk ? chunk->getTile(x % TileChunk::Size, y % TileChunk::Size) : Tileset::Empty;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint8 TileStamp::getFlags(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= this->m_size.x || y >= this->m_size.y)
+	{
+		return TileFlags::None;
+	}
+
+	x += this->m_offset.x;
+	y += this->m_offset.y;
+	const TileChunk* chunk = getChunk(x / TileChunk::Size, y / TileChunk::Size);
+	return chunk ? chunk->getFlags(x % TileChunk::Size, y % TileChunk::Size) : sf::Uint8(TileFlags::None);
+}
+
+
+////////////////////////////////////////////////////////////
+const TileChunk* TileStamp::getChunk(int x, int y) const
+{
+	const std::unique_ptr<TileChunk>* chunk = this->m_chunks.find(sf::Vector2i(x, y));
+	return chunk ? chunk->get() : nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileStamp::isChunkCovered(int x, int y) const
+{
+	sf::Vector2i origin = sf::Vector2i(x, y) * TileChunk::Size - this->m_offset;
+	return origin.x >= 0 && origin.y >= 0 && origin.x + TileChunk::Size <= this->m_size.x && origin.y + TileChunk::Size <= this->m_size.y;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string TileStamp::encode() const
+{
+	std::vector<char> data;
+	Varint::write(data, static_cast<sf::Uint64>(this->m_size.x));
+	Varint::write(data, static_cast<sf::Uint64>(this->m_size.y));
+	Varint::write(data, static_cast<sf::Uint64>(this->m_offset.x));
+	Varint::write(data, static_cast<sf::Uint64>(this->m_offset.y));
+	Varint::write(data, this->m_chunks.getSize());
+
+	std::vector<char> payload;
+	for (const CoordMap<std::unique_ptr<TileChunk>>::Entry& entry : this->m_chunks.getEntries())
+	{
+		payload.clear();
+		ChunkCodec::Encoding encoding = ChunkCodec::encode(*entry.m_value, payload);
+		Varint::write(data, static_cast<sf::Uint64>(entry.m_key.x));
+		Varint::write(data, static_cast<sf::Uint64>(entry.m_key.y));
+		Varint::write(data, encoding);
+		Varint::write(data, payload.size());
+		data.insert(data.end(), payload.begin(), payload.end());
+	}
+
+	return Prefix + Base64::encode(data.data(), data.size());
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileStamp::decode(const std::string& text)
+{
+	std::vector<char> data;
+	if (text.compare(0, Prefix.size(), Prefix) != 0 || !Base64::decode(text.substr(Prefix.size()), data))
+	{
+		return false;
+	}
+
+	const sf::Uint8* cursor = reinterpret_cast<const sf::Uint8*>(data.data());
+	const sf::Uint8* end = cursor + data.size();
+	sf::Uint64 width = 0, height = 0, offsetX = 0, offsetY = 0, count = 0;
+	if (!Varint::read(cursor, end, width) || !Varint::read(cursor, end, height) || !Varint::read(cursor, end, offsetX) || !Varint::read(cursor, end, offsetY) || !Varint::read(cursor, end, count) ||
+		width > MaxSide || height > MaxSide || offsetX >= TileChunk::Size || offsetY >= TileChunk::Size)
+	{
+		printf("Failed to decode copied tiles\n");
+		return false;
+	}
+
+	// Chunks extend past the last tile, by less than a chunk
+	sf::Uint64 columns = (offsetX + width + TileChunk::Size - 1) / TileChunk::Size;
+	sf::Uint64 rows = (offsetY + height + TileChunk::Size - 1) / TileChunk::Size;
+	CoordMap<std::unique_ptr<TileChunk>> chunks;
+	for (sf::Uint64 i = 0; i < count; i++)
+	{
+		sf::Uint64 x = 0, y = 0, encoding = 0, size = 0;
+		if (!Varint::read(cursor, end, x) || !Varint::read(cursor, end, y) || !Varint::read(cursor, end, encoding) || !Varint::read(cursor, end, size) ||
+			x >= columns || y >= rows || encoding > 0xFFFF || size > static_cast<sf::Uint64>(end - cursor))
+		{
+			printf("Failed to decode copied tiles\n");
+			return false;
+		}
+
+		std::unique_ptr<TileChunk>& chunk = chunks[sf::Vector2i(static_cast<int>(x), static_cast<int>(y))];
+		chunk = std::make_unique<TileChunk>();
+		if (!ChunkCodec::decode(reinterpret_cast<const char*>(cursor), static_cast<std::size_t>(size), static_cast<sf::Uint16>(encoding), *chunk))
+		{
+			printf("Failed to decode copied tiles\n");
+			return false;
+		}
+
+		cursor += size;
+	}
+
+	this->m_size = sf::Vector2i(static_cast<int>(width), static_cast<int>(height));
+	this->m_offset = sf::Vector2i(static_cast<int>(offsetX), static_cast<int>(offsetY));
+	this->m_chunks = std::move(chunks);
+	return true;
+}
+
+} //namespace le
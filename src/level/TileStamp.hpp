@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_TILE_STAMP_HPP
+#define LEVEL_EDITOR_TILE_STAMP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "TileLayer.hpp"
+#include <string>
+#include <SFML/Graphics/Rect.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Rectangle of tiles copied from a layer, the content of
+///        the clipboard and of stamps
+///
+/// The stamp keeps the chunk grid of the layer it was copied
+/// from. Chunks lying entirely within the rectangle share their
+/// tiles with the layer instead of copying them, so copying a
+/// large region costs little more than its border chunks. Pasting
+/// it back at a position aligned with that grid shares them again.
+/// A stamp converts to and from a compact text form for the
+/// system clipboard.
+///
+////////////////////////////////////////////////////////////
+class TileStamp : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// This constructor creates an empty stamp
+	///
+	////////////////////////////////////////////////////////////
+	TileStamp();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Copy a rectangle of tiles from a layer
+	///
+	/// \param layer Layer to copy from
+	/// \param tiles Tile coordinates and amount of tiles to copy
+	///
+	////////////////////////////////////////////////////////////
+	void capture(const TileLayer& layer, const sf::IntRect& tiles);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of tiles per side
+	///
+	////////////////////////////////////////////////////////////
+	const sf::Vector2i& getSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the position of the first tile within its chunk
+	///
+	/// A stamp pasted at a position sharing this remainder keeps
+	/// sharing its chunks.
+	///
+	////////////////////////////////////////////////////////////
+	const sf::Vector2i& getOffset() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether the stamp holds no tile
+	///
+	////////////////////////////////////////////////////////////
+	bool isEmpty() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a tile
+	///
+	/// \param x Column of the tile within the stamp
+	/// \param y Row of the tile within the stamp
+	///
+	/// \return Tile id, Tileset::Empty outside of the stamp
+	///
+	////////////////////////////////////////////////////////////
+	TileId getTile(int x, int y) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the flags of a tile
+	///
+	/// \param x Column of the tile within the stamp
+	/// \param y Row of the tile within the stamp
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint8 getFlags(int x, int y) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a chunk of the stamp
+	///
+	/// Chunk (0, 0) holds the first tile at the offset of the
+	/// stamp, the chunks extend past its edges with empty tiles.
+	///
+	/// \param x Column of the chunk
+	/// \param y Row of the chunk
+	///
+	/// \return The chunk, or nullptr if its tiles are all empty
+	///
+	////////////////////////////////////////////////////////////
+	const TileChunk* getChunk(int x, int y) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether every tile of a chunk lies within the stamp
+	///
+	/// \param x Column of the chunk
+	/// \param y Row of the chunk
+	///
+	////////////////////////////////////////////////////////////
+	bool isChunkCovered(int x, int y) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Convert the stamp to text
+	///
+	/// The chunks are encoded as in level files and the result is
+	/// base64 encoded behind a short prefix.
+	///
+	/// \return Text that decode reads back
+	///
+	////////////////////////////////////////////////////////////
+	std::string encode() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Replace the stamp by one converted to text
+	///
+	/// \param text Text returned by encode
+	///
+	/// \return False if the text is not a stamp, the stamp is left untouched
+	///
+	////////////////////////////////////////////////////////////
+	bool decode(const std::string& text);
+
+private:
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	sf::Vector2i                         m_size;   //!< Amount of tiles per side
+	sf::Vector2i                         m_offset; //!< Position of the first tile within its chunk
+	CoordMap<std::unique_ptr<TileChunk>> m_chunks; //!< Chunks holding at least one tile
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_TILE_STAMP_HPP
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Tileset.hpp"
+#include <algorithm>
+#include <limits>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+Tileset::Tileset() :
+m_texture (nullptr),
+m_tileSize(1, 1),
+m_columns (0),
+m_count   (0),
+m_layout  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Tileset::Tileset(const sf::Texture& texture, const sf::Vector2u& tileSize) :
+m_texture (&texture),
+m_tileSize(std::max(tileSize.x, 1u), std::max(tileSize.y, 1u)),
+m_columns (0),
+m_count   (0),
+m_layout  (0)
+{
+	refresh();
+	this->m_layout = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const sf::Texture* Tileset::getTexture() const
+{
+	return this->m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const sf::Vector2u& Tileset::getTileSize() const
+{
+	return this->m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+TileId Tileset::getTileCount() const
+{
+	return this->m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::IntRect Tileset::getTextureRect(TileId tile) const
+{
+	unsigned int index = tile - 1u;
+	unsigned int columns = std::max(this->m_columns, 1u);
+	return sf::IntRect((index % columns) * this->m_tileSize.x, (index / columns) * this->m_tileSize.y,
+		this->m_tileSize.x, this->m_tileSize.y);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Tileset::refresh()
+{
+	unsigned int columns = this->m_texture ? this->m_texture->getSize().x / this->m_tileSize.x : 0;
+	unsigned int count = this->m_texture ? columns * (this->m_texture->getSize().y / this->m_tileSize.y) : 0;
+	this->m_count = static_cast<TileId>(std::min<unsigned int>(count, std::numeric_limits<TileId>::max()));
+	if (columns == this->m_columns)
+	{
+		return false;
+	}
+
+	this->m_columns = columns;
+	this->m_layout++;
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Tileset::getLayout() const
+{
+	return this->m_layout;
+}
+
+} //namespace le
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_TILESET_HPP
+#define LEVEL_EDITOR_TILESET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Identifier of a tile within a tileset, 0 is the empty tile
+///
+////////////////////////////////////////////////////////////
+using TileId = sf::Uint16;
+
+////////////////////////////////////////////////////////////
+/// \brief Texture atlas made of equally sized tiles
+///
+/// Tiles are numbered row by row starting at 1, so that
+/// TileId 0 can represent the absence of a tile.
+///
+////////////////////////////////////////////////////////////
+class Tileset
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Id of the empty tile
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr TileId Empty = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// This constructor creates a tileset without texture
+	///
+	////////////////////////////////////////////////////////////
+	Tileset();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param texture  Atlas texture
+	/// \param tileSize Size of a single tile in pixels
+	///
+	////////////////////////////////////////////////////////////
+	Tileset(const sf::Texture& texture, const sf::Vector2u& tileSize);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the atlas texture
+	///
+	////////////////////////////////////////////////////////////
+	const sf::Texture* getTexture() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the size of a single tile in pixels
+	///
+	////////////////////////////////////////////////////////////
+	const sf::Vector2u& getTileSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of tiles in the atlas
+	///
+	////////////////////////////////////////////////////////////
+	TileId getTileCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the sub-rectangle of the texture showing a tile
+	///
+	/// \param tile Tile id, must not be Empty
+	///
+	////////////////////////////////////////////////////////////
+	sf::IntRect getTextureRect(TileId tile) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Recompute the tiles after the texture was resized
+	///
+	/// Meant to be called when the texture was reloaded. The
+	/// layout revision only changes if tiles moved within the
+	/// texture, so geometry built for the tileset is kept otherwise.
+	///
+	/// \return True if tiles moved within the texture
+	///
+	////////////////////////////////////////////////////////////
+	bool refresh();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the revision of the layout of the tiles
+	///
+	/// Incremented whenever refresh moves tiles.
+	///
+	////////////////////////////////////////////////////////////
+	unsigned int getLayout() const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	const sf::Texture* m_texture;  //!< Atlas texture
+	sf::Vector2u       m_tileSize; //!< Size of a single tile in pixels
+	unsigned int       m_columns;  //!< Amount of tiles per atlas row
+	TileId             m_count;    //!< Amount of tiles in the atlas
+	unsigned int       m_layout;   //!< Revision of the layout of the tiles
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_TILESET_HPP
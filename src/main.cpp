@@ -1,24 +1,666 @@
+#include "assets/AssetCache.hpp"
+#include "assets/ThumbnailCache.hpp"
+#include "level/AutoTiler.hpp"
+#include "level/EditJournal.hpp"
+#include "level/ImpostorPool.hpp"
+#include "level/Level.hpp"
+#include "level/LevelFile.hpp"
+#include "level/StampCommand.hpp"
+#include "level/TileCommand.hpp"
+#include "level/TileStamp.hpp"
+#include "tools/FillTool.hpp"
+#include "ui/controls/AssetBrowser.hpp"
+#include "ui/controls/CommandPalette.hpp"
+#include "ui/controls/InputControl.hpp"
+#include "ui/controls/LayerPanel.hpp"
+#include "ui/controls/LevelViewport.hpp"
+#include "ui/controls/Minimap.hpp"
+#include "ui/controls/SearchBox.hpp"
+#include "ui/controls/Table.hpp"
+#include "ui/controls/TableModel.hpp"
+#include "ui/rendering/UiCompositor.hpp"
+#include "ui/styling/InputTextStyle.hpp"
+#include "ui/styling/TextTheme.hpp"
+#include "utility/FrameScheduler.hpp"
+#include "utility/History.hpp"
+#include "utility/TimerWheel.hpp"
+#include "utility/TrigramIndex.hpp"
+#include "utility/UpdateScheduler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 #include <SFML/Graphics.hpp>
 
+static sf::Texture createPlaceholderTiles(const sf::Vector2u& tileSize, unsigned int columns, unsigned int rows)
+{
+    sf::Image image;
+    image.create(tileSize.x * columns, tileSize.y * rows);
+
+    for (unsigned int tile = 0; tile < columns * rows; tile++)
+    {
+        sf::Color color = sf::Color(40 + (tile * 67) % 200, 40 + (tile * 131) % 200, 40 + (tile * 29) % 200);
+        sf::Color border = sf::Color(color.r / 2, color.g / 2, color.b / 2);
+        sf::Vector2u origin = sf::Vector2u((tile % columns) * tileSize.x, (tile / columns) * tileSize.y);
+
+        for (unsigned int y = 0; y < tileSize.y; y++)
+        {
+            for (unsigned int x = 0; x < tileSize.x; x++)
+            {
+                bool edge = x == 0 || y == 0 || x == tileSize.x - 1 || y == tileSize.y - 1;
+                image.setPixel(origin.x + x, origin.y + y, edge ? border : color);
+            }
+        }
+    }
+
+    sf::Texture texture;
+    texture.loadFromImage(image);
+    return texture;
+}
+
+static sf::Texture createInputSprites(unsigned int height)
+{
+    // A column repeated across the width of the inputs, the default sprite above the focused one
+    sf::Image image;
+    image.create(1, height * 2, sf::Color(30, 30, 30));
+    for (unsigned int y = height; y < height * 2; y++)
+    {
+        image.setPixel(0, y, sf::Color(50, 50, 70));
+    }
+
+    sf::Texture texture;
+    texture.loadFromImage(image);
+    texture.setRepeated(true);
+    return texture;
+}
+
+static std::string getEntityTypeName(sf::Uint32 type)
+{
+    const char* names[] = { "Prop", "Spawner", "Trigger" };
+    return type < std::size(names) ? names[type] : "Type " + std::to_string(type);
+}
+
+static void generateLevel(le::Level& level, const le::Tileset& tileset)
+{
+    // Dense islands far apart, only the chunks covering them are stored
+    const sf::IntRect islands[] = { sf::IntRect(0, 0, 512, 512), sf::IntRect(4096, 256, 256, 128), sf::IntRect(-65536, 65536, 384, 384) };
+    le::TileLayer& ground = level.addLayer();
+    for (const sf::IntRect& island : islands)
+    {
+        for (int y = island.top; y < island.top + island.height; y++)
+        {
+            for (int x = island.left; x < island.left + island.width; x++)
+            {
+                unsigned int pattern = static_cast<unsigned int>((x >> 3) ^ (y >> 3));
+                ground.setTile(x, y, static_cast<le::TileId>(1 + pattern % tileset.getTileCount()));
+            }
+        }
+    }
+
+    level.addLayer();
+}
+
 int main()
 {
-    sf::RenderWindow window(sf::VideoMode(200, 200), "SFML works!");
-    sf::CircleShape shape(100.f);
-    shape.setFillColor(sf::Color::Green);
+    sf::RenderWindow window(sf::VideoMode(1280, 720), "Level Editor");
+
+    sf::Texture tiles = createPlaceholderTiles(sf::Vector2u(16, 16), 4, 4);
+    le::Tileset tileset(tiles, sf::Vector2u(16, 16));
+
+    // The file is declared first, the layers load their chunks from it until the level is destroyed
+    const char* levelPath = "level.lvl";
+    le::LevelFile file;
+    le::Level level(tileset);
+    if (!std::filesystem::exists(levelPath) || !file.open(levelPath, level))
+    {
+        generateLevel(level, tileset);
+    }
+
+    while (level.getLayerCount() < 2)
+    {
+        level.addLayer();
+    }
+
+    // The journal replays the edits a crash lost and records new ones against the current save
+    if (!file.isOpen())
+    {
+        file.saveAs(levelPath, level);
+    }
+
+    le::EditJournal journal;
+    if (file.isOpen())
+    {
+        journal.open("level.journal", file, level);
+    }
+
+    // The details are auto-tiled, by default each tile shows which of its four sides touch the terrain
+    le::AutoTiler terrain(level.getLayer(1));
+    if (!std::filesystem::exists("autotile.rules") || !terrain.loadRules("autotile.rules"))
+    {
+        for (int sides = 0; sides < 16; sides++)
+        {
+            char pattern[] = { '*', "01"[sides & 1], '*', "01"[sides >> 3 & 1], '1', "01"[sides >> 1 & 1], '*', "01"[sides >> 2 & 1], '*', '\0' };
+            terrain.addRule(static_cast<le::TileId>(1 + sides), pattern);
+        }
+    }
+
+    // Chunks already loaded by the journal or generated are retiled now, the others as they load
+    terrain.retileLoaded();
+
+    le::TileLayer& details = level.getLayer(1);
+    le::LevelViewport viewport(level, sf::Vector2f(0.f, 0.f), sf::Vector2f(1280.f, 720.f));
+    sf::View uiView(sf::FloatRect(0.f, 0.f, 1280.f, 720.f));
+
+    // The minimap sits at the bottom of the toolbox, clicking or dragging over it moves the camera
+    le::Minimap minimap(level, sf::Vector2f(0.f, 520.f), sf::Vector2f(200.f, 200.f), [&](le::Minimap&, const sf::Vector2f& world)
+    {
+        viewport.setCenter(world);
+    });
+
+    // A tileset file is decoded in the background, the generated tiles are shown until it is uploaded
+    le::AssetCache& assets = le::AssetCache::getDefault();
+    le::TextureHandle tilesetFile;
+    le::Tileset loadedTileset;
+    if (std::filesystem::exists("tileset.png"))
+    {
+        tilesetFile = assets.loadTexture("tileset.png");
+    }
+
+    // Files written in the project are reloaded, a reloaded tileset only rebuilds the chunks if its tiles moved
+    assets.watch(".");
+    assets.setOnLoaded([&](le::AssetCache&, const le::AssetHandle& asset)
+    {
+        if (asset == tilesetFile && asset.isReady())
+        {
+            if (&level.getTileset() == &loadedTileset)
+            {
+                loadedTileset.refresh();
+            }
+            else
+            {
+                loadedTileset = le::Tileset(tilesetFile.get(), tileset.getTileSize());
+            }
+
+            level.setTileset(loadedTileset);
+            minimap.refreshColors();
+        }
+    });
+
+    // Tile changes made while the mouse is held down form one undoable stroke
+    le::History& history = le::History::getDefault();
+    std::unique_ptr<le::TileCommand> stroke;
+    level.setOnTileChanged([&](le::Level&, const le::Level::TileChange& change)
+    {
+        journal.record(change);
+        if (&level.getLayer(change.m_layer) == &terrain.getLayer())
+        {
+            terrain.invalidate(change.m_change);
+        }
+
+        minimap.applyChange(change);
+        if (stroke && !history.isApplying())
+        {
+            stroke->add(change);
+        }
+    });
+
+    // Chunks are loaded as they are first shown or edited, the minimap and the terrain catch up with them
+    level.setOnChunkLoaded([&](le::Level&, const le::Level::ChunkLoad& load)
+    {
+        if (&level.getLayer(load.m_layer) == &terrain.getLayer())
+        {
+            terrain.invalidateChunk(load.m_chunk);
+            le::FrameScheduler::getDefault().invalidate();
+        }
+
+        minimap.applyChunk(load);
+    });
+
+    // The bucket fills within the visible tiles, B switches between painting and filling
+    le::FillTool bucket(level, history);
+    bucket.setLayer(1);
+    bucket.setTile(tileset.getTileCount());
+
+    // Copied tiles share their chunks with the layer, the clipboard only gets their text form
+    le::TileStamp copied;
+    std::string copiedText;
+
+    // The images of the project are listed at once, their thumbnails are read from the cache or generated in the background
+    le::ThumbnailCache thumbnails(std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u));
+    thumbnails.open(".thumbnails", 60);
+    le::AssetBrowser browser(thumbnails, sf::Vector2f(0.f, 164.f), sf::Vector2f(200.f, 352.f));
+    browser.scan(".");
+    thumbnails.setOnGenerated([&](le::ThumbnailCache&, const std::filesystem::path&)
+    {
+        browser.invalidate();
+    });
+
+    // The panels use the font of the project, their texts are left empty without one
+    sf::Font font;
+    if (!std::filesystem::exists("font.ttf") || !font.loadFromFile("font.ttf"))
+    {
+        printf("Failed to load font \"font.ttf\"\n");
+    }
+
+    le::TextStyle textStyle{ le::TextStyle::HorizontalAlignment::Left, le::TextStyle::VerticalAlignment::Center, &font, 12, 1.f, 1.f, sf::Text::Regular, sf::Color::White, sf::Color::Black, 0.f };
+    le::TextTheme textTheme{ &textStyle, &textStyle, &textStyle, &textStyle };
+    sf::Cursor arrowCursor;
+    sf::Cursor textCursor;
+    arrowCursor.loadFromSystem(sf::Cursor::Arrow);
+    textCursor.loadFromSystem(sf::Cursor::Text);
+    le::InputTextStyle inputStyle{ &arrowCursor, &textCursor, sf::Color(0, 0, 255, 100), sf::Color::White, 1.f };
+    const float rowHeight = 20.f;
+    sf::Texture inputSprites = createInputSprites(static_cast<unsigned int>(rowHeight));
+
+    auto centerOnEntity = [&](le::EntityId id)
+    {
+        const le::Entity* entity = level.getEntities().get(id);
+        if (entity)
+        {
+            viewport.setCenter(sf::Vector2f(entity->m_bounds.left + entity->m_bounds.width / 2.f, entity->m_bounds.top + entity->m_bounds.height / 2.f));
+        }
+    };
+
+    // Assets, commands and entities are searched by name, the index saved by the last session only gets the images added since
+    const char* indexPath = "search.index";
+    const sf::Uint32 assetGroup = 0;
+    const sf::Uint32 commandGroup = 1;
+    const sf::Uint32 entityGroup = 2;
+    le::TrigramIndex index;
+    index.load(indexPath);
+    for (std::size_t i = 0; i < browser.getItemCount(); i++)
+    {
+        std::string name = browser.getItemPath(i).generic_string();
+        if (index.find(name, assetGroup) == le::TrigramIndex::NoId)
+        {
+            index.add(name, assetGroup);
+        }
+    }
+
+    // The commands are filled in once the state they act on exists
+    le::Strings commandShortcuts;
+    std::map<sf::String, std::function<void()>> commandActions;
+    std::vector<sf::Uint32> entityNames;
+    le::SearchBox search(index, sf::Vector2f(0.f, 0.f), sf::Vector2f(200.f, 160.f), rowHeight, inputSprites,
+        sf::IntRect(0, 0, 200, static_cast<int>(rowHeight)), sf::IntRect(0, static_cast<int>(rowHeight), 200, static_cast<int>(rowHeight)), &textTheme, &inputStyle,
+        &textStyle, { "Asset", "Command", "Entity" }, 50, [&](le::SearchBox& box, sf::Uint32 id)
+        {
+            // Choosing an asset shows it in the browser, a command runs it and an entity moves the camera onto it
+            std::string name = index.getName(id);
+            sf::Uint32 group = index.getGroup(id);
+            if (group == assetGroup)
+            {
+                std::size_t item = browser.findItem(name);
+                if (item < browser.getItemCount())
+                {
+                    browser.selectItem(item);
+                    return;
+                }
+            }
+            else if (group == commandGroup)
+            {
+                auto command = commandActions.find(sf::String::fromUtf8(name.begin(), name.end()));
+                if (command != commandActions.end())
+                {
+                    command->second();
+                    return;
+                }
+            }
+            else if (group == entityGroup)
+            {
+                centerOnEntity(static_cast<le::EntityId>(std::find(entityNames.begin(), entityNames.end(), id) - entityNames.begin()));
+                return;
+            }
+
+            // The image was deleted or the command removed since the index was saved
+            index.remove(id);
+            box.refresh();
+        });
+
+    le::LayerPanel toolbox(sf::Vector2f(0.f, 0.f), sf::Vector2f(200.f, 720.f));
+    toolbox.addControl(search);
+    toolbox.addControl(browser);
+    toolbox.addControl(minimap);
+
+    // The entities are listed at the right, clicking a title sorts them by its column and the input above keeps those containing its text
+    le::TableModel entityRows({ le::TableModel::Kind::Number, le::TableModel::Kind::Text, le::TableModel::Kind::Number, le::TableModel::Kind::Number },
+        std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u));
+    std::vector<sf::Uint32> entityRowIds;
+    le::Table entityTable(sf::Vector2f(0.f, rowHeight + 4.f), sf::Vector2f(200.f, 716.f - rowHeight), rowHeight, &textStyle,
+        [&](std::size_t row, std::size_t column) { return entityRows.getText(row, column); },
+        [&](le::Table&, std::size_t row)
+        {
+            // Clicking an entity moves the camera onto it
+            centerOnEntity(static_cast<le::EntityId>(std::stoul(entityRows.getCell(entityRows.getRowId(row), 0))));
+        });
+    entityTable.setColumns({ { "Id", 40.f }, { "Type", 64.f }, { "X", 48.f }, { "Y", 48.f } });
+    entityTable.setOnColumnClicked([&](le::Table&, std::size_t column)
+    {
+        entityRows.setSort(column, entityRows.getSortColumn() == column && !entityRows.isDescending());
+    });
+    entityRows.setOnChanged([&](le::TableModel&)
+    {
+        entityTable.setRowCount(entityRows.getRowCount());
+        entityTable.refresh();
+    });
+
+    le::InputControl entityFilter(sf::Vector2f(0.f, 0.f), sf::Vector2f(200.f, rowHeight), inputSprites,
+        sf::IntRect(0, 0, 200, static_cast<int>(rowHeight)), sf::IntRect(0, static_cast<int>(rowHeight), 200, static_cast<int>(rowHeight)), &textTheme, &inputStyle,
+        [&](le::InputControl&, sf::String query) { entityRows.setFilter(query); });
+
+    le::LayerPanel entityPanel(sf::Vector2f(1080.f, 0.f), sf::Vector2f(200.f, 720.f));
+    entityPanel.addControl(entityFilter);
+    entityPanel.addControl(entityTable);
+
+    // Entities are added and removed through these, which keep their rows in the list and their names in the index
+    auto addEntity = [&](const le::Entity& entity)
+    {
+        le::EntityId id = level.getEntities().add(entity);
+        entityRowIds.resize(std::max(entityRowIds.size(), static_cast<std::size_t>(id) + 1), le::TableModel::NoRow);
+        entityRowIds[id] = entityRows.insertRow({ std::to_string(id), getEntityTypeName(entity.m_type),
+            std::to_string(static_cast<int>(entity.m_bounds.left)), std::to_string(static_cast<int>(entity.m_bounds.top)) });
+        entityNames.resize(entityRowIds.size(), le::TrigramIndex::NoId);
+        entityNames[id] = index.add(getEntityTypeName(entity.m_type) + " " + std::to_string(id), entityGroup);
+        search.refresh();
+    };
+
+    auto removeEntity = [&](le::EntityId id)
+    {
+        if (level.getEntities().remove(id))
+        {
+            entityRows.removeRow(entityRowIds[id]);
+            entityRowIds[id] = le::TableModel::NoRow;
+            index.remove(entityNames[id]);
+            entityNames[id] = le::TrigramIndex::NoId;
+            search.refresh();
+        }
+    };
+
+    le::FrameScheduler& frames = le::FrameScheduler::getDefault();
+    le::UiCompositor ui;
+    ui.create(window.getSize());
+    bool debugRegions = false;
+
+    // Every command is run by its shortcut or chosen by name from the search box
+    auto addCommand = [&](const sf::String& name, const sf::String& shortcut, std::function<void()> action)
+    {
+        commandShortcuts[name] = shortcut;
+        commandActions[name] = std::move(action);
+    };
+
+    addCommand("Save level", "Ctrl+S", [&]()
+    {
+        bool saved = journal.isOpen() ? journal.compact() : file.saveAs(levelPath, level);
+        printf(saved ? "Saved %s\n" : "Failed to save %s\n", levelPath);
+    });
+
+    addCommand("Undo", "Ctrl+Z", [&]()
+    {
+        if (!stroke)
+            history.undo();
+    });
+
+    addCommand("Redo", "Ctrl+Y", [&]()
+    {
+        if (!stroke)
+            history.redo();
+    });
+
+    // Copying takes the visible details, pasting puts them under the cursor
+    addCommand("Copy visible details", "Ctrl+C", [&]()
+    {
+        copied.capture(details, viewport.getVisibleTiles(window));
+        copiedText = copied.encode();
+        sf::Clipboard::setString(copiedText);
+    });
+
+    addCommand("Paste details", "Ctrl+V", [&]()
+    {
+        // Tiles copied by this instance are pasted from the stamp, which keeps sharing their chunks
+        std::string text = sf::Clipboard::getString().toAnsiString();
+        if (!stroke && (text == copiedText || copied.decode(text)) && !copied.isEmpty())
+        {
+            copiedText = text;
+            sf::Vector2i tile = viewport.mapPixelToTile(window, sf::Mouse::getPosition(window));
+            auto paste = std::make_unique<le::StampCommand>(level, 1, copied, tile);
+            if (paste->getChunkCount() > 0)
+            {
+                paste->redo();
+                history.push(std::move(paste));
+            }
+        }
+    });
+
+    addCommand("Duplicate details layer", "Ctrl+D", [&]()
+    {
+        level.duplicateLayer(1);
+        journal.recordDuplicate(1);
+        minimap.rebuild();
+    });
+
+    addCommand("Toggle bucket", "B", [&]()
+    {
+        if (!stroke)
+            viewport.setTool(viewport.getTool() ? nullptr : &bucket);
+    });
+
+    addCommand("Toggle debug regions", "F2", [&]()
+    {
+        debugRegions = !debugRegions;
+        ui.setDebugRegions(debugRegions);
+    });
+
+    addCommand("Reload autotile rules", "F5", [&]()
+    {
+        // The rules are read again and applied to the whole layer
+        if (terrain.loadRules("autotile.rules"))
+        {
+            terrain.retileAll();
+        }
+    });
+
+    index.addKeys(commandShortcuts, commandGroup);
+
+    // Ctrl+Shift+P opens the palette over the editor, it runs a command or shows an asset in the browser
+    le::CommandPalette palette(sf::Vector2f(340.f, 100.f), sf::Vector2f(600.f, 400.f), rowHeight, inputSprites,
+        sf::IntRect(0, 0, 600, static_cast<int>(rowHeight)), sf::IntRect(0, static_cast<int>(rowHeight), 600, static_cast<int>(rowHeight)), &textTheme, &inputStyle,
+        &textStyle, { "Command", "Asset" }, 50, [&](le::CommandPalette& chosen, sf::Uint32 id)
+        {
+            const std::string& text = chosen.getEntryText(id);
+            le::CommandPalette::Source source = chosen.getEntrySource(id);
+            if (source == le::CommandPalette::Source::Command)
+            {
+                commandActions[sf::String::fromUtf8(text.begin(), text.end())]();
+            }
+            else
+            {
+                browser.selectItem(browser.findItem(text));
+            }
+        });
+
+    for (const auto& command : commandShortcuts)
+    {
+        std::basic_string<sf::Uint8> name = command.first.toUtf8();
+        palette.addEntry(std::string(name.begin(), name.end()), le::CommandPalette::Source::Command);
+    }
+
+    for (std::size_t i = 0; i < browser.getItemCount(); i++)
+    {
+        palette.addEntry(browser.getItemPath(i).generic_string(), le::CommandPalette::Source::Asset);
+    }
 
     while (window.isOpen())
     {
         sf::Event event;
-        while (window.pollEvent(event))
+        if (frames.waitEvent(window, event))
         {
-            if (event.type == sf::Event::Closed)
-                window.close();
+            do
+            {
+                frames.onWindowEvent(event);
+
+                // The impostor pages are OpenGL resources, they are destroyed while the window still exists
+                if (event.type == sf::Event::Closed)
+                {
+                    le::ImpostorPool::getDefault().release();
+                    window.close();
+                }
+
+                if (event.type == sf::Event::Resized)
+                {
+                    sf::Vector2u size = sf::Vector2u(event.size.width, event.size.height);
+                    uiView = sf::View(sf::FloatRect(0.f, 0.f, static_cast<float>(size.x), static_cast<float>(size.y)));
+                    viewport.setSize(sf::Vector2f(static_cast<float>(size.x), static_cast<float>(size.y)));
+                    entityPanel.setPosition(static_cast<float>(size.x) - 200.f, 0.f);
+                    palette.setPosition(std::floor((static_cast<float>(size.x) - 600.f) / 2.f), 100.f);
+                    ui.create(size);
+                }
+
+                // The palette takes every event while open, the keys typed into it are not shortcuts
+                if (palette.onWindowEvent(window, event) || palette.isOpen())
+                {
+                    continue;
+                }
+
+                if (event.type == sf::Event::MouseButtonPressed && !stroke && !viewport.getTool())
+                {
+                    stroke = std::make_unique<le::TileCommand>(level);
+                }
+
+                if (event.type == sf::Event::MouseButtonPressed)
+                {
+                    bucket.setBounds(viewport.getVisibleTiles(window));
+                }
+
+                // The viewport goes first, so that dragging a selection does not paint
+                viewport.onWindowEvent(window, event);
+
+                bool paint = sf::Mouse::isButtonPressed(sf::Mouse::Left);
+                bool erase = sf::Mouse::isButtonPressed(sf::Mouse::Right);
+                bool pointer = event.type == sf::Event::MouseButtonPressed || event.type == sf::Event::MouseMoved;
+                sf::Vector2f cursor = window.mapPixelToCoords(sf::Mouse::getPosition(window), uiView);
+                bool overToolbox = toolbox.contains(cursor.x, cursor.y) || entityPanel.contains(cursor.x, cursor.y);
+                if (pointer && (paint || erase) && !viewport.isSelecting() && !viewport.getTool() && !overToolbox)
+                {
+                    sf::Vector2i tile = viewport.mapPixelToTile(window, sf::Mouse::getPosition(window));
+                    details.setTile(tile.x, tile.y, erase ? le::Tileset::Empty : level.getTileset().getTileCount());
+                }
+
+                // Retiling before the stroke ends makes the retiled neighbours part of it
+                terrain.update();
+
+                if (event.type == sf::Event::MouseButtonReleased && stroke && !paint && !erase)
+                {
+                    if (stroke->finish())
+                    {
+                        history.push(std::move(stroke));
+                    }
+
+                    stroke.reset();
+                }
+
+                toolbox.onWindowEvent(window, event);
+                entityPanel.onWindowEvent(window, event);
+
+                // Keys typed into an input are not shortcuts
+                bool typing = entityFilter.isFocused() || search.isFocused();
+
+                if (event.type == sf::Event::KeyPressed && event.key.control && event.key.code == sf::Keyboard::S)
+                {
+                    commandActions["Save level"]();
+                }
+
+                if (event.type == sf::Event::KeyPressed && event.key.control && !stroke && !typing)
+                {
+                    if (event.key.code == sf::Keyboard::Z && !event.key.shift)
+                        commandActions["Undo"]();
+                    else if (event.key.code == sf::Keyboard::Y || (event.key.code == sf::Keyboard::Z && event.key.shift))
+                        commandActions["Redo"]();
+                    else if (event.key.code == sf::Keyboard::C)
+                        commandActions["Copy visible details"]();
+                    else if (event.key.code == sf::Keyboard::V)
+                        commandActions["Paste details"]();
+                    else if (event.key.code == sf::Keyboard::D)
+                        commandActions["Duplicate details layer"]();
+                }
+
+                // Entities are placed on the tile under the cursor, Delete removes the selected ones, or the hovered one without a selection
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::E && !event.key.control && !typing)
+                {
+                    sf::Vector2i tile = viewport.mapPixelToTile(window, sf::Mouse::getPosition(window));
+                    sf::Vector2f tileSize(level.getTileset().getTileSize());
+                    addEntity(le::Entity{ sf::FloatRect(sf::Vector2f(tile.x * tileSize.x, tile.y * tileSize.y), tileSize), 0 });
+                    frames.invalidate();
+                }
+
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Delete && !typing)
+                {
+                    const le::BitSet& selection = viewport.getSelection();
+                    bool selected = selection.findNext(0) < selection.getSize();
+                    for (std::size_t id = selection.findNext(0); id < selection.getSize(); id = selection.findNext(id + 1))
+                        removeEntity(static_cast<le::EntityId>(id));
+
+                    if (!selected)
+                        removeEntity(viewport.getHoveredEntity());
+
+                    viewport.clearSelection();
+                }
+
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::B && !stroke && !typing)
+                {
+                    commandActions["Toggle bucket"]();
+                }
+
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F2)
+                {
+                    commandActions["Toggle debug regions"]();
+                }
+
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F5)
+                {
+                    commandActions["Reload autotile rules"]();
+                }
+            }
+            while (window.pollEvent(event));
+        }
+
+        terrain.update();
+        le::TimerWheel::getDefault().update();
+        le::UpdateScheduler::getDefault().update();
+
+        sf::IntRect visible = viewport.getVisibleTiles(window);
+        sf::Vector2f tileSize(level.getTileset().getTileSize());
+        minimap.setCamera(sf::FloatRect(visible.left * tileSize.x, visible.top * tileSize.y, visible.width * tileSize.x, visible.height * tileSize.y));
+
+        if (frames.beginFrame())
+        {
+            window.clear();
+            window.setView(uiView);
+            window.draw(viewport);
+            ui.render(window, { &toolbox, &entityPanel, &palette });
+            window.display();
+        }
+    }
+
+    // Entities are not saved with the level, so their names are left out of the saved index
+    for (sf::Uint32 name : entityNames)
+    {
+        if (name != le::TrigramIndex::NoId)
+        {
+            index.remove(name);
         }
+    }
 
-        window.clear();
-        window.draw(shape);
-        window.display();
+    if (!index.save(indexPath))
+    {
+        printf("Failed to write search index \"%s\"\n", indexPath);
     }
 
     return 0;
-}
\ No newline at end of file
+}
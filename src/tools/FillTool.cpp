@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "FillTool.hpp"
+#include "../level/FillCommand.hpp"
+#include "../level/FloodFill.hpp"
+#include <memory>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+FillTool::FillTool(Level& level, History& history) :
+m_level  (&level),
+m_history(&history),
+m_layer  (0),
+m_tile   (Tileset::Empty),
+m_flags  (TileFlags::None),
+m_bounds (-512, -512, 1024, 1024)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void FillTool::setLayer(std::size_t layer)
+{
+	this->m_layer = layer;
+}
+
+
+////////////////////////////////////////////////////////////
+void FillTool::setTile(TileId tile, sf::Uint8 flags)
+{
+	this->m_tile = tile;
+	this->m_flags = flags;
+}
+
+
+////////////////////////////////////////////////////////////
+void FillTool::setBounds(const sf::IntRect& bounds)
+{
+	this->m_bounds = bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FillTool::fill(const sf::Vector2i& seed, TileId tile, sf::Uint8 flags)
+{
+	if (this->m_layer >= this->m_level->getLayerCount())
+	{
+		return 0;
+	}
+
+	TileLayer& layer = this->m_level->getLayer(this->m_layer);
+	TileId previousTile = layer.getTile(seed.x, seed.y);
+	sf::Uint8 previousFlags = layer.getFlags(seed.x, seed.y);
+	if (previousTile == tile && previousFlags == flags)
+	{
+		return 0;
+	}
+
+	std::vector<TileLayer::Span> spans;
+	if (!FloodFill::compute(layer, seed, this->m_bounds, spans))
+	{
+		return 0;
+	}
+
+	auto command = std::make_unique<FillCommand>(*this->m_level, this->m_layer, spans, previousTile, previousFlags, tile, flags);
+	std::size_t count = command->getTileCount();
+	command->redo();
+	this->m_history->push(std::move(command));
+	return count;
+}
+
+
+////////////////////////////////////////////////////////////
+void FillTool::onPressed(const sf::Vector2i& tile, sf::Mouse::Button button)
+{
+	if (button == sf::Mouse::Left)
+	{
+		fill(tile, this->m_tile, this->m_flags);
+	}
+	else if (button == sf::Mouse::Right)
+	{
+		fill(tile, Tileset::Empty, TileFlags::None);
+	}
+}
+
+} //namespace le
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_FILL_TOOL_HPP
+#define LEVEL_EDITOR_FILL_TOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Tool.hpp"
+#include "../level/Level.hpp"
+#include "../utility/History.hpp"
+#include <SFML/Graphics/Rect.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Bucket tool filling the region of connected tiles under the cursor
+///
+/// The left button fills the region with the tool's tile, the
+/// right button erases it. Layers are unbounded, so a region is
+/// limited to the tool's bounds, which keeps a fill over empty
+/// space from running forever. Every fill is pushed to the
+/// history as one command.
+///
+////////////////////////////////////////////////////////////
+class FillTool : public Tool
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param level   Level to fill
+	/// \param history History the fills are pushed to
+	///
+	////////////////////////////////////////////////////////////
+	FillTool(Level& level, History& history);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the layer that is filled
+	///
+	/// \param layer Index of the layer
+	///
+	////////////////////////////////////////////////////////////
+	void setLayer(std::size_t layer);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the tile placed by the left button
+	///
+	/// \param tile  Tile id
+	/// \param flags Tile flags
+	///
+	////////////////////////////////////////////////////////////
+	void setTile(TileId tile, sf::Uint8 flags = TileFlags::None);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the tiles a region is limited to
+	///
+	/// \param bounds Tile coordinates and amount of tiles
+	///
+	////////////////////////////////////////////////////////////
+	void setBounds(const sf::IntRect& bounds);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Fill the region connected to a tile
+	///
+	/// \param seed  Coordinates of the tile the region starts from
+	/// \param tile  Tile id, Tileset::Empty erases the region
+	/// \param flags Tile flags
+	///
+	/// \return Amount of tiles that were filled
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t fill(const sf::Vector2i& seed, TileId tile, sf::Uint8 flags);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Fill or erase the region under the cursor
+	///
+	/// \param tile   Coordinates of the tile under the cursor
+	/// \param button Button that was pressed
+	///
+	////////////////////////////////////////////////////////////
+	virtual void onPressed(const sf::Vector2i& tile, sf::Mouse::Button button) override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	Level*      m_level;   //!< Level to fill
+	History*    m_history; //!< History the fills are pushed to
+	std::size_t m_layer;   //!< Index of the filled layer
+	TileId      m_tile;    //!< Tile placed by the left button
+	sf::Uint8   m_flags;   //!< Flags of the placed tile
+	sf::IntRect m_bounds;  //!< Tiles a region is limited to
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_FILL_TOOL_HPP
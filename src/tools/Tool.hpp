@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_TOOL_HPP
+#define LEVEL_EDITOR_TOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Window/Mouse.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Interface of the editing tools driven by a level viewport
+///
+/// The viewport translates the cursor into level tiles, so a tool
+/// only deals with the tiles it edits.
+///
+////////////////////////////////////////////////////////////
+class Tool
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~Tool() {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Handle a mouse button pressed over the level
+	///
+	/// \param tile   Coordinates of the tile under the cursor
+	/// \param button Button that was pressed
+	///
+	////////////////////////////////////////////////////////////
+	virtual void onPressed(const sf::Vector2i& tile, sf::Mouse::Button button) = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Handle a mouse button released over the level
+	///
+	/// \param tile   Coordinates of the tile under the cursor
+	/// \param button Button that was released
+	///
+	////////////////////////////////////////////////////////////
+	virtual void onReleased(const sf::Vector2i& tile, sf::Mouse::Button button) {}
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_TOOL_HPP
@@ -28,17 +28,17 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include "SecondaryButtonComponent.hpp"
+#include <algorithm>
 
 
 namespace le
 {
 ////////////////////////////////////////////////////////////
 SecondaryButtonComponent::SecondaryButtonComponent() :
-m_onHold    ([](int8_t) {}),
-m_clock     (),
-m_restart   (false),
-m_elapsed   (0),
-m_scrollTime(0)
+m_onHold     ([](int8_t) {}),
+m_first      (nullptr),
+m_second     (nullptr),
+m_repeatCurve()
 {
 }
 
@@ -46,11 +46,10 @@ SecondaryButtonComponent::SecondaryButtonComponent(Button* first, Button* second
 const sf::Vector2f& secondButtonPos, const sf::Vector2f& size, const sf::Texture& texture, const sf::IntRect& spriteDefault, 
 const sf::IntRect& spriteActive, const TextTheme* textTheme, bool enabled, int scrollTime, std::function<void(int8_t)> onHold) :
 	
-m_onHold    (onHold),
-m_clock     (),
-m_restart   (false),
-m_elapsed   (0),
-m_scrollTime(scrollTime)
+m_onHold     (onHold),
+m_first      (first),
+m_second     (second),
+m_repeatCurve(getScrollCurve(scrollTime))
 {
 	auto initializeButton = [&](Button* button, const sf::Vector2f& position, int8_t summand)
 	{
@@ -64,10 +63,7 @@ m_scrollTime(scrollTime)
 			textTheme,
 			nullptr,
 			L"",
-			[=, this](Button&)
-			{
-				onHoldButton(summand);
-			},
+			[](Button&) {},
 			[=, this](Button&)
 			{
 				onHoldButton(summand);
@@ -78,18 +74,36 @@ m_scrollTime(scrollTime)
 
 	initializeButton(first, firstButtonPos, -1);
 	initializeButton(second, secondButtonPos, 1);
+	setRepeatCurve(this->m_repeatCurve);
 }
 
 
 ////////////////////////////////////////////////////////////
-void SecondaryButtonComponent::onHoldButton(int8_t summand)
+void SecondaryButtonComponent::setRepeatCurve(const RepeatCurve& curve)
 {
-	this->m_elapsed = m_clock.getElapsedTime().asMilliseconds();
-	if (this->m_elapsed >= this->m_scrollTime)
+	this->m_repeatCurve = curve;
+
+	if (this->m_first && this->m_second)
 	{
-		this->m_clock.restart();
-		this->m_onHold(summand);
+		this->m_first->setRepeatCurve(curve);
+		this->m_second->setRepeatCurve(curve);
 	}
 }
 
-} //namespace le
\ No newline at end of file
+
+////////////////////////////////////////////////////////////
+void SecondaryButtonComponent::onHoldButton(int8_t summand)
+{
+	this->m_onHold(summand);
+}
+
+
+////////////////////////////////////////////////////////////
+RepeatCurve SecondaryButtonComponent::getScrollCurve(int scrollTime)
+{
+	// Holding waits a bit longer before the first repetition, then accelerates up to five times the scroll speed
+	sf::Time interval = sf::milliseconds(std::max(scrollTime, 1));
+	return RepeatCurve{ interval * 2.f, interval, std::max(interval / 5.f, sf::milliseconds(1)), 0.85f };
+}
+
+} //namespace le
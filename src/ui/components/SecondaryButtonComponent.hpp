@@ -64,14 +64,22 @@ public:
 	/// \param spriteActive    Sub-rectangle of the texture to assign to the active sprite
 	/// \param textTheme       Text theme assigned to the button (Can be empty)
 	/// \param enabled         Enable this button
-	/// \param scrollTime      Amount of time required to scroll through the combo box
-	/// \param onItemChanged   Event raised when a button is held
+	/// \param scrollTime      Amount of time required to scroll through the combo box, used to build the default repeat curve
+	/// \param onItemChanged   Event raised when a button is pressed or held
 	/// 
 	////////////////////////////////////////////////////////////
 	SecondaryButtonComponent(Button* first, Button* second, const sf::Vector2f& firstButtonPos, const sf::Vector2f& secondButtonPos,
 	const sf::Vector2f& size, const sf::Texture& texture, const sf::IntRect& spriteDefault,
 	const sf::IntRect& spriteActive, const TextTheme* textTheme, bool enabled, int scrollTime, std::function<void(int8_t)> onHold);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Sets the auto-repeat curve of both buttons
+	///
+	/// \param curve New repeat curve
+	///
+	////////////////////////////////////////////////////////////
+	void setRepeatCurve(const RepeatCurve& curve);
+
 	////////////////////////////////////////////////////////////
 	/// \brief Event raised when a child button is pressed or held
 	/// 
@@ -82,14 +90,21 @@ public:
 
 private:
 
+	////////////////////////////////////////////////////////////
+	/// \brief Build the default accelerating curve out of a scroll time
+	///
+	/// \param scrollTime Interval between the first repetitions in milliseconds
+	///
+	////////////////////////////////////////////////////////////
+	static RepeatCurve getScrollCurve(int scrollTime);
+
 	////////////////////////////////////////////////////////////
 	// Member data
 	////////////////////////////////////////////////////////////
-	std::function<void(int8_t)> m_onHold;     //!< Event raised when a button is held
-	sf::Clock                   m_clock;      //!< Internal clock for validating holding
-	bool                        m_restart;    //!< Determines if the clock should be restarted
-	int                         m_elapsed;    //!< Elapsed time of the clock;
-	int                         m_scrollTime; //!< Amount of time required to scroll through the items
+	std::function<void(int8_t)> m_onHold;      //!< Event raised when a button is held
+	Button*                     m_first;       //!< The first button
+	Button*                     m_second;      //!< The second button
+	RepeatCurve                 m_repeatCurve; //!< Curve used to repeat m_onHold while a button is held
 };
 
 } //namespace le
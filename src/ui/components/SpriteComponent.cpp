@@ -36,7 +36,8 @@ namespace le
 SpriteComponent::SpriteComponent() :
 m_spriteDefault(),
 m_spriteAlt    (std::nullopt),
-m_useAlt       (false)
+m_useAlt       (false),
+m_damage       ()
 {
 }
 
@@ -45,9 +46,11 @@ m_useAlt       (false)
 SpriteComponent::SpriteComponent(const sf::Vector2f& position, const sf::Texture& texture, const sf::IntRect& sprite) :
 m_spriteDefault(texture, sprite),
 m_spriteAlt    (std::nullopt),
-m_useAlt       (false)
+m_useAlt       (false),
+m_damage       ()
 {
 	setPosition(position);
+	observe(&texture);
 }
 
 
@@ -56,9 +59,11 @@ SpriteComponent::SpriteComponent(const sf::Vector2f& position, const sf::Texture
 const sf::IntRect& spriteDefault, std::optional<const sf::IntRect> spriteAlt, bool useAlt) :
 m_spriteDefault(texture, spriteDefault),
 m_spriteAlt    (spriteAlt ? std::make_optional<sf::Sprite>(texture, *spriteAlt) : std::nullopt),
-m_useAlt       (useAlt)
+m_useAlt       (useAlt),
+m_damage       ()
 {
 	setPosition(position);
+	observe(&texture);
 }
 
 
@@ -87,15 +92,28 @@ sf::FloatRect SpriteComponent::getGlobalBounds() const
 ////////////////////////////////////////////////////////////
 void SpriteComponent::setUseAlt(bool useAlt)
 {
-	this->m_useAlt = this->m_spriteAlt && useAlt;
+	bool current = this->m_spriteAlt && useAlt;
+	if (this->m_useAlt != current)
+	{
+		this->m_useAlt = current;
+		this->m_damage.damage(getGlobalBounds());
+	}
 }
 
 
 ////////////////////////////////////////////////////////////
 void SpriteComponent::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
+	this->m_damage.setDrawn(states.transform, getGlobalBounds());
 	states.transform *= getTransform();
 	target.draw(getCurrent(), states);
 }
 
+
+////////////////////////////////////////////////////////////
+void SpriteComponent::onAssetChanged()
+{
+	this->m_damage.damage(getGlobalBounds());
+}
+
 } //namespace le
\ No newline at end of file
@@ -30,6 +30,8 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include "../rendering/DamageTracker.hpp"
+#include "../../assets/AssetObserver.hpp"
 #include <memory>
 #include <optional>
 #include <SFML/Graphics/Sprite.hpp>
@@ -42,7 +44,7 @@ namespace le
 /// \brief Sprite component representing a rich sf::Sprite wrapper
 ///
 ////////////////////////////////////////////////////////////
-class SpriteComponent : public sf::Drawable, public sf::Transformable
+class SpriteComponent : public sf::Drawable, public sf::Transformable, private AssetObserver
 {
 public:
 
@@ -134,12 +136,19 @@ public:
 
 private:
 
+	////////////////////////////////////////////////////////////
+	/// \brief Redraw the sprite once its texture changed
+	///
+	////////////////////////////////////////////////////////////
+	virtual void onAssetChanged() override;
+
 	////////////////////////////////////////////////////////////
 	// Member data
 	////////////////////////////////////////////////////////////
 	sf::Sprite                m_spriteDefault; //!< Default sprite
 	std::optional<sf::Sprite> m_spriteAlt;     //!< Optional alternative sprite. Is initialized only if the corresponding sf::IntRect was provided
 	bool                      m_useAlt;        //!< Indicates whether to use the alternative sprite or not
+	DamageTracker             m_damage;        //!< Area the sprite was drawn in last
 };
 
 } //namespace le
@@ -40,7 +40,8 @@ m_renderTexture(new sf::RenderTexture()),
 m_clearColor(sf::Color::Transparent),
 m_text(),
 m_textOffset(0, 0),
-m_style(nullptr)
+m_style(nullptr),
+m_damage()
 {
 	this->m_renderTexture->create(1, 1);
 }
@@ -54,7 +55,9 @@ m_sprite(sf::Texture(), sf::IntRect(0, 0, size.x, size.y)),
 m_renderTexture(new sf::RenderTexture()),
 m_clearColor(sf::Color::Transparent),
 m_text(string, style ? *style->m_font : sf::Font()),
-m_textOffset(textOffset)
+m_textOffset(textOffset),
+m_style(nullptr),
+m_damage()
 {
 	this->m_renderTexture->create(std::max(1u, size.x), std::max(1u, size.y));
 	setStyle(style);
@@ -146,6 +149,7 @@ void TextComponent::applyStyleChanges()
 {
 	if (this->m_style)
 	{
+		observe(this->m_style->m_font);
 		this->m_text.setFont(*this->m_style->m_font);
 		this->m_text.setCharacterSize(this->m_style->m_characterSize);
 		this->m_text.setLetterSpacing(this->m_style->m_letterSpacingFactor);
@@ -162,6 +166,7 @@ void TextComponent::applyStyleChanges()
 ////////////////////////////////////////////////////////////
 void TextComponent::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
+	this->m_damage.setDrawn(states.transform, getTransform().transformRect(this->m_sprite.getGlobalBounds()));
 	states.transform *= getTransform();
 	target.draw(this->m_sprite, states);
 }
@@ -226,6 +231,14 @@ void TextComponent::displayRenderTexture()
 	this->m_renderTexture->draw(this->m_text);
 	this->m_renderTexture->display();
 	this->m_sprite.setTexture(this->m_renderTexture->getTexture());
+	this->m_damage.damage(getTransform().transformRect(this->m_sprite.getGlobalBounds()));
+}
+
+
+////////////////////////////////////////////////////////////
+void TextComponent::onAssetChanged()
+{
+	applyStyleChanges();
 }
 
 } // namespace le
\ No newline at end of file
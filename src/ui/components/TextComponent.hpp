@@ -30,7 +30,10 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include "../rendering/DamageTracker.hpp"
+#include "../../assets/AssetObserver.hpp"
 #include "../styling/TextStyle.hpp"
+#include <memory>
 #include <optional>
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Text.hpp>
@@ -43,7 +46,7 @@ namespace le
 /// \brief Text component representing a rich sf::Text wrapper
 ///
 ////////////////////////////////////////////////////////////
-class TextComponent : public sf::Drawable, public sf::Transformable
+class TextComponent : public sf::Drawable, public sf::Transformable, private AssetObserver
 {
 public:
 
@@ -218,6 +221,12 @@ protected:
 	////////////////////////////////////////////////////////////
 	void displayRenderTexture();
 
+	////////////////////////////////////////////////////////////
+	/// \brief Render the text again once its font changed
+	///
+	////////////////////////////////////////////////////////////
+	virtual void onAssetChanged() override;
+
 	////////////////////////////////////////////////////////////
 	// Member data
 	////////////////////////////////////////////////////////////
@@ -228,6 +237,7 @@ protected:
 	sf::Text                           m_text;          //!< Text drawn to m_renderTexture
 	sf::Vector2f                       m_textOffset;    //!< Offset of the text towards m_renderTexture
 	const TextStyle*                   m_style;         //!< Text style
+	DamageTracker                      m_damage;        //!< Area the sprite was drawn in last
 };
 
 } //namespace le
@@ -0,0 +1,380 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "AssetBrowser.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const float     Spacing          = 4.f;                  //!< Pixels between two tiles
+static const sf::Color BackgroundColor  = sf::Color(40, 40, 40); //!< Colour behind the tiles
+static const sf::Color PlaceholderColor = sf::Color(70, 70, 70); //!< Colour of the tiles without a thumbnail yet
+
+
+////////////////////////////////////////////////////////////
+static bool isImage(const std::filesystem::path& path)
+{
+	// Formats decoded by sf::Image
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	for (const char* known : { ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".gif", ".psd", ".hdr", ".pic" })
+	{
+		if (extension == known)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+////////////////////////////////////////////////////////////
+static void appendQuad(std::vector<sf::Vertex>& vertices, sf::FloatRect rect, sf::FloatRect texture, float height, const sf::Color& color = sf::Color::White)
+{
+	// Tiles cut by the top or bottom of the browser keep the matching part of their thumbnail
+	float top = std::max(rect.top, 0.f);
+	float bottom = std::min(rect.top + rect.height, height);
+	if (bottom <= top)
+	{
+		return;
+	}
+
+	float scale = texture.height / rect.height;
+	texture.top += (top - rect.top) * scale;
+	texture.height = (bottom - top) * scale;
+	rect.top = top;
+	rect.height = bottom - top;
+
+	sf::Vertex topLeft(sf::Vector2f(rect.left, rect.top), color, sf::Vector2f(texture.left, texture.top));
+	sf::Vertex topRight(sf::Vector2f(rect.left + rect.width, rect.top), color, sf::Vector2f(texture.left + texture.width, texture.top));
+	sf::Vertex bottomLeft(sf::Vector2f(rect.left, rect.top + rect.height), color, sf::Vector2f(texture.left, texture.top + texture.height));
+	sf::Vertex bottomRight(sf::Vector2f(rect.left + rect.width, rect.top + rect.height), color, sf::Vector2f(texture.left + texture.width, texture.top + texture.height));
+
+	vertices.insert(vertices.end(), { topLeft, topRight, bottomLeft, bottomLeft, topRight, bottomRight });
+}
+
+
+////////////////////////////////////////////////////////////
+AssetBrowser::AssetBrowser(ThumbnailCache& cache, const sf::Vector2f& position, const sf::Vector2f& size, Event1<AssetBrowser, const std::filesystem::path&> onSelected) :
+SpriteBasedControl::SpriteBasedControl(),
+m_cache     (&cache),
+m_items     (),
+m_scroll    (0.f),
+m_selected  (0),
+m_onSelected(onSelected)
+{
+	this->m_size = size;
+	this->m_enabled = true;
+	setPosition(position);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetBrowser::scan(const std::filesystem::path& directory)
+{
+	this->m_items.clear();
+
+	// Only the names are read here, which the system returns a directory at a time
+	std::error_code error;
+	for (std::filesystem::recursive_directory_iterator it(directory, std::filesystem::directory_options::skip_permission_denied, error), end; !error && it != end; it.increment(error))
+	{
+		if (isImage(it->path()) && it->is_regular_file(error))
+		{
+			this->m_items.push_back(Item{ it->path(), 0, 0, false });
+		}
+	}
+
+	std::sort(this->m_items.begin(), this->m_items.end(), [](const Item& left, const Item& right) { return left.m_path < right.m_path; });
+	this->m_selected = this->m_items.size();
+	setScroll(0.f);
+	invalidate();
+	schedule();
+	return this->m_items.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetBrowser::getItemCount() const
+{
+	return this->m_items.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const std::filesystem::path& AssetBrowser::getItemPath(std::size_t index) const
+{
+	return this->m_items[index].m_path;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetBrowser::findItem(const std::filesystem::path& path) const
+{
+	auto it = std::lower_bound(this->m_items.begin(), this->m_items.end(), path, [](const Item& item, const std::filesystem::path& value) { return item.m_path < value; });
+	return it != this->m_items.end() && it->m_path == path ? static_cast<std::size_t>(it - this->m_items.begin()) : this->m_items.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetBrowser::selectItem(std::size_t index)
+{
+	if (index >= this->m_items.size())
+	{
+		return;
+	}
+
+	this->m_selected = index;
+	invalidate();
+
+	// The row of the image is scrolled to the top when it is out of view
+	float top = (index / getColumnCount()) * getCellSize();
+	if (top < this->m_scroll || top + getCellSize() > this->m_scroll + this->m_size.y)
+	{
+		setScroll(top);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetBrowser::setScroll(float offset)
+{
+	float rows = std::ceil(static_cast<float>(this->m_items.size()) / getColumnCount());
+	float scroll = std::clamp(offset, 0.f, std::max(rows * getCellSize() + Spacing - this->m_size.y, 0.f));
+	if (scroll != this->m_scroll)
+	{
+		this->m_scroll = scroll;
+		invalidate();
+		schedule();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+float AssetBrowser::getScroll() const
+{
+	return this->m_scroll;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetBrowser::contains(float x, float y) const
+{
+	// The browser has no sprite, its area is its size
+	return Control::contains(x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetBrowser::update()
+{
+	Control::update();
+
+	// The sizes and times are read once the images come into view, the scan only lists their names
+	std::size_t first, last;
+	getVisibleRange(first, last);
+	bool read = false;
+	for (std::size_t i = first; i < last; i++)
+	{
+		Item& item = this->m_items[i];
+		if (!item.m_known)
+		{
+			std::error_code error;
+			item.m_size = std::filesystem::file_size(item.m_path, error);
+			item.m_modified = static_cast<sf::Int64>(std::filesystem::last_write_time(item.m_path, error).time_since_epoch().count());
+			item.m_known = true;
+			read = true;
+		}
+	}
+
+	if (read)
+	{
+		invalidate();
+	}
+
+	if (!this->m_holding)
+	{
+		unschedule();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetBrowser::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	setDrawn(states);
+	states.transform *= getTransform();
+
+	sf::RectangleShape background(this->m_size);
+	background.setFillColor(BackgroundColor);
+	target.draw(background, states);
+
+	// Textures may only be released before the thumbnails are looked up, the batches point at them
+	this->m_cache->trim();
+
+	float cellSize = getCellSize();
+	float thumbnailSize = static_cast<float>(this->m_cache->getThumbnailSize());
+	std::size_t columns = getColumnCount();
+	std::size_t first, last;
+	getVisibleRange(first, last);
+
+	std::vector<std::pair<const sf::Texture*, std::vector<sf::Vertex>>> batches;
+	std::vector<sf::Vertex> placeholders;
+	for (std::size_t i = first; i < last; i++)
+	{
+		const Item& item = this->m_items[i];
+		sf::FloatRect rect(Spacing + (i % columns) * cellSize, Spacing + (i / columns) * cellSize - this->m_scroll, thumbnailSize, thumbnailSize);
+		const sf::Texture* texture = nullptr;
+		sf::IntRect textureRect;
+		if (!item.m_known || !this->m_cache->getThumbnail(item.m_path, item.m_size, item.m_modified, texture, textureRect))
+		{
+			appendQuad(placeholders, rect, sf::FloatRect(), this->m_size.y, PlaceholderColor);
+			continue;
+		}
+
+		// Visible tiles span a handful of pages, a linear search finds their batch
+		auto batch = std::find_if(batches.begin(), batches.end(), [texture](const auto& pair) { return pair.first == texture; });
+		if (batch == batches.end())
+		{
+			batch = batches.emplace(batches.end(), texture, std::vector<sf::Vertex>());
+		}
+
+		appendQuad(batch->second, rect, sf::FloatRect(textureRect), this->m_size.y);
+	}
+
+	if (!placeholders.empty())
+	{
+		target.draw(placeholders.data(), placeholders.size(), sf::Triangles, states);
+	}
+
+	for (const auto& [texture, vertices] : batches)
+	{
+		sf::RenderStates pageStates = states;
+		pageStates.texture = texture;
+		target.draw(vertices.data(), vertices.size(), sf::Triangles, pageStates);
+	}
+
+	if (this->m_selected >= first && this->m_selected < last)
+	{
+		float top = std::max(Spacing + (this->m_selected / columns) * cellSize - this->m_scroll, 1.f);
+		float bottom = std::min(Spacing + (this->m_selected / columns) * cellSize - this->m_scroll + thumbnailSize, this->m_size.y - 1.f);
+		sf::RectangleShape outline(sf::Vector2f(thumbnailSize - 2.f, std::max(bottom - top - 2.f, 0.f)));
+		outline.setPosition(Spacing + (this->m_selected % columns) * cellSize + 1.f, top + 1.f);
+		outline.setFillColor(sf::Color::Transparent);
+		outline.setOutlineColor(sf::Color::White);
+		outline.setOutlineThickness(1.f);
+		target.draw(outline, states);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+float AssetBrowser::getCellSize() const
+{
+	return static_cast<float>(this->m_cache->getThumbnailSize()) + Spacing;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetBrowser::getColumnCount() const
+{
+	return std::max(static_cast<std::size_t>((this->m_size.x - Spacing) / getCellSize()), std::size_t(1));
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetBrowser::getVisibleRange(std::size_t& first, std::size_t& last) const
+{
+	float cellSize = getCellSize();
+	std::size_t columns = getColumnCount();
+	first = std::min(static_cast<std::size_t>(this->m_scroll / cellSize) * columns, this->m_items.size());
+	last = std::min(static_cast<std::size_t>(std::ceil((this->m_scroll + this->m_size.y) / cellSize)) * columns, this->m_items.size());
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetBrowser::onScrolledControl(sf::Event::MouseWheelScrollEvent mouseWheelScroll)
+{
+	if (mouseWheelScroll.wheel == sf::Mouse::VerticalWheel)
+	{
+		setScroll(this->m_scroll - mouseWheelScroll.delta * getCellSize());
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetBrowser::onClicked(sf::Mouse::Button button, sf::Vector2f worldPos)
+{
+	if (button != sf::Mouse::Left)
+	{
+		return;
+	}
+
+	sf::Vector2f point = getCombinedTransform().getInverse().transformPoint(worldPos);
+	float cellSize = getCellSize();
+	float column = std::floor((point.x - Spacing) / cellSize);
+	float row = std::floor((point.y + this->m_scroll - Spacing) / cellSize);
+	std::size_t index = static_cast<std::size_t>(std::max(row, 0.f)) * getColumnCount() + static_cast<std::size_t>(std::max(column, 0.f));
+	if (column < 0.f || row < 0.f || column >= getColumnCount() || index >= this->m_items.size())
+	{
+		return;
+	}
+
+	this->m_selected = index;
+	invalidate();
+	this->m_onSelected(*this, this->m_items[index].m_path);
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetBrowser::onReleasedControl(sf::Mouse::Button button, sf::Vector2f worldPos)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetBrowser::onEntered(sf::Vector2f worldPos)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetBrowser::onLeft(sf::Vector2f worldPos)
+{
+}
+
+} //namespace le
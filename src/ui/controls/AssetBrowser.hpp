@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_ASSET_BROWSER_HPP
+#define LEVEL_EDITOR_ASSET_BROWSER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../interfaces/SpriteBasedControl.hpp"
+#include "../../assets/ThumbnailCache.hpp"
+#include "../../utility/Config.hpp"
+#include <filesystem>
+#include <vector>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Control showing the images of a directory as a grid of thumbnails
+///
+/// Only the tiles within the control are looked up and drawn, a
+/// batch of quads per atlas page, so a directory of any size
+/// costs the same to show. Scanning only lists the files, their
+/// size and time of modification are read by update once a tile
+/// comes into view, and tiles without a thumbnail yet show a
+/// placeholder.
+///
+////////////////////////////////////////////////////////////
+class AssetBrowser : public SpriteBasedControl
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param cache      Cache providing the thumbnails
+	/// \param position   Position set to browser
+	/// \param size       Size of browser
+	/// \param onSelected Event raised with the path of the image clicked on
+	///
+	////////////////////////////////////////////////////////////
+	AssetBrowser(ThumbnailCache& cache, const sf::Vector2f& position, const sf::Vector2f& size,
+	Event1<AssetBrowser, const std::filesystem::path&> onSelected = [](AssetBrowser&, const std::filesystem::path&) {});
+
+	////////////////////////////////////////////////////////////
+	/// \brief List the images of a directory and its subdirectories
+	///
+	/// \param directory Directory to show
+	///
+	/// \return Amount of images found
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t scan(const std::filesystem::path& directory);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of images listed
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getItemCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the path of an image listed
+	///
+	/// \param index Index of the image, in the order of the paths
+	///
+	////////////////////////////////////////////////////////////
+	const std::filesystem::path& getItemPath(std::size_t index) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find an image listed
+	///
+	/// \param path Path of the image, as listed by the scan
+	///
+	/// \return Index of the image, the item count if it is not listed
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t findItem(const std::filesystem::path& path) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Select an image and scroll it into view
+	///
+	/// The selected event is not raised.
+	///
+	/// \param index Index of the image
+	///
+	////////////////////////////////////////////////////////////
+	void selectItem(std::size_t index);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scroll the grid
+	///
+	/// \param offset Distance between the top of the grid and the top of the browser
+	///
+	////////////////////////////////////////////////////////////
+	void setScroll(float offset);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the distance between the top of the grid and the top of the browser
+	///
+	////////////////////////////////////////////////////////////
+	float getScroll() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a point is within the browser
+	///
+	/// \param x X coordinate of the point
+	/// \param y Y coordinate of the point
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool contains(float x, float y) const override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Read the size and time of the images in view
+	///
+	/// Scheduled when images come into view, the tiles of images
+	/// not read yet are drawn as placeholders.
+	///
+	////////////////////////////////////////////////////////////
+	virtual void update() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the tiles within the browser
+	///
+	/// \param target Render target to draw to
+	/// \param states Current render states
+	///
+	////////////////////////////////////////////////////////////
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Image file listed by the browser
+	///
+	////////////////////////////////////////////////////////////
+	struct Item
+	{
+		std::filesystem::path m_path;     //!< Path of the file
+		sf::Uint64            m_size;     //!< Size of the file in bytes
+		sf::Int64             m_modified; //!< Time of the last write of the file
+		bool                  m_known;    //!< Size and time were read
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the distance between two rows of tiles
+	///
+	////////////////////////////////////////////////////////////
+	float getCellSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of tiles per row
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getColumnCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the range of images in view
+	///
+	/// \param first Index of the first image in view
+	/// \param last  Index past the last image in view
+	///
+	////////////////////////////////////////////////////////////
+	void getVisibleRange(std::size_t& first, std::size_t& last) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when the mouse wheel is scrolled
+	///        while the browser is being hovered
+	///
+	/// \param mouseWheelScroll Mouse wheel scroll event
+	///
+	////////////////////////////////////////////////////////////
+	void onScrolledControl(sf::Event::MouseWheelScrollEvent mouseWheelScroll) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when a mouse button is pressed
+	///        while the browser is being hovered
+	///
+	/// \param button   Mouse button that was pressed
+	/// \param worldPos Position of the cursor
+	///
+	////////////////////////////////////////////////////////////
+	void onClicked(sf::Mouse::Button button, sf::Vector2f worldPos) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when a mouse button is released
+	///        while the browser is being hovered
+	///
+	/// \param button   Mouse button that was released
+	/// \param worldPos Position of the cursor
+	///
+	////////////////////////////////////////////////////////////
+	void onReleasedControl(sf::Mouse::Button button, sf::Vector2f worldPos) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when the mouse cursor enters the area of the browser
+	///
+	/// \param worldPos Position of the cursor
+	///
+	////////////////////////////////////////////////////////////
+	void onEntered(sf::Vector2f worldPos) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when the mouse cursor leaves the area of the browser
+	///
+	/// \param worldPos Position of the cursor
+	///
+	////////////////////////////////////////////////////////////
+	void onLeft(sf::Vector2f worldPos) override;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	ThumbnailCache*                                    m_cache;      //!< Cache providing the thumbnails
+	std::vector<Item>                                  m_items;      //!< Images listed, sorted by path
+	float                                              m_scroll;     //!< Distance between the top of the grid and the top of the browser
+	std::size_t                                        m_selected;   //!< Index of the image clicked on, the item count if none
+	Event1<AssetBrowser, const std::filesystem::path&> m_onSelected; //!< Event raised with the path of the image clicked on
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_ASSET_BROWSER_HPP
@@ -32,11 +32,17 @@
 
 namespace le
 {
+////////////////////////////////////////////////////////////
+static const RepeatCurve DefaultRepeatCurve = { sf::milliseconds(400), sf::milliseconds(100), sf::milliseconds(100), 1.f };
+
+
 ////////////////////////////////////////////////////////////
 Button::Button() :
 TextBasedControl::TextBasedControl(),
 m_onReleased(),
-m_onHold()
+m_onHold(),
+m_repeatCurve(DefaultRepeatCurve),
+m_repeatTimer(0)
 {
 };
 
@@ -48,15 +54,58 @@ const sf::String& string, Event0<Button> onReleasedControl, Event0<Button> onHol
 TextBasedControl::TextBasedControl(position, sf::Vector2f(0, 0), size, texture, spriteDefault,
 spriteActive, textTheme, false, enabled),
 m_onReleased(onReleasedControl),
-m_onHold(onHold)
+m_onHold(onHold),
+m_repeatCurve(DefaultRepeatCurve),
+m_repeatTimer(0)
 {
 	this->m_text = LocalizableTextComponent(sf::Vector2f(), sf::Vector2u(size), textTheme->m_default, strings, string);
 }
 
+
 ////////////////////////////////////////////////////////////
-void Button::onHold()
+Button::~Button()
 {
-	this->m_onHold(*this);
+	stopRepeat();
+}
+
+
+////////////////////////////////////////////////////////////
+void Button::setRepeatCurve(const RepeatCurve& curve)
+{
+	this->m_repeatCurve = curve;
+}
+
+
+////////////////////////////////////////////////////////////
+void Button::setEnabled(bool enabled)
+{
+	TextBasedControl::setEnabled(enabled);
+	if (!enabled)
+	{
+		stopRepeat();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void Button::startRepeat()
+{
+	stopRepeat();
+	this->m_repeatTimer = TimerWheel::getDefault().setRepeat(this->m_repeatCurve, [this]()
+	{
+		this->m_onHold(*this);
+	});
+}
+
+
+////////////////////////////////////////////////////////////
+void Button::stopRepeat()
+{
+	if (this->m_repeatTimer)
+	{
+		TimerWheel::getDefault().cancel(this->m_repeatTimer);
+		this->m_repeatTimer = 0;
+	}
 }
 
 
@@ -65,6 +114,8 @@ void Button::onClicked(sf::Mouse::Button button, sf::Vector2f worldPos)
 {
 	TextBasedControl::onClicked(button, worldPos);
 	this->m_sprite.setUseAlt(true);
+	this->m_onHold(*this);
+	startRepeat();
 }
 
 
@@ -77,11 +128,24 @@ void Button::onReleasedControl(sf::Mouse::Button button, sf::Vector2f worldPos)
 }
 
 
+////////////////////////////////////////////////////////////
+void Button::onReleased(sf::Mouse::Button button, sf::Vector2f worldPos)
+{
+	TextBasedControl::onReleased(button, worldPos);
+	stopRepeat();
+}
+
+
 ////////////////////////////////////////////////////////////
 void Button::onEntered(sf::Vector2f worldPos)
 {
 	TextBasedControl::onEntered(worldPos);
 	this->m_sprite.setUseAlt(this->m_holding);
+
+	if (this->m_holding)
+	{
+		startRepeat();
+	}
 }
 
 
@@ -90,6 +154,7 @@ void Button::onLeft(sf::Vector2f worldPos)
 {
 	TextBasedControl::onLeft(worldPos);
 	this->m_sprite.setUseAlt(false);
+	stopRepeat();
 }
 
 } //namespace le
\ No newline at end of file
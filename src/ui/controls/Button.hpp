@@ -32,6 +32,7 @@
 ////////////////////////////////////////////////////////////
 #include "../interfaces/TextBasedControl.hpp"
 #include "../../utility/Config.hpp"
+#include "../../utility/TimerWheel.hpp"
 
 
 namespace le
@@ -64,7 +65,7 @@ public:
 	/// \param strings       List of strings
 	/// \param string        String key
 	/// \param onReleasedControl    Event raised when this button is released
-	/// \param onHold        Event raised when this button is held
+	/// \param onHold        Event raised when this button is pressed and repeatedly while it is held
 	/// \param enable        Enable this button
 	/// 
 	////////////////////////////////////////////////////////////
@@ -72,13 +73,43 @@ public:
 	const sf::IntRect& spriteActive, const TextTheme* textTheme, const Strings* strings, const sf::String& string,
 	Event0<Button> onReleasedControl = [](Button&) {}, Event0<Button> onHold = [](Button&) {}, bool enabled = true);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Cancels the repeat timer of a held button
+	///
+	////////////////////////////////////////////////////////////
+	~Button();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sets the curve used to repeat the onHold event
+	///
+	/// \param curve New repeat curve
+	///
+	////////////////////////////////////////////////////////////
+	void setRepeatCurve(const RepeatCurve& curve);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Enables or disabled the button
+	///
+	/// \param enabled Enable
+	/// 
+	////////////////////////////////////////////////////////////
+	void setEnabled(bool enabled) override;
+
 private:
 
 	////////////////////////////////////////////////////////////
-	/// \brief Event continuously triggered when the mouse button is held
+	/// \brief Start raising the onHold event on the timer wheel
 	///
 	////////////////////////////////////////////////////////////
-	void onHold() override;
+	void startRepeat();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Stop raising the onHold event
+	///
+	////////////////////////////////////////////////////////////
+	void stopRepeat();
 
 	////////////////////////////////////////////////////////////
 	/// \brief Event triggered when a mouse button is pressed
@@ -98,6 +129,14 @@ private:
 	////////////////////////////////////////////////////////////
 	void onReleasedControl(sf::Mouse::Button button, sf::Vector2f worldPos) override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when a mouse button is released
+	/// 
+	/// \param mouseButton Mouse button event parameters
+	///
+	////////////////////////////////////////////////////////////
+	void onReleased(sf::Mouse::Button button, sf::Vector2f worldPos) override;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Event triggered when the mouse cursor enters the area of the button
 	///
@@ -117,8 +156,10 @@ private:
 	////////////////////////////////////////////////////////////
 	// Member data
 	////////////////////////////////////////////////////////////
-	Event0<Button> m_onReleased; //!< Event raised when this button is released
-	Event0<Button> m_onHold;     //!< Event raised when this button is held
+	Event0<Button>  m_onReleased;  //!< Event raised when this button is released
+	Event0<Button>  m_onHold;      //!< Event raised when this button is held
+	RepeatCurve     m_repeatCurve; //!< Curve used to repeat m_onHold while held
+	TimerWheel::Id  m_repeatTimer; //!< Pending repeat timer, 0 if not held
 };
 
 } //namespace le
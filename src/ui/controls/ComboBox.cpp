@@ -113,20 +113,18 @@ void ComboBox::setIndex(size_t index, bool raiseEvent)
 
 
 ////////////////////////////////////////////////////////////
-void ComboBox::setEnabled(bool enabled)
+void ComboBox::setRepeatCurve(const RepeatCurve& curve)
 {
-	Control::setEnabled(enabled);
-	this->m_buttonLeft.setEnabled(enabled);
-	this->m_buttonRight.setEnabled(enabled);
+	this->m_secondaryButtons.setRepeatCurve(curve);
 }
 
 
 ////////////////////////////////////////////////////////////
-void ComboBox::update()
+void ComboBox::setEnabled(bool enabled)
 {
-	Control::update();
-	this->m_buttonLeft.update();
-	this->m_buttonRight.update();
+	Control::setEnabled(enabled);
+	this->m_buttonLeft.setEnabled(enabled);
+	this->m_buttonRight.setEnabled(enabled);
 }
 
 
@@ -147,6 +145,7 @@ bool ComboBox::onWindowEvent(sf::RenderWindow& window, sf::Event event)
 ////////////////////////////////////////////////////////////
 void ComboBox::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
+	setDrawn(states);
 	states.transform *= getTransform();
 	target.draw(this->m_text, states);
 	target.draw(this->m_buttonLeft, states);
@@ -109,18 +109,20 @@ public:
 	void setIndex(size_t index, bool raiseEvent = true);
 
 	////////////////////////////////////////////////////////////
-	/// \brief Enables or disabled the combo box
+	/// \brief Sets the auto-repeat curve of the combo box's buttons
+	///
+	/// \param curve New repeat curve
 	///
-	/// \param enabled Enable
-	/// 
 	////////////////////////////////////////////////////////////
-	void setEnabled(bool enabled) override;
+	void setRepeatCurve(const RepeatCurve& curve);
 
 	////////////////////////////////////////////////////////////
-	/// \brief Updates the control within the application's main thread loop
+	/// \brief Enables or disabled the combo box
 	///
+	/// \param enabled Enable
+	/// 
 	////////////////////////////////////////////////////////////
-	void update() override;
+	void setEnabled(bool enabled) override;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Process sf::Event within the control
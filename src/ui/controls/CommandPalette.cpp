@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "CommandPalette.hpp"
+#include <algorithm>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const float TextShare = 0.75f; //!< Part of the width given to the texts, the rest shows their source
+
+
+////////////////////////////////////////////////////////////
+CommandPalette::CommandPalette(const sf::Vector2f& position, const sf::Vector2f& size, float rowHeight, const sf::Texture& texture,
+const sf::IntRect& spriteDefault, const sf::IntRect& spriteFocused, const TextTheme* textTheme, const InputTextStyle* inputStyle,
+const TextStyle* resultStyle, const std::vector<sf::String>& sourceNames, std::size_t maxResults,
+Event1<CommandPalette, sf::Uint32> onChosen) :
+Control::Control(position, size),
+m_matcher    (),
+m_sources    (),
+m_sourceNames(sourceNames),
+m_maxResults (maxResults),
+m_results    (),
+m_open       (false),
+m_onChosen   (onChosen),
+m_input      (sf::Vector2f(0, 0), sf::Vector2f(size.x, rowHeight), texture, spriteDefault, spriteFocused, textTheme, inputStyle,
+	[this](InputControl&, sf::String query) { search(query); }),
+m_table      (sf::Vector2f(0, rowHeight), sf::Vector2f(size.x, std::max(size.y - rowHeight, rowHeight)), rowHeight, resultStyle,
+	[this](std::size_t row, std::size_t column) { return getCellText(row, column); },
+	[this](Table&, std::size_t row) { choose(row); })
+{
+	this->m_input.setParent(this);
+	this->m_table.setParent(this);
+	this->m_table.setColumns({ { "Name", size.x * TextShare }, { "Kind", size.x * (1.f - TextShare) } });
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 CommandPalette::addEntry(const std::string& text, Source source)
+{
+	this->m_sources.push_back(source);
+	return this->m_matcher.add(text);
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandPalette::clearEntries()
+{
+	this->m_matcher.clear();
+	this->m_sources.clear();
+	this->m_results.clear();
+	this->m_table.setRowCount(0);
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& CommandPalette::getEntryText(sf::Uint32 id) const
+{
+	return this->m_matcher.getText(id);
+}
+
+
+////////////////////////////////////////////////////////////
+CommandPalette::Source CommandPalette::getEntrySource(sf::Uint32 id) const
+{
+	return this->m_sources[id];
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandPalette::open()
+{
+	if (!this->m_open)
+	{
+		this->m_open = true;
+		this->m_input.setString(sf::String(), false);
+		this->m_input.setFocused(true);
+		search(sf::String());
+		invalidate();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandPalette::close()
+{
+	if (this->m_open)
+	{
+		// The area is damaged while it still holds the palette
+		invalidate();
+		this->m_input.setFocused(false);
+		this->m_open = false;
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool CommandPalette::isOpen() const
+{
+	return this->m_open;
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandPalette::refresh()
+{
+	search(this->m_input.getText());
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CommandPalette::getResultCount() const
+{
+	return this->m_results.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CommandPalette::getMatchCount() const
+{
+	return this->m_matcher.getMatchCount();
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 CommandPalette::getResult(std::size_t index) const
+{
+	return index < this->m_results.size() ? this->m_results[index].m_index : NoEntry;
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandPalette::setEnabled(bool enabled)
+{
+	Control::setEnabled(enabled);
+	this->m_input.setEnabled(enabled);
+	this->m_table.setEnabled(enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+bool CommandPalette::onWindowEvent(sf::RenderWindow& window, sf::Event event)
+{
+	if (!this->m_open)
+	{
+		bool isShortcut = event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P && event.key.control && event.key.shift;
+		if (isShortcut && this->m_enabled)
+		{
+			open();
+		}
+
+		return isShortcut && this->m_enabled;
+	}
+
+	bool isAccepted = Control::onWindowEvent(window, event);
+	if (isAccepted && this->m_open)
+	{
+		this->m_input.onWindowEvent(window, event);
+		this->m_table.onWindowEvent(window, event);
+	}
+
+	return isAccepted;
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandPalette::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	if (!this->m_open)
+	{
+		return;
+	}
+
+	setDrawn(states);
+	states.transform *= getTransform();
+	target.draw(this->m_input, states);
+	target.draw(this->m_table, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandPalette::onKeyPressed(sf::Event::KeyEvent key)
+{
+	if (!this->m_enabled)
+	{
+		return;
+	}
+
+	if (key.code == sf::Keyboard::Escape)
+	{
+		close();
+		return;
+	}
+
+	if (this->m_results.empty())
+	{
+		return;
+	}
+
+	// The selection wraps around so that the last result is one key away
+	std::size_t count = this->m_results.size();
+	std::size_t selected = this->m_table.getSelectedRow();
+	if (key.code == sf::Keyboard::Down)
+	{
+		selected = selected == Table::NoRow ? 0 : (selected + 1) % count;
+	}
+	else if (key.code == sf::Keyboard::Up)
+	{
+		selected = selected == Table::NoRow || selected == 0 ? count - 1 : selected - 1;
+	}
+	else if (key.code == sf::Keyboard::Enter)
+	{
+		choose(selected == Table::NoRow ? 0 : selected);
+		return;
+	}
+	else
+	{
+		return;
+	}
+
+	this->m_table.setSelectedRow(selected);
+	this->m_table.scrollToRow(selected);
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandPalette::search(const sf::String& query)
+{
+	std::basic_string<sf::Uint8> utf8 = query.toUtf8();
+	this->m_matcher.match(std::string(utf8.begin(), utf8.end()), this->m_maxResults, this->m_results);
+
+	// The best result is selected, so that return picks it
+	this->m_table.setRowCount(this->m_results.size());
+	this->m_table.setSelectedRow(this->m_results.empty() ? Table::NoRow : 0);
+	this->m_table.setScroll(0.f, 0.0);
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandPalette::choose(std::size_t index)
+{
+	if (index < this->m_results.size())
+	{
+		this->m_onChosen(*this, this->m_results[index].m_index);
+		close();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+sf::String CommandPalette::getCellText(std::size_t row, std::size_t column) const
+{
+	if (row >= this->m_results.size())
+	{
+		return sf::String();
+	}
+
+	sf::Uint32 id = this->m_results[row].m_index;
+	if (column == 0)
+	{
+		const std::string& text = this->m_matcher.getText(id);
+		return sf::String::fromUtf8(text.begin(), text.end());
+	}
+
+	std::size_t source = static_cast<std::size_t>(this->m_sources[id]);
+	return source < this->m_sourceNames.size() ? this->m_sourceNames[source] : sf::String();
+}
+
+} //namespace le
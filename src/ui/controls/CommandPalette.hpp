@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_COMMAND_PALETTE_HPP
+#define LEVEL_EDITOR_COMMAND_PALETTE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "InputControl.hpp"
+#include "Table.hpp"
+#include "../interfaces/Control.hpp"
+#include "../../utility/Config.hpp"
+#include "../../utility/FuzzyMatcher.hpp"
+#include <vector>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Overlay picking a command or an asset by typing
+///
+/// The palette is hidden until opened, by the editor or with
+/// Ctrl+Shift+P. An input at the top takes the query and keeps
+/// the keys typed while the palette is open, a table below lists
+/// the entries best matching it. Entries match when they contain
+/// the letters of the query in order, they are ranked again on
+/// every change of the query.
+///
+/// Up and down move the selection, return chooses the selected
+/// entry and escape closes the palette.
+///
+////////////////////////////////////////////////////////////
+class CommandPalette : public Control, sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Where an entry comes from
+	///
+	////////////////////////////////////////////////////////////
+	enum class Source
+	{
+		Command, //!< Command of the editor
+		Asset    //!< Asset of the project
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Id meaning no entry
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr sf::Uint32 NoEntry = 0xFFFFFFFF;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param position      Position set to palette
+	/// \param size          Size of palette, input and results
+	/// \param rowHeight     Height of the input and of a result
+	/// \param texture       Source texture of the input
+	/// \param spriteDefault Sub-rectangle of the texture to assign to the default sprite of the input
+	/// \param spriteFocused Sub-rectangle of the texture to assign to the focused sprite of the input
+	/// \param textTheme     Text theme of the input
+	/// \param inputStyle    Style of the input
+	/// \param resultStyle   Style of the results
+	/// \param sourceNames   Name shown for every source, in the order of Source
+	/// \param maxResults    Amount of results listed at most
+	/// \param onChosen      Event raised with the id of the entry chosen, before the palette closes
+	///
+	////////////////////////////////////////////////////////////
+	CommandPalette(const sf::Vector2f& position, const sf::Vector2f& size, float rowHeight, const sf::Texture& texture,
+	const sf::IntRect& spriteDefault, const sf::IntRect& spriteFocused, const TextTheme* textTheme, const InputTextStyle* inputStyle,
+	const TextStyle* resultStyle, const std::vector<sf::String>& sourceNames, std::size_t maxResults,
+	Event1<CommandPalette, sf::Uint32> onChosen = [](CommandPalette&, sf::Uint32) {});
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add an entry
+	///
+	/// \param text   UTF-8 text matched and shown
+	/// \param source Where the entry comes from
+	///
+	/// \return Id of the entry
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint32 addEntry(const std::string& text, Source source);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove every entry
+	///
+	////////////////////////////////////////////////////////////
+	void clearEntries();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the text of an entry
+	///
+	/// \param id Id of the entry
+	///
+	////////////////////////////////////////////////////////////
+	const std::string& getEntryText(sf::Uint32 id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get where an entry comes from
+	///
+	/// \param id Id of the entry
+	///
+	////////////////////////////////////////////////////////////
+	Source getEntrySource(sf::Uint32 id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Show the palette with an empty query and focus the input
+	///
+	////////////////////////////////////////////////////////////
+	void open();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Hide the palette
+	///
+	////////////////////////////////////////////////////////////
+	void close();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether the palette is shown
+	///
+	////////////////////////////////////////////////////////////
+	bool isOpen() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Rank the entries again
+	///
+	/// Called when entries were added or removed while open.
+	///
+	////////////////////////////////////////////////////////////
+	void refresh();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of results listed
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getResultCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of entries matching the query
+	///
+	/// Is at least the amount of results listed. Is counted the
+	/// first time it is asked for after the query changes.
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getMatchCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the id of a result
+	///
+	/// \param index Index of the result, best first
+	///
+	/// \return Id of the entry, NoEntry if there is no such result
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint32 getResult(std::size_t index) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Enable or disable the palette
+	///
+	/// \param enabled Enable the palette
+	///
+	////////////////////////////////////////////////////////////
+	virtual void setEnabled(bool enabled) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Handle a window event and pass it to the input and the results
+	///
+	/// While closed, only the shortcut opening the palette is handled.
+	///
+	/// \param window Window the event was raised by
+	/// \param event  Event to handle
+	///
+	/// \return True if the event was handled
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool onWindowEvent(sf::RenderWindow& window, sf::Event event) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the input and the results while open
+	///
+	/// \param target Render target to draw to
+	/// \param states Current render states
+	///
+	////////////////////////////////////////////////////////////
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+protected:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when a key is pressed
+	///
+	/// \param key Key event parameters
+	///
+	////////////////////////////////////////////////////////////
+	void onKeyPressed(sf::Event::KeyEvent key) override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Rank the entries and list the best
+	///
+	/// \param query Text typed
+	///
+	////////////////////////////////////////////////////////////
+	void search(const sf::String& query);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Raise the chosen event with a result and close
+	///
+	/// \param index Index of the result
+	///
+	////////////////////////////////////////////////////////////
+	void choose(std::size_t index);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the text of a cell of the results
+	///
+	/// \param row    Index of the result
+	/// \param column Index of the column
+	///
+	////////////////////////////////////////////////////////////
+	sf::String getCellText(std::size_t row, std::size_t column) const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	FuzzyMatcher                       m_matcher;     //!< Text of every entry, ranked by the query
+	std::vector<Source>                m_sources;     //!< Source of every entry
+	std::vector<sf::String>            m_sourceNames; //!< Name shown for every source
+	std::size_t                        m_maxResults;  //!< Amount of results listed at most
+	std::vector<FuzzyMatcher::Match>   m_results;     //!< Entries listed, best first
+	bool                               m_open;        //!< Palette is shown and takes the keys typed
+	Event1<CommandPalette, sf::Uint32> m_onChosen;    //!< Event raised with the id of the entry chosen
+	InputControl                       m_input;       //!< Input taking the query
+	Table                              m_table;       //!< Table listing the results
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_COMMAND_PALETTE_HPP
@@ -86,6 +86,26 @@ const sf::String& InputControl::getText() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool InputControl::isFocused() const
+{
+	return this->m_focused;
+}
+
+
+////////////////////////////////////////////////////////////
+void InputControl::setFocused(bool focused)
+{
+	if (this->m_focused != focused)
+	{
+		this->m_focused = focused;
+		this->m_sprite.setUseAlt(focused);
+		clearSelection();
+		invalidate();
+	}
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputControl::setString(const sf::String& string, bool raiseEvent)
 {
@@ -103,6 +123,7 @@ void InputControl::setCursor(size_t index)
 		float characterPosition = this->m_text.findCharacterPos(index).x;
 		this->m_cursor.setPosition(characterPosition, 0);
 		this->m_cursorPosition = index;
+		invalidate();
 
 		auto move = [this](float diff)
 		{
@@ -298,6 +319,7 @@ void InputControl::onClicked(sf::Mouse::Button button, sf::Vector2f worldPos)
 	this->m_focused = true;
 	this->m_sprite.setUseAlt(true);
 	clearSelection();
+	invalidate();
 
 	sf::Transform transform = getParentTransform() * getTransform();
 	sf::FloatRect textBounds = this->m_text.getGlobalBounds();
@@ -333,6 +355,11 @@ void InputControl::onClicked(sf::Mouse::Button button, sf::Vector2f worldPos)
 ////////////////////////////////////////////////////////////
 void InputControl::onUnclicked(sf::Mouse::Button button, sf::Vector2f worldPos)
 {
+	if (this->m_focused)
+	{
+		invalidate();
+	}
+
 	this->m_focused = false;
 	this->m_sprite.setUseAlt(false);
 	clearSelection();
@@ -371,6 +398,7 @@ void InputControl::onMovedControl(sf::Vector2f worldPos)
 		this->m_selection.setPosition(selection.first - getPosition().x, 0);
 		this->m_selection.setSize(size);
 		this->m_selected = true;
+		invalidate();
 	}
 }
 
@@ -481,6 +509,11 @@ void InputControl::updateText(size_t offset, sf::String buffer, bool raiseEvent)
 ////////////////////////////////////////////////////////////
 void InputControl::clearSelection()
 {
+	if (this->m_selected)
+	{
+		invalidate();
+	}
+
 	this->m_selected = false;
 	this->m_selectionOffset = 0;
 	this->m_selectionRange = std::make_pair(0, 0);
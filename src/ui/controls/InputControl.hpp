@@ -93,6 +93,22 @@ public:
 	////////////////////////////////////////////////////////////
 	const sf::String& getText() const;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether the input receives the keys typed
+	///
+	////////////////////////////////////////////////////////////
+	bool isFocused() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Give or take the keys typed to the input
+	///
+	/// Lets a parent focus the input without it being clicked.
+	///
+	/// \param focused Input receives the keys typed
+	///
+	////////////////////////////////////////////////////////////
+	void setFocused(bool focused);
+
 	////////////////////////////////////////////////////////////
 	/// \brief Set the text's string
 	///
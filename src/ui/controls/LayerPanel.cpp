@@ -0,0 +1,331 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "LayerPanel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <SFML/Graphics/Sprite.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const float ScaleStep = 8.f;           //!< Layer scales are rounded to 1 / ScaleStep to avoid recreating layers on small zoom changes
+static std::vector<LayerPanel*> panels;       //!< Every existing panel
+static std::size_t memoryBudget = 64 << 20;   //!< Amount of memory all layers may occupy
+static std::size_t memoryUsage = 0;           //!< Amount of memory occupied by all layers
+static sf::Uint64 useCounter = 0;             //!< Stamp given to the next drawn panel
+
+
+////////////////////////////////////////////////////////////
+static std::size_t getTextureMemory(const sf::RenderTexture& texture)
+{
+	sf::Vector2u size = texture.getSize();
+	return static_cast<std::size_t>(size.x) * size.y * 4;
+}
+
+
+////////////////////////////////////////////////////////////
+LayerPanel::LayerPanel() :
+Control::Control(),
+m_controls   (),
+m_visible    (true),
+m_scalePolicy(ScalePolicy::MatchTarget),
+m_scale      (1.f),
+m_cache      (),
+m_cacheScale (0.f),
+m_dirty      (true),
+m_lastUse    (0)
+{
+	panels.push_back(this);
+}
+
+
+////////////////////////////////////////////////////////////
+LayerPanel::LayerPanel(const sf::Vector2f& position, const sf::Vector2f& size) :
+Control::Control(position, size),
+m_controls   (),
+m_visible    (true),
+m_scalePolicy(ScalePolicy::MatchTarget),
+m_scale      (1.f),
+m_cache      (),
+m_cacheScale (0.f),
+m_dirty      (true),
+m_lastUse    (0)
+{
+	panels.push_back(this);
+}
+
+
+////////////////////////////////////////////////////////////
+LayerPanel::~LayerPanel()
+{
+	evictCache();
+	panels.erase(std::find(panels.begin(), panels.end(), this));
+
+	for (Control* control : this->m_controls)
+	{
+		control->setParent(nullptr);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void LayerPanel::addControl(Control& control)
+{
+	control.setParent(this);
+	this->m_controls.push_back(&control);
+	addFullDamage();
+}
+
+
+////////////////////////////////////////////////////////////
+void LayerPanel::removeControl(Control& control)
+{
+	auto it = std::find(this->m_controls.begin(), this->m_controls.end(), &control);
+	if (it != this->m_controls.end())
+	{
+		control.setParent(nullptr);
+		this->m_controls.erase(it);
+		addFullDamage();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void LayerPanel::setVisible(bool visible)
+{
+	if (this->m_visible != visible)
+	{
+		this->m_visible = visible;
+		invalidate();
+		enforceMemoryBudget();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool LayerPanel::isVisible() const
+{
+	return this->m_visible;
+}
+
+
+////////////////////////////////////////////////////////////
+void LayerPanel::setScalePolicy(ScalePolicy policy, float scale)
+{
+	this->m_scalePolicy = policy;
+	this->m_scale = scale;
+	invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+bool LayerPanel::isCached() const
+{
+	return this->m_cache != nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+void LayerPanel::evictCache() const
+{
+	if (this->m_cache)
+	{
+		memoryUsage -= getTextureMemory(*this->m_cache);
+		this->m_cache.reset();
+		this->m_dirty = true;
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void LayerPanel::setMemoryBudget(std::size_t bytes)
+{
+	memoryBudget = bytes;
+	enforceMemoryBudget();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t LayerPanel::getMemoryUsage()
+{
+	return memoryUsage;
+}
+
+
+////////////////////////////////////////////////////////////
+bool LayerPanel::onWindowEvent(sf::RenderWindow& window, sf::Event event)
+{
+	if (!this->m_visible)
+	{
+		return false;
+	}
+
+	bool isAccepted = Control::onWindowEvent(window, event);
+	for (Control* control : this->m_controls)
+	{
+		control->onWindowEvent(window, event);
+	}
+
+	return isAccepted;
+}
+
+
+////////////////////////////////////////////////////////////
+void LayerPanel::addDamage(const sf::FloatRect& rect)
+{
+	addFullDamage();
+}
+
+
+////////////////////////////////////////////////////////////
+void LayerPanel::addFullDamage()
+{
+	this->m_dirty = true;
+	invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void LayerPanel::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	setDrawn(states);
+	if (!this->m_visible)
+	{
+		return;
+	}
+
+	float scale = getLayerScale(target, states.transform);
+	if (!this->m_cache || this->m_cacheScale != scale)
+	{
+		if (!createCache(scale))
+		{
+			return;
+		}
+	}
+
+	if (this->m_dirty)
+	{
+		renderCache();
+	}
+
+	this->m_lastUse = ++useCounter;
+
+	states.transform *= getTransform();
+	states.transform.scale(1.f / scale, 1.f / scale);
+	target.draw(sf::Sprite(this->m_cache->getTexture()), states);
+}
+
+
+////////////////////////////////////////////////////////////
+float LayerPanel::getLayerScale(const sf::RenderTarget& target, const sf::Transform& transform) const
+{
+	float scale = this->m_scale;
+	if (this->m_scalePolicy == ScalePolicy::MatchTarget)
+	{
+		const sf::View& view = target.getView();
+		float pixelsPerUnit = target.getSize().x * view.getViewport().width / view.getSize().x;
+
+		const float* matrix = (transform * getTransform()).getMatrix();
+		scale *= pixelsPerUnit * std::hypot(matrix[0], matrix[1]);
+	}
+
+	return std::max(std::round(scale * ScaleStep), 1.f) / ScaleStep;
+}
+
+
+////////////////////////////////////////////////////////////
+bool LayerPanel::createCache(float scale) const
+{
+	evictCache();
+
+	unsigned int maximumSize = sf::Texture::getMaximumSize();
+	unsigned int width = std::clamp(static_cast<unsigned int>(std::ceil(this->m_size.x * scale)), 1u, maximumSize);
+	unsigned int height = std::clamp(static_cast<unsigned int>(std::ceil(this->m_size.y * scale)), 1u, maximumSize);
+
+	this->m_cache = std::make_unique<sf::RenderTexture>();
+	if (!this->m_cache->create(width, height))
+	{
+		printf("Failed to create the %ux%u layer of a panel\n", width, height);
+		this->m_cache.reset();
+		return false;
+	}
+
+	memoryUsage += getTextureMemory(*this->m_cache);
+	this->m_cacheScale = scale;
+	this->m_dirty = true;
+
+	enforceMemoryBudget();
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void LayerPanel::renderCache() const
+{
+	// The view maps the panel's own space onto the layer, whatever its resolution
+	this->m_cache->setView(sf::View(sf::FloatRect(0.f, 0.f, this->m_size.x, this->m_size.y)));
+	this->m_cache->clear(sf::Color::Transparent);
+
+	DrawScope scope(*this);
+	for (const Control* control : this->m_controls)
+	{
+		this->m_cache->draw(*control);
+	}
+
+	this->m_cache->display();
+	this->m_dirty = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void LayerPanel::enforceMemoryBudget()
+{
+	while (memoryUsage > memoryBudget)
+	{
+		LayerPanel* oldest = nullptr;
+		for (LayerPanel* panel : panels)
+		{
+			if (!panel->m_visible && panel->m_cache && (!oldest || panel->m_lastUse < oldest->m_lastUse))
+			{
+				oldest = panel;
+			}
+		}
+
+		if (!oldest)
+		{
+			break;
+		}
+
+		oldest->evictCache();
+	}
+}
+
+} //namespace le
@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_LAYER_PANEL_HPP
+#define LEVEL_EDITOR_LAYER_PANEL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../interfaces/Control.hpp"
+#include "../rendering/DamageTarget.hpp"
+#include <memory>
+#include <vector>
+#include <SFML/Graphics/RenderTexture.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Container control rendering its children into a cached layer
+///
+/// The children are only redrawn when one of them is damaged,
+/// otherwise the cached layer is drawn as a single quad.
+/// Children are positioned relative to the panel and are not
+/// owned by it, they must outlive the panel or be removed.
+///
+////////////////////////////////////////////////////////////
+class LayerPanel : public Control, public DamageTarget
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Enumeration of the ways the layer resolution is chosen
+	///
+	////////////////////////////////////////////////////////////
+	enum class ScalePolicy
+	{
+		Fixed,      //!< Layer has panel size multiplied by the scale
+		MatchTarget //!< Layer matches the pixels covered on the target, multiplied by the scale
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// This constructor creates an empty panel
+	///
+	////////////////////////////////////////////////////////////
+	LayerPanel();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param position Position set to panel
+	/// \param size     Size of panel
+	///
+	////////////////////////////////////////////////////////////
+	LayerPanel(const sf::Vector2f& position, const sf::Vector2f& size);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~LayerPanel();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a child control
+	///
+	/// \param control Control to add
+	///
+	////////////////////////////////////////////////////////////
+	void addControl(Control& control);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove a child control
+	///
+	/// \param control Control to remove
+	///
+	////////////////////////////////////////////////////////////
+	void removeControl(Control& control);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Show or hide the panel
+	///
+	/// Hidden panels are neither drawn nor receive events.
+	/// Their layer is kept until the memory budget is exceeded.
+	///
+	/// \param visible Visible
+	///
+	////////////////////////////////////////////////////////////
+	void setVisible(bool visible);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether the panel is visible
+	///
+	////////////////////////////////////////////////////////////
+	bool isVisible() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set how the resolution of the layer is chosen
+	///
+	/// \param policy Scale policy
+	/// \param scale  Scale applied on top of the policy
+	///
+	////////////////////////////////////////////////////////////
+	void setScalePolicy(ScalePolicy policy, float scale = 1.f);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether the layer is currently allocated
+	///
+	////////////////////////////////////////////////////////////
+	bool isCached() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Release the layer, it is recreated on the next draw
+	///
+	////////////////////////////////////////////////////////////
+	void evictCache() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the amount of memory all layers may occupy
+	///
+	/// Layers of hidden panels are evicted, least recently drawn
+	/// first, while the budget is exceeded.
+	///
+	/// \param bytes Budget in bytes
+	///
+	////////////////////////////////////////////////////////////
+	static void setMemoryBudget(std::size_t bytes);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of memory occupied by all layers
+	///
+	////////////////////////////////////////////////////////////
+	static std::size_t getMemoryUsage();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Process sf::Event within the panel and its children
+	///
+	/// \param window Respective window
+	/// \param event  Event that was triggered
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool onWindowEvent(sf::RenderWindow& window, sf::Event event) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark the layer to be redrawn
+	///
+	/// \param rect Damaged rectangle in the coordinates of the panel
+	///
+	////////////////////////////////////////////////////////////
+	virtual void addDamage(const sf::FloatRect& rect) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark the layer to be redrawn
+	///
+	////////////////////////////////////////////////////////////
+	virtual void addFullDamage() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the panel to a render target
+	///
+	/// \param target Render target to draw to
+	/// \param states Current render states
+	///
+	////////////////////////////////////////////////////////////
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the scale the layer has to be rendered at
+	///
+	/// \param target    Render target the panel is drawn to
+	/// \param transform Parent transform of the panel
+	///
+	////////////////////////////////////////////////////////////
+	float getLayerScale(const sf::RenderTarget& target, const sf::Transform& transform) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Allocate the layer for a scale
+	///
+	/// \param scale Scale of the layer
+	///
+	/// \return True if the layer has been created successfully
+	///
+	////////////////////////////////////////////////////////////
+	bool createCache(float scale) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Redraw the children into the layer
+	///
+	////////////////////////////////////////////////////////////
+	void renderCache() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Evict layers of hidden panels while the budget is exceeded
+	///
+	////////////////////////////////////////////////////////////
+	static void enforceMemoryBudget();
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::vector<Control*>                      m_controls;    //!< Child controls
+	bool                                       m_visible;     //!< Panel is drawn and receives events
+	ScalePolicy                                m_scalePolicy; //!< Way the layer resolution is chosen
+	float                                      m_scale;       //!< Scale applied on top of the policy
+	mutable std::unique_ptr<sf::RenderTexture> m_cache;       //!< Cached layer
+	mutable float                              m_cacheScale;  //!< Scale the layer was created for
+	mutable bool                               m_dirty;       //!< Layer has to be redrawn
+	mutable sf::Uint64                         m_lastUse;     //!< Stamp of the last draw, used for eviction order
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_LAYER_PANEL_HPP
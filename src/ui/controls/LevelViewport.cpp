@@ -0,0 +1,410 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "LevelViewport.hpp"
+#include "../../utility/FrameScheduler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <SFML/Window/Keyboard.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const float MinZoom = 1.f / 16.f; //!< Closest zoom in level units per screen pixel
+static const float MaxZoom = 8192.f;     //!< Farthest zoom in level units per screen pixel
+static const float ZoomStep = 1.25f;     //!< Factor applied per mouse wheel notch
+static const float MaxEntityZoom = 4.f;  //!< Farthest zoom at which entities are outlined
+static const float LassoSpacing = 4.f;   //!< Screen pixels the cursor moves before the lasso gets a new vertex
+
+
+////////////////////////////////////////////////////////////
+LevelViewport::LevelViewport(const Level& level, const sf::Vector2f& position, const sf::Vector2f& size) :
+Control::Control(position, size),
+m_level    (&level),
+m_center   (size / 2.f),
+m_zoom     (1.f),
+m_panning  (false),
+m_panPixel (),
+m_hovered  (EntityStore::NoEntity),
+m_selection(),
+m_shape    (SelectionShape::None),
+m_points   (),
+m_tool     (nullptr),
+m_visible  (),
+m_outlines ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void LevelViewport::setSize(const sf::Vector2f& size)
+{
+	this->m_size = size;
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void LevelViewport::setCenter(const sf::Vector2f& center)
+{
+	this->m_center = center;
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+const sf::Vector2f& LevelViewport::getCenter() const
+{
+	return this->m_center;
+}
+
+
+////////////////////////////////////////////////////////////
+void LevelViewport::setZoom(float zoom)
+{
+	this->m_zoom = std::clamp(zoom, MinZoom, MaxZoom);
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+float LevelViewport::getZoom() const
+{
+	return this->m_zoom;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::View LevelViewport::getCamera(const sf::RenderTarget& target) const
+{
+	return getCamera(target, getParentTransform());
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Vector2f LevelViewport::mapPixelToWorld(const sf::RenderTarget& target, const sf::Vector2i& pixel) const
+{
+	return target.mapPixelToCoords(pixel, getCamera(target));
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Vector2i LevelViewport::mapPixelToTile(const sf::RenderTarget& target, const sf::Vector2i& pixel) const
+{
+	sf::Vector2f world = mapPixelToWorld(target, pixel);
+	sf::Vector2f tileSize(this->m_level->getTileset().getTileSize());
+	return sf::Vector2i(static_cast<int>(std::floor(world.x / tileSize.x)), static_cast<int>(std::floor(world.y / tileSize.y)));
+}
+
+
+////////////////////////////////////////////////////////////
+sf::IntRect LevelViewport::getVisibleTiles(const sf::RenderTarget& target) const
+{
+	sf::View camera = getCamera(target);
+	sf::Vector2f topLeft = camera.getCenter() - camera.getSize() / 2.f;
+	sf::Vector2f bottomRight = camera.getCenter() + camera.getSize() / 2.f;
+	sf::Vector2f tileSize(this->m_level->getTileset().getTileSize());
+
+	sf::Vector2i first(static_cast<int>(std::floor(topLeft.x / tileSize.x)), static_cast<int>(std::floor(topLeft.y / tileSize.y)));
+	sf::Vector2i last(static_cast<int>(std::ceil(bottomRight.x / tileSize.x)), static_cast<int>(std::ceil(bottomRight.y / tileSize.y)));
+	return sf::IntRect(first, last - first);
+}
+
+
+////////////////////////////////////////////////////////////
+void LevelViewport::setTool(Tool* tool)
+{
+	this->m_tool = tool;
+}
+
+
+////////////////////////////////////////////////////////////
+Tool* LevelViewport::getTool() const
+{
+	return this->m_tool;
+}
+
+
+////////////////////////////////////////////////////////////
+EntityId LevelViewport::getHoveredEntity() const
+{
+	return this->m_level->getEntities().get(this->m_hovered) ? this->m_hovered : EntityStore::NoEntity;
+}
+
+
+////////////////////////////////////////////////////////////
+const BitSet& LevelViewport::getSelection() const
+{
+	return this->m_selection;
+}
+
+
+////////////////////////////////////////////////////////////
+void LevelViewport::clearSelection()
+{
+	this->m_selection.clear();
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelViewport::isSelecting() const
+{
+	return this->m_shape != SelectionShape::None;
+}
+
+
+////////////////////////////////////////////////////////////
+bool LevelViewport::onWindowEvent(sf::RenderWindow& window, sf::Event event)
+{
+	bool isAccepted = Control::onWindowEvent(window, event);
+	if (!this->m_enabled)
+	{
+		return isAccepted;
+	}
+
+	switch (event.type)
+	{
+		case sf::Event::MouseWheelScrolled:
+			if (this->m_hovering)
+			{
+				sf::Vector2i pixel(event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+				zoomAt(window, pixel, std::pow(ZoomStep, -event.mouseWheelScroll.delta));
+			}
+			break;
+
+		case sf::Event::MouseButtonPressed:
+			if (this->m_hovering && event.mouseButton.button == sf::Mouse::Middle)
+			{
+				this->m_panning = true;
+				this->m_panPixel = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+			}
+
+			if (this->m_hovering && event.mouseButton.button == sf::Mouse::Left && (sf::Keyboard::isKeyPressed(sf::Keyboard::LShift) || sf::Keyboard::isKeyPressed(sf::Keyboard::LAlt)))
+			{
+				sf::Vector2i pixel(event.mouseButton.x, event.mouseButton.y);
+				this->m_shape = sf::Keyboard::isKeyPressed(sf::Keyboard::LShift) ? SelectionShape::Marquee : SelectionShape::Lasso;
+				this->m_points.assign(1, mapPixelToWorld(window, pixel));
+				updateSelection(window, pixel);
+			}
+
+			if (this->m_hovering && this->m_tool && this->m_shape == SelectionShape::None && event.mouseButton.button != sf::Mouse::Middle)
+			{
+				this->m_tool->onPressed(mapPixelToTile(window, sf::Vector2i(event.mouseButton.x, event.mouseButton.y)), event.mouseButton.button);
+			}
+			break;
+
+		case sf::Event::MouseButtonReleased:
+			if (event.mouseButton.button == sf::Mouse::Middle)
+			{
+				this->m_panning = false;
+			}
+
+			if (event.mouseButton.button == sf::Mouse::Left && this->m_shape != SelectionShape::None)
+			{
+				this->m_shape = SelectionShape::None;
+				FrameScheduler::getDefault().invalidate();
+			}
+			else if (this->m_hovering && this->m_tool && event.mouseButton.button != sf::Mouse::Middle)
+			{
+				this->m_tool->onReleased(mapPixelToTile(window, sf::Vector2i(event.mouseButton.x, event.mouseButton.y)), event.mouseButton.button);
+			}
+			break;
+
+		case sf::Event::MouseMoved:
+			if (this->m_panning)
+			{
+				sf::Vector2i pixel(event.mouseMove.x, event.mouseMove.y);
+				setCenter(this->m_center + mapPixelToWorld(window, this->m_panPixel) - mapPixelToWorld(window, pixel));
+				this->m_panPixel = pixel;
+			}
+
+			if (this->m_shape != SelectionShape::None)
+			{
+				updateSelection(window, sf::Vector2i(event.mouseMove.x, event.mouseMove.y));
+			}
+
+			updateHover(window, sf::Vector2i(event.mouseMove.x, event.mouseMove.y));
+			break;
+
+		default:
+			break;
+	}
+
+	return isAccepted;
+}
+
+
+////////////////////////////////////////////////////////////
+void LevelViewport::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	sf::View previous = target.getView();
+	sf::View camera = getCamera(target, states.transform);
+	target.setView(camera);
+	target.draw(*this->m_level);
+	drawEntities(target, camera);
+	target.setView(previous);
+}
+
+
+////////////////////////////////////////////////////////////
+sf::View LevelViewport::getCamera(const sf::RenderTarget& target, const sf::Transform& transform) const
+{
+	// Area covered on the target in pixels, through the view the viewport itself is drawn with
+	sf::FloatRect bounds = transform.transformRect(getBounds());
+	sf::Vector2i topLeft = target.mapCoordsToPixel(sf::Vector2f(bounds.left, bounds.top));
+	sf::Vector2i bottomRight = target.mapCoordsToPixel(sf::Vector2f(bounds.left + bounds.width, bounds.top + bounds.height));
+	sf::Vector2f pixels(static_cast<float>(std::max(bottomRight.x - topLeft.x, 1)), static_cast<float>(std::max(bottomRight.y - topLeft.y, 1)));
+	sf::Vector2f targetSize(target.getSize());
+
+	sf::View camera(this->m_center, pixels * this->m_zoom);
+	camera.setViewport(sf::FloatRect(topLeft.x / targetSize.x, topLeft.y / targetSize.y, pixels.x / targetSize.x, pixels.y / targetSize.y));
+	return camera;
+}
+
+
+////////////////////////////////////////////////////////////
+void LevelViewport::zoomAt(const sf::RenderTarget& target, const sf::Vector2i& pixel, float factor)
+{
+	sf::Vector2f before = mapPixelToWorld(target, pixel);
+	this->m_zoom = std::clamp(this->m_zoom * factor, MinZoom, MaxZoom);
+	sf::Vector2f after = mapPixelToWorld(target, pixel);
+	setCenter(this->m_center + before - after);
+}
+
+
+////////////////////////////////////////////////////////////
+void LevelViewport::updateHover(const sf::RenderTarget& target, const sf::Vector2i& pixel)
+{
+	EntityId hovered = EntityStore::NoEntity;
+	if (this->m_hovering)
+	{
+		hovered = this->m_level->getEntities().pick(mapPixelToWorld(target, pixel));
+	}
+
+	if (hovered != this->m_hovered)
+	{
+		this->m_hovered = hovered;
+		FrameScheduler::getDefault().invalidate();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void LevelViewport::updateSelection(const sf::RenderTarget& target, const sf::Vector2i& pixel)
+{
+	sf::Vector2f point = mapPixelToWorld(target, pixel);
+	if (this->m_shape == SelectionShape::Marquee)
+	{
+		this->m_points.resize(1);
+		this->m_points.push_back(point);
+	}
+	else
+	{
+		sf::Vector2f offset = (point - this->m_points.back()) / this->m_zoom;
+		if (offset.x * offset.x + offset.y * offset.y < LassoSpacing * LassoSpacing && this->m_points.size() > 1)
+		{
+			return;
+		}
+
+		this->m_points.push_back(point);
+	}
+
+	// The whole selection is recomputed, the hierarchy keeps it fast enough to follow the cursor
+	this->m_selection.clear();
+	if (this->m_shape == SelectionShape::Marquee)
+	{
+		sf::Vector2f min(std::min(this->m_points[0].x, point.x), std::min(this->m_points[0].y, point.y));
+		sf::Vector2f max(std::max(this->m_points[0].x, point.x), std::max(this->m_points[0].y, point.y));
+		this->m_level->getEntities().selectRect(sf::FloatRect(min, max - min), this->m_selection);
+	}
+	else
+	{
+		this->m_level->getEntities().selectLasso(this->m_points, this->m_selection);
+	}
+
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void LevelViewport::drawEntities(sf::RenderTarget& target, const sf::View& camera) const
+{
+	const EntityStore& entities = this->m_level->getEntities();
+	sf::Vector2f size = camera.getSize();
+	this->m_visible.clear();
+	this->m_outlines.clear();
+	if (this->m_zoom <= MaxEntityZoom)
+	{
+		entities.queryRect(sf::FloatRect(camera.getCenter() - size / 2.f, size), this->m_visible);
+	}
+
+	for (EntityId id : this->m_visible)
+	{
+		const sf::FloatRect& bounds = entities.get(id)->m_bounds;
+		sf::Color color = id == this->m_hovered ? sf::Color::Yellow : this->m_selection.test(id) ? sf::Color::Cyan : sf::Color(255, 255, 255, 160);
+		sf::Vector2f corners[4] =
+		{
+			sf::Vector2f(bounds.left, bounds.top),
+			sf::Vector2f(bounds.left + bounds.width, bounds.top),
+			sf::Vector2f(bounds.left + bounds.width, bounds.top + bounds.height),
+			sf::Vector2f(bounds.left, bounds.top + bounds.height)
+		};
+
+		for (int i = 0; i < 4; i++)
+		{
+			this->m_outlines.push_back(sf::Vertex(corners[i], color));
+			this->m_outlines.push_back(sf::Vertex(corners[(i + 1) % 4], color));
+		}
+	}
+
+	// The marquee is stored as its two opposite corners, the lasso as its vertices
+	if (this->m_shape != SelectionShape::None)
+	{
+		std::vector<sf::Vector2f> shape = this->m_points;
+		if (this->m_shape == SelectionShape::Marquee && shape.size() == 2)
+		{
+			shape = { shape[0], sf::Vector2f(shape[1].x, shape[0].y), shape[1], sf::Vector2f(shape[0].x, shape[1].y) };
+		}
+
+		for (std::size_t i = 0; i < shape.size(); i++)
+		{
+			this->m_outlines.push_back(sf::Vertex(shape[i], sf::Color::Cyan));
+			this->m_outlines.push_back(sf::Vertex(shape[(i + 1) % shape.size()], sf::Color::Cyan));
+		}
+	}
+
+	if (!this->m_outlines.empty())
+	{
+		target.draw(this->m_outlines.data(), this->m_outlines.size(), sf::Lines);
+	}
+}
+
+} //namespace le
@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_LEVEL_VIEWPORT_HPP
+#define LEVEL_EDITOR_LEVEL_VIEWPORT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../interfaces/Control.hpp"
+#include "../../level/Level.hpp"
+#include "../../tools/Tool.hpp"
+#include "../../utility/BitSet.hpp"
+#include <vector>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Control showing a level through a movable camera
+///
+/// The middle mouse button pans the camera, the mouse wheel zooms
+/// around the cursor. Layers only draw the chunks overlapping the
+/// camera and switch to impostors once zoomed out far enough.
+/// Entities are outlined while zoomed in, the one under the
+/// cursor is highlighted. Dragging the left mouse button with
+/// shift held selects the entities in a rectangle, with alt held
+/// those inside a lasso drawn by the cursor. Other clicks on the
+/// level are handed to the current tool, if any.
+/// The level changes with every pan, so the viewport is drawn
+/// directly to the window rather than through a UiCompositor.
+///
+////////////////////////////////////////////////////////////
+class LevelViewport : public Control
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param level    Level to show
+	/// \param position Position set to viewport
+	/// \param size     Size of viewport
+	///
+	////////////////////////////////////////////////////////////
+	LevelViewport(const Level& level, const sf::Vector2f& position, const sf::Vector2f& size);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the size of the viewport
+	///
+	/// \param size Size of viewport
+	///
+	////////////////////////////////////////////////////////////
+	void setSize(const sf::Vector2f& size);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the point of the level shown at the viewport's center
+	///
+	/// \param center Center in level coordinates
+	///
+	////////////////////////////////////////////////////////////
+	void setCenter(const sf::Vector2f& center);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the point of the level shown at the viewport's center
+	///
+	////////////////////////////////////////////////////////////
+	const sf::Vector2f& getCenter() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the zoom factor
+	///
+	/// \param zoom Level units per screen pixel, clamped to the supported range
+	///
+	////////////////////////////////////////////////////////////
+	void setZoom(float zoom);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the zoom factor in level units per screen pixel
+	///
+	////////////////////////////////////////////////////////////
+	float getZoom() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the camera covering the viewport's area on a target
+	///
+	/// \param target Render target whose current view positions the viewport
+	///
+	////////////////////////////////////////////////////////////
+	sf::View getCamera(const sf::RenderTarget& target) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Convert a target pixel to level coordinates
+	///
+	/// \param target Render target whose current view positions the viewport
+	/// \param pixel  Pixel to convert
+	///
+	////////////////////////////////////////////////////////////
+	sf::Vector2f mapPixelToWorld(const sf::RenderTarget& target, const sf::Vector2i& pixel) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the tile of the level under a target pixel
+	///
+	/// \param target Render target whose current view positions the viewport
+	/// \param pixel  Pixel to convert
+	///
+	////////////////////////////////////////////////////////////
+	sf::Vector2i mapPixelToTile(const sf::RenderTarget& target, const sf::Vector2i& pixel) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the tiles of the level covered by the viewport
+	///
+	/// \param target Render target whose current view positions the viewport
+	///
+	/// \return Tile coordinates and amount of tiles
+	///
+	////////////////////////////////////////////////////////////
+	sf::IntRect getVisibleTiles(const sf::RenderTarget& target) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the tool receiving the clicks on the level
+	///
+	/// The tool must outlive the viewport or be replaced.
+	///
+	/// \param tool Tool, nullptr to leave the clicks to the caller
+	///
+	////////////////////////////////////////////////////////////
+	void setTool(Tool* tool);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the tool receiving the clicks on the level
+	///
+	////////////////////////////////////////////////////////////
+	Tool* getTool() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the entity under the cursor
+	///
+	/// \return Identifier of the entity, EntityStore::NoEntity if there is none
+	///
+	////////////////////////////////////////////////////////////
+	EntityId getHoveredEntity() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the selected entities
+	///
+	/// \return Set holding a bit per selected entity identifier
+	///
+	////////////////////////////////////////////////////////////
+	const BitSet& getSelection() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deselect every entity
+	///
+	////////////////////////////////////////////////////////////
+	void clearSelection();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a rectangle or a lasso is being dragged
+	///
+	////////////////////////////////////////////////////////////
+	bool isSelecting() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Process sf::Event, panning and zooming the camera
+	///
+	/// \param window Window the event was triggered in
+	/// \param event  Event that was triggered
+	///
+	/// \return True if the event was accepted
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool onWindowEvent(sf::RenderWindow& window, sf::Event event) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the level through the camera
+	///
+	/// \param target Render target to draw to
+	/// \param states Current render states
+	///
+	////////////////////////////////////////////////////////////
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Shapes the entities can be selected with
+	///
+	////////////////////////////////////////////////////////////
+	enum class SelectionShape
+	{
+		None,    //!< No selection is being dragged
+		Marquee, //!< Rectangle spanned from the point the drag started at
+		Lasso    //!< Polygon following the cursor
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the camera covering the viewport's area on a target
+	///
+	/// \param target    Render target whose current view positions the viewport
+	/// \param transform Parent transform of the viewport
+	///
+	////////////////////////////////////////////////////////////
+	sf::View getCamera(const sf::RenderTarget& target, const sf::Transform& transform) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Zoom while keeping the level point under a pixel in place
+	///
+	/// \param target Render target whose current view positions the viewport
+	/// \param pixel  Pixel to zoom around
+	/// \param factor Factor applied to the zoom
+	///
+	////////////////////////////////////////////////////////////
+	void zoomAt(const sf::RenderTarget& target, const sf::Vector2i& pixel, float factor);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Update the entity under the cursor
+	///
+	/// \param target Render target whose current view positions the viewport
+	/// \param pixel  Pixel the cursor is at
+	///
+	////////////////////////////////////////////////////////////
+	void updateHover(const sf::RenderTarget& target, const sf::Vector2i& pixel);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Extend the dragged selection shape and select the entities it covers
+	///
+	/// \param target Render target whose current view positions the viewport
+	/// \param pixel  Pixel the cursor is at
+	///
+	////////////////////////////////////////////////////////////
+	void updateSelection(const sf::RenderTarget& target, const sf::Vector2i& pixel);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the outlines of the entities visible through a camera
+	///
+	/// The selection shape being dragged is drawn on top.
+	///
+	/// \param target Render target to draw to
+	/// \param camera Camera the level is drawn through
+	///
+	////////////////////////////////////////////////////////////
+	void drawEntities(sf::RenderTarget& target, const sf::View& camera) const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	const Level*                    m_level;     //!< Level shown
+	sf::Vector2f                    m_center;    //!< Level point shown at the center
+	float                           m_zoom;      //!< Level units per screen pixel
+	bool                            m_panning;   //!< Middle mouse button is dragging the camera
+	sf::Vector2i                    m_panPixel;  //!< Pixel the camera was last dragged from
+	EntityId                        m_hovered;   //!< Entity under the cursor
+	BitSet                          m_selection; //!< Bit per selected entity identifier
+	SelectionShape                  m_shape;     //!< Selection shape being dragged
+	std::vector<sf::Vector2f>       m_points;    //!< Corners of the marquee or vertices of the lasso in level coordinates
+	Tool*                           m_tool;      //!< Tool receiving the clicks on the level, nullptr if none
+	mutable std::vector<EntityId>   m_visible;   //!< Entities found by the last draw, kept to reuse its memory
+	mutable std::vector<sf::Vertex> m_outlines;  //!< Outline vertices of the last draw, kept to reuse its memory
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_LEVEL_VIEWPORT_HPP
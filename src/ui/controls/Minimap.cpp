@@ -0,0 +1,545 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Minimap.hpp"
+#include "../../utility/JobSystem.hpp"
+#include <algorithm>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+Minimap::Minimap(const Level& level, const sf::Vector2f& position, const sf::Vector2f& size, Event1<Minimap, const sf::Vector2f&> onJump) :
+SpriteBasedControl::SpriteBasedControl(),
+m_level     (&level),
+m_tileColors(),
+m_cells     (),
+m_texture   (),
+m_shown     (0),
+m_origin    (0, 0),
+m_relayout  (true),
+m_dirty     (),
+m_dirtyList (),
+m_camera    (),
+m_onJump    (onJump)
+{
+	// The texture is a member, so the sprite can only be pointed at it once it exists
+	sf::Vector2u pixels(static_cast<unsigned int>(std::max(size.x, 1.f)), static_cast<unsigned int>(std::max(size.y, 1.f)));
+	this->m_texture.create(pixels.x, pixels.y);
+	this->m_sprite = SpriteComponent(sf::Vector2f(), this->m_texture, sf::IntRect(0, 0, pixels.x, pixels.y));
+	this->m_dirty.resize(static_cast<std::size_t>(pixels.x) * pixels.y);
+	this->m_size = size;
+	this->m_enabled = true;
+	setPosition(position);
+
+	loadTileColors();
+	rebuild();
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::rebuild()
+{
+	for (CoordMap<Cell>& cells : this->m_cells)
+	{
+		cells.clear();
+	}
+
+	// Chunks held in memory are summed in parallel, then merged across layers into level 0, the others are added as they load
+	std::vector<std::pair<sf::Vector2i, const TileChunk*>> chunks;
+	for (std::size_t i = 0; i < this->m_level->getLayerCount(); i++)
+	{
+		for (const TileLayer::ChunkEntry& entry : this->m_level->getLayer(i).getChunks())
+		{
+			if (entry.m_value)
+			{
+				chunks.emplace_back(entry.m_key, entry.m_value.get());
+			}
+		}
+	}
+
+	std::vector<Cell> sums(chunks.size());
+	JobSystem::getDefault().parallelFor(chunks.size(), [&](std::size_t i)
+	{
+		sums[i] = sumChunk(*chunks[i].second);
+	});
+
+	for (std::size_t i = 0; i < chunks.size(); i++)
+	{
+		if (sums[i].m_count == 0)
+		{
+			continue;
+		}
+
+		Cell& cell = this->m_cells[0][chunks[i].first];
+		for (int channel = 0; channel < 4; channel++)
+		{
+			cell.m_color[channel] += sums[i].m_color[channel];
+		}
+
+		cell.m_count += sums[i].m_count;
+	}
+
+	for (int level = 1; level < LevelCount; level++)
+	{
+		for (const CoordMap<Cell>::Entry& entry : this->m_cells[level - 1].getEntries())
+		{
+			Cell& cell = this->m_cells[level][sf::Vector2i(entry.m_key.x >> 1, entry.m_key.y >> 1)];
+			for (int channel = 0; channel < 4; channel++)
+			{
+				cell.m_color[channel] += entry.m_value.m_color[channel];
+			}
+
+			cell.m_count += entry.m_value.m_count;
+		}
+	}
+
+	this->m_relayout = true;
+	invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::refreshColors()
+{
+	loadTileColors();
+	rebuild();
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::applyChange(const Level::TileChange& change)
+{
+	const TileLayer::TileChange& run = change.m_change;
+	Cell delta;
+	if (run.m_tile != Tileset::Empty && run.m_tile < this->m_tileColors.size())
+	{
+		for (int channel = 0; channel < 4; channel++)
+		{
+			delta.m_color[channel] += this->m_tileColors[run.m_tile][channel];
+		}
+
+		delta.m_count++;
+	}
+
+	if (run.m_previousTile != Tileset::Empty && run.m_previousTile < this->m_tileColors.size())
+	{
+		for (int channel = 0; channel < 4; channel++)
+		{
+			delta.m_color[channel] -= this->m_tileColors[run.m_previousTile][channel];
+		}
+
+		delta.m_count--;
+	}
+
+	if (delta.m_count == 0 && delta.m_color == Cell().m_color)
+	{
+		return;
+	}
+
+	// Every tile of the run changed the same way, the difference is scaled by the tiles falling in each chunk
+	int end = run.m_position.x + run.m_length;
+	for (int x = run.m_position.x; x < end;)
+	{
+		sf::Vector2i chunk = TileLayer::getChunkCoords(sf::Vector2i(x, run.m_position.y));
+		int next = std::min(end, (chunk.x + 1) * TileChunk::Size);
+		Cell scaled;
+		for (int channel = 0; channel < 4; channel++)
+		{
+			scaled.m_color[channel] = delta.m_color[channel] * (next - x);
+		}
+
+		scaled.m_count = delta.m_count * (next - x);
+		addDelta(chunk, scaled);
+		x = next;
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::applyChunk(const Level::ChunkLoad& load)
+{
+	const TileChunk* chunk = this->m_level->getLayer(load.m_layer).getChunk(load.m_chunk.x, load.m_chunk.y);
+	Cell sum = sumChunk(*chunk);
+	if (sum.m_count > 0)
+	{
+		addDelta(load.m_chunk, sum);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::setCamera(const sf::FloatRect& area)
+{
+	if (area != this->m_camera)
+	{
+		this->m_camera = area;
+		invalidate();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+int Minimap::getLevel() const
+{
+	return this->m_shown;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Vector2f Minimap::mapPointToWorld(const sf::Vector2f& point) const
+{
+	sf::Vector2f cellSize = sf::Vector2f(this->m_level->getTileset().getTileSize()) * static_cast<float>(TileChunk::Size << this->m_shown);
+	return sf::Vector2f((this->m_origin.x + point.x) * cellSize.x, (this->m_origin.y + point.y) * cellSize.y);
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	flush();
+	SpriteBasedControl::draw(target, states);
+
+	sf::Vector2f cellSize = sf::Vector2f(this->m_level->getTileset().getTileSize()) * static_cast<float>(TileChunk::Size << this->m_shown);
+	if (this->m_camera.width <= 0.f || this->m_camera.height <= 0.f)
+	{
+		return;
+	}
+
+	// The outline is kept within the minimap, the area damaged by the control
+	float left = std::clamp(this->m_camera.left / cellSize.x - this->m_origin.x, 0.f, this->m_size.x);
+	float top = std::clamp(this->m_camera.top / cellSize.y - this->m_origin.y, 0.f, this->m_size.y);
+	float right = std::clamp((this->m_camera.left + this->m_camera.width) / cellSize.x - this->m_origin.x, 0.f, this->m_size.x);
+	float bottom = std::clamp((this->m_camera.top + this->m_camera.height) / cellSize.y - this->m_origin.y, 0.f, this->m_size.y);
+
+	sf::RectangleShape outline(sf::Vector2f(std::max(right - left - 2.f, 0.f), std::max(bottom - top - 2.f, 0.f)));
+	outline.setPosition(left + 1.f, top + 1.f);
+	outline.setFillColor(sf::Color::Transparent);
+	outline.setOutlineColor(sf::Color::White);
+	outline.setOutlineThickness(1.f);
+	states.transform *= getTransform();
+	target.draw(outline, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::loadTileColors()
+{
+	const Tileset& tileset = this->m_level->getTileset();
+	this->m_tileColors.assign(static_cast<std::size_t>(tileset.getTileCount()) + 1, { 0, 0, 0, 0 });
+
+	sf::Image image;
+	if (tileset.getTexture())
+	{
+		image = tileset.getTexture()->copyToImage();
+	}
+
+	// Colours are premultiplied, so that transparent texels do not tint the average
+	for (TileId tile = 1; tile <= tileset.getTileCount(); tile++)
+	{
+		sf::IntRect rect = tileset.getTextureRect(tile);
+		int right = std::min(rect.left + rect.width, static_cast<int>(image.getSize().x));
+		int bottom = std::min(rect.top + rect.height, static_cast<int>(image.getSize().y));
+		std::array<sf::Int64, 4> sum = { 0, 0, 0, 0 };
+		sf::Int64 count = 0;
+		for (int y = rect.top; y < bottom; y++)
+		{
+			for (int x = rect.left; x < right; x++)
+			{
+				sf::Color color = image.getPixel(x, y);
+				sum[0] += color.r * color.a / 255;
+				sum[1] += color.g * color.a / 255;
+				sum[2] += color.b * color.a / 255;
+				sum[3] += color.a;
+				count++;
+			}
+		}
+
+		std::array<sf::Int64, 4>& average = this->m_tileColors[tile];
+		if (count == 0)
+		{
+			average = { 128, 128, 128, 255 };
+			continue;
+		}
+
+		for (int channel = 0; channel < 4; channel++)
+		{
+			average[channel] = sum[channel] / count;
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+Minimap::Cell Minimap::sumChunk(const TileChunk& chunk) const
+{
+	Cell sum;
+	for (TileId tile : chunk.getTiles())
+	{
+		if (tile != Tileset::Empty && tile < this->m_tileColors.size())
+		{
+			for (int channel = 0; channel < 4; channel++)
+			{
+				sum.m_color[channel] += this->m_tileColors[tile][channel];
+			}
+
+			sum.m_count++;
+		}
+	}
+
+	return sum;
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::addDelta(const sf::Vector2i& chunk, const Cell& delta)
+{
+	sf::Vector2i size = sf::Vector2i(this->m_texture.getSize());
+	for (int level = 0; level < LevelCount; level++)
+	{
+		sf::Vector2i key(chunk.x >> level, chunk.y >> level);
+		Cell& cell = this->m_cells[level][key];
+		for (int channel = 0; channel < 4; channel++)
+		{
+			cell.m_color[channel] += delta.m_color[channel];
+		}
+
+		cell.m_count += delta.m_count;
+		if (cell.m_count == 0)
+		{
+			this->m_cells[level].erase(key);
+		}
+
+		if (level != this->m_shown || this->m_relayout)
+		{
+			continue;
+		}
+
+		// Content outside of the shown cells makes the whole minimap move
+		sf::Vector2i pixel = key - this->m_origin;
+		if (pixel.x < 0 || pixel.y < 0 || pixel.x >= size.x || pixel.y >= size.y)
+		{
+			this->m_relayout = true;
+			invalidate();
+			continue;
+		}
+
+		std::size_t index = static_cast<std::size_t>(pixel.y) * size.x + pixel.x;
+		if (!this->m_dirty.test(index))
+		{
+			if (this->m_dirtyList.empty())
+			{
+				invalidate();
+			}
+
+			this->m_dirty.set(index);
+			this->m_dirtyList.push_back(pixel);
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::layout() const
+{
+	sf::Vector2i size = sf::Vector2i(this->m_texture.getSize());
+	const std::vector<CoordMap<Cell>::Entry>& cells = this->m_cells[0].getEntries();
+	if (cells.empty())
+	{
+		this->m_shown = 0;
+		this->m_origin = sf::Vector2i(-size.x / 2, -size.y / 2);
+		return;
+	}
+
+	// Entries are sorted by row, so only the columns have to be searched
+	int left = cells.front().m_key.x;
+	int right = left;
+	for (const CoordMap<Cell>::Entry& entry : cells)
+	{
+		left = std::min(left, entry.m_key.x);
+		right = std::max(right, entry.m_key.x);
+	}
+
+	int top = cells.front().m_key.y;
+	int bottom = cells.back().m_key.y;
+	int level = 0;
+	while (level < LevelCount - 1 && ((right >> level) - (left >> level) >= size.x || (bottom >> level) - (top >> level) >= size.y))
+	{
+		level++;
+	}
+
+	// The content is centered, which leaves room to grow in every direction before the next layout
+	this->m_shown = level;
+	this->m_origin.x = (left >> level) - (size.x - ((right >> level) - (left >> level) + 1)) / 2;
+	this->m_origin.y = (top >> level) - (size.y - ((bottom >> level) - (top >> level) + 1)) / 2;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Color Minimap::getPixel(const sf::Vector2i& key) const
+{
+	const Cell* cell = this->m_cells[this->m_shown].find(key);
+	if (!cell || cell->m_count <= 0 || cell->m_color[3] <= 0)
+	{
+		return sf::Color::Transparent;
+	}
+
+	// Sparse cells are drawn half transparent, so that scattered tiles stay visible without hiding the density
+	double area = static_cast<double>(TileChunk::Area) * static_cast<double>(1ll << (2 * this->m_shown));
+	double coverage = std::min(static_cast<double>(cell->m_count) / area, 1.0);
+	double alpha = static_cast<double>(cell->m_color[3]) / cell->m_count * (0.5 + 0.5 * coverage);
+	auto channel = [&](int index) { return static_cast<sf::Uint8>(std::min<sf::Int64>(cell->m_color[index] * 255 / cell->m_color[3], 255)); };
+	return sf::Color(channel(0), channel(1), channel(2), static_cast<sf::Uint8>(alpha));
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::flush() const
+{
+	sf::Vector2u size = this->m_texture.getSize();
+	if (this->m_relayout)
+	{
+		layout();
+		std::vector<sf::Uint8> pixels(static_cast<std::size_t>(size.x) * size.y * 4, 0);
+		for (const CoordMap<Cell>::Entry& entry : this->m_cells[this->m_shown].getEntries())
+		{
+			sf::Vector2i pixel = entry.m_key - this->m_origin;
+			if (pixel.x >= 0 && pixel.y >= 0 && pixel.x < static_cast<int>(size.x) && pixel.y < static_cast<int>(size.y))
+			{
+				sf::Color color = getPixel(entry.m_key);
+				sf::Uint8* texel = &pixels[(static_cast<std::size_t>(pixel.y) * size.x + pixel.x) * 4];
+				texel[0] = color.r;
+				texel[1] = color.g;
+				texel[2] = color.b;
+				texel[3] = color.a;
+			}
+		}
+
+		this->m_texture.update(pixels.data());
+		this->m_dirty.clear();
+		this->m_dirtyList.clear();
+		this->m_relayout = false;
+		return;
+	}
+
+	if (this->m_dirtyList.empty())
+	{
+		return;
+	}
+
+	sf::Vector2i low = this->m_dirtyList.front();
+	sf::Vector2i high = low;
+	for (const sf::Vector2i& pixel : this->m_dirtyList)
+	{
+		low = sf::Vector2i(std::min(low.x, pixel.x), std::min(low.y, pixel.y));
+		high = sf::Vector2i(std::max(high.x, pixel.x), std::max(high.y, pixel.y));
+	}
+
+	// Nearby pixels are uploaded as one rectangle, scattered ones one by one
+	sf::Vector2i extent = high - low + sf::Vector2i(1, 1);
+	std::size_t area = static_cast<std::size_t>(extent.x) * extent.y;
+	std::vector<sf::Uint8> pixels;
+	if (area <= this->m_dirtyList.size() * 4 + 64)
+	{
+		pixels.reserve(area * 4);
+		for (int y = low.y; y <= high.y; y++)
+		{
+			for (int x = low.x; x <= high.x; x++)
+			{
+				sf::Color color = getPixel(this->m_origin + sf::Vector2i(x, y));
+				pixels.insert(pixels.end(), { color.r, color.g, color.b, color.a });
+			}
+		}
+
+		this->m_texture.update(pixels.data(), extent.x, extent.y, low.x, low.y);
+	}
+	else
+	{
+		for (const sf::Vector2i& pixel : this->m_dirtyList)
+		{
+			sf::Color color = getPixel(this->m_origin + pixel);
+			const sf::Uint8 texel[4] = { color.r, color.g, color.b, color.a };
+			this->m_texture.update(texel, 1, 1, pixel.x, pixel.y);
+		}
+	}
+
+	for (const sf::Vector2i& pixel : this->m_dirtyList)
+	{
+		this->m_dirty.set(static_cast<std::size_t>(pixel.y) * size.x + pixel.x, false);
+	}
+
+	this->m_dirtyList.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::onClicked(sf::Mouse::Button button, sf::Vector2f worldPos)
+{
+	if (button == sf::Mouse::Left)
+	{
+		this->m_onJump(*this, mapPointToWorld(getCombinedTransform().getInverse().transformPoint(worldPos)));
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::onMovedControl(sf::Vector2f worldPos)
+{
+	if (!sf::Mouse::isButtonPressed(sf::Mouse::Left))
+	{
+		return;
+	}
+
+	sf::Vector2f point = getCombinedTransform().getInverse().transformPoint(worldPos);
+	point.x = std::clamp(point.x, 0.f, this->m_size.x);
+	point.y = std::clamp(point.y, 0.f, this->m_size.y);
+	this->m_onJump(*this, mapPointToWorld(point));
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::onReleasedControl(sf::Mouse::Button button, sf::Vector2f worldPos)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::onEntered(sf::Vector2f worldPos)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Minimap::onLeft(sf::Vector2f worldPos)
+{
+}
+
+} //namespace le
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_MINIMAP_HPP
+#define LEVEL_EDITOR_MINIMAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../interfaces/SpriteBasedControl.hpp"
+#include "../../level/Level.hpp"
+#include "../../utility/BitSet.hpp"
+#include "../../utility/Config.hpp"
+#include "../../utility/CoordMap.hpp"
+#include <array>
+#include <vector>
+#include <SFML/Graphics/Texture.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Control showing the whole level, clicking it moves the camera
+///
+/// The level is summarized by a pyramid held in CPU memory:
+/// level 0 holds a cell per chunk, each following level merges
+/// 2x2 cells of the level below. Cells keep the sum of the colours
+/// of their tiles across every layer, so a tile change adds its
+/// difference to one cell per level instead of rebuilding them.
+/// Each pixel of the control shows a cell of the level fitting the
+/// content, only the pixels whose cell changed are uploaded.
+///
+////////////////////////////////////////////////////////////
+class Minimap : public SpriteBasedControl
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Amount of pyramid levels
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr int LevelCount = 16;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// Reads the tileset's texture back once to average the colour
+	/// of every tile, then builds the pyramid from the loaded chunks.
+	///
+	/// \param level    Level to show
+	/// \param position Position set to minimap
+	/// \param size     Size of minimap, a pixel per cell
+	/// \param onJump   Event raised with the world position clicked on
+	///
+	////////////////////////////////////////////////////////////
+	Minimap(const Level& level, const sf::Vector2f& position, const sf::Vector2f& size,
+	Event1<Minimap, const sf::Vector2f&> onJump = [](Minimap&, const sf::Vector2f&) {});
+
+	////////////////////////////////////////////////////////////
+	/// \brief Rebuild the pyramid from scratch
+	///
+	/// Only needed after layers were added, duplicated or removed,
+	/// tile changes are accounted for by applyChange. Chunks are
+	/// not loaded, only those held in memory are summed.
+	///
+	////////////////////////////////////////////////////////////
+	void rebuild();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Average the colour of every tile again and rebuild the pyramid
+	///
+	/// Needed once the level uses another tileset or its texture
+	/// was reloaded, since the colours are read back only once.
+	///
+	////////////////////////////////////////////////////////////
+	void refreshColors();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Account for a change of tiles
+	///
+	/// Meant to be called from the tile changed event of the level.
+	///
+	/// \param change Previous and new state of the tiles
+	///
+	////////////////////////////////////////////////////////////
+	void applyChange(const Level::TileChange& change);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Account for a chunk loaded from the level's source
+	///
+	/// Meant to be called from the chunk loaded event of the level.
+	///
+	/// \param load Layer and coordinates of the chunk
+	///
+	////////////////////////////////////////////////////////////
+	void applyChunk(const Level::ChunkLoad& load);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the area of the world shown by the main view
+	///
+	/// \param area World rectangle outlined on the minimap
+	///
+	////////////////////////////////////////////////////////////
+	void setCamera(const sf::FloatRect& area);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the pyramid level shown
+	///
+	////////////////////////////////////////////////////////////
+	int getLevel() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Map a point of the minimap to the world
+	///
+	/// \param point Point in local coordinates of the minimap
+	///
+	////////////////////////////////////////////////////////////
+	sf::Vector2f mapPointToWorld(const sf::Vector2f& point) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the minimap, uploading the pixels that changed
+	///
+	/// \param target Render target to draw to
+	/// \param states Current render states
+	///
+	////////////////////////////////////////////////////////////
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class summing the tiles covered by a cell
+	///
+	////////////////////////////////////////////////////////////
+	struct Cell
+	{
+		std::array<sf::Int64, 4> m_color = {}; //!< Sum of the premultiplied colours of the tiles
+		sf::Int64                m_count = 0;  //!< Amount of tiles that are not empty
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Average the colour of every tile of the tileset
+	///
+	////////////////////////////////////////////////////////////
+	void loadTileColors();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sum the colours of the tiles of a chunk
+	///
+	/// \param chunk Chunk to sum
+	///
+	////////////////////////////////////////////////////////////
+	Cell sumChunk(const TileChunk& chunk) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the difference of a cell to a cell and every cell above it
+	///
+	/// \param chunk Coordinates of the level 0 cell
+	/// \param delta Difference to add
+	///
+	////////////////////////////////////////////////////////////
+	void addDelta(const sf::Vector2i& chunk, const Cell& delta);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Choose the level and the cells shown so that the content fits
+	///
+	////////////////////////////////////////////////////////////
+	void layout() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the colour of the pixel showing a cell
+	///
+	/// \param key Coordinates of the cell at the level shown
+	///
+	////////////////////////////////////////////////////////////
+	sf::Color getPixel(const sf::Vector2i& key) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Upload the pixels that changed to the texture
+	///
+	////////////////////////////////////////////////////////////
+	void flush() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when a mouse button is pressed
+	///        while the minimap is being hovered
+	///
+	/// \param button   Mouse button that was pressed
+	/// \param worldPos Position of the cursor
+	///
+	////////////////////////////////////////////////////////////
+	void onClicked(sf::Mouse::Button button, sf::Vector2f worldPos) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when the mouse cursor moves
+	///        while the minimap is being held
+	///
+	/// \param worldPos Position of the cursor
+	///
+	////////////////////////////////////////////////////////////
+	void onMovedControl(sf::Vector2f worldPos) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when a mouse button is released
+	///        while the minimap is being hovered
+	///
+	/// \param button   Mouse button that was released
+	/// \param worldPos Position of the cursor
+	///
+	////////////////////////////////////////////////////////////
+	void onReleasedControl(sf::Mouse::Button button, sf::Vector2f worldPos) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when the mouse cursor enters the area of the minimap
+	///
+	/// \param worldPos Position of the cursor
+	///
+	////////////////////////////////////////////////////////////
+	void onEntered(sf::Vector2f worldPos) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when the mouse cursor leaves the area of the minimap
+	///
+	/// \param worldPos Position of the cursor
+	///
+	////////////////////////////////////////////////////////////
+	void onLeft(sf::Vector2f worldPos) override;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	const Level*                           m_level;      //!< Level shown
+	std::vector<std::array<sf::Int64, 4>>  m_tileColors; //!< Premultiplied average colour of every tile id
+	std::array<CoordMap<Cell>, LevelCount> m_cells;      //!< Cells of each level, only those covering tiles exist
+	mutable sf::Texture                    m_texture;    //!< Pixel per cell of the level shown
+	mutable int                            m_shown;      //!< Level of the cells shown
+	mutable sf::Vector2i                   m_origin;     //!< Cell shown by the top-left pixel
+	mutable bool                           m_relayout;   //!< Content no longer fits, every pixel is uploaded again
+	mutable BitSet                         m_dirty;      //!< Bit per pixel whose cell changed
+	mutable std::vector<sf::Vector2i>      m_dirtyList;  //!< Pixels whose cell changed
+	sf::FloatRect                          m_camera;     //!< World rectangle shown by the main view
+	Event1<Minimap, const sf::Vector2f&>   m_onJump;     //!< Event raised with the world position clicked on
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_MINIMAP_HPP
@@ -107,10 +107,12 @@ public:
 	void setValue(T value, bool raiseEvent = true);
 
 	////////////////////////////////////////////////////////////
-	/// \brief Updates the control within the application's main thread loop
+	/// \brief Sets the auto-repeat curve of the numeric's buttons
+	///
+	/// \param curve New repeat curve
 	///
 	////////////////////////////////////////////////////////////
-	void update() override;
+	void setRepeatCurve(const RepeatCurve& curve);
 
 	////////////////////////////////////////////////////////////
 	/// \brief Process sf::Event within the control
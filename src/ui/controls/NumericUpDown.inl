@@ -122,11 +122,9 @@ inline void NumericUpDown<T>::setValue(T value, bool raiseEvent)
 ////////////////////////////////////////////////////////////
 template<typename T>
 requires std::is_arithmetic_v<T>
-inline void NumericUpDown<T>::update()
+inline void NumericUpDown<T>::setRepeatCurve(const RepeatCurve& curve)
 {
-	Control::update();
-	this->m_buttonUp.update();
-	this->m_buttonDown.update();
+	this->m_secondaryButtons.setRepeatCurve(curve);
 }
 
 
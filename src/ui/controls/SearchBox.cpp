@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "SearchBox.hpp"
+#include <algorithm>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const float NameShare = 0.7f; //!< Part of the width given to the names, the rest shows their group
+
+
+////////////////////////////////////////////////////////////
+SearchBox::SearchBox(const TrigramIndex& index, const sf::Vector2f& position, const sf::Vector2f& size, float rowHeight,
+const sf::Texture& texture, const sf::IntRect& spriteDefault, const sf::IntRect& spriteFocused, const TextTheme* textTheme,
+const InputTextStyle* inputStyle, const TextStyle* resultStyle, const std::vector<sf::String>& groupNames, std::size_t maxResults,
+Event1<SearchBox, sf::Uint32> onSelected) :
+Control::Control(position, size),
+m_index     (&index),
+m_groupNames(groupNames),
+m_maxResults(maxResults),
+m_results   (),
+m_matches   (0),
+m_onSelected(onSelected),
+m_input     (sf::Vector2f(0, 0), sf::Vector2f(size.x, rowHeight), texture, spriteDefault, spriteFocused, textTheme, inputStyle,
+	[this](InputControl&, sf::String query) { search(query); }),
+m_table     (sf::Vector2f(0, rowHeight), sf::Vector2f(size.x, std::max(size.y - rowHeight, rowHeight)), rowHeight, resultStyle,
+	[this](std::size_t row, std::size_t column) { return getCellText(row, column); },
+	[this](Table&, std::size_t row) { this->m_onSelected(*this, this->m_results[row]); })
+{
+	this->m_input.setParent(this);
+	this->m_table.setParent(this);
+	this->m_table.setColumns({ { "Name", size.x * NameShare }, { "Kind", size.x * (1.f - NameShare) } });
+}
+
+
+////////////////////////////////////////////////////////////
+void SearchBox::refresh()
+{
+	search(this->m_input.getText());
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SearchBox::getResultCount() const
+{
+	return this->m_results.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SearchBox::getMatchCount() const
+{
+	return this->m_matches;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 SearchBox::getResult(std::size_t index) const
+{
+	return index < this->m_results.size() ? this->m_results[index] : TrigramIndex::NoId;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SearchBox::isFocused() const
+{
+	return this->m_input.isFocused();
+}
+
+
+////////////////////////////////////////////////////////////
+void SearchBox::setEnabled(bool enabled)
+{
+	Control::setEnabled(enabled);
+	this->m_input.setEnabled(enabled);
+	this->m_table.setEnabled(enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SearchBox::onWindowEvent(sf::RenderWindow& window, sf::Event event)
+{
+	bool isAccepted = Control::onWindowEvent(window, event);
+	if (isAccepted)
+	{
+		this->m_input.onWindowEvent(window, event);
+		this->m_table.onWindowEvent(window, event);
+	}
+
+	return isAccepted;
+}
+
+
+////////////////////////////////////////////////////////////
+void SearchBox::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	setDrawn(states);
+	states.transform *= getTransform();
+	target.draw(this->m_input, states);
+	target.draw(this->m_table, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void SearchBox::onKeyPressed(sf::Event::KeyEvent key)
+{
+	if (!this->m_enabled || !this->m_input.isFocused() || this->m_results.empty())
+	{
+		return;
+	}
+
+	// The selection wraps around so that the last result is one key away
+	std::size_t count = this->m_results.size();
+	std::size_t selected = this->m_table.getSelectedRow();
+	if (key.code == sf::Keyboard::Down)
+	{
+		selected = selected == Table::NoRow ? 0 : (selected + 1) % count;
+	}
+	else if (key.code == sf::Keyboard::Up)
+	{
+		selected = selected == Table::NoRow || selected == 0 ? count - 1 : selected - 1;
+	}
+	else if (key.code == sf::Keyboard::Enter)
+	{
+		this->m_onSelected(*this, this->m_results[selected == Table::NoRow ? 0 : selected]);
+		return;
+	}
+	else
+	{
+		return;
+	}
+
+	this->m_table.setSelectedRow(selected);
+	this->m_table.scrollToRow(selected);
+}
+
+
+////////////////////////////////////////////////////////////
+void SearchBox::search(const sf::String& query)
+{
+	std::basic_string<sf::Uint8> utf8 = query.toUtf8();
+	this->m_matches = this->m_index->search(std::string(utf8.begin(), utf8.end()), this->m_maxResults, this->m_results);
+
+	// The best result is selected, so that return picks it
+	this->m_table.setRowCount(this->m_results.size());
+	this->m_table.setSelectedRow(this->m_results.empty() ? Table::NoRow : 0);
+	this->m_table.setScroll(0.f, 0.0);
+}
+
+
+////////////////////////////////////////////////////////////
+sf::String SearchBox::getCellText(std::size_t row, std::size_t column) const
+{
+	if (row >= this->m_results.size())
+	{
+		return sf::String();
+	}
+
+	sf::Uint32 id = this->m_results[row];
+	if (column == 0)
+	{
+		const std::string& name = this->m_index->getName(id);
+		return sf::String::fromUtf8(name.begin(), name.end());
+	}
+
+	sf::Uint32 group = this->m_index->getGroup(id);
+	return group < this->m_groupNames.size() ? this->m_groupNames[group] : sf::String();
+}
+
+} //namespace le
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_SEARCH_BOX_HPP
+#define LEVEL_EDITOR_SEARCH_BOX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "InputControl.hpp"
+#include "Table.hpp"
+#include "../interfaces/Control.hpp"
+#include "../../utility/Config.hpp"
+#include "../../utility/TrigramIndex.hpp"
+#include <vector>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Control searching an index as the query is typed
+///
+/// An input at the top takes the query, a table below lists the
+/// best names containing it with what they name. The index is
+/// searched again on every change of the query, the table only
+/// asks for the text of the results it shows.
+///
+/// Up and down move the selection while the input is focused,
+/// return raises the selected result.
+///
+////////////////////////////////////////////////////////////
+class SearchBox : public Control, sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param index         Index searched. Has to remain valid the entire lifetime of the search box
+	/// \param position      Position set to search box
+	/// \param size          Size of search box, input and results
+	/// \param rowHeight     Height of the input and of a result
+	/// \param texture       Source texture of the input
+	/// \param spriteDefault Sub-rectangle of the texture to assign to the default sprite of the input
+	/// \param spriteFocused Sub-rectangle of the texture to assign to the focused sprite of the input
+	/// \param textTheme     Text theme of the input
+	/// \param inputStyle    Style of the input
+	/// \param resultStyle   Style of the results
+	/// \param groupNames    Name shown for every group of the index
+	/// \param maxResults    Amount of results listed at most
+	/// \param onSelected    Event raised with the id of the result chosen
+	///
+	////////////////////////////////////////////////////////////
+	SearchBox(const TrigramIndex& index, const sf::Vector2f& position, const sf::Vector2f& size, float rowHeight,
+	const sf::Texture& texture, const sf::IntRect& spriteDefault, const sf::IntRect& spriteFocused, const TextTheme* textTheme,
+	const InputTextStyle* inputStyle, const TextStyle* resultStyle, const std::vector<sf::String>& groupNames, std::size_t maxResults,
+	Event1<SearchBox, sf::Uint32> onSelected = [](SearchBox&, sf::Uint32) {});
+
+	////////////////////////////////////////////////////////////
+	/// \brief Search the index again
+	///
+	/// Called when names were added, renamed or removed.
+	///
+	////////////////////////////////////////////////////////////
+	void refresh();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of results listed
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getResultCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of names found containing the query
+	///
+	/// Is at least the amount of results listed.
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getMatchCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the id of a result
+	///
+	/// \param index Index of the result, best first
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint32 getResult(std::size_t index) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether the input receives the keys typed
+	///
+	////////////////////////////////////////////////////////////
+	bool isFocused() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Enable or disable the search box
+	///
+	/// \param enabled Enable the search box
+	///
+	////////////////////////////////////////////////////////////
+	virtual void setEnabled(bool enabled) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Handle a window event and pass it to the input and the results
+	///
+	/// \param window Window the event was raised by
+	/// \param event  Event to handle
+	///
+	/// \return True if the event was handled
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool onWindowEvent(sf::RenderWindow& window, sf::Event event) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the input and the results
+	///
+	/// \param target Render target to draw to
+	/// \param states Current render states
+	///
+	////////////////////////////////////////////////////////////
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+protected:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when a key is pressed
+	///
+	/// \param key Key event parameters
+	///
+	////////////////////////////////////////////////////////////
+	void onKeyPressed(sf::Event::KeyEvent key) override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Search the index and list the results
+	///
+	/// \param query Text searched
+	///
+	////////////////////////////////////////////////////////////
+	void search(const sf::String& query);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the text of a cell of the results
+	///
+	/// \param row    Index of the result
+	/// \param column Index of the column
+	///
+	////////////////////////////////////////////////////////////
+	sf::String getCellText(std::size_t row, std::size_t column) const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	const TrigramIndex*           m_index;      //!< Index searched
+	std::vector<sf::String>       m_groupNames; //!< Name shown for every group of the index
+	std::size_t                   m_maxResults; //!< Amount of results listed at most
+	std::vector<sf::Uint32>       m_results;    //!< Ids of the results, best first
+	std::size_t                   m_matches;    //!< Amount of names found containing the query
+	Event1<SearchBox, sf::Uint32> m_onSelected; //!< Event raised with the id of the result chosen
+	InputControl                  m_input;      //!< Input taking the query
+	Table                         m_table;      //!< Table listing the results
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_SEARCH_BOX_HPP
@@ -205,6 +205,7 @@ inline void Slider<T>::updateThumbPosition()
 	float x = this->m_isVertical ? 0.5f : this->m_percentage;
 	float y = this->m_isVertical ? this->m_percentage : 0.5f;
 	this->m_thumb.setPosition(this->m_size.x * x, this->m_size.y * y);
+	this->invalidate();
 }
 
 
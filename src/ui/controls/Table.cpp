@@ -1 +1,482 @@
-#pragma once
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Table.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <SFML/Graphics/Sprite.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const sf::Color BackgroundColor = sf::Color(30, 30, 30);   //!< Colour behind the rows
+static const sf::Color AlternateColor  = sf::Color(38, 38, 38);   //!< Colour of every other row
+static const sf::Color SelectedColor   = sf::Color(50, 80, 130);  //!< Colour of the selected row
+static const sf::Color HeaderColor     = sf::Color(55, 55, 55);   //!< Colour behind the column titles
+static const float     WheelRows       = 3.f;                     //!< Rows scrolled per notch of the mouse wheel
+
+
+////////////////////////////////////////////////////////////
+static void appendQuad(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rect, const sf::Color& color)
+{
+	sf::Vertex topLeft(sf::Vector2f(rect.left, rect.top), color);
+	sf::Vertex topRight(sf::Vector2f(rect.left + rect.width, rect.top), color);
+	sf::Vertex bottomLeft(sf::Vector2f(rect.left, rect.top + rect.height), color);
+	sf::Vertex bottomRight(sf::Vector2f(rect.left + rect.width, rect.top + rect.height), color);
+
+	vertices.insert(vertices.end(), { topLeft, topRight, bottomLeft, bottomLeft, topRight, bottomRight });
+}
+
+
+////////////////////////////////////////////////////////////
+Table::Table(const sf::Vector2f& position, const sf::Vector2f& size, float rowHeight, const TextStyle* style,
+CellText cellText, Event1<Table, std::size_t> onRowSelected) :
+Control::Control(position, size),
+m_style          (style),
+m_rowHeight      (std::max(rowHeight, 1.f)),
+m_columns        (),
+m_offsets        (1, 0.f),
+m_header         (),
+m_rowCount       (0),
+m_cellText       (cellText),
+m_scrollLeft     (0.f),
+m_scrollTop      (0.0),
+m_selected       (NoRow),
+m_onRowSelected  (onRowSelected),
+m_onColumnClicked([](Table&, std::size_t) {}),
+m_rows           (),
+m_layer          (),
+m_dirty          (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::setColumns(const std::vector<Column>& columns)
+{
+	this->m_columns = columns;
+	layoutColumns();
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::setColumnWidth(std::size_t column, float width)
+{
+	if (column < this->m_columns.size())
+	{
+		this->m_columns[column].m_width = std::max(width, 1.f);
+		layoutColumns();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Table::getColumnCount() const
+{
+	return this->m_columns.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::setRowCount(std::size_t count)
+{
+	this->m_rowCount = count;
+	if (this->m_selected != NoRow && this->m_selected >= count)
+	{
+		this->m_selected = NoRow;
+	}
+
+	refresh();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Table::getRowCount() const
+{
+	return this->m_rowCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::refresh()
+{
+	for (Row& row : this->m_rows)
+	{
+		row.m_index = NoRow;
+	}
+
+	// The scroll is clamped to the new amount of rows before they are laid out
+	setScroll(this->m_scrollLeft, this->m_scrollTop);
+	layoutRows();
+	addFullDamage();
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::refreshRow(std::size_t row)
+{
+	for (Row& pooled : this->m_rows)
+	{
+		if (pooled.m_index == row)
+		{
+			assignRow(pooled, row);
+			addFullDamage();
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::setScroll(float left, double top)
+{
+	float maxLeft = std::max(this->m_offsets.back() - this->m_size.x, 0.f);
+	double maxTop = std::max(static_cast<double>(this->m_rowCount) * this->m_rowHeight - getBodyHeight(), 0.0);
+	left = std::clamp(left, 0.f, maxLeft);
+	top = std::clamp(top, 0.0, maxTop);
+	if (left != this->m_scrollLeft || top != this->m_scrollTop)
+	{
+		this->m_scrollLeft = left;
+		this->m_scrollTop = top;
+		layoutRows();
+		addFullDamage();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+float Table::getScrollLeft() const
+{
+	return this->m_scrollLeft;
+}
+
+
+////////////////////////////////////////////////////////////
+double Table::getScrollTop() const
+{
+	return this->m_scrollTop;
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::scrollToRow(std::size_t row)
+{
+	double top = static_cast<double>(row) * this->m_rowHeight;
+	if (top < this->m_scrollTop)
+	{
+		setScroll(this->m_scrollLeft, top);
+	}
+	else if (top + this->m_rowHeight > this->m_scrollTop + getBodyHeight())
+	{
+		setScroll(this->m_scrollLeft, top + this->m_rowHeight - getBodyHeight());
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::setSelectedRow(std::size_t row)
+{
+	row = row < this->m_rowCount ? row : NoRow;
+	if (row != this->m_selected)
+	{
+		this->m_selected = row;
+		addFullDamage();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Table::getSelectedRow() const
+{
+	return this->m_selected;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Table::getRowAt(const sf::Vector2f& worldPos) const
+{
+	sf::Vector2f point = getCombinedTransform().getInverse().transformPoint(worldPos);
+	if (point.x < 0.f || point.x >= this->m_size.x || point.y < this->m_rowHeight || point.y >= this->m_size.y)
+	{
+		return NoRow;
+	}
+
+	std::size_t row = static_cast<std::size_t>((point.y - this->m_rowHeight + this->m_scrollTop) / this->m_rowHeight);
+	return row < this->m_rowCount ? row : NoRow;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Table::getPoolSize() const
+{
+	return this->m_rows.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::setOnColumnClicked(Event1<Table, std::size_t> onColumnClicked)
+{
+	this->m_onColumnClicked = onColumnClicked;
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::addDamage(const sf::FloatRect& rect)
+{
+	addFullDamage();
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::addFullDamage()
+{
+	this->m_dirty = true;
+	invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	setDrawn(states);
+	if (this->m_dirty)
+	{
+		render();
+	}
+
+	if (this->m_layer)
+	{
+		states.transform *= getTransform();
+		target.draw(sf::Sprite(this->m_layer->getTexture()), states);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::onScrolledControl(sf::Event::MouseWheelScrollEvent mouseWheelScroll)
+{
+	float distance = mouseWheelScroll.delta * WheelRows * this->m_rowHeight;
+	if (mouseWheelScroll.wheel == sf::Mouse::HorizontalWheel || sf::Keyboard::isKeyPressed(sf::Keyboard::LShift))
+	{
+		setScroll(this->m_scrollLeft - distance, this->m_scrollTop);
+	}
+	else
+	{
+		setScroll(this->m_scrollLeft, this->m_scrollTop - distance);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::onClicked(sf::Mouse::Button button, sf::Vector2f worldPos)
+{
+	if (button != sf::Mouse::Left)
+	{
+		return;
+	}
+
+	// Titles are found from the offsets of the columns, scrolled with the rows
+	sf::Vector2f point = getCombinedTransform().getInverse().transformPoint(worldPos);
+	if (point.y >= 0.f && point.y < this->m_rowHeight)
+	{
+		auto right = std::upper_bound(this->m_offsets.begin() + 1, this->m_offsets.end(), point.x + this->m_scrollLeft);
+		if (point.x >= 0.f && right != this->m_offsets.end())
+		{
+			this->m_onColumnClicked(*this, static_cast<std::size_t>(right - this->m_offsets.begin()) - 1);
+		}
+
+		return;
+	}
+
+	std::size_t row = getRowAt(worldPos);
+	if (row != NoRow)
+	{
+		setSelectedRow(row);
+		this->m_onRowSelected(*this, row);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+float Table::getBodyHeight() const
+{
+	return std::max(this->m_size.y - this->m_rowHeight, 0.f);
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::layoutColumns()
+{
+	this->m_offsets.assign(1, 0.f);
+	for (const Column& column : this->m_columns)
+	{
+		this->m_offsets.push_back(this->m_offsets.back() + column.m_width);
+	}
+
+	// Text components are sized to their column, they are made again for the new widths
+	sf::Vector2u cellSize;
+	this->m_header.clear();
+	this->m_header.reserve(this->m_columns.size());
+	for (std::size_t i = 0; i < this->m_columns.size(); i++)
+	{
+		cellSize = sf::Vector2u(static_cast<unsigned int>(this->m_columns[i].m_width), static_cast<unsigned int>(this->m_rowHeight));
+		this->m_header.emplace_back(sf::Vector2f(this->m_offsets[i], 0.f), cellSize, this->m_style, this->m_columns[i].m_title);
+	}
+
+	this->m_rows.clear();
+	refresh();
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::layoutRows()
+{
+	std::size_t first = static_cast<std::size_t>(this->m_scrollTop / this->m_rowHeight);
+	std::size_t last = std::min(static_cast<std::size_t>(std::ceil((this->m_scrollTop + getBodyHeight()) / this->m_rowHeight)), this->m_rowCount);
+	first = std::min(first, last);
+
+	// The pool only grows to the amount of rows fitting in the table
+	std::size_t visible = last - first;
+	if (this->m_rows.size() < visible)
+	{
+		this->m_rows.resize(visible, Row{ NoRow, {} });
+	}
+
+	// Rows still visible keep their text, the others are given to the rows scrolled in
+	std::vector<Row*> shown(visible, nullptr);
+	std::vector<Row*> unused;
+	for (Row& row : this->m_rows)
+	{
+		if (row.m_index >= first && row.m_index < last)
+		{
+			shown[row.m_index - first] = &row;
+		}
+		else
+		{
+			row.m_index = NoRow;
+			unused.push_back(&row);
+		}
+	}
+
+	for (std::size_t i = 0; i < visible; i++)
+	{
+		if (!shown[i])
+		{
+			assignRow(*unused.back(), first + i);
+			unused.pop_back();
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::assignRow(Row& row, std::size_t index)
+{
+	if (row.m_cells.size() != this->m_columns.size())
+	{
+		row.m_cells.clear();
+		row.m_cells.reserve(this->m_columns.size());
+		for (std::size_t i = 0; i < this->m_columns.size(); i++)
+		{
+			sf::Vector2u cellSize(static_cast<unsigned int>(this->m_columns[i].m_width), static_cast<unsigned int>(this->m_rowHeight));
+			row.m_cells.emplace_back(sf::Vector2f(this->m_offsets[i], 0.f), cellSize, this->m_style);
+		}
+	}
+
+	row.m_index = index;
+	for (std::size_t i = 0; i < row.m_cells.size(); i++)
+	{
+		row.m_cells[i].setString(this->m_cellText(index, i));
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void Table::render() const
+{
+	if (!this->m_layer)
+	{
+		unsigned int width = std::max(static_cast<unsigned int>(this->m_size.x), 1u);
+		unsigned int height = std::max(static_cast<unsigned int>(this->m_size.y), 1u);
+		this->m_layer = std::make_unique<sf::RenderTexture>();
+		if (!this->m_layer->create(width, height))
+		{
+			printf("Failed to create the %ux%u layer of a table\n", width, height);
+			this->m_layer.reset();
+			return;
+		}
+	}
+
+	// Rows are drawn in the layer's space, which clips those cut by the header or the bottom
+	DrawScope scope(*this);
+	this->m_layer->setView(sf::View(sf::FloatRect(0.f, 0.f, this->m_size.x, this->m_size.y)));
+	this->m_layer->clear(BackgroundColor);
+
+	float width = std::min(this->m_offsets.back() - this->m_scrollLeft, this->m_size.x);
+	std::vector<sf::Vertex> backgrounds;
+	for (const Row& row : this->m_rows)
+	{
+		if (row.m_index != NoRow && (row.m_index == this->m_selected || row.m_index % 2 == 1))
+		{
+			float top = this->m_rowHeight + static_cast<float>(row.m_index * static_cast<double>(this->m_rowHeight) - this->m_scrollTop);
+			appendQuad(backgrounds, sf::FloatRect(0.f, top, width, this->m_rowHeight), row.m_index == this->m_selected ? SelectedColor : AlternateColor);
+		}
+	}
+
+	appendQuad(backgrounds, sf::FloatRect(0.f, 0.f, this->m_size.x, this->m_rowHeight), HeaderColor);
+	this->m_layer->draw(backgrounds.data(), backgrounds.size() - 6, sf::Triangles);
+
+	for (const Row& row : this->m_rows)
+	{
+		if (row.m_index != NoRow)
+		{
+			sf::RenderStates states;
+			states.transform.translate(-this->m_scrollLeft, this->m_rowHeight + static_cast<float>(row.m_index * static_cast<double>(this->m_rowHeight) - this->m_scrollTop));
+			for (const TextComponent& cell : row.m_cells)
+			{
+				this->m_layer->draw(cell, states);
+			}
+		}
+	}
+
+	// The header is drawn last, over the row cut by its bottom
+	this->m_layer->draw(backgrounds.data() + backgrounds.size() - 6, 6, sf::Triangles);
+	sf::RenderStates states;
+	states.transform.translate(-this->m_scrollLeft, 0.f);
+	for (const TextComponent& cell : this->m_header)
+	{
+		this->m_layer->draw(cell, states);
+	}
+
+	this->m_layer->display();
+	this->m_dirty = false;
+}
+
+} //namespace le
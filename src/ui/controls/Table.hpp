@@ -1 +1,336 @@
-#pragma once
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_TABLE_HPP
+#define LEVEL_EDITOR_TABLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../components/TextComponent.hpp"
+#include "../interfaces/Control.hpp"
+#include "../rendering/DamageTarget.hpp"
+#include "../styling/TextStyle.hpp"
+#include "../../utility/Config.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+#include <SFML/Graphics/RenderTexture.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Control showing rows of text in columns
+///
+/// The table does not store its rows, it asks for the text of the
+/// cells shown. Only the visible rows have text components, taken
+/// from a pool as large as the rows fitting in the control: a row
+/// scrolled out is given to the row scrolled in, and rows staying
+/// visible keep their text. Rows are placed from their index and
+/// the scroll offset, columns from the sum of the widths before
+/// them, so scrolling costs the same whatever the amount of rows.
+///
+////////////////////////////////////////////////////////////
+class Table : public Control, public DamageTarget
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Index meaning no row
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr std::size_t NoRow = static_cast<std::size_t>(-1);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class describing a column
+	///
+	////////////////////////////////////////////////////////////
+	struct Column
+	{
+		sf::String m_title; //!< Text of the header
+		float      m_width; //!< Width in pixels
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Function returning the text of a cell
+	///
+	////////////////////////////////////////////////////////////
+	using CellText = std::function<sf::String(std::size_t row, std::size_t column)>;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param position      Position set to table
+	/// \param size          Size of table, header included
+	/// \param rowHeight     Height of a row and of the header
+	/// \param style         Style of the text. Has to remain valid the entire lifetime of the table
+	/// \param cellText      Function returning the text of a cell
+	/// \param onRowSelected Event raised with the index of the row clicked on
+	///
+	////////////////////////////////////////////////////////////
+	Table(const sf::Vector2f& position, const sf::Vector2f& size, float rowHeight, const TextStyle* style,
+	CellText cellText, Event1<Table, std::size_t> onRowSelected = [](Table&, std::size_t) {});
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the columns
+	///
+	/// \param columns Columns, from left to right
+	///
+	////////////////////////////////////////////////////////////
+	void setColumns(const std::vector<Column>& columns);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Change the width of a column
+	///
+	/// \param column Index of the column
+	/// \param width  Width in pixels
+	///
+	////////////////////////////////////////////////////////////
+	void setColumnWidth(std::size_t column, float width);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of columns
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getColumnCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the amount of rows
+	///
+	/// The text of the visible rows is asked for again.
+	///
+	/// \param count Amount of rows
+	///
+	////////////////////////////////////////////////////////////
+	void setRowCount(std::size_t count);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of rows
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getRowCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Ask for the text of the visible rows again
+	///
+	/// Called when the content of the rows changed, or their order.
+	///
+	////////////////////////////////////////////////////////////
+	void refresh();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Ask for the text of a row again if it is visible
+	///
+	/// \param row Index of the row
+	///
+	////////////////////////////////////////////////////////////
+	void refreshRow(std::size_t row);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scroll the table
+	///
+	/// Offsets are clamped to the content.
+	///
+	/// \param left Distance between the left of the columns and the left of the table
+	/// \param top  Distance between the top of the first row and the bottom of the header
+	///
+	////////////////////////////////////////////////////////////
+	void setScroll(float left, double top);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the distance between the left of the columns and the left of the table
+	///
+	////////////////////////////////////////////////////////////
+	float getScrollLeft() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the distance between the top of the first row and the bottom of the header
+	///
+	////////////////////////////////////////////////////////////
+	double getScrollTop() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scroll as little as needed for a row to be entirely visible
+	///
+	/// \param row Index of the row
+	///
+	////////////////////////////////////////////////////////////
+	void scrollToRow(std::size_t row);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Select a row
+	///
+	/// \param row Index of the row, NoRow to select none
+	///
+	////////////////////////////////////////////////////////////
+	void setSelectedRow(std::size_t row);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the index of the selected row, NoRow if none
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getSelectedRow() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the index of the row under a point
+	///
+	/// \param worldPos Point in world coordinates
+	///
+	/// \return Index of the row, NoRow if the point is over the header or no row
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getRowAt(const sf::Vector2f& worldPos) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of rows having text components
+	///
+	/// Bounded by the rows fitting in the table.
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getPoolSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the event raised when the title of a column is clicked on
+	///
+	/// \param onColumnClicked Event raised with the index of the column
+	///
+	////////////////////////////////////////////////////////////
+	void setOnColumnClicked(Event1<Table, std::size_t> onColumnClicked);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark the layer to be redrawn
+	///
+	/// \param rect Damaged rectangle in the coordinates of the table
+	///
+	////////////////////////////////////////////////////////////
+	virtual void addDamage(const sf::FloatRect& rect) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark the layer to be redrawn
+	///
+	////////////////////////////////////////////////////////////
+	virtual void addFullDamage() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the visible rows and the header
+	///
+	/// \param target Render target to draw to
+	/// \param states Current render states
+	///
+	////////////////////////////////////////////////////////////
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+protected:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when the mouse wheel is scrolled
+	///        while the table is being hovered
+	///
+	/// \param mouseWheelScroll Mouse wheel event parameters
+	///
+	////////////////////////////////////////////////////////////
+	void onScrolledControl(sf::Event::MouseWheelScrollEvent mouseWheelScroll) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered when a mouse button is pressed
+	///        while the table is being hovered
+	///
+	/// \param button   Mouse button that was pressed
+	/// \param worldPos Position of the cursor
+	///
+	////////////////////////////////////////////////////////////
+	void onClicked(sf::Mouse::Button button, sf::Vector2f worldPos) override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Pooled row, showing the text of a visible row
+	///
+	////////////////////////////////////////////////////////////
+	struct Row
+	{
+		std::size_t                m_index; //!< Index of the row shown, NoRow if unused
+		std::vector<TextComponent> m_cells; //!< Text component of every column
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the height available to the rows
+	///
+	////////////////////////////////////////////////////////////
+	float getBodyHeight() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Compute the offset of every column and rebuild the header
+	///
+	////////////////////////////////////////////////////////////
+	void layoutColumns();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Give the pooled rows to the visible rows
+	///
+	////////////////////////////////////////////////////////////
+	void layoutRows();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Show a row with a pooled row
+	///
+	/// \param row   Pooled row
+	/// \param index Index of the row to show
+	///
+	////////////////////////////////////////////////////////////
+	void assignRow(Row& row, std::size_t index);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the rows and the header to the layer
+	///
+	////////////////////////////////////////////////////////////
+	void render() const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	const TextStyle*                           m_style;           //!< Style of the text
+	float                                      m_rowHeight;       //!< Height of a row and of the header
+	std::vector<Column>                        m_columns;         //!< Columns, from left to right
+	std::vector<float>                         m_offsets;         //!< Left of every column, followed by the right of the last
+	std::vector<TextComponent>                 m_header;          //!< Text component of every column title
+	std::size_t                                m_rowCount;        //!< Amount of rows
+	CellText                                   m_cellText;        //!< Function returning the text of a cell
+	float                                      m_scrollLeft;      //!< Distance between the left of the columns and the left of the table
+	double                                     m_scrollTop;       //!< Distance between the top of the first row and the bottom of the header
+	std::size_t                                m_selected;        //!< Index of the selected row, NoRow if none
+	Event1<Table, std::size_t>                 m_onRowSelected;   //!< Event raised with the index of the row clicked on
+	Event1<Table, std::size_t>                 m_onColumnClicked; //!< Event raised with the index of the column whose title was clicked on
+	std::vector<Row>                           m_rows;            //!< Pool of rows, as large as the rows fitting in the table
+	mutable std::unique_ptr<sf::RenderTexture> m_layer;           //!< Rows and header, clipped to the table
+	mutable bool                               m_dirty;           //!< Layer has to be drawn again
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_TABLE_HPP
@@ -0,0 +1,820 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "TableModel.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const std::size_t SortRunMinimum    = 16384;   //!< Entries below which a run is not split further
+static const std::size_t BackgroundMinimum = 65536;   //!< Rows added at once above which permutations are sorted again by the sort thread
+static const std::size_t FilterBlock       = 4096;    //!< Rows tested per job of the filter
+
+
+////////////////////////////////////////////////////////////
+static double parseNumber(const std::string& text)
+{
+	// Text not starting with a number, or NaN, is ordered as zero so that the order stays total
+	double value = std::strtod(text.c_str(), nullptr);
+	return value == value ? value : 0.0;
+}
+
+
+////////////////////////////////////////////////////////////
+static char fold(char character)
+{
+	return character >= 'A' && character <= 'Z' ? static_cast<char>(character - 'A' + 'a') : character;
+}
+
+
+////////////////////////////////////////////////////////////
+static bool containsFolded(const std::string& text, const std::string& query)
+{
+	return std::search(text.begin(), text.end(), query.begin(), query.end(),
+		[](char left, char right) { return fold(left) == right; }) != text.end();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename Key>
+static std::vector<sf::Uint32> parallelSort(JobSystem& jobs, std::vector<std::pair<Key, sf::Uint32>>& entries)
+{
+	// Entries are cut into runs sorted in parallel, ids are unique so the order is stable
+	std::size_t runCount = std::clamp<std::size_t>(entries.size() / SortRunMinimum, 1, (jobs.getWorkerCount() + 1) * 4);
+	std::vector<std::size_t> bounds(runCount + 1);
+	for (std::size_t i = 0; i <= runCount; i++)
+	{
+		bounds[i] = entries.size() * i / runCount;
+	}
+
+	jobs.parallelFor(runCount, [&](std::size_t i)
+	{
+		std::sort(entries.begin() + bounds[i], entries.begin() + bounds[i + 1]);
+	});
+
+	// Neighbouring runs are merged in parallel until a single one is left
+	std::vector<std::pair<Key, sf::Uint32>> merged(entries.size());
+	while (bounds.size() > 2)
+	{
+		std::size_t last = bounds.size() - 1;
+		jobs.parallelFor((last + 1) / 2, [&](std::size_t i)
+		{
+			auto begin = std::make_move_iterator(entries.begin() + bounds[i * 2]);
+			auto middle = std::make_move_iterator(entries.begin() + bounds[std::min(i * 2 + 1, last)]);
+			auto end = std::make_move_iterator(entries.begin() + bounds[std::min(i * 2 + 2, last)]);
+			std::merge(begin, middle, middle, end, merged.begin() + bounds[i * 2]);
+		});
+
+		std::vector<std::size_t> next;
+		for (std::size_t i = 0; i < last; i += 2)
+		{
+			next.push_back(bounds[i]);
+		}
+
+		next.push_back(bounds[last]);
+		bounds.swap(next);
+		entries.swap(merged);
+	}
+
+	std::vector<sf::Uint32> order(entries.size());
+	for (std::size_t i = 0; i < entries.size(); i++)
+	{
+		order[i] = entries[i].second;
+	}
+
+	return order;
+}
+
+
+////////////////////////////////////////////////////////////
+TableModel::TableModel(const std::vector<Kind>& columns, unsigned int workerCount) :
+m_kinds      (columns),
+m_texts      (columns.size()),
+m_numbers    (columns.size()),
+m_alive      (),
+m_free       (),
+m_count      (0),
+m_orders     (columns.size()),
+m_statuses   (columns.size(), Status::Missing),
+m_generations(columns.size(), 0),
+m_changed    (columns.size()),
+m_filter     (),
+m_matches    (),
+m_view       (),
+m_viewColumn (NoColumn),
+m_sortColumn (NoColumn),
+m_descending (false),
+m_onChanged  ([](TableModel&) {}),
+m_jobSystem  (workerCount),
+m_sorter     (),
+m_mutex      (),
+m_wake       (),
+m_jobs       (),
+m_results    (),
+m_stopping   (false)
+{
+	this->m_sorter = std::thread(&TableModel::run, this);
+}
+
+
+////////////////////////////////////////////////////////////
+TableModel::~TableModel()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_stopping = true;
+	}
+
+	this->m_wake.notify_all();
+	this->m_sorter.join();
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 TableModel::insertRow(const std::vector<std::string>& cells)
+{
+	sf::Uint32 id = store(cells);
+	for (std::size_t column = 0; column < this->m_kinds.size(); column++)
+	{
+		if (this->m_statuses[column] == Status::Ready)
+		{
+			insert(this->m_orders[column], column, id);
+		}
+		else if (this->m_statuses[column] == Status::Sorting)
+		{
+			this->m_changed[column].push_back(id);
+		}
+	}
+
+	if (this->m_matches.test(id))
+	{
+		insert(this->m_view, this->m_viewColumn, id);
+	}
+
+	this->m_onChanged(*this);
+	return id;
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<sf::Uint32> TableModel::insertRows(const std::vector<std::vector<std::string>>& rows)
+{
+	std::vector<sf::Uint32> ids;
+	ids.reserve(rows.size());
+	for (const std::vector<std::string>& cells : rows)
+	{
+		ids.push_back(store(cells));
+	}
+
+	// Sorting a large batch would stall the main thread, the permutations are sorted again instead
+	bool large = rows.size() >= BackgroundMinimum;
+	for (std::size_t column = 0; column < this->m_kinds.size(); column++)
+	{
+		if (this->m_statuses[column] == Status::Ready && large)
+		{
+			this->m_orders[column].clear();
+			this->m_statuses[column] = Status::Missing;
+		}
+		else if (this->m_statuses[column] == Status::Ready)
+		{
+			merge(this->m_orders[column], column, ids);
+		}
+		else if (this->m_statuses[column] == Status::Sorting && large)
+		{
+			requestSort(column);
+		}
+		else if (this->m_statuses[column] == Status::Sorting)
+		{
+			this->m_changed[column].insert(this->m_changed[column].end(), ids.begin(), ids.end());
+		}
+	}
+
+	if (this->m_sortColumn != NoColumn && this->m_statuses[this->m_sortColumn] == Status::Missing)
+	{
+		requestSort(this->m_sortColumn);
+	}
+
+	// The rows are shown in id order until the sort thread is done
+	if (large && this->m_viewColumn != NoColumn)
+	{
+		this->m_viewColumn = NoColumn;
+		rebuildView();
+	}
+	else
+	{
+		std::vector<sf::Uint32> shown;
+		std::copy_if(ids.begin(), ids.end(), std::back_inserter(shown), [this](sf::Uint32 id) { return this->m_matches.test(id); });
+		merge(this->m_view, this->m_viewColumn, std::move(shown));
+	}
+
+	this->m_onChanged(*this);
+	return ids;
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::removeRow(sf::Uint32 id)
+{
+	if (!this->m_alive.test(id))
+	{
+		return;
+	}
+
+	// Rows are found by their cells, which are cleared only once the row left every list
+	for (std::size_t column = 0; column < this->m_kinds.size(); column++)
+	{
+		if (this->m_statuses[column] == Status::Ready)
+		{
+			erase(this->m_orders[column], column, id);
+		}
+		else if (this->m_statuses[column] == Status::Sorting)
+		{
+			this->m_changed[column].push_back(id);
+		}
+	}
+
+	if (this->m_matches.test(id))
+	{
+		erase(this->m_view, this->m_viewColumn, id);
+	}
+
+	for (std::size_t column = 0; column < this->m_kinds.size(); column++)
+	{
+		this->m_texts[column][id].clear();
+	}
+
+	this->m_alive.set(id, false);
+	this->m_matches.set(id, false);
+	this->m_free.push_back(id);
+	this->m_count--;
+	this->m_onChanged(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::clear()
+{
+	for (std::size_t column = 0; column < this->m_kinds.size(); column++)
+	{
+		// Results of sorts still running are dropped, an empty permutation is ready
+		this->m_texts[column].clear();
+		this->m_numbers[column].clear();
+		this->m_orders[column].clear();
+		this->m_changed[column].clear();
+		++this->m_generations[column];
+		if (this->m_statuses[column] == Status::Sorting)
+		{
+			this->m_statuses[column] = Status::Ready;
+		}
+	}
+
+	this->m_alive.resize(0);
+	this->m_matches.resize(0);
+	this->m_free.clear();
+	this->m_count = 0;
+	this->m_view.clear();
+	if (this->m_sortColumn != NoColumn && this->m_statuses[this->m_sortColumn] == Status::Ready)
+	{
+		this->m_viewColumn = this->m_sortColumn;
+	}
+
+	this->m_onChanged(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::setCell(sf::Uint32 id, std::size_t column, const std::string& text)
+{
+	if (!this->m_alive.test(id) || column >= this->m_kinds.size())
+	{
+		return;
+	}
+
+	// The row leaves the lists sorted by the column while it still has its former cell
+	bool shown = this->m_matches.test(id);
+	if (shown && this->m_viewColumn == column)
+	{
+		erase(this->m_view, column, id);
+	}
+
+	if (this->m_statuses[column] == Status::Ready)
+	{
+		erase(this->m_orders[column], column, id);
+	}
+	else if (this->m_statuses[column] == Status::Sorting)
+	{
+		this->m_changed[column].push_back(id);
+	}
+
+	this->m_texts[column][id] = text;
+	if (this->m_kinds[column] == Kind::Number)
+	{
+		this->m_numbers[column][id] = parseNumber(text);
+	}
+
+	if (this->m_statuses[column] == Status::Ready)
+	{
+		insert(this->m_orders[column], column, id);
+	}
+
+	bool match = matches(id);
+	this->m_matches.set(id, match);
+	if (shown && this->m_viewColumn != column && !match)
+	{
+		erase(this->m_view, this->m_viewColumn, id);
+	}
+	else if (match && (!shown || this->m_viewColumn == column))
+	{
+		insert(this->m_view, this->m_viewColumn, id);
+	}
+
+	this->m_onChanged(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& TableModel::getCell(sf::Uint32 id, std::size_t column) const
+{
+	return this->m_texts[column][id];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TableModel::getRowCount() const
+{
+	return this->m_view.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TableModel::getTotalCount() const
+{
+	return this->m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 TableModel::getRowId(std::size_t row) const
+{
+	if (row >= this->m_view.size())
+	{
+		return NoRow;
+	}
+
+	return this->m_descending ? this->m_view[this->m_view.size() - 1 - row] : this->m_view[row];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TableModel::getRowIndex(sf::Uint32 id) const
+{
+	if (!this->m_matches.test(id))
+	{
+		return NoIndex;
+	}
+
+	auto found = std::lower_bound(this->m_view.begin(), this->m_view.end(), id,
+		[this](sf::Uint32 left, sf::Uint32 right) { return less(this->m_viewColumn, left, right); });
+	if (found == this->m_view.end() || *found != id)
+	{
+		return NoIndex;
+	}
+
+	std::size_t index = static_cast<std::size_t>(found - this->m_view.begin());
+	return this->m_descending ? this->m_view.size() - 1 - index : index;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::String TableModel::getText(std::size_t row, std::size_t column) const
+{
+	sf::Uint32 id = getRowId(row);
+	if (id == NoRow || column >= this->m_kinds.size())
+	{
+		return sf::String();
+	}
+
+	const std::string& text = this->m_texts[column][id];
+	return sf::String::fromUtf8(text.begin(), text.end());
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::setSort(std::size_t column, bool descending)
+{
+	this->m_sortColumn = column < this->m_kinds.size() ? column : NoColumn;
+	this->m_descending = descending;
+	if (this->m_sortColumn != NoColumn && this->m_statuses[this->m_sortColumn] == Status::Missing)
+	{
+		requestSort(this->m_sortColumn);
+	}
+
+	// A column still being sorted is shown once picked up by update
+	bool ready = this->m_sortColumn == NoColumn || this->m_statuses[this->m_sortColumn] == Status::Ready;
+	if (ready && this->m_viewColumn != this->m_sortColumn)
+	{
+		this->m_viewColumn = this->m_sortColumn;
+		rebuildView();
+	}
+
+	this->m_onChanged(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TableModel::getSortColumn() const
+{
+	return this->m_sortColumn;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TableModel::isDescending() const
+{
+	return this->m_descending;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TableModel::isSorting() const
+{
+	return std::find(this->m_statuses.begin(), this->m_statuses.end(), Status::Sorting) != this->m_statuses.end();
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::setFilter(const sf::String& query)
+{
+	std::basic_string<sf::Uint8> utf8 = query.toUtf8();
+	std::string filter;
+	filter.reserve(utf8.size());
+	for (sf::Uint8 character : utf8)
+	{
+		filter.push_back(fold(static_cast<char>(character)));
+	}
+
+	if (filter == this->m_filter)
+	{
+		return;
+	}
+
+	// Rows without the previous query cannot contain a query extending it, only the rows shown are tested
+	bool refine = filter.find(this->m_filter) != std::string::npos;
+	this->m_filter = filter;
+
+	std::vector<sf::Uint32> candidates;
+	if (refine)
+	{
+		candidates.swap(this->m_view);
+	}
+	else if (this->m_viewColumn != NoColumn)
+	{
+		candidates = this->m_orders[this->m_viewColumn];
+	}
+	else
+	{
+		candidates.reserve(this->m_count);
+		for (std::size_t id = this->m_alive.findNext(0); id < this->m_alive.getSize(); id = this->m_alive.findNext(id + 1))
+		{
+			candidates.push_back(static_cast<sf::Uint32>(id));
+		}
+	}
+
+	std::vector<char> kept(candidates.size());
+	JobSystem::getDefault().parallelFor((candidates.size() + FilterBlock - 1) / FilterBlock, [&](std::size_t block)
+	{
+		std::size_t end = std::min((block + 1) * FilterBlock, candidates.size());
+		for (std::size_t i = block * FilterBlock; i < end; i++)
+		{
+			kept[i] = matches(candidates[i]);
+		}
+	});
+
+	this->m_view.clear();
+	for (std::size_t i = 0; i < candidates.size(); i++)
+	{
+		this->m_matches.set(candidates[i], kept[i]);
+		if (kept[i])
+		{
+			this->m_view.push_back(candidates[i]);
+		}
+	}
+
+	this->m_onChanged(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::setOnChanged(Event0<TableModel> onChanged)
+{
+	this->m_onChanged = onChanged;
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::update()
+{
+	std::deque<Result> results;
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		results.swap(this->m_results);
+	}
+
+	bool changed = false;
+	for (Result& result : results)
+	{
+		std::size_t column = result.m_column;
+		if (result.m_generation != this->m_generations[column])
+		{
+			continue;
+		}
+
+		// Rows changed since the snapshot leave the permutation and are merged back with their current cells
+		BitSet touched;
+		touched.resize(this->m_alive.getSize());
+		for (sf::Uint32 id : this->m_changed[column])
+		{
+			touched.set(id);
+		}
+
+		std::vector<sf::Uint32>& order = result.m_order;
+		order.erase(std::remove_if(order.begin(), order.end(), [&touched](sf::Uint32 id) { return touched.test(id); }), order.end());
+
+		std::vector<sf::Uint32> added;
+		for (sf::Uint32 id : this->m_changed[column])
+		{
+			if (touched.test(id) && this->m_alive.test(id))
+			{
+				added.push_back(id);
+			}
+
+			touched.set(id, false);
+		}
+
+		merge(order, column, std::move(added));
+		this->m_orders[column] = std::move(order);
+		this->m_changed[column].clear();
+		this->m_statuses[column] = Status::Ready;
+		if (column == this->m_sortColumn && this->m_viewColumn != column)
+		{
+			this->m_viewColumn = column;
+			rebuildView();
+			changed = true;
+		}
+	}
+
+	if (!isSorting())
+	{
+		unschedule();
+	}
+
+	if (changed)
+	{
+		this->m_onChanged(*this);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool TableModel::less(std::size_t column, sf::Uint32 left, sf::Uint32 right) const
+{
+	if (column == NoColumn)
+	{
+		return left < right;
+	}
+
+	if (this->m_kinds[column] == Kind::Number)
+	{
+		double leftValue = this->m_numbers[column][left];
+		double rightValue = this->m_numbers[column][right];
+		return leftValue != rightValue ? leftValue < rightValue : left < right;
+	}
+
+	int comparison = this->m_texts[column][left].compare(this->m_texts[column][right]);
+	return comparison != 0 ? comparison < 0 : left < right;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TableModel::matches(sf::Uint32 id) const
+{
+	if (this->m_filter.empty())
+	{
+		return true;
+	}
+
+	for (const std::vector<std::string>& texts : this->m_texts)
+	{
+		if (containsFolded(texts[id], this->m_filter))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 TableModel::store(const std::vector<std::string>& cells)
+{
+	sf::Uint32 id = static_cast<sf::Uint32>(this->m_alive.getSize());
+	if (!this->m_free.empty())
+	{
+		id = this->m_free.back();
+		this->m_free.pop_back();
+	}
+	else
+	{
+		this->m_alive.resize(id + 1);
+		this->m_matches.resize(id + 1);
+		for (std::size_t column = 0; column < this->m_kinds.size(); column++)
+		{
+			this->m_texts[column].emplace_back();
+			if (this->m_kinds[column] == Kind::Number)
+			{
+				this->m_numbers[column].push_back(0.0);
+			}
+		}
+	}
+
+	for (std::size_t column = 0; column < this->m_kinds.size(); column++)
+	{
+		this->m_texts[column][id] = column < cells.size() ? cells[column] : std::string();
+		if (this->m_kinds[column] == Kind::Number)
+		{
+			this->m_numbers[column][id] = parseNumber(this->m_texts[column][id]);
+		}
+	}
+
+	this->m_alive.set(id);
+	this->m_matches.set(id, matches(id));
+	this->m_count++;
+	return id;
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::erase(std::vector<sf::Uint32>& ids, std::size_t column, sf::Uint32 id) const
+{
+	auto found = std::lower_bound(ids.begin(), ids.end(), id,
+		[this, column](sf::Uint32 left, sf::Uint32 right) { return less(column, left, right); });
+	if (found != ids.end() && *found == id)
+	{
+		ids.erase(found);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::insert(std::vector<sf::Uint32>& ids, std::size_t column, sf::Uint32 id) const
+{
+	auto position = std::lower_bound(ids.begin(), ids.end(), id,
+		[this, column](sf::Uint32 left, sf::Uint32 right) { return less(column, left, right); });
+	ids.insert(position, id);
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::merge(std::vector<sf::Uint32>& ids, std::size_t column, std::vector<sf::Uint32> added) const
+{
+	if (added.empty())
+	{
+		return;
+	}
+
+	auto compare = [this, column](sf::Uint32 left, sf::Uint32 right) { return less(column, left, right); };
+	std::sort(added.begin(), added.end(), compare);
+
+	std::vector<sf::Uint32> merged(ids.size() + added.size());
+	std::merge(ids.begin(), ids.end(), added.begin(), added.end(), merged.begin(), compare);
+	ids.swap(merged);
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::requestSort(std::size_t column)
+{
+	++this->m_generations[column];
+	this->m_changed[column].clear();
+	this->m_statuses[column] = Status::Sorting;
+
+	// The sort thread works on a copy, the main thread keeps changing the rows
+	Job job;
+	job.m_column = column;
+	job.m_generation = this->m_generations[column];
+	if (this->m_kinds[column] == Kind::Number)
+	{
+		job.m_numbers.reserve(this->m_count);
+	}
+	else
+	{
+		job.m_texts.reserve(this->m_count);
+	}
+
+	for (std::size_t id = this->m_alive.findNext(0); id < this->m_alive.getSize(); id = this->m_alive.findNext(id + 1))
+	{
+		if (this->m_kinds[column] == Kind::Number)
+		{
+			job.m_numbers.emplace_back(this->m_numbers[column][id], static_cast<sf::Uint32>(id));
+		}
+		else
+		{
+			job.m_texts.emplace_back(this->m_texts[column][id], static_cast<sf::Uint32>(id));
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		std::erase_if(this->m_jobs, [column](const Job& queued) { return queued.m_column == column; });
+		this->m_jobs.push_back(std::move(job));
+	}
+
+	this->m_wake.notify_one();
+	schedule();
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::rebuildView()
+{
+	this->m_view.clear();
+	if (this->m_viewColumn != NoColumn)
+	{
+		for (sf::Uint32 id : this->m_orders[this->m_viewColumn])
+		{
+			if (this->m_matches.test(id))
+			{
+				this->m_view.push_back(id);
+			}
+		}
+
+		return;
+	}
+
+	for (std::size_t id = this->m_matches.findNext(0); id < this->m_matches.getSize(); id = this->m_matches.findNext(id + 1))
+	{
+		this->m_view.push_back(static_cast<sf::Uint32>(id));
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void TableModel::run()
+{
+	for (;;)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(this->m_mutex);
+			this->m_wake.wait(lock, [this]() { return this->m_stopping || !this->m_jobs.empty(); });
+			if (this->m_stopping)
+			{
+				return;
+			}
+
+			job = std::move(this->m_jobs.front());
+			this->m_jobs.pop_front();
+		}
+
+		Result result;
+		result.m_column = job.m_column;
+		result.m_generation = job.m_generation;
+		result.m_order = job.m_texts.empty() ? parallelSort(this->m_jobSystem, job.m_numbers) : parallelSort(this->m_jobSystem, job.m_texts);
+
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_results.push_back(std::move(result));
+	}
+}
+
+} //namespace le
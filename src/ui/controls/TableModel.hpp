@@ -0,0 +1,417 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_TABLE_MODEL_HPP
+#define LEVEL_EDITOR_TABLE_MODEL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../interfaces/Updatable.hpp"
+#include "../../utility/BitSet.hpp"
+#include "../../utility/Config.hpp"
+#include "../../utility/JobSystem.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <SFML/Config.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/String.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Rows of a table, kept sorted and filtered as they change
+///
+/// Every column sorted on keeps the permutation of the row ids
+/// ordering it, ties broken by id so the order is stable. Rows
+/// inserted, removed or changed are moved within the kept
+/// permutations by binary search instead of sorting again.
+///
+/// Sorting a column for the first time or after a large batch of
+/// rows is done by a sort thread, running a parallel merge sort on
+/// a snapshot of the column, while the table keeps showing the
+/// previous order. Rows changed meanwhile are placed again once
+/// the sorted permutation is picked up by update.
+///
+/// The filter keeps the rows containing the query in any column,
+/// ignoring ASCII case. A query extending the previous one only
+/// tests the rows the previous one kept.
+///
+////////////////////////////////////////////////////////////
+class TableModel : public Updatable, sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Index meaning no column, the rows are then in id order
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr std::size_t NoColumn = static_cast<std::size_t>(-1);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Id meaning no row
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr sf::Uint32 NoRow = 0xFFFFFFFF;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Index meaning a row is not shown
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr std::size_t NoIndex = static_cast<std::size_t>(-1);
+
+	////////////////////////////////////////////////////////////
+	/// \brief How the cells of a column are compared
+	///
+	////////////////////////////////////////////////////////////
+	enum class Kind
+	{
+		Text,  //!< Cells are ordered by their UTF-8 text
+		Number //!< Cells are ordered by the number their text starts with
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param columns     Kind of every column
+	/// \param workerCount Amount of threads helping the sort thread
+	///
+	////////////////////////////////////////////////////////////
+	TableModel(const std::vector<Kind>& columns, unsigned int workerCount);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Waits for the sort thread to stop.
+	///
+	////////////////////////////////////////////////////////////
+	~TableModel();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a row
+	///
+	/// \param cells UTF-8 text of every column
+	///
+	/// \return Id of the row
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint32 insertRow(const std::vector<std::string>& cells);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add many rows at once
+	///
+	/// Small batches are sorted and merged into the permutations,
+	/// large ones have the permutations sorted again by the sort
+	/// thread.
+	///
+	/// \param rows UTF-8 text of every column of every row
+	///
+	/// \return Id of every row
+	///
+	////////////////////////////////////////////////////////////
+	std::vector<sf::Uint32> insertRows(const std::vector<std::vector<std::string>>& rows);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove a row
+	///
+	/// \param id Id of the row
+	///
+	////////////////////////////////////////////////////////////
+	void removeRow(sf::Uint32 id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove every row
+	///
+	////////////////////////////////////////////////////////////
+	void clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Change the text of a cell
+	///
+	/// \param id     Id of the row
+	/// \param column Index of the column
+	/// \param text   UTF-8 text
+	///
+	////////////////////////////////////////////////////////////
+	void setCell(sf::Uint32 id, std::size_t column, const std::string& text);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the UTF-8 text of a cell
+	///
+	/// \param id     Id of the row
+	/// \param column Index of the column
+	///
+	////////////////////////////////////////////////////////////
+	const std::string& getCell(sf::Uint32 id, std::size_t column) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of rows kept by the filter
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getRowCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of rows, filtered out or not
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getTotalCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the id of a row shown
+	///
+	/// \param row Index of the row among the rows kept by the filter, in the order shown
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint32 getRowId(std::size_t row) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the index a row is shown at
+	///
+	/// \param id Id of the row
+	///
+	/// \return Index of the row, NoIndex if filtered out
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getRowIndex(sf::Uint32 id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the text of a cell shown
+	///
+	/// Matches Table::CellText.
+	///
+	/// \param row    Index of the row among the rows shown
+	/// \param column Index of the column
+	///
+	////////////////////////////////////////////////////////////
+	sf::String getText(std::size_t row, std::size_t column) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Order the rows by a column
+	///
+	/// A column whose permutation is not kept yet is sorted by the
+	/// sort thread, the rows keep their order until then.
+	///
+	/// \param column     Index of the column, NoColumn for id order
+	/// \param descending Show the last row first
+	///
+	////////////////////////////////////////////////////////////
+	void setSort(std::size_t column, bool descending);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the column the rows are ordered by, NoColumn if by id
+	///
+	/// Is the column asked for even if still being sorted.
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getSortColumn() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether the last row is shown first
+	///
+	////////////////////////////////////////////////////////////
+	bool isDescending() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether the sort thread is sorting a column
+	///
+	////////////////////////////////////////////////////////////
+	bool isSorting() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Keep only the rows containing a query
+	///
+	/// \param query Text searched in every column, empty to keep every row
+	///
+	////////////////////////////////////////////////////////////
+	void setFilter(const sf::String& query);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the event raised when the rows shown changed
+	///
+	/// \param onChanged Event raised on the main thread
+	///
+	////////////////////////////////////////////////////////////
+	void setOnChanged(Event0<TableModel> onChanged);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Pick up the permutations sorted by the sort thread
+	///
+	////////////////////////////////////////////////////////////
+	virtual void update() override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief State of the permutation of a column
+	///
+	////////////////////////////////////////////////////////////
+	enum class Status
+	{
+		Missing, //!< Not kept
+		Sorting, //!< Being sorted by the sort thread
+		Ready    //!< Kept up to date
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Snapshot of a column to sort
+	///
+	////////////////////////////////////////////////////////////
+	struct Job
+	{
+		std::size_t                                     m_column;     //!< Index of the column
+		sf::Uint64                                      m_generation; //!< Generation of the column when taken
+		std::vector<std::pair<double, sf::Uint32>>      m_numbers;    //!< Value and id of every row, for number columns
+		std::vector<std::pair<std::string, sf::Uint32>> m_texts;      //!< Text and id of every row, for text columns
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Permutation sorted by the sort thread
+	///
+	////////////////////////////////////////////////////////////
+	struct Result
+	{
+		std::size_t             m_column;     //!< Index of the column
+		sf::Uint64              m_generation; //!< Generation of the column when taken
+		std::vector<sf::Uint32> m_order;      //!< Ids, sorted
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Compare two rows by a column, then by id
+	///
+	/// \param column Index of the column, NoColumn to compare ids only
+	/// \param left   Id of the first row
+	/// \param right  Id of the second row
+	///
+	////////////////////////////////////////////////////////////
+	bool less(std::size_t column, sf::Uint32 left, sf::Uint32 right) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a row contains the query of the filter
+	///
+	/// \param id Id of the row
+	///
+	////////////////////////////////////////////////////////////
+	bool matches(sf::Uint32 id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Store the cells of a new row
+	///
+	/// \param cells UTF-8 text of every column
+	///
+	/// \return Id of the row
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint32 store(const std::vector<std::string>& cells);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove a row from a sorted list of ids
+	///
+	/// \param ids    Ids sorted by the column
+	/// \param column Index of the column
+	/// \param id     Id of the row, with the cells it was sorted with
+	///
+	////////////////////////////////////////////////////////////
+	void erase(std::vector<sf::Uint32>& ids, std::size_t column, sf::Uint32 id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Insert a row into a sorted list of ids
+	///
+	/// \param ids    Ids sorted by the column
+	/// \param column Index of the column
+	/// \param id     Id of the row
+	///
+	////////////////////////////////////////////////////////////
+	void insert(std::vector<sf::Uint32>& ids, std::size_t column, sf::Uint32 id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sort rows and merge them into a sorted list of ids
+	///
+	/// \param ids    Ids sorted by the column
+	/// \param column Index of the column
+	/// \param added  Ids of the rows, in any order
+	///
+	////////////////////////////////////////////////////////////
+	void merge(std::vector<sf::Uint32>& ids, std::size_t column, std::vector<sf::Uint32> added) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Have the sort thread sort a column
+	///
+	/// \param column Index of the column
+	///
+	////////////////////////////////////////////////////////////
+	void requestSort(std::size_t column);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Take the rows shown from the order of the view column and the filter
+	///
+	////////////////////////////////////////////////////////////
+	void rebuildView();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Loop of the sort thread
+	///
+	////////////////////////////////////////////////////////////
+	void run();
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::vector<Kind>                     m_kinds;       //!< Kind of every column
+	std::vector<std::vector<std::string>> m_texts;       //!< Text of every cell, per column then id
+	std::vector<std::vector<double>>      m_numbers;     //!< Value of every cell of the number columns, per column then id
+	BitSet                                m_alive;       //!< Bit per id in use
+	std::vector<sf::Uint32>               m_free;        //!< Ids of removed rows, reused first
+	std::size_t                           m_count;       //!< Amount of rows
+	std::vector<std::vector<sf::Uint32>>  m_orders;      //!< Ids sorted by every column whose permutation is ready
+	std::vector<Status>                   m_statuses;    //!< State of the permutation of every column
+	std::vector<sf::Uint64>               m_generations; //!< Incremented when a column is sorted again, older results are dropped
+	std::vector<std::vector<sf::Uint32>>  m_changed;     //!< Ids changed while the column is being sorted
+	std::string                           m_filter;      //!< Query of the filter, ASCII lowercase
+	BitSet                                m_matches;     //!< Bit per id kept by the filter
+	std::vector<sf::Uint32>               m_view;        //!< Ids of the rows kept by the filter, sorted by the view column
+	std::size_t                           m_viewColumn;  //!< Column the view is sorted by
+	std::size_t                           m_sortColumn;  //!< Column asked for
+	bool                                  m_descending;  //!< Last row of the view is shown first
+	Event0<TableModel>                    m_onChanged;   //!< Event raised when the rows shown changed
+	JobSystem                             m_jobSystem;   //!< Threads helping the sort thread
+	std::thread                           m_sorter;      //!< Thread sorting the columns
+	std::mutex                            m_mutex;       //!< Protects the jobs, results and stopping flag
+	std::condition_variable               m_wake;        //!< Signals the sort thread a job or the stop
+	std::deque<Job>                       m_jobs;        //!< Columns to sort
+	std::deque<Result>                    m_results;     //!< Columns sorted, waiting for the main thread
+	bool                                  m_stopping;    //!< Sort thread has to exit
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_TABLE_MODEL_HPP
@@ -40,7 +40,8 @@ m_enabled(false),
 m_size(),
 m_hovering(false),
 m_holding(false),
-m_wasHolding(false)
+m_wasHolding(false),
+m_damage()
 {
 }
 
@@ -53,32 +54,28 @@ m_enabled(enabled),
 m_size(size),
 m_hovering(false),
 m_holding(false),
-m_wasHolding(false)
+m_wasHolding(false),
+m_damage()
 {
 	setPosition(position);
 }
 
 
 ////////////////////////////////////////////////////////////
-const sf::Transform& Control::getParentTransform() const
+sf::Transform Control::getParentTransform() const
 {
 	sf::Transform combinedTransform = sf::Transform::Identity;
-	std::function<void(const Control*)> getParentTransform = [&](const Control* parent)
+	for (const Control* parent = this->m_parent; parent != nullptr; parent = parent->m_parent)
 	{
-		if (parent != nullptr)
-		{
-			combinedTransform *= parent->getTransform();
-			getParentTransform(parent->m_parent);
-		}
-	};
+		combinedTransform = parent->getTransform() * combinedTransform;
+	}
 
-	getParentTransform(this->m_parent);
 	return combinedTransform;
 }
 
 
 ////////////////////////////////////////////////////////////
-const sf::Transform& Control::getCombinedTransform() const
+sf::Transform Control::getCombinedTransform() const
 {
 	return getParentTransform() * getTransform();
 }
@@ -96,7 +93,16 @@ bool Control::contains(float x, float y) const
 ////////////////////////////////////////////////////////////
 void Control::setEnabled(bool enabled)
 {
+	if (this->m_enabled != enabled)
+	{
+		invalidate();
+	}
+
 	this->m_enabled = enabled;
+	if (!enabled)
+	{
+		unschedule();
+	}
 }
 
 
@@ -107,6 +113,13 @@ void Control::setParent(Control* parent)
 }
 
 
+////////////////////////////////////////////////////////////
+void Control::invalidate()
+{
+	this->m_damage.damage(getBounds());
+}
+
+
 ////////////////////////////////////////////////////////////
 void Control::update()
 {
@@ -181,6 +194,11 @@ void Control::onMouseButtonPressed(sf::Mouse::Button button, sf::Vector2f worldP
 		this->m_holding = button == sf::Mouse::Left || button == sf::Mouse::Right;
 	}
 
+	if (this->m_enabled && this->m_holding)
+	{
+		schedule();
+	}
+
 	if (this->m_enabled)
 	{
 		onPressed(button, worldPos);
@@ -204,6 +222,7 @@ void Control::onMouseButtonReleased(sf::Mouse::Button button, sf::Vector2f world
 	{
 		this->m_wasHolding = this->m_holding;
 		this->m_holding = false;
+		unschedule();
 
 		if (this->m_wasHolding)
 		{
@@ -245,4 +264,18 @@ void Control::onMouseMoved(sf::Vector2f worldPos)
 	}
 }
 
+
+////////////////////////////////////////////////////////////
+void Control::setDrawn(const sf::RenderStates& states) const
+{
+	this->m_damage.setDrawn(states.transform, getBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+sf::FloatRect Control::getBounds() const
+{
+	return getTransform().transformRect(sf::FloatRect(0, 0, this->m_size.x, this->m_size.y));
+}
+
 } //namespace le
\ No newline at end of file
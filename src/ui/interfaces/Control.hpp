@@ -31,6 +31,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include "Updatable.hpp"
+#include "../rendering/DamageTracker.hpp"
 #include <functional>
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Transformable.hpp>
@@ -76,13 +77,13 @@ public:
 	/// \brief Get the parent transform of the control
 	/// 
 	////////////////////////////////////////////////////////////
-	const sf::Transform& getParentTransform() const;
+	sf::Transform getParentTransform() const;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Get the combined transform
 	/// 
 	////////////////////////////////////////////////////////////
-	const sf::Transform& getCombinedTransform() const;
+	sf::Transform getCombinedTransform() const;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Checks whether a point intersects the control
@@ -109,9 +110,20 @@ public:
 	////////////////////////////////////////////////////////////
 	void setParent(Control* parent);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Request the control to be redrawn in the next frame
+	///
+	/// Damages the area the control was drawn in last.
+	///
+	////////////////////////////////////////////////////////////
+	void invalidate();
+
 	////////////////////////////////////////////////////////////
 	/// \brief Updates the control within the application's main thread loop
 	///
+	/// The control is only updated while it is scheduled, which
+	/// happens while the mouse button is held over it.
+	///
 	////////////////////////////////////////////////////////////
 	virtual void update() override;
 
@@ -196,7 +208,24 @@ public:
 protected:
 
 	////////////////////////////////////////////////////////////
-	/// \brief Event continuously triggered when the mouse button is held
+	/// \brief Record the control being drawn
+	///
+	/// Must be called from the draw function of derived classes,
+	/// so that invalidate knows where the control is displayed.
+	///
+	/// \param states Render states passed to the draw function
+	///
+	////////////////////////////////////////////////////////////
+	void setDrawn(const sf::RenderStates& states) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the bounds of the control in its parent's space
+	///
+	////////////////////////////////////////////////////////////
+	sf::FloatRect getBounds() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Event triggered every frame while the mouse button is held
 	///
 	////////////////////////////////////////////////////////////
 	virtual void onHold() {}
@@ -288,6 +317,7 @@ protected:
 	bool           m_hovering;   //!< Mouse hovering over this control
 	bool           m_holding;    //!< Mouse is being held over this control
 	bool           m_wasHolding; //!< Previous mouse holding state
+	DamageTracker  m_damage;     //!< Area the control was drawn in last
 };
 
 } //namespace le
@@ -64,6 +64,7 @@ bool SpriteBasedControl::contains(float x, float y) const
 ////////////////////////////////////////////////////////////
 void SpriteBasedControl::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
+	setDrawn(states);
 	states.transform *= getTransform();
 	states.shader = this->m_shader;
 	target.draw(this->m_sprite, states);
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Updatable.hpp"
+#include "../../utility/UpdateScheduler.hpp"
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+Updatable::Updatable() :
+m_scheduleIndex(UpdateScheduler::NotScheduled)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Updatable::Updatable(const Updatable&) :
+m_scheduleIndex(UpdateScheduler::NotScheduled)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Updatable& Updatable::operator=(const Updatable&)
+{
+	return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Updatable::~Updatable()
+{
+	unschedule();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Updatable::isScheduled() const
+{
+	return this->m_scheduleIndex != UpdateScheduler::NotScheduled;
+}
+
+
+////////////////////////////////////////////////////////////
+void Updatable::schedule()
+{
+	UpdateScheduler::getDefault().add(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+void Updatable::unschedule()
+{
+	if (isScheduled())
+	{
+		UpdateScheduler::getDefault().remove(*this);
+	}
+}
+
+} //namespace le
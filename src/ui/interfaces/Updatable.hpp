@@ -27,22 +27,54 @@
 #ifndef LEVEL_EDITOR_UPDATABLE_HPP
 #define LEVEL_EDITOR_UPDATABLE_HPP
 
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+
 
 namespace le
 {
 ////////////////////////////////////////////////////////////
 /// \brief Interface, representing an updatable object
 ///
+/// An updatable is only updated by the main loop while it is
+/// scheduled in the UpdateScheduler's active set, see schedule().
+///
 ////////////////////////////////////////////////////////////
 class Updatable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Updatable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// The copy is not scheduled, regardless of the source.
+    ///
+    ////////////////////////////////////////////////////////////
+    Updatable(const Updatable&);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy assignment
+    ///
+    /// Keeps the scheduling state of the assigned object.
+    ///
+    ////////////////////////////////////////////////////////////
+    Updatable& operator=(const Updatable&);
+
     ////////////////////////////////////////////////////////////
     /// \brief Virtual destructor
     ///
+    /// Removes the object from the active set.
+    ///
     ////////////////////////////////////////////////////////////
-    virtual ~Updatable() {}
+    virtual ~Updatable();
 
     ////////////////////////////////////////////////////////////
     /// \brief Updates the object within the application's main thread loop
@@ -53,6 +85,38 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual void update() = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the object is in the active set
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isScheduled() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the object to the active set
+    ///
+    /// Has to be called while the object needs ticking, e.g. while
+    /// it is held or animating. Scheduling twice has no effect.
+    ///
+    ////////////////////////////////////////////////////////////
+    void schedule();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the object from the active set
+    ///
+    ////////////////////////////////////////////////////////////
+    void unschedule();
+
+private:
+
+    friend class UpdateScheduler;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t m_scheduleIndex; //!< Index within UpdateScheduler's active set
 };
 
 } //namespace le
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "DamageTarget.hpp"
+#include <unordered_map>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static std::unordered_map<DamageTarget::Id, DamageTarget*> targets; //!< Every existing target by its id
+static DamageTarget::Id nextId = DamageTarget::None + 1;            //!< Id given to the next target
+static DamageTarget::Id currentId = DamageTarget::None;             //!< Target currently being drawn into
+
+
+////////////////////////////////////////////////////////////
+DamageTarget::DamageTarget() :
+m_damageId(nextId++)
+{
+	targets.emplace(this->m_damageId, this);
+}
+
+
+////////////////////////////////////////////////////////////
+DamageTarget::~DamageTarget()
+{
+	targets.erase(this->m_damageId);
+}
+
+
+////////////////////////////////////////////////////////////
+DamageTarget::Id DamageTarget::getDamageId() const
+{
+	return this->m_damageId;
+}
+
+
+////////////////////////////////////////////////////////////
+DamageTarget* DamageTarget::find(Id id)
+{
+	auto it = targets.find(id);
+	return it != targets.end() ? it->second : nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+DamageTarget::Id DamageTarget::getCurrent()
+{
+	return currentId;
+}
+
+
+////////////////////////////////////////////////////////////
+void DamageTarget::addFullDamageAll()
+{
+	for (auto& [id, target] : targets)
+	{
+		target->addFullDamage();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+DamageTarget::DrawScope::DrawScope(const DamageTarget& target) :
+m_previous(currentId)
+{
+	currentId = target.m_damageId;
+}
+
+
+////////////////////////////////////////////////////////////
+DamageTarget::DrawScope::~DrawScope()
+{
+	currentId = this->m_previous;
+}
+
+} //namespace le
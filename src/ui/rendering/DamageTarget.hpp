@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_DAMAGE_TARGET_HPP
+#define LEVEL_EDITOR_DAMAGE_TARGET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract class, representing a cached surface
+///        that is redrawn in parts
+///
+/// Every target is registered under an id while it exists.
+/// Components remember the id of the target they were drawn
+/// into, so damage is routed to the right surface without
+/// keeping pointers that could dangle.
+///
+////////////////////////////////////////////////////////////
+class DamageTarget : sf::NonCopyable
+{
+public:
+
+	using Id = sf::Uint32;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Id of no target, used while drawing directly to a window
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Id None = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// Registers the target under a new id
+	///
+	////////////////////////////////////////////////////////////
+	DamageTarget();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Virtual destructor
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~DamageTarget();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the id of the target
+	///
+	////////////////////////////////////////////////////////////
+	Id getDamageId() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark a region of the target to be redrawn
+	///
+	/// \param rect Damaged rectangle in the coordinates of the target
+	///
+	////////////////////////////////////////////////////////////
+	virtual void addDamage(const sf::FloatRect& rect) = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark the whole target to be redrawn
+	///
+	////////////////////////////////////////////////////////////
+	virtual void addFullDamage() = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find a target by its id
+	///
+	/// \param id Id of the target
+	///
+	/// \return The target, or nullptr if it does not exist anymore
+	///
+	////////////////////////////////////////////////////////////
+	static DamageTarget* find(Id id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the id of the target currently being drawn into
+	///
+	////////////////////////////////////////////////////////////
+	static Id getCurrent();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark every existing target to be redrawn completely
+	///
+	////////////////////////////////////////////////////////////
+	static void addFullDamageAll();
+
+protected:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Makes a target the current one for its lifetime
+	///
+	////////////////////////////////////////////////////////////
+	class DrawScope : sf::NonCopyable
+	{
+	public:
+
+		////////////////////////////////////////////////////////////
+		/// \brief Default constructor
+		///
+		/// \param target Target that is being drawn into
+		///
+		////////////////////////////////////////////////////////////
+		explicit DrawScope(const DamageTarget& target);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Destructor, restores the previous target
+		///
+		////////////////////////////////////////////////////////////
+		~DrawScope();
+
+	private:
+
+		////////////////////////////////////////////////////////////
+		// Member data
+		////////////////////////////////////////////////////////////
+		Id m_previous; //!< Target that was current before
+	};
+
+private:
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	Id m_damageId; //!< Id this target is registered under
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_DAMAGE_TARGET_HPP
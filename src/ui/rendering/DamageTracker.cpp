@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "DamageTracker.hpp"
+#include "../../utility/FrameScheduler.hpp"
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+DamageTracker::DamageTracker() :
+m_drawn    (false),
+m_target   (DamageTarget::None),
+m_transform(),
+m_bounds   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void DamageTracker::setDrawn(const sf::Transform& transform, const sf::FloatRect& bounds) const
+{
+	this->m_drawn = true;
+	this->m_target = DamageTarget::getCurrent();
+	this->m_transform = transform;
+	this->m_bounds = bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void DamageTracker::damage(const sf::FloatRect& bounds)
+{
+	FrameScheduler::getDefault().invalidate();
+
+	if (!this->m_drawn)
+	{
+		DamageTarget::addFullDamageAll();
+	}
+	else if (DamageTarget* target = DamageTarget::find(this->m_target))
+	{
+		target->addDamage(this->m_transform.transformRect(this->m_bounds));
+		target->addDamage(this->m_transform.transformRect(bounds));
+	}
+}
+
+} //namespace le
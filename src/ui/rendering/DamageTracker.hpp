@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_DAMAGE_TRACKER_HPP
+#define LEVEL_EDITOR_DAMAGE_TRACKER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "DamageTarget.hpp"
+#include <SFML/Graphics/Transform.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Remembers where a drawable was drawn last
+///        so its visual changes can be reported as damage
+///
+/// Bounds are given in the space of the drawable's parent,
+/// the transform recorded at draw time maps them to the
+/// target the drawable was drawn into.
+///
+////////////////////////////////////////////////////////////
+class DamageTracker
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// This constructor creates a tracker that was never drawn
+	///
+	////////////////////////////////////////////////////////////
+	DamageTracker();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Record the drawable being drawn
+	///
+	/// Must be called from the drawable's draw function.
+	///
+	/// \param transform Parent transform passed to the draw function
+	/// \param bounds    Bounds of the drawable in its parent's space
+	///
+	////////////////////////////////////////////////////////////
+	void setDrawn(const sf::Transform& transform, const sf::FloatRect& bounds) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Report a visual change of the drawable
+	///
+	/// Damages the area the drawable was drawn in and the area
+	/// it will be drawn in. Drawables that were never drawn
+	/// damage every target, since it is unknown where they appear.
+	///
+	/// \param bounds Current bounds of the drawable in its parent's space
+	///
+	////////////////////////////////////////////////////////////
+	void damage(const sf::FloatRect& bounds);
+
+private:
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	mutable bool             m_drawn;     //!< Drawable was drawn at least once
+	mutable DamageTarget::Id m_target;    //!< Target the drawable was drawn into
+	mutable sf::Transform    m_transform; //!< Parent transform at the last draw
+	mutable sf::FloatRect    m_bounds;    //!< Bounds at the last draw
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_DAMAGE_TRACKER_HPP
@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "UiCompositor.hpp"
+#include "../../utility/FrameScheduler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const std::size_t MaxRegions = 8;                     //!< More regions are collapsed into their bounding rectangle
+static const int RegionMargin = 1;                           //!< Pixels added around damage to cover antialiasing and outlines
+static const sf::Color DebugFill = sf::Color(255, 0, 0, 48); //!< Fill of highlighted regions
+static const sf::Color DebugOutline = sf::Color::Red;        //!< Outline of highlighted regions
+
+
+////////////////////////////////////////////////////////////
+static bool touches(const sf::IntRect& first, const sf::IntRect& second)
+{
+	return first.left <= second.left + second.width && second.left <= first.left + first.width &&
+		first.top <= second.top + second.height && second.top <= first.top + first.height;
+}
+
+
+////////////////////////////////////////////////////////////
+static sf::IntRect unite(const sf::IntRect& first, const sf::IntRect& second)
+{
+	int left = std::min(first.left, second.left);
+	int top = std::min(first.top, second.top);
+	int right = std::max(first.left + first.width, second.left + second.width);
+	int bottom = std::max(first.top + first.height, second.top + second.height);
+	return sf::IntRect(left, top, right - left, bottom - top);
+}
+
+
+////////////////////////////////////////////////////////////
+UiCompositor::UiCompositor() :
+m_composite   (),
+m_clearColor  (sf::Color::Transparent),
+m_debugRegions(false),
+m_fullDamage  (true),
+m_damage      (),
+m_regions     ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool UiCompositor::create(const sf::Vector2u& size)
+{
+	addFullDamage();
+	return this->m_composite.create(size.x, size.y);
+}
+
+
+////////////////////////////////////////////////////////////
+void UiCompositor::setClearColor(const sf::Color& color)
+{
+	this->m_clearColor = color;
+	addFullDamage();
+}
+
+
+////////////////////////////////////////////////////////////
+void UiCompositor::setDebugRegions(bool enabled)
+{
+	this->m_debugRegions = enabled;
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+bool UiCompositor::isDamaged() const
+{
+	return this->m_fullDamage || !this->m_damage.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+void UiCompositor::addDamage(const sf::FloatRect& rect)
+{
+	if (!this->m_fullDamage && rect.width > 0 && rect.height > 0)
+	{
+		this->m_damage.push_back(rect);
+	}
+
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void UiCompositor::addFullDamage()
+{
+	this->m_fullDamage = true;
+	this->m_damage.clear();
+	FrameScheduler::getDefault().invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void UiCompositor::render(sf::RenderTarget& target, const sf::Drawable& ui)
+{
+	render(target, std::vector<const sf::Drawable*>{ &ui });
+}
+
+
+////////////////////////////////////////////////////////////
+void UiCompositor::render(sf::RenderTarget& target, const std::vector<const sf::Drawable*>& layers)
+{
+	this->m_regions.clear();
+	if (isDamaged())
+	{
+		mergeDamage();
+
+		DrawScope scope(*this);
+		for (const sf::IntRect& region : this->m_regions)
+		{
+			redrawRegion(region, layers);
+		}
+
+		this->m_composite.setView(this->m_composite.getDefaultView());
+		this->m_composite.display();
+	}
+
+	target.draw(sf::Sprite(this->m_composite.getTexture()));
+
+	if (this->m_debugRegions)
+	{
+		drawDebugRegions(target);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<sf::IntRect>& UiCompositor::getRedrawnRegions() const
+{
+	return this->m_regions;
+}
+
+
+////////////////////////////////////////////////////////////
+void UiCompositor::mergeDamage()
+{
+	sf::Vector2u size = this->m_composite.getSize();
+	sf::IntRect bounds = sf::IntRect(0, 0, size.x, size.y);
+
+	if (this->m_fullDamage)
+	{
+		this->m_regions.push_back(bounds);
+	}
+
+	for (const sf::FloatRect& rect : this->m_damage)
+	{
+		int left = static_cast<int>(std::floor(rect.left)) - RegionMargin;
+		int top = static_cast<int>(std::floor(rect.top)) - RegionMargin;
+		int right = static_cast<int>(std::ceil(rect.left + rect.width)) + RegionMargin;
+		int bottom = static_cast<int>(std::ceil(rect.top + rect.height)) + RegionMargin;
+
+		sf::IntRect region;
+		if (!bounds.intersects(sf::IntRect(left, top, right - left, bottom - top), region))
+		{
+			continue;
+		}
+
+		// Merging may make the region touch one that was checked before, so restart after every merge
+		for (std::size_t i = 0; i < this->m_regions.size();)
+		{
+			if (touches(this->m_regions[i], region))
+			{
+				region = unite(this->m_regions[i], region);
+				this->m_regions[i] = this->m_regions.back();
+				this->m_regions.pop_back();
+				i = 0;
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		this->m_regions.push_back(region);
+	}
+
+	if (this->m_regions.size() > MaxRegions)
+	{
+		sf::IntRect region = this->m_regions.front();
+		for (const sf::IntRect& other : this->m_regions)
+		{
+			region = unite(region, other);
+		}
+
+		this->m_regions.assign(1, region);
+	}
+
+	this->m_damage.clear();
+	this->m_fullDamage = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void UiCompositor::redrawRegion(const sf::IntRect& region, const std::vector<const sf::Drawable*>& layers)
+{
+	sf::Vector2f size = sf::Vector2f(this->m_composite.getSize());
+	sf::FloatRect area = sf::FloatRect(region);
+
+	sf::View view = sf::View(area);
+	view.setViewport(sf::FloatRect(area.left / size.x, area.top / size.y, area.width / size.x, area.height / size.y));
+	this->m_composite.setView(view);
+
+	sf::RectangleShape clear = sf::RectangleShape(sf::Vector2f(area.width, area.height));
+	clear.setPosition(area.left, area.top);
+	clear.setFillColor(this->m_clearColor);
+
+	this->m_composite.draw(clear, sf::RenderStates(sf::BlendNone));
+	for (const sf::Drawable* layer : layers)
+	{
+		this->m_composite.draw(*layer);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void UiCompositor::drawDebugRegions(sf::RenderTarget& target) const
+{
+	for (const sf::IntRect& region : this->m_regions)
+	{
+		sf::RectangleShape shape = sf::RectangleShape(sf::Vector2f(static_cast<float>(region.width), static_cast<float>(region.height)));
+		shape.setPosition(static_cast<float>(region.left), static_cast<float>(region.top));
+		shape.setFillColor(DebugFill);
+		shape.setOutlineColor(DebugOutline);
+		shape.setOutlineThickness(-1.f);
+		target.draw(shape);
+	}
+}
+
+} //namespace le
@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_UI_COMPOSITOR_HPP
+#define LEVEL_EDITOR_UI_COMPOSITOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "DamageTarget.hpp"
+#include <vector>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Keeps a cached composite of the user interface
+///        and redraws only its damaged regions
+///
+/// Damaged rectangles are merged into a few pixel regions.
+/// Each region is redrawn with a view whose viewport covers
+/// exactly that region, so the rasterization is clipped to it.
+/// The composite is then drawn to the window as a single quad.
+///
+////////////////////////////////////////////////////////////
+class UiCompositor : public DamageTarget
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	UiCompositor();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Create the cached composite
+	///
+	/// The user interface is drawn in pixel coordinates of the
+	/// composite. The whole composite is damaged.
+	///
+	/// \param size Size of the composite, usually the window size
+	///
+	/// \return True if creation has been successful
+	///
+	////////////////////////////////////////////////////////////
+	bool create(const sf::Vector2u& size);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the color damaged regions are cleared with
+	///
+	/// \param color Clear color
+	///
+	////////////////////////////////////////////////////////////
+	void setClearColor(const sf::Color& color);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Enable or disable highlighting redrawn regions
+	///
+	/// \param enabled Enable
+	///
+	////////////////////////////////////////////////////////////
+	void setDebugRegions(bool enabled);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether any region has to be redrawn
+	///
+	////////////////////////////////////////////////////////////
+	bool isDamaged() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark a region of the composite to be redrawn
+	///
+	/// \param rect Damaged rectangle in pixel coordinates
+	///
+	////////////////////////////////////////////////////////////
+	virtual void addDamage(const sf::FloatRect& rect) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark the whole composite to be redrawn
+	///
+	////////////////////////////////////////////////////////////
+	virtual void addFullDamage() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Redraw the damaged regions and draw the composite
+	///
+	/// \param target Render target to draw the composite to
+	/// \param ui     Drawable containing the whole user interface
+	///
+	////////////////////////////////////////////////////////////
+	void render(sf::RenderTarget& target, const sf::Drawable& ui);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Redraw the damaged regions and draw the composite
+	///
+	/// \param target Render target to draw the composite to
+	/// \param layers Drawables making up the user interface, drawn back to front
+	///
+	////////////////////////////////////////////////////////////
+	void render(sf::RenderTarget& target, const std::vector<const sf::Drawable*>& layers);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the regions redrawn by the last render
+	///
+	////////////////////////////////////////////////////////////
+	const std::vector<sf::IntRect>& getRedrawnRegions() const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Merge the damaged rectangles into pixel regions
+	///
+	////////////////////////////////////////////////////////////
+	void mergeDamage();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Redraw a single region of the composite
+	///
+	/// \param region Region in pixel coordinates
+	/// \param layers Drawables making up the user interface, drawn back to front
+	///
+	////////////////////////////////////////////////////////////
+	void redrawRegion(const sf::IntRect& region, const std::vector<const sf::Drawable*>& layers);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the outlines of the redrawn regions
+	///
+	/// \param target Render target to draw to
+	///
+	////////////////////////////////////////////////////////////
+	void drawDebugRegions(sf::RenderTarget& target) const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	sf::RenderTexture          m_composite;    //!< Cached user interface
+	sf::Color                  m_clearColor;   //!< Color damaged regions are cleared with
+	bool                       m_debugRegions; //!< Highlight redrawn regions
+	bool                       m_fullDamage;   //!< Whole composite has to be redrawn
+	std::vector<sf::FloatRect> m_damage;       //!< Damaged rectangles since the last render
+	std::vector<sf::IntRect>   m_regions;      //!< Regions redrawn by the last render
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_UI_COMPOSITOR_HPP
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Base64.hpp"
+#include <array>
+#include <SFML/Config.hpp>
+
+
+namespace le
+{
+static const char Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"; //!< Character of every 6 bit value
+
+
+////////////////////////////////////////////////////////////
+static std::array<sf::Int8, 256> buildValues()
+{
+	std::array<sf::Int8, 256> values;
+	values.fill(-1);
+	for (int i = 0; i < 64; i++)
+	{
+		values[static_cast<unsigned char>(Alphabet[i])] = static_cast<sf::Int8>(i);
+	}
+
+	return values;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string Base64::encode(const void* data, std::size_t size)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	std::string text;
+	text.reserve((size + 2) / 3 * 4);
+
+	std::size_t i = 0;
+	for (; i + 3 <= size; i += 3)
+	{
+		sf::Uint32 group = static_cast<sf::Uint32>(bytes[i]) << 16 | static_cast<sf::Uint32>(bytes[i + 1]) << 8 | bytes[i + 2];
+		text += Alphabet[group >> 18];
+		text += Alphabet[group >> 12 & 63];
+		text += Alphabet[group >> 6 & 63];
+		text += Alphabet[group & 63];
+	}
+
+	if (i < size)
+	{
+		sf::Uint32 group = static_cast<sf::Uint32>(bytes[i]) << 16 | (i + 1 < size ? static_cast<sf::Uint32>(bytes[i + 1]) << 8 : 0);
+		text += Alphabet[group >> 18];
+		text += Alphabet[group >> 12 & 63];
+		text += i + 1 < size ? Alphabet[group >> 6 & 63] : '=';
+		text += '=';
+	}
+
+	return text;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Base64::decode(const std::string& text, std::vector<char>& data)
+{
+	static const std::array<sf::Int8, 256> values = buildValues();
+
+	sf::Uint32 group = 0;
+	int count = 0;
+	int padding = 0;
+	for (char character : text)
+	{
+		if (character == ' ' || character == '\t' || character == '\r' || character == '\n')
+		{
+			continue;
+		}
+
+		// Only padding may follow padding
+		if (character == '=')
+		{
+			padding++;
+			group <<= 6;
+		}
+		else if (padding > 0 || values[static_cast<unsigned char>(character)] < 0)
+		{
+			return false;
+		}
+		else
+		{
+			group = group << 6 | static_cast<sf::Uint32>(values[static_cast<unsigned char>(character)]);
+		}
+
+		if (++count == 4)
+		{
+			if (padding > 2)
+			{
+				return false;
+			}
+
+			data.push_back(static_cast<char>(group >> 16));
+			if (padding < 2)
+			{
+				data.push_back(static_cast<char>(group >> 8));
+			}
+
+			if (padding < 1)
+			{
+				data.push_back(static_cast<char>(group));
+			}
+
+			group = 0;
+			count = 0;
+		}
+	}
+
+	return count == 0;
+}
+
+} //namespace le
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_BASE64_HPP
+#define LEVEL_EDITOR_BASE64_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Base64 encoding of binary data as text, as used by the clipboard
+///
+////////////////////////////////////////////////////////////
+class Base64
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Encode a block of memory
+	///
+	/// \param data Data to encode
+	/// \param size Size of the data in bytes
+	///
+	/// \return Padded base64 text
+	///
+	////////////////////////////////////////////////////////////
+	static std::string encode(const void* data, std::size_t size);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Decode base64 text
+	///
+	/// Whitespace is skipped, so that text wrapped by other
+	/// applications still decodes.
+	///
+	/// \param text Text to decode
+	/// \param data Buffer the decoded bytes are appended to
+	///
+	/// \return False if the text holds other characters or is truncated
+	///
+	////////////////////////////////////////////////////////////
+	static bool decode(const std::string& text, std::vector<char>& data);
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_BASE64_HPP
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "BitSet.hpp"
+#include <algorithm>
+#include <bit>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+BitSet::BitSet() :
+m_words(),
+m_size (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void BitSet::resize(std::size_t size)
+{
+	this->m_words.resize((size + 63) / 64, 0);
+	this->m_size = size;
+
+	// Bits past the size are kept cleared, so that growing again exposes cleared bits
+	if (size % 64 != 0)
+	{
+		this->m_words.back() &= (sf::Uint64(1) << (size % 64)) - 1;
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t BitSet::getSize() const
+{
+	return this->m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+void BitSet::set(std::size_t index, bool value)
+{
+	sf::Uint64 mask = sf::Uint64(1) << (index % 64);
+	if (value)
+	{
+		this->m_words[index / 64] |= mask;
+	}
+	else
+	{
+		this->m_words[index / 64] &= ~mask;
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool BitSet::test(std::size_t index) const
+{
+	return index < this->m_size && (this->m_words[index / 64] >> (index % 64)) & 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void BitSet::clear()
+{
+	std::fill(this->m_words.begin(), this->m_words.end(), 0);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t BitSet::getCount() const
+{
+	std::size_t count = 0;
+	for (sf::Uint64 word : this->m_words)
+	{
+		count += static_cast<std::size_t>(std::popcount(word));
+	}
+
+	return count;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t BitSet::findNext(std::size_t index) const
+{
+	if (index >= this->m_size)
+	{
+		return this->m_size;
+	}
+
+	// The bits below the index are masked out of its word, following words are skipped while empty
+	std::size_t word = index / 64;
+	sf::Uint64 bits = this->m_words[word] & (~sf::Uint64(0) << (index % 64));
+	while (bits == 0)
+	{
+		if (++word == this->m_words.size())
+		{
+			return this->m_size;
+		}
+
+		bits = this->m_words[word];
+	}
+
+	return word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+}
+
+} //namespace le
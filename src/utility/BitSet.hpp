@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_BIT_SET_HPP
+#define LEVEL_EDITOR_BIT_SET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <vector>
+#include <SFML/Config.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Resizable set of bits packed into 64 bit words
+///
+/// Used to store selections over dense indices, a million
+/// entries take 125 KiB and are cleared or counted a word at
+/// a time.
+///
+////////////////////////////////////////////////////////////
+class BitSet
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// This constructor creates an empty set
+	///
+	////////////////////////////////////////////////////////////
+	BitSet();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Change the amount of bits
+	///
+	/// Added bits are cleared, removed bits are lost.
+	///
+	/// \param size Amount of bits
+	///
+	////////////////////////////////////////////////////////////
+	void resize(std::size_t size);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of bits
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set or clear a bit
+	///
+	/// \param index Index of the bit, must be lower than the size
+	/// \param value New value of the bit
+	///
+	////////////////////////////////////////////////////////////
+	void set(std::size_t index, bool value = true);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the value of a bit
+	///
+	/// \param index Index of the bit, bits past the size read as cleared
+	///
+	////////////////////////////////////////////////////////////
+	bool test(std::size_t index) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Clear every bit, keeping the size
+	///
+	////////////////////////////////////////////////////////////
+	void clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of set bits
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the first set bit at or after an index
+	///
+	/// \param index Index to start from
+	///
+	/// \return Index of the bit, or the size if there is none
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t findNext(std::size_t index) const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::vector<sf::Uint64> m_words; //!< Bits, the unused bits of the last word are cleared
+	std::size_t             m_size;  //!< Amount of bits
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_BIT_SET_HPP
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "BoxFilter.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define LEVEL_EDITOR_BOX_FILTER_SSE2
+	#include <emmintrin.h>
+#endif
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static void sumRow(const sf::Uint8* row, const std::vector<unsigned int>& starts, const std::vector<unsigned int>& ends, std::vector<float>& sums)
+{
+#ifdef LEVEL_EDITOR_BOX_FILTER_SSE2
+	// Two pixels are widened to 16 bits per channel, colours are weighted by alpha and alpha by one
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+	const __m128i ones = _mm_set_epi16(1, 0, 0, 0, 1, 0, 0, 0);
+	for (std::size_t x = 0; x < starts.size(); x++)
+	{
+		__m128i sum = zero;
+		unsigned int i = starts[x];
+		for (; i + 2 <= ends[x]; i += 2)
+		{
+			__m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + i * 4)), zero);
+			__m128i weights = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			__m128i weighted = _mm_mullo_epi16(pixels, _mm_or_si128(_mm_andnot_si128(alphaLanes, weights), ones));
+			sum = _mm_add_epi32(sum, _mm_add_epi32(_mm_unpacklo_epi16(weighted, zero), _mm_unpackhi_epi16(weighted, zero)));
+		}
+
+		if (i < ends[x])
+		{
+			int value;
+			std::memcpy(&value, row + i * 4, 4);
+			__m128i pixel = _mm_unpacklo_epi8(_mm_cvtsi32_si128(value), zero);
+			__m128i weights = _mm_shufflelo_epi16(pixel, _MM_SHUFFLE(3, 3, 3, 3));
+			__m128i weighted = _mm_mullo_epi16(pixel, _mm_or_si128(_mm_andnot_si128(alphaLanes, weights), ones));
+			sum = _mm_add_epi32(sum, _mm_unpacklo_epi16(weighted, zero));
+		}
+
+		float* total = &sums[x * 4];
+		_mm_storeu_ps(total, _mm_add_ps(_mm_loadu_ps(total), _mm_cvtepi32_ps(sum)));
+	}
+#else
+	for (std::size_t x = 0; x < starts.size(); x++)
+	{
+		sf::Uint32 sum[4] = { 0, 0, 0, 0 };
+		for (unsigned int i = starts[x]; i < ends[x]; i++)
+		{
+			const sf::Uint8* pixel = row + i * 4;
+			sum[0] += pixel[0] * pixel[3];
+			sum[1] += pixel[1] * pixel[3];
+			sum[2] += pixel[2] * pixel[3];
+			sum[3] += pixel[3];
+		}
+
+		for (int channel = 0; channel < 4; channel++)
+		{
+			sums[x * 4 + channel] += static_cast<float>(sum[channel]);
+		}
+	}
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void BoxFilter::downscale(const sf::Uint8* source, const sf::Vector2u& sourceSize, sf::Uint8* destination, const sf::Vector2u& destinationSize, std::size_t stride)
+{
+	if (sourceSize.x == 0 || sourceSize.y == 0 || destinationSize.x == 0 || destinationSize.y == 0)
+	{
+		return;
+	}
+
+	// Every destination column covers at least one source column
+	std::vector<unsigned int> starts(destinationSize.x);
+	std::vector<unsigned int> ends(destinationSize.x);
+	for (unsigned int x = 0; x < destinationSize.x; x++)
+	{
+		starts[x] = static_cast<unsigned int>(static_cast<sf::Uint64>(x) * sourceSize.x / destinationSize.x);
+		ends[x] = std::max(starts[x] + 1, static_cast<unsigned int>(static_cast<sf::Uint64>(x + 1) * sourceSize.x / destinationSize.x));
+	}
+
+	std::vector<float> sums(static_cast<std::size_t>(destinationSize.x) * 4);
+	for (unsigned int y = 0; y < destinationSize.y; y++)
+	{
+		unsigned int top = static_cast<unsigned int>(static_cast<sf::Uint64>(y) * sourceSize.y / destinationSize.y);
+		unsigned int bottom = std::max(top + 1, static_cast<unsigned int>(static_cast<sf::Uint64>(y + 1) * sourceSize.y / destinationSize.y));
+
+		std::fill(sums.begin(), sums.end(), 0.f);
+		for (unsigned int row = top; row < bottom; row++)
+		{
+			sumRow(source + static_cast<std::size_t>(row) * sourceSize.x * 4, starts, ends, sums);
+		}
+
+		// Colours are divided by the alpha they were weighted with, alpha by the area of the box
+		sf::Uint8* pixel = destination + y * stride * 4;
+		for (unsigned int x = 0; x < destinationSize.x; x++, pixel += 4)
+		{
+			const float* sum = &sums[x * 4];
+			if (sum[3] <= 0.f)
+			{
+				std::memset(pixel, 0, 4);
+				continue;
+			}
+
+			float area = static_cast<float>((ends[x] - starts[x]) * (bottom - top));
+			for (int channel = 0; channel < 3; channel++)
+			{
+				pixel[channel] = static_cast<sf::Uint8>(std::min(sum[channel] / sum[3] + 0.5f, 255.f));
+			}
+
+			pixel[3] = static_cast<sf::Uint8>(std::min(sum[3] / area + 0.5f, 255.f));
+		}
+	}
+}
+
+} //namespace le
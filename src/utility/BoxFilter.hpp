@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_BOX_FILTER_HPP
+#define LEVEL_EDITOR_BOX_FILTER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Utility class shrinking RGBA images with a box filter
+///
+/// Every destination pixel averages the source pixels it covers,
+/// weighted by their alpha so that transparent pixels do not
+/// darken the edges of sprites. Each source row is read once,
+/// with SSE2 summing the four channels of a pixel at once when
+/// the compiler targets it.
+///
+////////////////////////////////////////////////////////////
+class BoxFilter
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Shrink an image
+	///
+	/// Images smaller than the destination are enlarged by
+	/// repeating their pixels.
+	///
+	/// \param source          RGBA pixels of the source, rows packed
+	/// \param sourceSize      Size of the source in pixels
+	/// \param destination     First RGBA pixel written
+	/// \param destinationSize Size of the area written in pixels
+	/// \param stride          Pixels between two rows of the destination
+	///
+	////////////////////////////////////////////////////////////
+	static void downscale(const sf::Uint8* source, const sf::Vector2u& sourceSize, sf::Uint8* destination, const sf::Vector2u& destinationSize, std::size_t stride);
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_BOX_FILTER_HPP
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_COMMAND_HPP
+#define LEVEL_EDITOR_COMMAND_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <vector>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Interface of the edits stored in the history
+///
+/// A command is pushed once it was applied and only keeps what
+/// differs between the state before and after it. Its data can
+/// be moved out of memory and restored later, the history uses
+/// this to keep old commands on disk.
+///
+////////////////////////////////////////////////////////////
+class Command
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~Command() {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Revert the edit
+	///
+	////////////////////////////////////////////////////////////
+	virtual void undo() = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Apply the edit again after it was reverted
+	///
+	////////////////////////////////////////////////////////////
+	virtual void redo() = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Absorb the command applied right after this one
+	///
+	/// \param next Command following this one
+	///
+	/// \return True if this command now covers both edits
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool merge(Command& next) { return false; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of memory held by the command in bytes
+	///
+	////////////////////////////////////////////////////////////
+	virtual std::size_t getMemoryUsage() const = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move the data of the command out of memory
+	///
+	/// \param data Buffer the data is appended to
+	///
+	////////////////////////////////////////////////////////////
+	virtual void spill(std::vector<char>& data) = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Restore the data moved out by spill
+	///
+	/// \param data Data returned by spill
+	/// \param size Size of the data in bytes
+	///
+	/// \return False if the data could not be read
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool restore(const char* data, std::size_t size) = 0;
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_COMMAND_HPP
@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_COORD_MAP_HPP
+#define LEVEL_EDITOR_COORD_MAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <vector>
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Hash map keyed by 2D integer coordinates
+///
+/// Values are stored densely next to their keys, an open
+/// addressing table with linear probing maps coordinates to
+/// their position. Iteration walks the dense array, which is
+/// sorted row by row on demand after it was modified.
+///
+/// Inserting, erasing and getting the entries after a change
+/// invalidate pointers to values.
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class CoordMap
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class pairing a value with its coordinates
+	///
+	////////////////////////////////////////////////////////////
+	struct Entry
+	{
+		sf::Vector2i m_key;   //!< Coordinates, must not be modified
+		T            m_value; //!< Stored value
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// This constructor creates an empty map
+	///
+	////////////////////////////////////////////////////////////
+	CoordMap();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the value stored at coordinates
+	///
+	/// \param key Coordinates
+	///
+	/// \return The value, or nullptr if there is none
+	///
+	////////////////////////////////////////////////////////////
+	T* find(const sf::Vector2i& key);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the value stored at coordinates
+	///
+	/// \param key Coordinates
+	///
+	/// \return The value, or nullptr if there is none
+	///
+	////////////////////////////////////////////////////////////
+	const T* find(const sf::Vector2i& key) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the value stored at coordinates, inserting a default one if there is none
+	///
+	/// \param key Coordinates
+	///
+	////////////////////////////////////////////////////////////
+	T& operator[](const sf::Vector2i& key);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove the value stored at coordinates
+	///
+	/// \param key Coordinates
+	///
+	/// \return True if a value was removed
+	///
+	////////////////////////////////////////////////////////////
+	bool erase(const sf::Vector2i& key);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove every value
+	///
+	////////////////////////////////////////////////////////////
+	void clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of stored values
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether no value is stored
+	///
+	////////////////////////////////////////////////////////////
+	bool isEmpty() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get every entry, sorted by row and then by column
+	///
+	/// The entries are sorted again if the map was modified since
+	/// the last call, which moves the values. Pointers and
+	/// references returned by find or operator[] before the call
+	/// are invalid after it.
+	///
+	////////////////////////////////////////////////////////////
+	std::vector<Entry>& getEntries();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get every entry, sorted by row and then by column
+	///
+	/// The entries are sorted again if the map was modified since
+	/// the last call, which moves the values. Pointers and
+	/// references returned by find or operator[] before the call
+	/// are invalid after it.
+	///
+	////////////////////////////////////////////////////////////
+	const std::vector<Entry>& getEntries() const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the preferred slot of coordinates
+	///
+	/// \param key Coordinates
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getHome(const sf::Vector2i& key) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the slot holding coordinates or the empty slot ending their probe sequence
+	///
+	/// \param key Coordinates
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t probe(const sf::Vector2i& key) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Rebuild the slot table with a capacity
+	///
+	/// \param capacity Amount of slots, a power of two
+	///
+	////////////////////////////////////////////////////////////
+	void rehash(std::size_t capacity) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sort the entries and rebuild the slot table if needed
+	///
+	////////////////////////////////////////////////////////////
+	void sort() const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	mutable std::vector<Entry>      m_entries; //!< Dense array of the stored entries
+	mutable std::vector<sf::Uint32> m_slots;   //!< Open addressing table holding entry indices plus one, 0 being empty
+	mutable bool                    m_sorted;  //!< Entries are sorted
+};
+
+} //namespace le
+
+
+#include "CoordMap.inl"
+#endif // LEVEL_EDITOR_COORD_MAP_HPP
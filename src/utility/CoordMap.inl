@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_COORD_MAP_INL
+#define LEVEL_EDITOR_COORD_MAP_INL
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "CoordMap.hpp"
+#include <algorithm>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+template <typename T>
+inline CoordMap<T>::CoordMap() :
+m_entries(),
+m_slots  (),
+m_sorted (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline T* CoordMap<T>::find(const sf::Vector2i& key)
+{
+	return const_cast<T*>(static_cast<const CoordMap<T>*>(this)->find(key));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline const T* CoordMap<T>::find(const sf::Vector2i& key) const
+{
+	if (this->m_entries.empty())
+	{
+		return nullptr;
+	}
+
+	sf::Uint32 slot = this->m_slots[probe(key)];
+	return slot != 0 ? &this->m_entries[slot - 1].m_value : nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline T& CoordMap<T>::operator[](const sf::Vector2i& key)
+{
+	if (T* value = find(key))
+	{
+		return *value;
+	}
+
+	// Keep the load factor at or below one half, so probe sequences stay short
+	if ((this->m_entries.size() + 1) * 2 > this->m_slots.size())
+	{
+		rehash(std::max<std::size_t>(this->m_slots.size() * 2, 16));
+	}
+
+	this->m_entries.push_back(Entry{ key, T() });
+	this->m_slots[probe(key)] = static_cast<sf::Uint32>(this->m_entries.size());
+
+	const Entry* previous = this->m_entries.size() > 1 ? &this->m_entries[this->m_entries.size() - 2] : nullptr;
+	if (previous && (previous->m_key.y > key.y || (previous->m_key.y == key.y && previous->m_key.x > key.x)))
+	{
+		this->m_sorted = false;
+	}
+
+	return this->m_entries.back().m_value;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline bool CoordMap<T>::erase(const sf::Vector2i& key)
+{
+	if (this->m_entries.empty())
+	{
+		return false;
+	}
+
+	std::size_t hole = probe(key);
+	sf::Uint32 slot = this->m_slots[hole];
+	if (slot == 0)
+	{
+		return false;
+	}
+
+	// Backward shift deletion moves displaced entries into the hole instead of leaving tombstones
+	std::size_t mask = this->m_slots.size() - 1;
+	for (std::size_t next = (hole + 1) & mask; this->m_slots[next] != 0; next = (next + 1) & mask)
+	{
+		std::size_t home = getHome(this->m_entries[this->m_slots[next] - 1].m_key);
+		bool movable = hole <= next ? (home <= hole || home > next) : (home <= hole && home > next);
+		if (movable)
+		{
+			this->m_slots[hole] = this->m_slots[next];
+			hole = next;
+		}
+	}
+
+	this->m_slots[hole] = 0;
+
+	// The last entry takes the place of the removed one
+	std::size_t index = slot - 1;
+	std::size_t last = this->m_entries.size() - 1;
+	if (index != last)
+	{
+		this->m_entries[index] = std::move(this->m_entries[last]);
+		this->m_slots[probe(this->m_entries[index].m_key)] = slot;
+		this->m_sorted = false;
+	}
+
+	this->m_entries.pop_back();
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline void CoordMap<T>::clear()
+{
+	this->m_entries.clear();
+	this->m_slots.clear();
+	this->m_sorted = true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline std::size_t CoordMap<T>::getSize() const
+{
+	return this->m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline bool CoordMap<T>::isEmpty() const
+{
+	return this->m_entries.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline std::vector<typename CoordMap<T>::Entry>& CoordMap<T>::getEntries()
+{
+	sort();
+	return this->m_entries;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline const std::vector<typename CoordMap<T>::Entry>& CoordMap<T>::getEntries() const
+{
+	sort();
+	return this->m_entries;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline std::size_t CoordMap<T>::getHome(const sf::Vector2i& key) const
+{
+	// Fibonacci hashing spreads neighbouring coordinates over the whole table
+	sf::Uint64 packed = static_cast<sf::Uint64>(static_cast<sf::Uint32>(key.x)) << 32 | static_cast<sf::Uint32>(key.y);
+	sf::Uint64 hash = packed * 0x9E3779B97F4A7C15ull;
+	return static_cast<std::size_t>(hash >> 32) & (this->m_slots.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline std::size_t CoordMap<T>::probe(const sf::Vector2i& key) const
+{
+	std::size_t mask = this->m_slots.size() - 1;
+	std::size_t index = getHome(key);
+
+	while (this->m_slots[index] != 0 && this->m_entries[this->m_slots[index] - 1].m_key != key)
+	{
+		index = (index + 1) & mask;
+	}
+
+	return index;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline void CoordMap<T>::rehash(std::size_t capacity) const
+{
+	this->m_slots.assign(capacity, 0);
+	for (std::size_t i = 0; i < this->m_entries.size(); i++)
+	{
+		this->m_slots[probe(this->m_entries[i].m_key)] = static_cast<sf::Uint32>(i + 1);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+inline void CoordMap<T>::sort() const
+{
+	if (!this->m_sorted)
+	{
+		std::sort(this->m_entries.begin(), this->m_entries.end(), [](const Entry& first, const Entry& second)
+		{
+			return first.m_key.y < second.m_key.y || (first.m_key.y == second.m_key.y && first.m_key.x < second.m_key.x);
+		});
+
+		rehash(this->m_slots.size());
+		this->m_sorted = true;
+	}
+}
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_COORD_MAP_INL
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Crc32.hpp"
+#include <array>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static constexpr std::array<sf::Uint32, 256> createTable()
+{
+	std::array<sf::Uint32, 256> table = {};
+	for (sf::Uint32 i = 0; i < 256; i++)
+	{
+		sf::Uint32 value = i;
+		for (int bit = 0; bit < 8; bit++)
+		{
+			value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+		}
+
+		table[i] = value;
+	}
+
+	return table;
+}
+
+
+////////////////////////////////////////////////////////////
+static constexpr std::array<sf::Uint32, 256> Table = createTable(); //!< Checksum of every byte value, reflected polynomial 0x04C11DB7
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 Crc32::compute(const void* data, std::size_t size, sf::Uint32 crc)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	crc = ~crc;
+	for (std::size_t i = 0; i < size; i++)
+	{
+		crc = Table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+	}
+
+	return ~crc;
+}
+
+} //namespace le
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "DurableFile.hpp"
+#include <algorithm>
+
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+DurableFile::DurableFile() :
+m_handle(-1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+DurableFile::~DurableFile()
+{
+	close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool DurableFile::open(const std::filesystem::path& path)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	this->m_handle = reinterpret_cast<std::intptr_t>(file);
+#else
+	int descriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (descriptor < 0)
+	{
+		return false;
+	}
+
+	this->m_handle = descriptor;
+#endif
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DurableFile::close()
+{
+	if (!isOpen())
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	CloseHandle(reinterpret_cast<HANDLE>(this->m_handle));
+#else
+	::close(static_cast<int>(this->m_handle));
+#endif
+
+	this->m_handle = -1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DurableFile::isOpen() const
+{
+	return this->m_handle != -1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DurableFile::write(const void* data, std::size_t size)
+{
+	if (!isOpen())
+	{
+		return false;
+	}
+
+	const char* bytes = static_cast<const char*>(data);
+	while (size > 0)
+	{
+#ifdef _WIN32
+		DWORD written = 0;
+		DWORD block = static_cast<DWORD>(std::min<std::size_t>(size, 1 << 30));
+		if (!WriteFile(reinterpret_cast<HANDLE>(this->m_handle), bytes, block, &written, nullptr))
+		{
+			return false;
+		}
+#else
+		ssize_t written = ::write(static_cast<int>(this->m_handle), bytes, size);
+		if (written < 0 && errno == EINTR)
+		{
+			continue;
+		}
+
+		if (written <= 0)
+		{
+			return false;
+		}
+#endif
+
+		bytes += written;
+		size -= static_cast<std::size_t>(written);
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DurableFile::sync()
+{
+	if (!isOpen())
+	{
+		return false;
+	}
+
+#ifdef _WIN32
+	return FlushFileBuffers(reinterpret_cast<HANDLE>(this->m_handle)) != 0;
+#else
+	return fsync(static_cast<int>(this->m_handle)) == 0;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool DurableFile::sync(const std::filesystem::path& path)
+{
+	// Flushing through a new handle also covers what other handles wrote to the same file
+#ifdef _WIN32
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	bool synced = FlushFileBuffers(file) != 0;
+	CloseHandle(file);
+#else
+	int descriptor = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+	if (descriptor < 0)
+	{
+		return false;
+	}
+
+	bool synced = fsync(descriptor) == 0;
+	::close(descriptor);
+#endif
+
+	return synced;
+}
+
+} //namespace le
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_DURABLE_FILE_HPP
+#define LEVEL_EDITOR_DURABLE_FILE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief File written sequentially whose content can be forced to disk
+///
+/// Writes only reach the operating system's cache, sync returns
+/// once the written data would survive a crash or a power loss.
+///
+////////////////////////////////////////////////////////////
+class DurableFile : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	DurableFile();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	////////////////////////////////////////////////////////////
+	~DurableFile();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Create a file or empty an existing one, replacing the current one
+	///
+	/// \param path Path of the file
+	///
+	/// \return True if the file was opened
+	///
+	////////////////////////////////////////////////////////////
+	bool open(const std::filesystem::path& path);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Close the file
+	///
+	////////////////////////////////////////////////////////////
+	void close();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a file is open
+	///
+	////////////////////////////////////////////////////////////
+	bool isOpen() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Append data to the file
+	///
+	/// \param data Data to write
+	/// \param size Size of the data in bytes
+	///
+	/// \return True if every byte was written
+	///
+	////////////////////////////////////////////////////////////
+	bool write(const void* data, std::size_t size);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Wait until the written data is stored on disk
+	///
+	/// \return True if the data is stored
+	///
+	////////////////////////////////////////////////////////////
+	bool sync();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Wait until the data written to a file by any handle is stored on disk
+	///
+	/// \param path Path of the file
+	///
+	/// \return True if the data is stored
+	///
+	////////////////////////////////////////////////////////////
+	static bool sync(const std::filesystem::path& path);
+
+private:
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::intptr_t m_handle; //!< Native handle of the file, -1 if no file is open
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_DURABLE_FILE_HPP
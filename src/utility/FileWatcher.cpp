@@ -0,0 +1,327 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "FileWatcher.hpp"
+#include <cstdio>
+
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <poll.h>
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#endif
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const sf::Int64 SettleTime  = 30000; //!< Microseconds a file must be left alone before it is reported
+static const int       WaitTimeout = 50;    //!< Milliseconds the thread waits before checking whether to stop
+
+
+#ifndef _WIN32
+////////////////////////////////////////////////////////////
+static void watchTree(int descriptor, std::unordered_map<int, std::filesystem::path>& watches, const std::filesystem::path& directory)
+{
+	const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+	int watch = inotify_add_watch(descriptor, directory.c_str(), mask);
+	if (watch < 0)
+	{
+		return;
+	}
+
+	watches[watch] = directory;
+
+	std::error_code error;
+	for (std::filesystem::recursive_directory_iterator it(directory, std::filesystem::directory_options::skip_permission_denied, error), end; !error && it != end; it.increment(error))
+	{
+		if (it->is_directory(error))
+		{
+			watch = inotify_add_watch(descriptor, it->path().c_str(), mask);
+			if (watch >= 0)
+			{
+				watches[watch] = it->path();
+			}
+		}
+	}
+}
+#endif
+
+
+////////////////////////////////////////////////////////////
+FileWatcher::FileWatcher() :
+m_directory(),
+m_handle   (-1),
+m_watches  (),
+m_thread   (),
+m_stopping (false),
+m_mutex    (),
+m_written  (),
+m_clock    ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+FileWatcher::~FileWatcher()
+{
+	close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool FileWatcher::open(const std::filesystem::path& directory)
+{
+	close();
+
+	std::error_code error;
+	this->m_directory = std::filesystem::absolute(directory, error).lexically_normal();
+	if (error || !std::filesystem::is_directory(this->m_directory, error))
+	{
+		return false;
+	}
+
+#ifdef _WIN32
+	HANDLE handle = CreateFileW(this->m_directory.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	this->m_handle = reinterpret_cast<std::intptr_t>(handle);
+#else
+	int descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (descriptor < 0)
+	{
+		return false;
+	}
+
+	// inotify is not recursive, every directory of the tree gets its own watch
+	watchTree(descriptor, this->m_watches, this->m_directory);
+	if (this->m_watches.empty())
+	{
+		::close(descriptor);
+		return false;
+	}
+
+	this->m_handle = descriptor;
+#endif
+
+	this->m_thread = std::thread(&FileWatcher::run, this);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void FileWatcher::close()
+{
+	if (!isOpen())
+	{
+		return;
+	}
+
+	this->m_stopping = true;
+	this->m_thread.join();
+	this->m_stopping = false;
+
+#ifdef _WIN32
+	CloseHandle(reinterpret_cast<HANDLE>(this->m_handle));
+#else
+	::close(static_cast<int>(this->m_handle));
+#endif
+
+	this->m_handle = -1;
+	this->m_watches.clear();
+	this->m_written.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool FileWatcher::isOpen() const
+{
+	return this->m_handle != -1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FileWatcher::poll(std::vector<std::filesystem::path>& changed)
+{
+	changed.clear();
+	sf::Int64 now = this->m_clock.getElapsedTime().asMicroseconds();
+
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	for (auto it = this->m_written.begin(); it != this->m_written.end();)
+	{
+		if (now - it->second >= SettleTime)
+		{
+			changed.emplace_back(it->first);
+			it = this->m_written.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	return !changed.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+void FileWatcher::run()
+{
+#ifdef _WIN32
+	HANDLE directory = reinterpret_cast<HANDLE>(this->m_handle);
+	OVERLAPPED overlapped = {};
+	overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	alignas(DWORD) char buffer[64 * 1024];
+	bool pending = false;
+	DWORD length = 0;
+
+	while (!this->m_stopping)
+	{
+		if (!pending)
+		{
+			ResetEvent(overlapped.hEvent);
+			if (!ReadDirectoryChangesW(directory, buffer, sizeof(buffer), TRUE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE,
+				nullptr, &overlapped, nullptr))
+			{
+				printf("Failed to watch %s\n", this->m_directory.generic_string().c_str());
+				break;
+			}
+
+			pending = true;
+		}
+
+		if (WaitForSingleObject(overlapped.hEvent, WaitTimeout) != WAIT_OBJECT_0)
+		{
+			continue;
+		}
+
+		// An empty result means the buffer overflowed and the writes are lost
+		pending = false;
+		if (!GetOverlappedResult(directory, &overlapped, &length, FALSE) || length == 0)
+		{
+			continue;
+		}
+
+		for (DWORD offset = 0;;)
+		{
+			const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buffer + offset);
+			if (info->Action != FILE_ACTION_REMOVED && info->Action != FILE_ACTION_RENAMED_OLD_NAME)
+			{
+				add(this->m_directory / std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR)));
+			}
+
+			if (info->NextEntryOffset == 0)
+			{
+				break;
+			}
+
+			offset += info->NextEntryOffset;
+		}
+	}
+
+	if (pending)
+	{
+		CancelIo(directory);
+		GetOverlappedResult(directory, &overlapped, &length, TRUE);
+	}
+
+	CloseHandle(overlapped.hEvent);
+#else
+	int descriptor = static_cast<int>(this->m_handle);
+	alignas(inotify_event) char buffer[64 * 1024];
+
+	while (!this->m_stopping)
+	{
+		pollfd request = { descriptor, POLLIN, 0 };
+		if (::poll(&request, 1, WaitTimeout) <= 0)
+		{
+			continue;
+		}
+
+		ssize_t length = read(descriptor, buffer, sizeof(buffer));
+		for (ssize_t offset = 0; offset < length;)
+		{
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+			auto watch = this->m_watches.find(event->wd);
+			if (watch == this->m_watches.end())
+			{
+				continue;
+			}
+
+			if (event->mask & IN_IGNORED)
+			{
+				this->m_watches.erase(watch);
+				continue;
+			}
+
+			if (event->len == 0)
+			{
+				continue;
+			}
+
+			// Files are reported when closed after writing or moved in, which is how most tools save atomically
+			std::filesystem::path path = watch->second / event->name;
+			if (event->mask & IN_ISDIR)
+			{
+				watchTree(descriptor, this->m_watches, path);
+			}
+			else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+			{
+				add(path);
+			}
+		}
+	}
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void FileWatcher::add(const std::filesystem::path& path)
+{
+	sf::Int64 now = this->m_clock.getElapsedTime().asMicroseconds();
+	std::string key = path.lexically_normal().generic_string();
+
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	this->m_written[key] = now;
+}
+
+} //namespace le
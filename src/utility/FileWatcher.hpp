@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_FILE_WATCHER_HPP
+#define LEVEL_EDITOR_FILE_WATCHER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Config.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Reports the files written within a directory tree
+///
+/// A thread waits for the notifications of the system, inotify
+/// on Linux and ReadDirectoryChangesW on Windows. A file is only
+/// reported once it was left alone for a short while, so a file
+/// written in several steps is reported once, when complete.
+///
+////////////////////////////////////////////////////////////
+class FileWatcher : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	FileWatcher();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Stops watching.
+	///
+	////////////////////////////////////////////////////////////
+	~FileWatcher();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Watch a directory and its subdirectories
+	///
+	/// \param directory Path of the directory
+	///
+	/// \return False if the directory could not be watched
+	///
+	////////////////////////////////////////////////////////////
+	bool open(const std::filesystem::path& directory);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Stop watching
+	///
+	////////////////////////////////////////////////////////////
+	void close();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a directory is watched
+	///
+	////////////////////////////////////////////////////////////
+	bool isOpen() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Take the files written since the last poll
+	///
+	/// \param changed Receives the absolute, normalized paths of the files, each once
+	///
+	/// \return True if a file was reported
+	///
+	////////////////////////////////////////////////////////////
+	bool poll(std::vector<std::filesystem::path>& changed);
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Loop of the thread waiting for notifications
+	///
+	////////////////////////////////////////////////////////////
+	void run();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Record a write to a file
+	///
+	/// \param path Absolute path of the file
+	///
+	////////////////////////////////////////////////////////////
+	void add(const std::filesystem::path& path);
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::filesystem::path                                   m_directory;   //!< Absolute path of the watched directory
+	std::intptr_t                                           m_handle;      //!< Notification handle of the system, -1 while closed
+	std::unordered_map<int, std::filesystem::path>          m_watches;     //!< Directory of every inotify watch, used by the thread
+	std::thread                                             m_thread;      //!< Thread waiting for notifications
+	std::atomic<bool>                                       m_stopping;    //!< Thread has to exit
+	std::mutex                                              m_mutex;       //!< Protects the written files
+	std::unordered_map<std::string, sf::Int64>              m_written;     //!< Written files with the time of their last write, in microseconds
+	sf::Clock                                               m_clock;       //!< Time the writes are measured with
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_FILE_WATCHER_HPP
@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "FrameScheduler.hpp"
+#include "TimerWheel.hpp"
+#include "UpdateScheduler.hpp"
+#include <algorithm>
+#include <SFML/System/Sleep.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const sf::Time PollInterval = sf::milliseconds(8); //!< Granularity of input polling while waiting for a deadline
+
+
+////////////////////////////////////////////////////////////
+FrameScheduler::FrameScheduler() :
+m_invalidated      (true),
+m_focused          (true),
+m_focusedInterval  (sf::seconds(1.f / 60.f)),
+m_unfocusedInterval(sf::seconds(1.f / 10.f)),
+m_frameClock       (),
+m_statistics       ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+FrameScheduler& FrameScheduler::getDefault()
+{
+	static FrameScheduler scheduler;
+	return scheduler;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameScheduler::invalidate()
+{
+	this->m_invalidated = true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameScheduler::isInvalidated() const
+{
+	return this->m_invalidated;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameScheduler::setFrameIntervals(sf::Time focused, sf::Time unfocused)
+{
+	this->m_focusedInterval = focused;
+	this->m_unfocusedInterval = unfocused;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameScheduler::waitEvent(sf::Window& window, sf::Event& event)
+{
+	if (window.pollEvent(event))
+	{
+		return true;
+	}
+
+	sf::Clock clock;
+	std::optional<sf::Time> timeout = getTimeout();
+
+	if (!timeout)
+	{
+		bool received = window.waitEvent(event);
+		this->m_statistics.m_idle += clock.getElapsedTime();
+		return received;
+	}
+
+	// SFML cannot wait for an event with a timeout, so the deadline is approached in short sleeps
+	bool received = false;
+	for (sf::Time elapsed = sf::Time::Zero; elapsed < *timeout && !received; elapsed = clock.getElapsedTime())
+	{
+		sf::sleep(std::min(*timeout - elapsed, PollInterval));
+		received = window.pollEvent(event);
+	}
+
+	this->m_statistics.m_idle += clock.getElapsedTime();
+	return received;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameScheduler::onWindowEvent(const sf::Event& event)
+{
+	switch (event.type)
+	{
+		case sf::Event::LostFocus:
+			this->m_focused = false;
+			break;
+
+		case sf::Event::GainedFocus:
+			this->m_focused = true;
+			invalidate();
+			break;
+
+		case sf::Event::Resized:
+			invalidate();
+			break;
+
+		default:
+			break;
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameScheduler::beginFrame()
+{
+	if (!this->m_invalidated || this->m_frameClock.getElapsedTime() < getFrameInterval())
+	{
+		++this->m_statistics.m_skipped;
+		return false;
+	}
+
+	this->m_invalidated = false;
+	this->m_frameClock.restart();
+	++this->m_statistics.m_rendered;
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const FrameScheduler::Statistics& FrameScheduler::getStatistics() const
+{
+	return this->m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Time FrameScheduler::getFrameInterval() const
+{
+	return this->m_focused ? this->m_focusedInterval : this->m_unfocusedInterval;
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<sf::Time> FrameScheduler::getTimeout() const
+{
+	sf::Time untilFrame = std::max(getFrameInterval() - this->m_frameClock.getElapsedTime(), sf::Time::Zero);
+	if (this->m_invalidated || UpdateScheduler::getDefault().getCount() > 0)
+	{
+		return untilFrame;
+	}
+
+	return TimerWheel::getDefault().getTimeUntilNext();
+}
+
+} //namespace le
@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_FRAME_SCHEDULER_HPP
+#define LEVEL_EDITOR_FRAME_SCHEDULER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <optional>
+#include <SFML/Config.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Window.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Decides when the main loop renders and how long it may sleep
+///
+/// Controls and components invalidate the frame whenever their
+/// visual state changes. While nothing is invalidated, no control is
+/// scheduled for updates and no timer is due, the main loop blocks
+/// in waitEvent instead of redrawing the same frame again.
+///
+////////////////////////////////////////////////////////////
+class FrameScheduler : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class gathering frame metrics
+	///
+	////////////////////////////////////////////////////////////
+	struct Statistics
+	{
+		sf::Uint64 m_rendered; //!< Amount of frames that were rendered
+		sf::Uint64 m_skipped;  //!< Amount of wake-ups that did not need a new frame
+		sf::Time   m_idle;     //!< Total time spent waiting for events or timers
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	FrameScheduler();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the scheduler driving the application's main loop
+	///
+	////////////////////////////////////////////////////////////
+	static FrameScheduler& getDefault();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Request a new frame to be rendered
+	///
+	////////////////////////////////////////////////////////////
+	void invalidate();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a new frame was requested
+	///
+	////////////////////////////////////////////////////////////
+	bool isInvalidated() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the shortest time between two rendered frames
+	///
+	/// \param focused   Interval used while the window has focus
+	/// \param unfocused Interval used while the window is in background
+	///
+	////////////////////////////////////////////////////////////
+	void setFrameIntervals(sf::Time focused, sf::Time unfocused);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Wait until an event arrives or the loop has work to do
+	///
+	/// Returns immediately if an event is pending. Otherwise blocks
+	/// until the next frame slot if a frame is requested or controls
+	/// are scheduled, until the next timer is due if one is pending,
+	/// or until the next event arrives.
+	///
+	/// \param window Window to get events from
+	/// \param event  Event to be returned
+	///
+	/// \return True if an event was returned
+	///
+	////////////////////////////////////////////////////////////
+	bool waitEvent(sf::Window& window, sf::Event& event);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Process sf::Event affecting the frame pacing
+	///
+	/// Focus changes switch the frame interval, resizing and
+	/// regaining focus invalidate the frame.
+	///
+	/// \param event Event that was triggered
+	///
+	////////////////////////////////////////////////////////////
+	void onWindowEvent(const sf::Event& event);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a frame should be rendered now
+	///
+	/// Consumes the invalidation if it does, so that invalidations
+	/// raised while drawing request the following frame.
+	///
+	/// \return True if the caller has to render a frame
+	///
+	////////////////////////////////////////////////////////////
+	bool beginFrame();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the frame metrics
+	///
+	////////////////////////////////////////////////////////////
+	const Statistics& getStatistics() const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the shortest time between two frames in the current focus state
+	///
+	////////////////////////////////////////////////////////////
+	sf::Time getFrameInterval() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get how long the loop may wait before it has work to do
+	///
+	/// \return Time to wait, or std::nullopt to wait for the next event
+	///
+	////////////////////////////////////////////////////////////
+	std::optional<sf::Time> getTimeout() const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	bool       m_invalidated;       //!< A new frame was requested
+	bool       m_focused;           //!< Window has focus
+	sf::Time   m_focusedInterval;   //!< Shortest time between two frames while focused
+	sf::Time   m_unfocusedInterval; //!< Shortest time between two frames while unfocused
+	sf::Clock  m_frameClock;        //!< Time since the last rendered frame
+	Statistics m_statistics;        //!< Frame metrics
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_FRAME_SCHEDULER_HPP
@@ -0,0 +1,1068 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "FuzzyMatcher.hpp"
+#include "JobSystem.hpp"
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#if defined(__AVX2__)
+	#define LEVEL_EDITOR_FUZZY_MATCHER_AVX2
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define LEVEL_EDITOR_FUZZY_MATCHER_SSE2
+	#include <emmintrin.h>
+#endif
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const std::size_t Padding          = 64;   //!< Bytes after the last text, so that a vector load never leaves the buffer
+static const std::size_t MaskedLength     = 64;   //!< Length of the texts matched with a bit per position
+static const std::size_t MaskedLetters    = 32;   //!< Length of the queries matched with a bit per position
+static const std::size_t MatchBlock       = 4096; //!< Texts matched per job
+static const std::size_t Letters          = 26;   //!< Amount of letters, whose bits of texts come first
+static const std::size_t Symbols          = 32;   //!< Amount of letters and separators whose pairs list the texts containing them in order
+static const std::size_t PairResults      = 64;   //!< Amount of best texts kept for every pair of letters
+static const std::size_t PrefetchOffsets  = 16;   //!< Texts scored ahead of the one whose offset is fetched
+static const std::size_t PrefetchTexts    = 8;    //!< Texts scored ahead of the one whose bytes are fetched
+static const sf::Int32   ScoreMatch       = 16;   //!< Score of every letter matched
+static const sf::Int32   BonusStart       = 32;   //!< Added when a letter matches the first of the text
+static const sf::Int32   BonusBoundary    = 24;   //!< Added when a letter matches the first of a word
+static const sf::Int32   BonusConsecutive = 16;   //!< Added when a letter matches right after the previous one
+static const sf::Int32   PenaltyGap       = 3;    //!< Removed when letters are skipped between two matched
+static const sf::Int32   PenaltyGapLetter = 1;    //!< Removed for every letter skipped after the first
+static const sf::Int32   Lengths          = MaskedLength + 1; //!< Lengths the texts of a bound are sorted by, longer ones sorting together
+
+
+////////////////////////////////////////////////////////////
+static const std::vector<sf::Uint64> NoTexts; //!< Bits of no text
+
+
+////////////////////////////////////////////////////////////
+static char fold(char byte)
+{
+	return byte >= 'A' && byte <= 'Z' ? static_cast<char>(byte - 'A' + 'a') : byte;
+}
+
+
+////////////////////////////////////////////////////////////
+static sf::Uint64 letterBit(char byte)
+{
+	// Letters and digits get a bit of their own, other bytes share the rest
+	unsigned char value = static_cast<unsigned char>(byte);
+	if (value >= 'a' && value <= 'z')
+	{
+		return sf::Uint64(1) << (value - 'a');
+	}
+
+	if (value >= '0' && value <= '9')
+	{
+		return sf::Uint64(1) << (26 + value - '0');
+	}
+
+	return sf::Uint64(1) << (36 + value % 28);
+}
+
+
+////////////////////////////////////////////////////////////
+static bool isLetter(char byte)
+{
+	return byte >= 'a' && byte <= 'z';
+}
+
+
+////////////////////////////////////////////////////////////
+static std::size_t symbolIndex(char byte)
+{
+	// Folded letters and the separators of paths and names have pairs, other bytes get Symbols
+	if (isLetter(byte))
+	{
+		return static_cast<std::size_t>(byte - 'a');
+	}
+
+	static const char separators[] = " -./\\_";
+	const char* end = separators + sizeof(separators) - 1;
+	const char* found = std::find(separators, end, byte);
+	return found == end ? Symbols : Letters + static_cast<std::size_t>(found - separators);
+}
+
+
+////////////////////////////////////////////////////////////
+static bool isBoundary(const std::string& text, std::size_t position)
+{
+	unsigned char previous = static_cast<unsigned char>(text[position - 1]);
+	unsigned char current = static_cast<unsigned char>(text[position]);
+	bool previousLower = previous >= 'a' && previous <= 'z';
+	bool previousUpper = previous >= 'A' && previous <= 'Z';
+	bool previousDigit = previous >= '0' && previous <= '9';
+	bool currentUpper = current >= 'A' && current <= 'Z';
+	bool currentDigit = current >= '0' && current <= '9';
+
+	// Words start after separators, at humps of camel case and where digits follow letters
+	if (!previousLower && !previousUpper && !previousDigit && previous < 0x80)
+	{
+		return true;
+	}
+
+	return (previousLower && currentUpper) || ((previousLower || previousUpper) && currentDigit);
+}
+
+
+////////////////////////////////////////////////////////////
+static bool isSubsequence(const std::string& letters, const std::string& text)
+{
+	std::size_t found = 0;
+	for (std::size_t i = 0; i < text.size() && found < letters.size(); i++)
+	{
+		found += text[i] == letters[found];
+	}
+
+	return found == letters.size();
+}
+
+
+////////////////////////////////////////////////////////////
+static const char* findByte(const char* begin, const char* end, char byte)
+{
+	// Loads may read past the end, up to the padding after the last text
+#if defined(LEVEL_EDITOR_FUZZY_MATCHER_AVX2)
+	const __m256i needle = _mm256_set1_epi8(byte);
+	for (; begin < end; begin += 32)
+	{
+		__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+		unsigned int found = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, needle)));
+		if (found != 0)
+		{
+			return std::min(begin + std::countr_zero(found), end);
+		}
+	}
+
+	return end;
+#elif defined(LEVEL_EDITOR_FUZZY_MATCHER_SSE2)
+	const __m128i needle = _mm_set1_epi8(byte);
+	for (; begin < end; begin += 16)
+	{
+		__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+		unsigned int found = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, needle)));
+		if (found != 0)
+		{
+			return std::min(begin + std::countr_zero(found), end);
+		}
+	}
+
+	return end;
+#else
+	while (begin < end && *begin != byte)
+	{
+		begin++;
+	}
+
+	return begin;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+static void setBit(std::vector<sf::Uint64>& bits, sf::Uint32 index)
+{
+	bits.resize(std::max<std::size_t>(bits.size(), index / 64 + 1), 0);
+	bits[index / 64] |= sf::Uint64(1) << (index % 64);
+}
+
+
+////////////////////////////////////////////////////////////
+static sf::Uint64 getBits(const std::vector<sf::Uint64>* bits, std::size_t word)
+{
+	// Null bits stand for every text, texts added after the last bit set have none
+	if (bits == nullptr)
+	{
+		return ~sf::Uint64(0);
+	}
+
+	return word < bits->size() ? (*bits)[word] : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+static void prefetch(const void* address)
+{
+#if defined(LEVEL_EDITOR_FUZZY_MATCHER_AVX2) || defined(LEVEL_EDITOR_FUZZY_MATCHER_SSE2)
+	_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+	static_cast<void>(address);
+#endif
+}
+
+
+#if defined(LEVEL_EDITOR_FUZZY_MATCHER_AVX2) || defined(LEVEL_EDITOR_FUZZY_MATCHER_SSE2)
+////////////////////////////////////////////////////////////
+static __m128i spreadBits(sf::Uint64 bits, int chunk)
+{
+	// The 16 bits of the chunk are copied to 8 bytes each, then every byte keeps its own
+	const __m128i own = _mm_set_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+	__m128i bytes = _mm_cvtsi32_si128(static_cast<int>((bits >> (chunk * 16)) & 0xFFFF));
+	bytes = _mm_unpacklo_epi8(bytes, bytes);
+	bytes = _mm_unpacklo_epi16(bytes, bytes);
+	bytes = _mm_unpacklo_epi32(bytes, bytes);
+	return _mm_cmpeq_epi8(_mm_and_si128(bytes, own), own);
+}
+#endif
+
+
+////////////////////////////////////////////////////////////
+FuzzyMatcher::FuzzyMatcher() :
+m_texts     (),
+m_buffer    (Padding, 0),
+m_offsets   (1, 0),
+m_masks     (),
+m_words     (),
+m_letters   (),
+m_initials  (),
+m_humps     (),
+m_starts    (),
+m_pairs     (),
+m_bigrams   (),
+m_wordPairs (),
+m_pairWords (),
+m_pairBest  (),
+m_best      (),
+m_ranked    (),
+m_query     (),
+m_candidates(),
+m_matchCount(0),
+m_counted   (true),
+m_filtered  (false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 FuzzyMatcher::add(const std::string& text)
+{
+	sf::Uint32 index = static_cast<sf::Uint32>(this->m_texts.size());
+	sf::Uint64 mask = 0;
+	sf::Uint64 words = text.empty() ? 0 : 1;
+
+	// The padding is moved behind the new text
+	this->m_buffer.resize(this->m_offsets.back());
+	bool listed[256] = {};
+	for (std::size_t i = 0; i < text.size(); i++)
+	{
+		char folded = fold(text[i]);
+		std::size_t letter = symbolIndex(folded);
+		this->m_buffer.push_back(folded);
+		mask |= letterBit(folded);
+		if (i > 0 && isBoundary(text, i))
+		{
+			// Words start after a separator, or at a hump right after a letter or a digit
+			unsigned char previous = static_cast<unsigned char>(this->m_buffer[this->m_buffer.size() - 2]);
+			bool hump = isLetter(static_cast<char>(previous)) || (previous >= '0' && previous <= '9');
+			words |= i < MaskedLength ? sf::Uint64(1) << i : 0;
+			if (letter < Symbols)
+			{
+				setBit(hump ? this->m_humps[letter] : this->m_starts[letter], index);
+			}
+		}
+
+		if (i > 0 && symbolIndex(this->m_buffer[this->m_buffer.size() - 2]) < Symbols && letter < Symbols)
+		{
+			setBit(this->m_bigrams[symbolIndex(this->m_buffer[this->m_buffer.size() - 2]) * Symbols + letter], index);
+		}
+
+		// The text joins the list of every byte it contains, ranked by the first occurrence: start, word, other
+		unsigned char byte = static_cast<unsigned char>(folded);
+		if (!listed[byte])
+		{
+			listed[byte] = true;
+			this->m_letters[byte].push_back(index * 4 + (i == 0 ? 0 : isBoundary(text, i) ? 1 : 2));
+			this->m_ranked[byte] = false;
+		}
+	}
+
+	if (!text.empty() && symbolIndex(fold(text[0])) < Symbols)
+	{
+		setBit(this->m_initials[symbolIndex(fold(text[0]))], index);
+	}
+
+	this->m_buffer.resize(this->m_buffer.size() + Padding, 0);
+	this->m_offsets.push_back(static_cast<sf::Uint32>(this->m_buffer.size() - Padding));
+	this->m_masks.push_back(mask);
+	this->m_words.push_back(words);
+	this->m_texts.push_back(text);
+	this->m_filtered = false;
+
+	// Every pair of letters is located as a query of the two would be: the second at its first occurrence after
+	// the first occurrence of the first, the first at its last occurrence before that
+	const char* folded = this->m_buffer.data() + this->m_offsets[index];
+	sf::Uint32 seen = 0;
+	for (std::size_t start = 0; start < text.size(); start++)
+	{
+		std::size_t first = symbolIndex(folded[start]);
+		if (first == Symbols || (seen >> first & 1) != 0)
+		{
+			continue;
+		}
+
+		seen |= sf::Uint32(1) << first;
+		sf::Uint32 paired = 0;
+		sf::Uint32 positions[2] = { static_cast<sf::Uint32>(start), 0 };
+		for (std::size_t i = start + 1; i < text.size(); i++)
+		{
+			std::size_t second = symbolIndex(folded[i]);
+			if (second < Symbols && (paired >> second & 1) == 0)
+			{
+				paired |= sf::Uint32(1) << second;
+				positions[1] = static_cast<sf::Uint32>(i);
+
+				std::size_t pair = first * Symbols + second;
+				setBit(this->m_pairs[pair], index);
+				keep(this->m_pairBest[pair], { index, score(index, positions, 2) }, PairResults);
+			}
+
+			if (second == first)
+			{
+				positions[0] = static_cast<sf::Uint32>(i);
+			}
+		}
+	}
+
+	// Every letter starting the text or a word is paired with the letters before it and with those after it
+	sf::Uint32 before[Symbols] = {};
+	sf::Uint32 after[Symbols] = {};
+	sf::Uint32 earlier = 0;
+	for (std::size_t i = 0; i < text.size(); i++)
+	{
+		std::size_t letter = symbolIndex(folded[i]);
+		if (letter < Symbols)
+		{
+			before[letter] |= i > 0 && isBoundary(text, i) ? earlier : 0;
+			earlier |= sf::Uint32(1) << letter;
+		}
+	}
+
+	sf::Uint32 later = 0;
+	for (std::size_t i = text.size(); i-- > 0;)
+	{
+		std::size_t letter = symbolIndex(folded[i]);
+		if (letter < Symbols)
+		{
+			after[letter] |= i == 0 || isBoundary(text, i) ? later : 0;
+			later |= sf::Uint32(1) << letter;
+		}
+	}
+
+	for (std::size_t letter = 0; letter < Symbols; letter++)
+	{
+		for (sf::Uint32 bits = after[letter]; bits != 0; bits &= bits - 1)
+		{
+			setBit(this->m_wordPairs[letter * Symbols + std::countr_zero(bits)], index);
+		}
+
+		for (sf::Uint32 bits = before[letter]; bits != 0; bits &= bits - 1)
+		{
+			setBit(this->m_pairWords[std::countr_zero(bits) * Symbols + letter], index);
+		}
+	}
+
+	return index;
+}
+
+
+////////////////////////////////////////////////////////////
+void FuzzyMatcher::clear()
+{
+	this->m_texts.clear();
+	this->m_buffer.assign(Padding, 0);
+	this->m_offsets.assign(1, 0);
+	this->m_masks.clear();
+	this->m_words.clear();
+	for (std::size_t byte = 0; byte < 256; byte++)
+	{
+		this->m_letters[byte].clear();
+		this->m_best[byte].clear();
+		this->m_ranked[byte] = false;
+	}
+
+	for (std::size_t letter = 0; letter < Symbols; letter++)
+	{
+		this->m_initials[letter].clear();
+		this->m_humps[letter].clear();
+		this->m_starts[letter].clear();
+	}
+
+	for (std::size_t pair = 0; pair < Symbols * Symbols; pair++)
+	{
+		this->m_pairs[pair].clear();
+		this->m_bigrams[pair].clear();
+		this->m_wordPairs[pair].clear();
+		this->m_pairWords[pair].clear();
+		this->m_pairBest[pair].clear();
+	}
+
+	this->m_candidates.clear();
+	this->m_matchCount = 0;
+	this->m_counted = true;
+	this->m_filtered = false;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& FuzzyMatcher::getText(sf::Uint32 index) const
+{
+	return this->m_texts[index];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FuzzyMatcher::getCount() const
+{
+	return this->m_texts.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void FuzzyMatcher::match(const std::string& query, std::size_t maxResults, std::vector<Match>& matches)
+{
+	matches.clear();
+
+	std::string folded;
+	sf::Uint64 queryMask = 0;
+	for (char byte : query)
+	{
+		if (byte != 0)
+		{
+			folded.push_back(fold(byte));
+			queryMask |= letterBit(folded.back());
+		}
+	}
+
+	if (folded.empty())
+	{
+		std::size_t count = std::min(maxResults, this->m_texts.size());
+		for (std::size_t i = 0; i < count; i++)
+		{
+			matches.push_back({ static_cast<sf::Uint32>(i), 0 });
+		}
+
+		this->m_matchCount = this->m_texts.size();
+		this->m_counted = true;
+		this->m_filtered = false;
+		return;
+	}
+
+	// Worse matches sort after better ones, so the top of a heap is the worst match it keeps
+	auto isBetter = [this](const Match& left, const Match& right)
+	{
+		return this->isBetter(left, right);
+	};
+
+	// A single letter scores by its first occurrence alone, which its list holds
+	if (folded.size() == 1)
+	{
+		unsigned char byte = static_cast<unsigned char>(folded[0]);
+		const std::vector<sf::Uint32>& listed = this->m_letters[byte];
+		std::vector<Match>& best = this->m_best[byte];
+		if (!this->m_ranked[byte] || (best.size() < maxResults && best.size() < listed.size()))
+		{
+			const sf::Int32 scores[] = { ScoreMatch + BonusStart, ScoreMatch + BonusBoundary, ScoreMatch };
+			best.clear();
+			for (sf::Uint32 entry : listed)
+			{
+				keep(best, { entry / 4, scores[entry % 4] }, maxResults);
+			}
+
+			std::sort_heap(best.begin(), best.end(), isBetter);
+			this->m_ranked[byte] = true;
+		}
+
+		// The pairs of the next query are exact already, its candidates need not be remembered
+		matches.assign(best.begin(), best.begin() + std::min(maxResults, best.size()));
+		this->m_matchCount = listed.size();
+		this->m_counted = true;
+		this->m_filtered = false;
+		return;
+	}
+
+	// A pair of letters is answered from its best texts alone
+	std::size_t words = (this->m_texts.size() + 63) / 64;
+	std::size_t pair = symbolIndex(folded[0]) * Symbols + symbolIndex(folded[1]);
+	if (folded.size() == 2 && symbolIndex(folded[0]) < Symbols && symbolIndex(folded[1]) < Symbols && maxResults <= PairResults)
+	{
+		const std::vector<sf::Uint64>& texts = this->m_pairs[pair];
+		matches = this->m_pairBest[pair];
+		std::sort_heap(matches.begin(), matches.end(), isBetter);
+		matches.resize(std::min(maxResults, matches.size()));
+
+		std::size_t count = 0;
+		for (sf::Uint64 bits : texts)
+		{
+			count += static_cast<std::size_t>(std::popcount(bits));
+		}
+
+		this->m_candidates.assign(texts.begin(), texts.end());
+		this->m_candidates.resize(words, 0);
+		this->m_query = folded;
+		this->m_matchCount = count;
+		this->m_counted = true;
+		this->m_filtered = true;
+		return;
+	}
+
+	// Texts matching a query match every query it is contained by, and contain every pair of its letters in order
+	bool refine = this->m_filtered && isSubsequence(this->m_query, folded);
+	bool paired = false;
+	std::vector<sf::Uint64> candidates;
+	if (refine)
+	{
+		candidates.swap(this->m_candidates);
+	}
+	else
+	{
+		candidates.assign(words, ~sf::Uint64(0));
+		candidates.back() >>= words * 64 - this->m_texts.size();
+	}
+
+	std::vector<Step> steps(folded.size());
+	bool symbolsOnly = true;
+	for (std::size_t i = 0; i < folded.size(); i++)
+	{
+		std::size_t letter = symbolIndex(folded[i]);
+		std::size_t previous = i > 0 ? symbolIndex(folded[i - 1]) : Symbols;
+		std::size_t next = i + 1 < folded.size() ? symbolIndex(folded[i + 1]) : Symbols;
+		symbolsOnly &= letter < Symbols;
+
+		// A letter following another starts a word at a hump, or after a separator of the query
+		unsigned char before = i > 0 ? static_cast<unsigned char>(folded[i - 1]) : 0;
+		bool separator = i > 0 && before < 0x80 && !isLetter(folded[i - 1]) && (before < '0' || before > '9');
+
+		Step& step = steps[i];
+		step.m_initial = letter < Symbols ? &this->m_initials[letter] : nullptr;
+		step.m_adjacent = letter < Symbols && previous < Symbols ? &this->m_bigrams[previous * Symbols + letter] : nullptr;
+		step.m_after = letter < Symbols && previous < Symbols ? &this->m_pairWords[previous * Symbols + letter] : nullptr;
+		step.m_before = letter < Symbols && next < Symbols ? &this->m_wordPairs[letter * Symbols + next] : nullptr;
+		step.m_humps = letter < Symbols ? &this->m_humps[letter] : nullptr;
+		step.m_starts = letter == Symbols ? nullptr : separator ? &this->m_starts[letter] : &NoTexts;
+
+		if (letter < Symbols && previous < Symbols)
+		{
+			const std::vector<sf::Uint64>& texts = this->m_pairs[previous * Symbols + letter];
+			for (std::size_t word = 0; word < words; word++)
+			{
+				candidates[word] &= word < texts.size() ? texts[word] : 0;
+			}
+
+			paired = true;
+		}
+	}
+
+	// Without any pair of letters, the candidates are the texts listing the rarest byte
+	if (!paired && !refine)
+	{
+		unsigned char rarest = static_cast<unsigned char>(folded[0]);
+		for (char letter : folded)
+		{
+			unsigned char byte = static_cast<unsigned char>(letter);
+			if (this->m_letters[byte].size() < this->m_letters[rarest].size())
+			{
+				rarest = byte;
+			}
+		}
+
+		candidates.assign(words, 0);
+		for (sf::Uint32 entry : this->m_letters[rarest])
+		{
+			candidates[entry / 4 / 64] |= sf::Uint64(1) << (entry / 4 % 64);
+		}
+	}
+
+	// The best texts of every pair of letters of the query are scored first, the worst one kept bounds the others
+	std::vector<sf::Uint32> seeds;
+	for (std::size_t i = 1; i < folded.size(); i++)
+	{
+		std::size_t first = symbolIndex(folded[i - 1]);
+		std::size_t second = symbolIndex(folded[i]);
+		if (first < Symbols && second < Symbols)
+		{
+			for (const Match& best : this->m_pairBest[first * Symbols + second])
+			{
+				seeds.push_back(best.m_index);
+			}
+		}
+	}
+
+	std::sort(seeds.begin(), seeds.end());
+	seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+
+	std::vector<sf::Uint32> positions(folded.size());
+	for (sf::Uint32 index : seeds)
+	{
+		bool candidate = ((candidates[index / 64] >> (index % 64)) & 1) != 0 && (this->m_masks[index] & queryMask) == queryMask;
+		if (candidate && locate(index, folded, positions.data()))
+		{
+			keep(matches, { index, score(index, positions.data(), positions.size()) }, maxResults);
+		}
+	}
+
+	// Candidates are kept with the best score they could reach, unless it is below the worst match kept. Whether
+	// they contain the query is only checked when they are scored or counted
+	sf::Int32 lowest = static_cast<sf::Int32>(folded.size()) * ScoreMatch - static_cast<sf::Int32>(folded.size() - 1) * PenaltyGap;
+	sf::Int32 highest = static_cast<sf::Int32>(folded.size()) * ScoreMatch + BonusStart + static_cast<sf::Int32>(folded.size() - 1) * (BonusConsecutive + BonusBoundary);
+	bool full = matches.size() == maxResults && maxResults > 0;
+	sf::Int32 slack = full ? std::min(highest - matches.front().m_score, 255) : 255;
+	std::size_t blockWords = MatchBlock / 64;
+	std::vector<std::vector<Match>> blocks((words + blockWords - 1) / blockWords);
+	JobSystem::getDefault().parallelFor(blocks.size(), [&](std::size_t block)
+	{
+		alignas(16) sf::Uint8 deficits[64];
+		std::size_t end = std::min((block + 1) * blockWords, words);
+		for (std::size_t word = block * blockWords; word < end; word++)
+		{
+			if (candidates[word] == 0)
+			{
+				continue;
+			}
+
+			sf::Uint64 bounded = getDeficits(word, steps, static_cast<sf::Uint8>(slack), deficits);
+			for (sf::Uint64 bits = candidates[word] & bounded; bits != 0; bits &= bits - 1)
+			{
+				unsigned lane = static_cast<unsigned>(std::countr_zero(bits));
+				sf::Uint32 index = static_cast<sf::Uint32>(word * 64 + lane);
+
+				// Every letter is in a pair already when the query holds letters only
+				if (!symbolsOnly && (this->m_masks[index] & queryMask) != queryMask)
+				{
+					candidates[word] &= ~(sf::Uint64(1) << lane);
+					continue;
+				}
+
+				// Texts reaching the worst match kept at best only beat it if they rank before it
+				if (full && deficits[lane] == slack && !isBetter({ index, highest - slack }, matches.front()))
+				{
+					continue;
+				}
+
+				sf::Uint32 length = std::min<sf::Uint32>(this->m_offsets[index + 1] - this->m_offsets[index], MaskedLength);
+				blocks[block].push_back({ index, deficits[lane] * Lengths + static_cast<sf::Int32>(length) });
+			}
+		}
+	});
+
+	// The bounds are sorted from the highest, then from the shortest text, texts of the same bound and length
+	// staying in the order they were added
+	std::vector<sf::Uint32> firsts(static_cast<std::size_t>((std::min(highest - lowest, 255) + 1) * Lengths) + 1, 0);
+	std::size_t count = 0;
+	for (const std::vector<Match>& found : blocks)
+	{
+		for (const Match& key : found)
+		{
+			firsts[static_cast<std::size_t>(key.m_score) + 1]++;
+		}
+
+		count += found.size();
+	}
+
+	for (std::size_t i = 1; i < firsts.size(); i++)
+	{
+		firsts[i] += firsts[i - 1];
+	}
+
+	std::vector<Match> keys(count);
+	for (const std::vector<Match>& found : blocks)
+	{
+		for (const Match& key : found)
+		{
+			keys[firsts[static_cast<std::size_t>(key.m_score)]++] = key;
+		}
+	}
+
+	// Texts are scored until the worst match kept beats the best score left. The texts scored next are fetched
+	// ahead, since they are scattered across the buffer
+	for (std::size_t i = 0; i < keys.size(); i++)
+	{
+		if (i + PrefetchOffsets < keys.size())
+		{
+			prefetch(&this->m_offsets[keys[i + PrefetchOffsets].m_index]);
+		}
+
+		if (i + PrefetchTexts < keys.size())
+		{
+			sf::Uint32 ahead = keys[i + PrefetchTexts].m_index;
+			prefetch(this->m_buffer.data() + this->m_offsets[ahead]);
+			prefetch(&this->m_words[ahead]);
+		}
+
+		Match bound = { keys[i].m_index, highest - keys[i].m_score / Lengths };
+		if (matches.size() == maxResults && (maxResults == 0 || !isBetter(bound, matches.front())))
+		{
+			// Texts left have lower bounds, or longer texts, unless the lengths were clamped
+			if (maxResults == 0 || bound.m_score < matches.front().m_score || keys[i].m_score % Lengths < Lengths - 1)
+			{
+				break;
+			}
+
+			continue;
+		}
+
+		if (std::binary_search(seeds.begin(), seeds.end(), bound.m_index))
+		{
+			continue;
+		}
+
+		if (locate(bound.m_index, folded, positions.data()))
+		{
+			keep(matches, { bound.m_index, score(bound.m_index, positions.data(), positions.size()) }, maxResults);
+		}
+		else
+		{
+			candidates[bound.m_index / 64] &= ~(sf::Uint64(1) << (bound.m_index % 64));
+		}
+	}
+
+	std::sort_heap(matches.begin(), matches.end(), isBetter);
+	this->m_query = folded;
+	this->m_candidates.swap(candidates);
+	this->m_counted = false;
+	this->m_filtered = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FuzzyMatcher::getMatchCount() const
+{
+	if (this->m_counted)
+	{
+		return this->m_matchCount;
+	}
+
+	// Candidates are only known to contain every pair of letters of the query, the others are dropped now
+	sf::Uint64 queryMask = 0;
+	for (char letter : this->m_query)
+	{
+		queryMask |= letterBit(letter);
+	}
+
+	std::size_t count = 0;
+	for (std::size_t word = 0; word < this->m_candidates.size(); word++)
+	{
+		for (sf::Uint64 bits = this->m_candidates[word]; bits != 0; bits &= bits - 1)
+		{
+			sf::Uint32 index = static_cast<sf::Uint32>(word * 64 + std::countr_zero(bits));
+			if ((this->m_masks[index] & queryMask) != queryMask || !contains(index, this->m_query))
+			{
+				this->m_candidates[word] &= ~(bits & (~bits + 1));
+			}
+		}
+
+		count += static_cast<std::size_t>(std::popcount(this->m_candidates[word]));
+	}
+
+	this->m_matchCount = count;
+	this->m_counted = true;
+	return count;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FuzzyMatcher::contains(sf::Uint32 index, const std::string& query) const
+{
+	const char* position = this->m_buffer.data() + this->m_offsets[index];
+	const char* end = this->m_buffer.data() + this->m_offsets[index + 1];
+	for (char letter : query)
+	{
+		position = findByte(position, end, letter);
+		if (position == end)
+		{
+			return false;
+		}
+
+		position++;
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint64 FuzzyMatcher::getDeficits(std::size_t word, const std::vector<Step>& steps, sf::Uint8 slack, sf::Uint8* deficits) const
+{
+	// The best score starts the text with the first letter, and matches the others right after the previous one at
+	// the start of a word. Every letter of a text falls short of it by what its bits allow at best: a word instead of
+	// the text, the previous letter right before it or a word after a gap, else a gap. Adding the deficits saturates,
+	// so that the bound only gets higher
+	const int startDeficits[] = { 0, BonusStart - BonusBoundary, 0, BonusStart };
+	const int letterDeficits[] = { 0, BonusConsecutive + PenaltyGap, BonusBoundary, BonusConsecutive + BonusBoundary + PenaltyGap };
+
+	// Every letter sorts the texts in four classes: best, second, third and none, as disjoint bits
+	auto getClasses = [&](std::size_t i, sf::Uint64* classes)
+	{
+		const Step& step = steps[i];
+		if (i == 0)
+		{
+			classes[0] = getBits(step.m_initial, word);
+			classes[1] = getBits(step.m_before, word) & ~classes[0];
+			classes[2] = 0;
+			return startDeficits;
+		}
+
+		sf::Uint64 adjacent = getBits(step.m_adjacent, word);
+		sf::Uint64 starting = getBits(step.m_after, word) & getBits(step.m_before, word);
+		sf::Uint64 following = getBits(step.m_humps, word) | getBits(step.m_starts, word);
+		classes[0] = adjacent & following;
+		classes[1] = starting & ~classes[0];
+		classes[2] = adjacent & ~classes[0] & ~starting;
+		return letterDeficits;
+	};
+
+#if defined(LEVEL_EDITOR_FUZZY_MATCHER_AVX2) || defined(LEVEL_EDITOR_FUZZY_MATCHER_SSE2)
+	// Texts are summed a byte each, 16 at a time
+	__m128i sums[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+	for (std::size_t i = 0; i < steps.size(); i++)
+	{
+		sf::Uint64 classes[3];
+		const int* values = getClasses(i, classes);
+		for (int chunk = 0; chunk < 4; chunk++)
+		{
+			__m128i second = spreadBits(classes[1], chunk);
+			__m128i third = spreadBits(classes[2], chunk);
+			__m128i any = _mm_or_si128(spreadBits(classes[0], chunk), _mm_or_si128(second, third));
+			__m128i deficit = _mm_andnot_si128(any, _mm_set1_epi8(static_cast<char>(values[3])));
+			deficit = _mm_or_si128(deficit, _mm_and_si128(second, _mm_set1_epi8(static_cast<char>(values[1]))));
+			deficit = _mm_or_si128(deficit, _mm_and_si128(third, _mm_set1_epi8(static_cast<char>(values[2]))));
+			sums[chunk] = _mm_adds_epu8(sums[chunk], deficit);
+		}
+	}
+
+	sf::Uint64 bounded = 0;
+	const __m128i limit = _mm_set1_epi8(static_cast<char>(slack));
+	for (int chunk = 0; chunk < 4; chunk++)
+	{
+		_mm_store_si128(reinterpret_cast<__m128i*>(deficits + chunk * 16), sums[chunk]);
+		__m128i kept = _mm_cmpeq_epi8(_mm_subs_epu8(sums[chunk], limit), _mm_setzero_si128());
+		bounded |= static_cast<sf::Uint64>(static_cast<unsigned int>(_mm_movemask_epi8(kept))) << (chunk * 16);
+	}
+
+	return bounded;
+#else
+	int sums[64] = {};
+	for (std::size_t i = 0; i < steps.size(); i++)
+	{
+		sf::Uint64 classes[3];
+		const int* values = getClasses(i, classes);
+		for (unsigned lane = 0; lane < 64; lane++)
+		{
+			sums[lane] += ((classes[0] >> lane) & 1) != 0 ? values[0] : ((classes[1] >> lane) & 1) != 0 ? values[1] : ((classes[2] >> lane) & 1) != 0 ? values[2] : values[3];
+		}
+	}
+
+	sf::Uint64 bounded = 0;
+	for (unsigned lane = 0; lane < 64; lane++)
+	{
+		deficits[lane] = static_cast<sf::Uint8>(std::min(sums[lane], 255));
+		bounded |= deficits[lane] <= slack ? sf::Uint64(1) << lane : 0;
+	}
+
+	return bounded;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool FuzzyMatcher::locate(sf::Uint32 index, const std::string& query, sf::Uint32* positions) const
+{
+	const char* text = this->m_buffer.data() + this->m_offsets[index];
+	std::size_t length = this->m_offsets[index + 1] - this->m_offsets[index];
+	std::size_t count = query.size();
+
+	if (length <= MaskedLength && count <= MaskedLetters)
+	{
+		// The text is loaded once, every letter is compared with all of it
+#if defined(LEVEL_EDITOR_FUZZY_MATCHER_AVX2)
+		const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text));
+		const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + 32));
+		auto findLetter = [&](char letter)
+		{
+			const __m256i needle = _mm256_set1_epi8(letter);
+			sf::Uint64 lowBits = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, needle)));
+			sf::Uint64 highBits = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, needle)));
+			return lowBits | (highBits << 32);
+		};
+#elif defined(LEVEL_EDITOR_FUZZY_MATCHER_SSE2)
+		__m128i bytes[4];
+		for (int i = 0; i < 4; i++)
+		{
+			bytes[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i * 16));
+		}
+
+		auto findLetter = [&](char letter)
+		{
+			const __m128i needle = _mm_set1_epi8(letter);
+			sf::Uint64 bits = 0;
+			for (int i = 0; i < 4; i++)
+			{
+				bits |= static_cast<sf::Uint64>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes[i], needle))) << (i * 16);
+			}
+
+			return bits;
+		};
+#else
+		auto findLetter = [&](char letter)
+		{
+			sf::Uint64 bits = 0;
+			for (std::size_t i = 0; i < length; i++)
+			{
+				bits |= static_cast<sf::Uint64>(text[i] == letter) << i;
+			}
+
+			return bits;
+		};
+#endif
+
+		// Every letter is matched at the first position after the previous one
+		sf::Uint64 valid = length == 64 ? ~sf::Uint64(0) : (sf::Uint64(1) << length) - 1;
+		sf::Uint64 letters[MaskedLetters];
+		sf::Uint64 allowed = valid;
+		sf::Uint64 first = 0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			letters[i] = findLetter(query[i]) & valid;
+			first = letters[i] & allowed;
+			if (first == 0)
+			{
+				return false;
+			}
+
+			first &= ~first + 1;
+			allowed = ~((first << 1) - 1);
+		}
+
+		// Then moved back to the last position before the next one
+		positions[count - 1] = static_cast<sf::Uint32>(std::countr_zero(first));
+		for (std::size_t i = count - 1; i > 0; i--)
+		{
+			sf::Uint64 before = letters[i - 1] & ((sf::Uint64(1) << positions[i]) - 1);
+			positions[i - 1] = static_cast<sf::Uint32>(63 - std::countl_zero(before));
+		}
+
+		return true;
+	}
+
+	const char* end = text + length;
+	const char* position = text;
+	for (char letter : query)
+	{
+		position = findByte(position, end, letter);
+		if (position == end)
+		{
+			return false;
+		}
+
+		position++;
+	}
+
+	positions[count - 1] = static_cast<sf::Uint32>(position - 1 - text);
+	position -= 2;
+	for (std::size_t i = count - 1; i > 0; i--)
+	{
+		while (*position != query[i - 1])
+		{
+			position--;
+		}
+
+		positions[i - 1] = static_cast<sf::Uint32>(position - text);
+		position--;
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Int32 FuzzyMatcher::score(sf::Uint32 index, const sf::Uint32* positions, std::size_t count) const
+{
+	sf::Uint64 words = this->m_words[index];
+	sf::Int32 score = 0;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		sf::Uint32 position = positions[i];
+		bool isWord = position < MaskedLength ? ((words >> position) & 1) != 0 : isBoundary(this->m_texts[index], position);
+
+		score += ScoreMatch;
+		score += position == 0 ? BonusStart : isWord ? BonusBoundary : 0;
+		if (i > 0)
+		{
+			sf::Int32 gap = static_cast<sf::Int32>(position - positions[i - 1] - 1);
+			score += gap == 0 ? BonusConsecutive : -(PenaltyGap + (gap - 1) * PenaltyGapLetter);
+		}
+	}
+
+	return score;
+}
+
+
+////////////////////////////////////////////////////////////
+void FuzzyMatcher::keep(std::vector<Match>& best, const Match& match, std::size_t maxResults) const
+{
+	// Worse matches sort after better ones, so the top of the heap is the worst match it keeps
+	auto isBetter = [this](const Match& left, const Match& right)
+	{
+		return this->isBetter(left, right);
+	};
+
+	if (best.size() < maxResults)
+	{
+		best.push_back(match);
+		std::push_heap(best.begin(), best.end(), isBetter);
+	}
+	else if (maxResults > 0 && isBetter(match, best.front()))
+	{
+		std::pop_heap(best.begin(), best.end(), isBetter);
+		best.back() = match;
+		std::push_heap(best.begin(), best.end(), isBetter);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool FuzzyMatcher::isBetter(const Match& left, const Match& right) const
+{
+	if (left.m_score != right.m_score)
+	{
+		return left.m_score > right.m_score;
+	}
+
+	sf::Uint32 leftLength = this->m_offsets[left.m_index + 1] - this->m_offsets[left.m_index];
+	sf::Uint32 rightLength = this->m_offsets[right.m_index + 1] - this->m_offsets[right.m_index];
+	return leftLength != rightLength ? leftLength < rightLength : left.m_index < right.m_index;
+}
+
+} //namespace le
@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_FUZZY_MATCHER_HPP
+#define LEVEL_EDITOR_FUZZY_MATCHER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <string>
+#include <vector>
+#include <SFML/Config.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Ranks texts containing the letters of a query in order
+///
+/// Texts are folded to lower case once and packed one after
+/// another into a single buffer. The letters of a query are
+/// found with SSE2 or AVX2, comparing the first 64 bytes of a
+/// text with a letter in a few instructions and keeping a bit per
+/// position, and matched in order with bit operations.
+///
+/// Letters matched right after one another or at the start of a
+/// word score higher, gaps between them lower. The best texts are
+/// kept in a heap bounded by the amount of results asked for.
+///
+/// Every letter lists the texts containing it, with the score its
+/// first occurrence gets. A query of a single letter is answered
+/// from its list alone, the best texts of the list being kept
+/// until texts are added. Every pair of letters keeps a bit per
+/// text containing it in order, and a heap of its best texts, so
+/// that a query of two letters is answered from them alone.
+///
+/// Longer queries only check the texts containing every pair of
+/// their letters. Further bits per text, of letters side by side
+/// and at the start of words, bound the score each text could
+/// reach, 64 texts at a time with SSE2. The best texts of the
+/// pairs of the query are scored first, the others from the
+/// highest bound until the worst match kept beats the bounds
+/// left, so that only a few thousand texts are read. The texts
+/// are split in blocks across the default job system, so queries
+/// are matched on the main thread.
+///
+/// The texts possibly matching the last query are remembered. A
+/// query containing the last one, such as the last one with a
+/// letter typed after it, only checks those texts again. They
+/// are counted only when the count is asked for.
+///
+////////////////////////////////////////////////////////////
+class FuzzyMatcher : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Text matching a query
+	///
+	////////////////////////////////////////////////////////////
+	struct Match
+	{
+		sf::Uint32 m_index; //!< Index of the text
+		sf::Int32  m_score; //!< How well the text matches, higher is better
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	FuzzyMatcher();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a text
+	///
+	/// \param text UTF-8 text
+	///
+	/// \return Index of the text
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint32 add(const std::string& text);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove every text
+	///
+	////////////////////////////////////////////////////////////
+	void clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a text
+	///
+	/// \param index Index of the text
+	///
+	////////////////////////////////////////////////////////////
+	const std::string& getText(sf::Uint32 index) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of texts
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the texts containing the letters of a query in order
+	///
+	/// An empty query matches every text, listed in the order
+	/// they were added.
+	///
+	/// \param query      UTF-8 text searched, ignoring ASCII case
+	/// \param maxResults Amount of matches returned at most
+	/// \param matches    Best matches, best first
+	///
+	////////////////////////////////////////////////////////////
+	void match(const std::string& query, std::size_t maxResults, std::vector<Match>& matches);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of texts matching the last query
+	///
+	/// Is counted the first time it is asked for after a query,
+	/// since the query only checks the texts it scores. Texts
+	/// added after the query are not counted.
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getMatchCount() const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Letter of a query, with the bits of the texts its bound needs
+	///
+	/// Null bits stand for every text, so that letters without
+	/// bits of their own bound no text.
+	///
+	////////////////////////////////////////////////////////////
+	struct Step
+	{
+		const std::vector<sf::Uint64>* m_initial;  //!< Bit per text starting with the letter
+		const std::vector<sf::Uint64>* m_adjacent; //!< Bit per text holding the previous letter right before this one
+		const std::vector<sf::Uint64>* m_after;    //!< Bit per text holding this letter at the start of a word after the previous one
+		const std::vector<sf::Uint64>* m_before;   //!< Bit per text holding this letter at the start of a word before the next one
+		const std::vector<sf::Uint64>* m_humps;    //!< Bit per text holding the letter at the start of a word right after a letter or a digit
+		const std::vector<sf::Uint64>* m_starts;   //!< Bit per text holding the letter at the start of a word after a separator, none unless the previous letter is one
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a text contains the letters of a folded query in order
+	///
+	/// \param index Index of the text
+	/// \param query Query folded to lower case
+	///
+	////////////////////////////////////////////////////////////
+	bool contains(sf::Uint32 index, const std::string& query) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find where the letters of a folded query match a text
+	///
+	/// Each letter is matched at the latest position still
+	/// followed by the rest of the query, so that the letters are
+	/// as close to one another as the earliest match allows.
+	///
+	/// \param index     Index of the text
+	/// \param query     Query folded to lower case
+	/// \param positions Position of every letter of the query in the text, as large as the query
+	///
+	/// \return True if the text contains the letters of the query in order
+	///
+	////////////////////////////////////////////////////////////
+	bool locate(sf::Uint32 index, const std::string& query, sf::Uint32* positions) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Score the positions the letters of a query match a text at
+	///
+	/// \param index     Index of the text
+	/// \param positions Position of every letter of the query in the text
+	/// \param count     Amount of letters of the query
+	///
+	////////////////////////////////////////////////////////////
+	sf::Int32 score(sf::Uint32 index, const sf::Uint32* positions, std::size_t count) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get how far below the best score of a query 64 texts are bound to stay
+	///
+	/// \param word     Index of the 64 texts, divided by 64
+	/// \param steps    Letters of the query, at least two
+	/// \param slack    Deficit of the texts kept at most
+	/// \param deficits Deficit of every text, clamped to 255
+	///
+	/// \return Bit per text whose deficit is at most the slack
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint64 getDeficits(std::size_t word, const std::vector<Step>& steps, sf::Uint8 slack, sf::Uint8* deficits) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Keep a match in a heap of the best ones
+	///
+	/// \param best       Heap whose top is the worst match kept
+	/// \param match      Match to keep if it is among the best
+	/// \param maxResults Amount of matches the heap keeps at most
+	///
+	////////////////////////////////////////////////////////////
+	void keep(std::vector<Match>& best, const Match& match, std::size_t maxResults) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a match ranks before another
+	///
+	/// Higher scores come first, then shorter texts, then the
+	/// texts added first.
+	///
+	/// \param left  First match
+	/// \param right Second match
+	///
+	////////////////////////////////////////////////////////////
+	bool isBetter(const Match& left, const Match& right) const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::vector<std::string>        m_texts;              //!< Text of every index
+	std::vector<char>               m_buffer;             //!< Texts folded to lower case one after another, followed by padding
+	std::vector<sf::Uint32>         m_offsets;            //!< Offset of every text in the buffer, followed by the end of the last
+	std::vector<sf::Uint64>         m_masks;              //!< Bit per letter contained by every text
+	std::vector<sf::Uint64>         m_words;              //!< Bit per position of the first 64 bytes of every text starting a word
+	std::vector<sf::Uint32>         m_letters[256];       //!< Texts containing every byte, by index, as the index times four plus the rank of the first occurrence
+	std::vector<sf::Uint64>         m_initials[32];       //!< Bit per text starting with every letter or separator
+	std::vector<sf::Uint64>         m_humps[32];          //!< Bit per text holding every letter or separator at the start of a word right after a letter or a digit
+	std::vector<sf::Uint64>         m_starts[32];         //!< Bit per text holding every letter or separator at the start of a word after a separator
+	std::vector<sf::Uint64>         m_pairs[32 * 32];     //!< Bit per text containing a letter followed by another, for every pair of letters or separators
+	std::vector<sf::Uint64>         m_bigrams[32 * 32];   //!< Bit per text containing a letter right before another, for every pair of letters or separators
+	std::vector<sf::Uint64>         m_wordPairs[32 * 32]; //!< Bit per text containing a letter at the start of the text or a word followed by another, for every pair of letters or separators
+	std::vector<sf::Uint64>         m_pairWords[32 * 32]; //!< Bit per text containing a letter followed by another at the start of a word, for every pair of letters or separators
+	std::vector<Match>              m_pairBest[32 * 32];  //!< Best texts of every pair of letters queried alone, as a heap
+	std::vector<Match>              m_best[256];          //!< Best texts of every byte queried alone, best first
+	bool                            m_ranked[256];        //!< Best texts of every byte are valid
+	std::string                     m_query;              //!< Folded query the candidates were found with
+	mutable std::vector<sf::Uint64> m_candidates;         //!< Bit per text that may match the last query, at least every one matching
+	mutable std::size_t             m_matchCount;         //!< Amount of texts matching the last query, once counted
+	mutable bool                    m_counted;            //!< Texts matching the last query were counted
+	bool                            m_filtered;           //!< Candidates are valid for the current texts
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_FUZZY_MATCHER_HPP
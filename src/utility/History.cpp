@@ -0,0 +1,333 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "History.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+History::History() :
+m_entries     (),
+m_position    (0),
+m_memoryUsage (0),
+m_memoryBudget(16 * 1024 * 1024),
+m_spilledCount(0),
+m_mergeWindow (sf::seconds(1.f)),
+m_mergeClock  (),
+m_mergeable   (false),
+m_applying    (false),
+m_spillPath   (),
+m_spillFile   (),
+m_spillEnd    (0),
+m_buffer      ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+History::~History()
+{
+	if (!this->m_spillPath.empty())
+	{
+		this->m_spillFile.close();
+		std::error_code error;
+		std::filesystem::remove(this->m_spillPath, error);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+History& History::getDefault()
+{
+	static History history;
+	return history;
+}
+
+
+////////////////////////////////////////////////////////////
+void History::push(std::unique_ptr<Command> command)
+{
+	discardRedo();
+
+	if (this->m_mergeable && !this->m_entries.empty() && !this->m_entries.back().m_spilled && this->m_mergeClock.getElapsedTime() <= this->m_mergeWindow)
+	{
+		Command& last = *this->m_entries.back().m_command;
+		std::size_t usage = last.getMemoryUsage();
+		if (last.merge(*command))
+		{
+			this->m_memoryUsage = this->m_memoryUsage - usage + last.getMemoryUsage();
+			this->m_mergeClock.restart();
+			enforceBudget();
+			return;
+		}
+	}
+
+	this->m_memoryUsage += command->getMemoryUsage();
+	this->m_entries.push_back(Entry{ std::move(command), 0, 0, 0, false });
+	this->m_position = this->m_entries.size();
+	this->m_mergeable = true;
+	this->m_mergeClock.restart();
+	enforceBudget();
+}
+
+
+////////////////////////////////////////////////////////////
+bool History::undo()
+{
+	if (!canUndo() || !apply(this->m_entries[this->m_position - 1], true))
+	{
+		return false;
+	}
+
+	--this->m_position;
+	enforceBudget();
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool History::redo()
+{
+	if (!canRedo() || !apply(this->m_entries[this->m_position], false))
+	{
+		return false;
+	}
+
+	++this->m_position;
+	enforceBudget();
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool History::canUndo() const
+{
+	return this->m_position > 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool History::canRedo() const
+{
+	return this->m_position < this->m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+bool History::isApplying() const
+{
+	return this->m_applying;
+}
+
+
+////////////////////////////////////////////////////////////
+void History::clear()
+{
+	this->m_entries.clear();
+	this->m_position = 0;
+	this->m_memoryUsage = 0;
+	this->m_spilledCount = 0;
+	this->m_spillEnd = 0;
+	this->m_mergeable = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void History::setMergeWindow(sf::Time window)
+{
+	this->m_mergeWindow = window;
+}
+
+
+////////////////////////////////////////////////////////////
+void History::setMemoryBudget(std::size_t bytes)
+{
+	this->m_memoryBudget = bytes;
+	enforceBudget();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t History::getMemoryUsage() const
+{
+	return this->m_memoryUsage;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint64 History::getSpilledSize() const
+{
+	return this->m_spilledCount > 0 ? this->m_spillEnd : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool History::apply(Entry& entry, bool undo)
+{
+	if (entry.m_spilled)
+	{
+		this->m_buffer.resize(entry.m_size);
+		this->m_spillFile.seekg(static_cast<std::streamoff>(entry.m_offset));
+		this->m_spillFile.read(this->m_buffer.data(), static_cast<std::streamsize>(entry.m_size));
+		if (!this->m_spillFile || !entry.m_command->restore(this->m_buffer.data(), entry.m_size))
+		{
+			printf("Failed to read back the history from \"%s\"\n", this->m_spillPath.string().c_str());
+			this->m_spillFile.clear();
+			return false;
+		}
+
+		entry.m_spilled = false;
+		this->m_memoryUsage += entry.m_command->getMemoryUsage();
+
+		// Without spilled data left the file is written from its start again
+		if (--this->m_spilledCount == 0)
+		{
+			rewindSpillFile();
+		}
+	}
+
+	this->m_applying = true;
+	if (undo)
+	{
+		entry.m_command->undo();
+	}
+	else
+	{
+		entry.m_command->redo();
+	}
+
+	this->m_applying = false;
+	this->m_mergeable = false;
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void History::discardRedo()
+{
+	for (std::size_t i = this->m_position; i < this->m_entries.size(); i++)
+	{
+		if (this->m_entries[i].m_spilled)
+		{
+			--this->m_spilledCount;
+		}
+		else
+		{
+			this->m_memoryUsage -= this->m_entries[i].m_command->getMemoryUsage();
+		}
+	}
+
+	this->m_entries.resize(this->m_position);
+	if (this->m_spilledCount == 0)
+	{
+		rewindSpillFile();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void History::enforceBudget()
+{
+	// The oldest applied commands go first, then the undone commands farthest from the position
+	std::size_t count = this->m_entries.size();
+	for (std::size_t i = 0; i < count && this->m_memoryUsage > this->m_memoryBudget; i++)
+	{
+		std::size_t index = i < this->m_position ? i : count - 1 - (i - this->m_position);
+		Entry& entry = this->m_entries[index];
+		if (!entry.m_spilled && !spill(entry))
+		{
+			return;
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool History::spill(Entry& entry)
+{
+	if (this->m_spillPath.empty())
+	{
+		std::string name = "level-editor-history-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+		std::error_code error;
+		this->m_spillPath = std::filesystem::temp_directory_path(error) / name;
+		this->m_spillFile.open(this->m_spillPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!this->m_spillFile)
+		{
+			printf("Failed to create history file \"%s\", the history stays in memory\n", this->m_spillPath.string().c_str());
+		}
+	}
+
+	if (!this->m_spillFile)
+	{
+		return false;
+	}
+
+	std::size_t usage = entry.m_command->getMemoryUsage();
+	this->m_buffer.clear();
+	entry.m_command->spill(this->m_buffer);
+
+	// A command read back earlier is written to its previous place if it still fits there
+	bool reuse = entry.m_capacity >= this->m_buffer.size();
+	sf::Uint64 offset = reuse ? entry.m_offset : this->m_spillEnd;
+	this->m_spillFile.seekp(static_cast<std::streamoff>(offset));
+	this->m_spillFile.write(this->m_buffer.data(), static_cast<std::streamsize>(this->m_buffer.size()));
+	if (!this->m_spillFile)
+	{
+		// The command lost its data, it is read back from the buffer before giving up on the file
+		entry.m_command->restore(this->m_buffer.data(), this->m_buffer.size());
+		printf("Failed to write history file \"%s\", the history stays in memory\n", this->m_spillPath.string().c_str());
+		return false;
+	}
+
+	entry.m_offset = offset;
+	entry.m_size = this->m_buffer.size();
+	entry.m_capacity = reuse ? entry.m_capacity : this->m_buffer.size();
+	entry.m_spilled = true;
+	this->m_spillEnd = reuse ? this->m_spillEnd : this->m_spillEnd + this->m_buffer.size();
+	this->m_memoryUsage -= usage;
+	++this->m_spilledCount;
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void History::rewindSpillFile()
+{
+	this->m_spillEnd = 0;
+	for (Entry& entry : this->m_entries)
+	{
+		entry.m_capacity = 0;
+	}
+}
+
+} //namespace le
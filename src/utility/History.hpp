@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_HISTORY_HPP
+#define LEVEL_EDITOR_HISTORY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Command.hpp"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <SFML/Config.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Editor-wide undo and redo stack
+///
+/// Commands pushed shortly after the previous one are merged
+/// into it, so quick consecutive strokes are undone together.
+/// Once the commands exceed the memory budget, the data of the
+/// commands farthest from the current position is moved to a
+/// temporary file and read back when they are undone or redone.
+///
+////////////////////////////////////////////////////////////
+class History : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	History();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Deletes the temporary file.
+	///
+	////////////////////////////////////////////////////////////
+	~History();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the history shared by the whole editor
+	///
+	////////////////////////////////////////////////////////////
+	static History& getDefault();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a command that was just applied
+	///
+	/// The commands that were undone are discarded.
+	///
+	/// \param command Command to add
+	///
+	////////////////////////////////////////////////////////////
+	void push(std::unique_ptr<Command> command);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Revert the last applied command
+	///
+	/// \return False if there is nothing to undo or the command could not be read back
+	///
+	////////////////////////////////////////////////////////////
+	bool undo();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Apply the last reverted command again
+	///
+	/// \return False if there is nothing to redo or the command could not be read back
+	///
+	////////////////////////////////////////////////////////////
+	bool redo();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a command can be undone
+	///
+	////////////////////////////////////////////////////////////
+	bool canUndo() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a command can be redone
+	///
+	////////////////////////////////////////////////////////////
+	bool canRedo() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a command is being undone or redone
+	///
+	/// Edits made meanwhile belong to that command and must not
+	/// be pushed again.
+	///
+	////////////////////////////////////////////////////////////
+	bool isApplying() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove every command
+	///
+	////////////////////////////////////////////////////////////
+	void clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set how soon a command must follow the previous one to be merged into it
+	///
+	/// \param window Time between the two pushes, zero disables merging
+	///
+	////////////////////////////////////////////////////////////
+	void setMergeWindow(sf::Time window);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the amount of memory the commands may occupy
+	///
+	/// \param bytes Memory budget in bytes
+	///
+	////////////////////////////////////////////////////////////
+	void setMemoryBudget(std::size_t bytes);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of memory occupied by the commands
+	///
+	/// Commands whose data is in the temporary file are not counted.
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getMemoryUsage() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of command data held by the temporary file
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint64 getSpilledSize() const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Standard layout class holding a command of the stack
+	///
+	////////////////////////////////////////////////////////////
+	struct Entry
+	{
+		std::unique_ptr<Command> m_command;  //!< Command
+		sf::Uint64               m_offset;   //!< Position of the spilled data in the temporary file
+		std::size_t              m_size;     //!< Size of the spilled data in bytes
+		std::size_t              m_capacity; //!< Size of the space reserved for the command in the file, 0 if none
+		bool                     m_spilled;  //!< Data of the command is in the temporary file
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Apply or revert a command, reading its data back if needed
+	///
+	/// \param entry Entry of the command
+	/// \param undo  True to revert the command, false to apply it
+	///
+	/// \return False if the data could not be read back
+	///
+	////////////////////////////////////////////////////////////
+	bool apply(Entry& entry, bool undo);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove the commands following the current position
+	///
+	////////////////////////////////////////////////////////////
+	void discardRedo();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move command data to the temporary file until the budget is met
+	///
+	////////////////////////////////////////////////////////////
+	void enforceBudget();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move the data of a command to the temporary file
+	///
+	/// \param entry Entry of the command
+	///
+	/// \return False if the file could not be written
+	///
+	////////////////////////////////////////////////////////////
+	bool spill(Entry& entry);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Write the file from its start again once no command is spilled
+	///
+	////////////////////////////////////////////////////////////
+	void rewindSpillFile();
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::vector<Entry>    m_entries;      //!< Applied commands followed by the undone ones
+	std::size_t           m_position;     //!< Amount of applied commands
+	std::size_t           m_memoryUsage;  //!< Memory occupied by the commands
+	std::size_t           m_memoryBudget; //!< Memory the commands may occupy
+	std::size_t           m_spilledCount; //!< Amount of commands whose data is in the temporary file
+	sf::Time              m_mergeWindow;  //!< Time within which a push is merged into the previous command
+	sf::Clock             m_mergeClock;   //!< Time since the last push
+	bool                  m_mergeable;    //!< The last command may absorb the next one
+	bool                  m_applying;     //!< A command is being undone or redone
+	std::filesystem::path m_spillPath;    //!< Path of the temporary file, empty until data is spilled
+	std::fstream          m_spillFile;    //!< Temporary file
+	sf::Uint64            m_spillEnd;     //!< End of the data in the temporary file
+	std::vector<char>     m_buffer;       //!< Buffer used to move command data to and from the file
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_HISTORY_HPP
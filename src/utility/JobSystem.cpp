@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "JobSystem.hpp"
+#include <algorithm>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+JobSystem::JobSystem(unsigned int workerCount) :
+m_workers   (),
+m_mutex     (),
+m_wake      (),
+m_done      (),
+m_job       (nullptr),
+m_count     (0),
+m_next      (0),
+m_pending   (0),
+m_generation(0),
+m_stopping  (false)
+{
+	for (unsigned int i = 0; i < workerCount; i++)
+	{
+		this->m_workers.emplace_back(&JobSystem::run, this);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_stopping = true;
+	}
+
+	this->m_wake.notify_all();
+	for (std::thread& worker : this->m_workers)
+	{
+		worker.join();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+JobSystem& JobSystem::getDefault()
+{
+	static JobSystem system(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+	return system;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int JobSystem::getWorkerCount() const
+{
+	return static_cast<unsigned int>(this->m_workers.size());
+}
+
+
+////////////////////////////////////////////////////////////
+void JobSystem::parallelFor(std::size_t count, const std::function<void(std::size_t)>& job)
+{
+	if (this->m_workers.empty() || count < 2)
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			job(i);
+		}
+
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_job = &job;
+		this->m_count = count;
+		this->m_next = 0;
+		this->m_pending = this->m_workers.size();
+		++this->m_generation;
+	}
+
+	this->m_wake.notify_all();
+	work(job, count);
+
+	// The job lives on the caller's stack, every worker has to be done with it
+	std::unique_lock<std::mutex> lock(this->m_mutex);
+	this->m_done.wait(lock, [this]() { return this->m_pending == 0; });
+	this->m_job = nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+void JobSystem::run()
+{
+	sf::Uint64 generation = 0;
+	while (true)
+	{
+		std::unique_lock<std::mutex> lock(this->m_mutex);
+		this->m_wake.wait(lock, [this, generation]() { return this->m_stopping || this->m_generation != generation; });
+		if (this->m_stopping)
+		{
+			return;
+		}
+
+		generation = this->m_generation;
+		const std::function<void(std::size_t)>& job = *this->m_job;
+		std::size_t count = this->m_count;
+		lock.unlock();
+
+		work(job, count);
+
+		lock.lock();
+		if (--this->m_pending == 0)
+		{
+			this->m_done.notify_one();
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void JobSystem::work(const std::function<void(std::size_t)>& job, std::size_t count)
+{
+	for (std::size_t i = this->m_next++; i < count; i = this->m_next++)
+	{
+		job(i);
+	}
+}
+
+} //namespace le
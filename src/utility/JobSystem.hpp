@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_JOB_SYSTEM_HPP
+#define LEVEL_EDITOR_JOB_SYSTEM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <SFML/Config.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Pool of worker threads splitting loops across the cores
+///
+/// The calling thread takes part in the work and returns once
+/// every iteration ran. Iterations must not touch graphics
+/// resources, which belong to the main thread.
+///
+////////////////////////////////////////////////////////////
+class JobSystem : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// \param workerCount Amount of threads helping the caller
+	///
+	////////////////////////////////////////////////////////////
+	explicit JobSystem(unsigned int workerCount);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Waits for the workers to stop.
+	///
+	////////////////////////////////////////////////////////////
+	~JobSystem();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the pool using every core but the caller's
+	///
+	////////////////////////////////////////////////////////////
+	static JobSystem& getDefault();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of threads helping the caller
+	///
+	////////////////////////////////////////////////////////////
+	unsigned int getWorkerCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Run a job for every index of a range in parallel
+	///
+	/// Loops must not be nested, a job may not call parallelFor.
+	///
+	/// \param count Amount of indices, the job receives 0 to count - 1
+	/// \param job   Job to run
+	///
+	////////////////////////////////////////////////////////////
+	void parallelFor(std::size_t count, const std::function<void(std::size_t)>& job);
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Loop of the worker threads
+	///
+	////////////////////////////////////////////////////////////
+	void run();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Run iterations of the current loop until none is left
+	///
+	/// \param job   Job of the loop
+	/// \param count Amount of indices of the loop
+	///
+	////////////////////////////////////////////////////////////
+	void work(const std::function<void(std::size_t)>& job, std::size_t count);
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::vector<std::thread>                 m_workers;    //!< Threads helping the caller
+	std::mutex                               m_mutex;      //!< Protects the state of the current loop
+	std::condition_variable                  m_wake;       //!< Signals a new loop or stopping to the workers
+	std::condition_variable                  m_done;       //!< Signals the caller that every worker left the loop
+	const std::function<void(std::size_t)>*  m_job;        //!< Job of the current loop
+	std::size_t                              m_count;      //!< Amount of indices of the current loop
+	std::atomic<std::size_t>                 m_next;       //!< Next index to run
+	std::size_t                              m_pending;    //!< Workers that did not leave the current loop yet
+	sf::Uint64                               m_generation; //!< Incremented for every loop, so workers join each loop once
+	bool                                     m_stopping;   //!< Workers have to exit
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_JOB_SYSTEM_HPP
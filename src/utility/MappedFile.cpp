@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+MappedFile::MappedFile() :
+m_data  (nullptr),
+m_size  (0),
+m_isOpen(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFile::open(const std::filesystem::path& path)
+{
+	close();
+
+#ifdef _WIN32
+	// Other handles may keep writing to the file, the editor appends to mapped levels
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size))
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	if (size.QuadPart > 0)
+	{
+		// The view keeps the mapping alive, both handles can be closed right away
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (mapping)
+		{
+			CloseHandle(mapping);
+		}
+
+		if (!data)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		this->m_data = static_cast<const char*>(data);
+		this->m_size = static_cast<std::size_t>(size.QuadPart);
+	}
+
+	CloseHandle(file);
+#else
+	int descriptor = ::open(path.c_str(), O_RDONLY);
+	if (descriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat status;
+	if (fstat(descriptor, &status) != 0)
+	{
+		::close(descriptor);
+		return false;
+	}
+
+	if (status.st_size > 0)
+	{
+		void* data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+		if (data == MAP_FAILED)
+		{
+			::close(descriptor);
+			return false;
+		}
+
+		this->m_data = static_cast<const char*>(data);
+		this->m_size = static_cast<std::size_t>(status.st_size);
+	}
+
+	::close(descriptor);
+#endif
+
+	this->m_isOpen = true;
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void MappedFile::close()
+{
+	if (this->m_data)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(this->m_data);
+#else
+		munmap(const_cast<char*>(this->m_data), this->m_size);
+#endif
+	}
+
+	this->m_data = nullptr;
+	this->m_size = 0;
+	this->m_isOpen = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFile::isOpen() const
+{
+	return this->m_isOpen;
+}
+
+
+////////////////////////////////////////////////////////////
+const char* MappedFile::getData() const
+{
+	return this->m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t MappedFile::getSize() const
+{
+	return this->m_size;
+}
+
+} //namespace le
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_MAPPED_FILE_HPP
+#define LEVEL_EDITOR_MAPPED_FILE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <filesystem>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Read-only view of a file mapped into memory
+///
+/// Pages are read from disk by the operating system the first
+/// time they are accessed, so opening costs the same whatever
+/// the size of the file.
+///
+////////////////////////////////////////////////////////////
+class MappedFile : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	MappedFile();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	////////////////////////////////////////////////////////////
+	~MappedFile();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Map a file, replacing the current one
+	///
+	/// \param path Path of the file
+	///
+	/// \return True if the file was mapped
+	///
+	////////////////////////////////////////////////////////////
+	bool open(const std::filesystem::path& path);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Unmap the file
+	///
+	////////////////////////////////////////////////////////////
+	void close();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a file is mapped
+	///
+	////////////////////////////////////////////////////////////
+	bool isOpen() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the content of the file
+	///
+	/// \return Pointer to the first byte, nullptr if the file is empty or not mapped
+	///
+	////////////////////////////////////////////////////////////
+	const char* getData() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the size of the file in bytes
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getSize() const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	const char* m_data;   //!< Mapped content
+	std::size_t m_size;   //!< Size of the content in bytes
+	bool        m_isOpen; //!< A file is mapped, possibly empty
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_MAPPED_FILE_HPP
@@ -0,0 +1,374 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "TimerWheel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+sf::Time RepeatCurve::getInterval(unsigned repetition) const
+{
+	if (repetition == 0)
+	{
+		return this->m_delay;
+	}
+
+	float factor = std::pow(this->m_acceleration, static_cast<float>(repetition - 1));
+	sf::Time interval = sf::microseconds(static_cast<sf::Int64>(this->m_interval.asMicroseconds() * factor));
+	return std::max(interval, this->m_minInterval);
+}
+
+
+////////////////////////////////////////////////////////////
+TimerWheel::TimerWheel() :
+m_clock  (),
+m_now    (0),
+m_buckets(),
+m_timers (),
+m_free   (),
+m_due    (),
+m_count  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TimerWheel& TimerWheel::getDefault()
+{
+	static TimerWheel wheel;
+	return wheel;
+}
+
+
+////////////////////////////////////////////////////////////
+TimerWheel::Id TimerWheel::setTimeout(sf::Time delay, Callback callback)
+{
+	return add(Mode::Once, delay, RepeatCurve(), std::move(callback));
+}
+
+
+////////////////////////////////////////////////////////////
+TimerWheel::Id TimerWheel::setInterval(sf::Time interval, Callback callback)
+{
+	RepeatCurve curve = { interval, interval, interval, 1.f };
+	return add(Mode::Interval, interval, curve, std::move(callback));
+}
+
+
+////////////////////////////////////////////////////////////
+TimerWheel::Id TimerWheel::setRepeat(const RepeatCurve& curve, Callback callback)
+{
+	return add(Mode::Curve, curve.getInterval(0), curve, std::move(callback));
+}
+
+
+////////////////////////////////////////////////////////////
+void TimerWheel::cancel(Id id)
+{
+	if (isPending(id))
+	{
+		release(static_cast<sf::Uint32>(id));
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool TimerWheel::isPending(Id id) const
+{
+	sf::Uint32 index = static_cast<sf::Uint32>(id);
+	sf::Uint32 generation = static_cast<sf::Uint32>(id >> 32);
+	return index < this->m_timers.size() && this->m_timers[index].m_active &&
+	       this->m_timers[index].m_generation == generation;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TimerWheel::getPendingCount() const
+{
+	return this->m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<sf::Time> TimerWheel::getTimeUntilNext() const
+{
+	if (this->m_count == 0)
+	{
+		return std::nullopt;
+	}
+
+	sf::Uint64 ticks = getTicks();
+	auto untilTick = [ticks](sf::Uint64 tick)
+	{
+		return sf::milliseconds(static_cast<sf::Int32>(tick > ticks ? std::min<sf::Uint64>(tick - ticks, std::numeric_limits<sf::Int32>::max()) : 0));
+	};
+
+	auto hasValidEntry = [this](const Bucket& bucket)
+	{
+		return std::any_of(bucket.begin(), bucket.end(), [this](const Entry& entry) { return isValid(entry); });
+	};
+
+	for (sf::Uint64 i = 0; i < InnerBuckets; ++i)
+	{
+		sf::Uint64 tick = this->m_now + i;
+		if (hasValidEntry(this->m_buckets[tick & (InnerBuckets - 1)]))
+		{
+			return untilTick(tick);
+		}
+	}
+
+	// Outer wheels only give a lower bound: the start of the first non-empty bucket
+	for (std::size_t level = 1; level < Levels; ++level)
+	{
+		std::size_t shift = InnerBits + OuterBits * (level - 1);
+		std::size_t offset = InnerBuckets + OuterBuckets * (level - 1);
+
+		// The current bucket holds due entries only until the start of its block was processed
+		bool cascaded = (this->m_now & ((sf::Uint64(1) << shift) - 1)) != 0;
+		for (sf::Uint64 i = cascaded ? 1 : 0; i <= OuterBuckets; ++i)
+		{
+			sf::Uint64 block = (this->m_now >> shift) + i;
+			if (hasValidEntry(this->m_buckets[offset + (block & (OuterBuckets - 1))]))
+			{
+				return untilTick(block << shift);
+			}
+		}
+	}
+
+	return untilTick(this->m_now + MaxTicks);
+}
+
+
+////////////////////////////////////////////////////////////
+void TimerWheel::update()
+{
+	sf::Uint64 target = getTicks();
+
+	while (this->m_now <= target)
+	{
+		if (this->m_count == 0)
+		{
+			this->m_now = target + 1;
+			break;
+		}
+
+		if ((this->m_now & (InnerBuckets - 1)) == 0)
+		{
+			cascade(1);
+		}
+
+		expire();
+		++this->m_now;
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+TimerWheel::Id TimerWheel::add(Mode mode, sf::Time delay, const RepeatCurve& curve, Callback callback)
+{
+	sf::Uint32 index;
+	if (this->m_free.empty())
+	{
+		index = static_cast<sf::Uint32>(this->m_timers.size());
+		this->m_timers.push_back(Timer{ Callback(), RepeatCurve(), 0, 1, 0, Mode::Once, false });
+	}
+	else
+	{
+		index = this->m_free.back();
+		this->m_free.pop_back();
+	}
+
+	// Timers scheduled between two updates are measured from the present, not the last processed tick
+	sf::Uint64 now = std::max(getTicks(), this->m_now);
+
+	Timer& timer = this->m_timers[index];
+	timer.m_callback = std::move(callback);
+	timer.m_curve = curve;
+	timer.m_expiry = now + std::max<sf::Int64>(delay.asMilliseconds(), 0);
+	timer.m_repetition = 0;
+	timer.m_mode = mode;
+	timer.m_active = true;
+	++this->m_count;
+
+	insert(Entry{ index, timer.m_generation });
+	return (static_cast<Id>(timer.m_generation) << 32) | index;
+}
+
+
+////////////////////////////////////////////////////////////
+void TimerWheel::insert(const Entry& entry)
+{
+	sf::Uint64 expiry = std::max(this->m_timers[entry.m_index].m_expiry, this->m_now);
+	sf::Uint64 delta = std::min(expiry - this->m_now, MaxTicks - 1);
+	expiry = this->m_now + delta;
+
+	if (delta < InnerBuckets)
+	{
+		this->m_buckets[expiry & (InnerBuckets - 1)].push_back(entry);
+		return;
+	}
+
+	for (std::size_t level = 1; level < Levels; ++level)
+	{
+		std::size_t shift = InnerBits + OuterBits * (level - 1);
+		if (delta < (sf::Uint64(1) << (shift + OuterBits)) || level == Levels - 1)
+		{
+			std::size_t offset = InnerBuckets + OuterBuckets * (level - 1);
+			this->m_buckets[offset + ((expiry >> shift) & (OuterBuckets - 1))].push_back(entry);
+			return;
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void TimerWheel::cascade(std::size_t level)
+{
+	if (level >= Levels)
+	{
+		return;
+	}
+
+	std::size_t shift = InnerBits + OuterBits * (level - 1);
+	std::size_t slot = (this->m_now >> shift) & (OuterBuckets - 1);
+
+	// The next wheel is cascaded first, so its entries can land in this bucket
+	if (slot == 0)
+	{
+		cascade(level + 1);
+	}
+
+	Bucket bucket;
+	bucket.swap(this->m_buckets[InnerBuckets + OuterBuckets * (level - 1) + slot]);
+
+	for (const Entry& entry : bucket)
+	{
+		if (isValid(entry))
+		{
+			insert(entry);
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void TimerWheel::expire()
+{
+	Bucket& bucket = this->m_buckets[this->m_now & (InnerBuckets - 1)];
+	if (bucket.empty())
+	{
+		return;
+	}
+
+	this->m_due.clear();
+	this->m_due.swap(bucket);
+
+	for (const Entry& entry : this->m_due)
+	{
+		if (!isValid(entry))
+		{
+			continue;
+		}
+
+		Timer& timer = this->m_timers[entry.m_index];
+		if (timer.m_expiry > this->m_now)
+		{
+			insert(entry);
+			continue;
+		}
+
+		// The callback is moved out, since it may schedule new timers and grow the pool
+		Callback callback = std::move(timer.m_callback);
+		if (timer.m_mode == Mode::Once)
+		{
+			release(entry.m_index);
+		}
+		else
+		{
+			++timer.m_repetition;
+			sf::Time interval = timer.m_mode == Mode::Curve ? timer.m_curve.getInterval(timer.m_repetition) : timer.m_curve.m_interval;
+			timer.m_expiry = this->m_now + std::max<sf::Int64>(interval.asMilliseconds(), 1);
+			insert(entry);
+		}
+
+		callback();
+
+		if (isValid(entry))
+		{
+			this->m_timers[entry.m_index].m_callback = std::move(callback);
+		}
+	}
+
+	// Timers the callbacks scheduled for the current tick are raised on the next one, instead of when the wheel comes round
+	if (!bucket.empty())
+	{
+		Bucket& next = this->m_buckets[(this->m_now + 1) & (InnerBuckets - 1)];
+		next.insert(next.end(), bucket.begin(), bucket.end());
+		bucket.clear();
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+bool TimerWheel::isValid(const Entry& entry) const
+{
+	const Timer& timer = this->m_timers[entry.m_index];
+	return timer.m_active && timer.m_generation == entry.m_generation;
+}
+
+
+////////////////////////////////////////////////////////////
+void TimerWheel::release(sf::Uint32 index)
+{
+	Timer& timer = this->m_timers[index];
+	timer.m_active = false;
+	timer.m_callback = nullptr;
+
+	// Generation 0 is skipped, so that a valid handle is never 0
+	if (++timer.m_generation == 0)
+	{
+		timer.m_generation = 1;
+	}
+
+	this->m_free.push_back(index);
+	--this->m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint64 TimerWheel::getTicks() const
+{
+	return static_cast<sf::Uint64>(this->m_clock.getElapsedTime().asMilliseconds());
+}
+
+} //namespace le
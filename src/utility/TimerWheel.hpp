@@ -0,0 +1,294 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_TIMER_WHEEL_HPP
+#define LEVEL_EDITOR_TIMER_WHEEL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../ui/interfaces/Updatable.hpp"
+#include <array>
+#include <functional>
+#include <optional>
+#include <vector>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Standard layout class describing how a held timer repeats
+///
+/// The first repetition happens after m_delay, every following one
+/// multiplies the interval by m_acceleration until m_minInterval is reached.
+///
+////////////////////////////////////////////////////////////
+struct RepeatCurve
+{
+	////////////////////////////////////////////////////////////
+	/// \brief Get the interval preceding the given repetition
+	///
+	/// \param repetition Number of repetitions that already happened
+	///
+	/// \return Time to wait before the next repetition
+	///
+	////////////////////////////////////////////////////////////
+	sf::Time getInterval(unsigned repetition) const;
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	sf::Time m_delay;        //!< Time between the initial event and the first repetition
+	sf::Time m_interval;     //!< Interval between the first repetitions
+	sf::Time m_minInterval;  //!< Shortest interval the curve accelerates to
+	float    m_acceleration; //!< Factor applied to the interval after every repetition
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Hierarchical timer wheel shared by all controls
+///
+/// Timers are bucketed by their expiry tick (1 ms) into four
+/// cascading wheels, so advancing the wheel only touches the
+/// buckets that are due. Controls without pending timers cost
+/// nothing per frame.
+///
+////////////////////////////////////////////////////////////
+class TimerWheel : public Updatable, sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Handle of a scheduled timer, 0 is never a valid handle
+	///
+	////////////////////////////////////////////////////////////
+	using Id = sf::Uint64;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Function raised when a timer is due
+	///
+	////////////////////////////////////////////////////////////
+	using Callback = std::function<void()>;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	TimerWheel();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the wheel driven by the application's main loop
+	///
+	////////////////////////////////////////////////////////////
+	static TimerWheel& getDefault();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Raise a callback once after a delay
+	///
+	/// \param delay    Time to wait
+	/// \param callback Function to raise
+	///
+	/// \return Handle of the timer
+	///
+	////////////////////////////////////////////////////////////
+	Id setTimeout(sf::Time delay, Callback callback);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Raise a callback repeatedly with a constant interval
+	///
+	/// \param interval Time between two calls
+	/// \param callback Function to raise
+	///
+	/// \return Handle of the timer
+	///
+	////////////////////////////////////////////////////////////
+	Id setInterval(sf::Time interval, Callback callback);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Raise a callback repeatedly following a repeat curve
+	///
+	/// \param curve    Curve describing the delay and the intervals
+	/// \param callback Function to raise
+	///
+	/// \return Handle of the timer
+	///
+	////////////////////////////////////////////////////////////
+	Id setRepeat(const RepeatCurve& curve, Callback callback);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Cancel a timer
+	///
+	/// Unknown or already finished handles are ignored.
+	///
+	/// \param id Handle of the timer
+	///
+	////////////////////////////////////////////////////////////
+	void cancel(Id id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a timer is still pending
+	///
+	/// \param id Handle of the timer
+	///
+	////////////////////////////////////////////////////////////
+	bool isPending(Id id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of pending timers
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getPendingCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the time left until the next timer is due
+	///
+	/// The result may underestimate timers stored in the outer
+	/// wheels, waking the caller slightly early is harmless.
+	///
+	/// \return Time left, or std::nullopt if nothing is pending
+	///
+	////////////////////////////////////////////////////////////
+	std::optional<sf::Time> getTimeUntilNext() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Raise every timer that became due since the last update
+	///
+	////////////////////////////////////////////////////////////
+	void update() override;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief How a timer reschedules itself after being raised
+	///
+	////////////////////////////////////////////////////////////
+	enum struct Mode : sf::Uint8
+	{
+		Once,     //!< Raised a single time
+		Interval, //!< Raised every m_curve.m_interval
+		Curve     //!< Raised following m_curve
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Pooled timer state
+	///
+	////////////////////////////////////////////////////////////
+	struct Timer
+	{
+		Callback    m_callback;   //!< Function to raise
+		RepeatCurve m_curve;      //!< Repeat parameters
+		sf::Uint64  m_expiry;     //!< Tick the timer is due at
+		sf::Uint32  m_generation; //!< Incremented whenever the slot is released
+		sf::Uint32  m_repetition; //!< Amount of times the timer was raised
+		Mode        m_mode;       //!< Rescheduling mode
+		bool        m_active;     //!< Timer is pending
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Reference to a pooled timer stored in a bucket
+	///
+	////////////////////////////////////////////////////////////
+	struct Entry
+	{
+		sf::Uint32 m_index;      //!< Index into m_timers
+		sf::Uint32 m_generation; //!< Generation of the timer when it was bucketed
+	};
+
+	using Bucket = std::vector<Entry>;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Allocate a timer and insert it into the wheel
+	///
+	////////////////////////////////////////////////////////////
+	Id add(Mode mode, sf::Time delay, const RepeatCurve& curve, Callback callback);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Insert an entry into the bucket matching its expiry
+	///
+	////////////////////////////////////////////////////////////
+	void insert(const Entry& entry);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move the entries of an outer bucket into the inner wheels
+	///
+	////////////////////////////////////////////////////////////
+	void cascade(std::size_t level);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Raise the timers of the bucket of the current tick
+	///
+	/// Timers the callbacks schedule for the current tick are
+	/// moved to the bucket of the next one.
+	///
+	////////////////////////////////////////////////////////////
+	void expire();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether a bucketed entry still refers to a pending timer
+	///
+	////////////////////////////////////////////////////////////
+	bool isValid(const Entry& entry) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Release a timer slot
+	///
+	////////////////////////////////////////////////////////////
+	void release(sf::Uint32 index);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the current tick of the internal clock
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint64 getTicks() const;
+
+	////////////////////////////////////////////////////////////
+	// Static member data
+	////////////////////////////////////////////////////////////
+	static constexpr std::size_t Levels       = 4;                                 //!< Amount of wheels
+	static constexpr std::size_t InnerBits    = 8;                                 //!< log2 of the bucket count of the innermost wheel
+	static constexpr std::size_t OuterBits    = 6;                                 //!< log2 of the bucket count of the outer wheels
+	static constexpr std::size_t InnerBuckets = 1 << InnerBits;                    //!< Bucket count of the innermost wheel
+	static constexpr std::size_t OuterBuckets = 1 << OuterBits;                    //!< Bucket count of an outer wheel
+	static constexpr std::size_t BucketCount  = InnerBuckets + OuterBuckets * 3;   //!< Bucket count of all wheels
+	static constexpr sf::Uint64  MaxTicks     = sf::Uint64(1) << (InnerBits + OuterBits * 3); //!< Range of the wheels
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	sf::Clock                        m_clock;   //!< Source of the wheel's ticks
+	sf::Uint64                       m_now;     //!< Next tick to be processed
+	std::array<Bucket, BucketCount>  m_buckets; //!< Buckets of all wheels, innermost first
+	std::vector<Timer>               m_timers;  //!< Timer pool
+	std::vector<sf::Uint32>          m_free;    //!< Released timer slots
+	Bucket                           m_due;     //!< Scratch bucket of the timers being raised
+	std::size_t                      m_count;   //!< Amount of pending timers
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_TIMER_WHEEL_HPP
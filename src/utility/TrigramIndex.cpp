@@ -0,0 +1,513 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "TrigramIndex.hpp"
+#include "MappedFile.hpp"
+#include "Varint.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static const char        Magic[]        = "LETRIGR1";   //!< Start of an index file
+static const std::size_t MagicSize      = 8;            //!< Length of the start of an index file
+static const std::size_t RankLimit      = 4096;         //!< Names matching a query above which no more are ranked
+static const std::size_t CompactMinimum = 65536;        //!< Stale ids above which the lists may be built again
+
+
+////////////////////////////////////////////////////////////
+static sf::Uint8 fold(char character)
+{
+	sf::Uint8 byte = static_cast<sf::Uint8>(character);
+	return byte >= 'A' && byte <= 'Z' ? static_cast<sf::Uint8>(byte - 'A' + 'a') : byte;
+}
+
+
+////////////////////////////////////////////////////////////
+static void collectTrigrams(const std::string& name, std::vector<sf::Uint32>& trigrams)
+{
+	trigrams.clear();
+	for (std::size_t i = 0; i + 3 <= name.size(); i++)
+	{
+		trigrams.push_back(static_cast<sf::Uint32>(fold(name[i])) << 16 | static_cast<sf::Uint32>(fold(name[i + 1])) << 8 | fold(name[i + 2]));
+	}
+
+	std::sort(trigrams.begin(), trigrams.end());
+	trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+
+////////////////////////////////////////////////////////////
+static std::size_t findFolded(const std::string& name, const std::string& query)
+{
+	auto found = std::search(name.begin(), name.end(), query.begin(), query.end(),
+		[](char left, char right) { return fold(left) == static_cast<sf::Uint8>(right); });
+	return found == name.end() ? std::string::npos : static_cast<std::size_t>(found - name.begin());
+}
+
+
+////////////////////////////////////////////////////////////
+TrigramIndex::TrigramIndex() :
+m_names   (),
+m_groups  (),
+m_alive   (),
+m_free    (),
+m_count   (0),
+m_postings(),
+m_entries (0),
+m_stale   (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 TrigramIndex::add(const std::string& name, sf::Uint32 group)
+{
+	sf::Uint32 id = static_cast<sf::Uint32>(this->m_names.size());
+	if (!this->m_free.empty())
+	{
+		id = this->m_free.back();
+		this->m_free.pop_back();
+	}
+	else
+	{
+		this->m_names.emplace_back();
+		this->m_groups.push_back(0);
+		this->m_alive.resize(id + 1);
+	}
+
+	this->m_names[id] = name;
+	this->m_groups[id] = group;
+	this->m_alive.set(id);
+	this->m_count++;
+
+	std::vector<sf::Uint32> trigrams;
+	collectTrigrams(name, trigrams);
+	insert(id, trigrams);
+	return id;
+}
+
+
+////////////////////////////////////////////////////////////
+void TrigramIndex::addKeys(const Strings& strings, sf::Uint32 group)
+{
+	for (const auto& [key, value] : strings)
+	{
+		std::basic_string<sf::Uint8> utf8 = key.toUtf8();
+		std::string name(utf8.begin(), utf8.end());
+		if (find(name, group) == NoId)
+		{
+			add(name, group);
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void TrigramIndex::rename(sf::Uint32 id, const std::string& name)
+{
+	if (!this->m_alive.test(id))
+	{
+		return;
+	}
+
+	// Trigrams the name loses keep listing it, the comparison with the query filters it out
+	std::vector<sf::Uint32> before;
+	std::vector<sf::Uint32> after;
+	collectTrigrams(this->m_names[id], before);
+	collectTrigrams(name, after);
+
+	std::vector<sf::Uint32> lost;
+	std::vector<sf::Uint32> gained;
+	std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(lost));
+	std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(gained));
+
+	this->m_names[id] = name;
+	this->m_stale += lost.size();
+	insert(id, gained);
+	compact();
+}
+
+
+////////////////////////////////////////////////////////////
+void TrigramIndex::remove(sf::Uint32 id)
+{
+	if (!this->m_alive.test(id))
+	{
+		return;
+	}
+
+	std::vector<sf::Uint32> trigrams;
+	collectTrigrams(this->m_names[id], trigrams);
+	this->m_stale += trigrams.size();
+
+	this->m_names[id].clear();
+	this->m_alive.set(id, false);
+	this->m_free.push_back(id);
+	this->m_count--;
+	compact();
+}
+
+
+////////////////////////////////////////////////////////////
+void TrigramIndex::clear()
+{
+	this->m_names.clear();
+	this->m_groups.clear();
+	this->m_alive.resize(0);
+	this->m_free.clear();
+	this->m_count = 0;
+	this->m_postings.clear();
+	this->m_entries = 0;
+	this->m_stale = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 TrigramIndex::find(const std::string& name, sf::Uint32 group) const
+{
+	// Names too short for a trigram are few, the other ones are looked up by their rarest trigram
+	std::vector<sf::Uint32> trigrams;
+	collectTrigrams(name, trigrams);
+	if (trigrams.empty())
+	{
+		for (std::size_t id = this->m_alive.findNext(0); id < this->m_alive.getSize(); id = this->m_alive.findNext(id + 1))
+		{
+			if (this->m_groups[id] == group && this->m_names[id] == name)
+			{
+				return static_cast<sf::Uint32>(id);
+			}
+		}
+
+		return NoId;
+	}
+
+	const std::vector<sf::Uint32>* rarest = nullptr;
+	for (sf::Uint32 trigram : trigrams)
+	{
+		auto found = this->m_postings.find(trigram);
+		if (found == this->m_postings.end())
+		{
+			return NoId;
+		}
+
+		rarest = !rarest || found->second.size() < rarest->size() ? &found->second : rarest;
+	}
+
+	for (sf::Uint32 id : *rarest)
+	{
+		if (this->m_alive.test(id) && this->m_groups[id] == group && this->m_names[id] == name)
+		{
+			return id;
+		}
+	}
+
+	return NoId;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& TrigramIndex::getName(sf::Uint32 id) const
+{
+	return this->m_names[id];
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 TrigramIndex::getGroup(sf::Uint32 id) const
+{
+	return this->m_groups[id];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TrigramIndex::getCount() const
+{
+	return this->m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TrigramIndex::search(const std::string& query, std::size_t maxResults, std::vector<sf::Uint32>& results) const
+{
+	results.clear();
+	std::string folded;
+	for (char character : query)
+	{
+		folded.push_back(static_cast<char>(fold(character)));
+	}
+
+	if (folded.empty())
+	{
+		return 0;
+	}
+
+	// Names are ranked by where the query starts in them, then by length
+	std::vector<std::pair<sf::Uint64, sf::Uint32>> ranked;
+	auto consider = [&](sf::Uint32 id)
+	{
+		const std::string& name = this->m_names[id];
+		std::size_t position = this->m_alive.test(id) ? findFolded(name, folded) : std::string::npos;
+		if (position != std::string::npos)
+		{
+			bool wordStart = position == 0 || !std::isalnum(static_cast<unsigned char>(name[position - 1]));
+			sf::Uint64 rank = position == 0 ? 0 : wordStart ? 1 : 2;
+			ranked.emplace_back(rank << 32 | std::min<sf::Uint64>(name.size(), 0xFFFFFFFF), id);
+		}
+
+		return ranked.size() < RankLimit;
+	};
+
+	std::vector<sf::Uint32> trigrams;
+	collectTrigrams(folded, trigrams);
+	if (trigrams.empty())
+	{
+		for (std::size_t id = this->m_alive.findNext(0); id < this->m_alive.getSize() && consider(static_cast<sf::Uint32>(id)); id = this->m_alive.findNext(id + 1))
+		{
+		}
+	}
+	else
+	{
+		std::vector<const std::vector<sf::Uint32>*> lists;
+		for (sf::Uint32 trigram : trigrams)
+		{
+			auto found = this->m_postings.find(trigram);
+			if (found == this->m_postings.end())
+			{
+				return 0;
+			}
+
+			lists.push_back(&found->second);
+		}
+
+		// The shortest list is walked, the others are searched from where the previous id was found
+		std::sort(lists.begin(), lists.end(), [](const std::vector<sf::Uint32>* left, const std::vector<sf::Uint32>* right) { return left->size() < right->size(); });
+		std::vector<std::size_t> cursors(lists.size(), 0);
+		bool searching = true;
+		for (std::size_t i = 0; searching && i < lists[0]->size(); i++)
+		{
+			sf::Uint32 id = (*lists[0])[i];
+			bool everywhere = true;
+			for (std::size_t list = 1; list < lists.size() && everywhere; list++)
+			{
+				const std::vector<sf::Uint32>& ids = *lists[list];
+				cursors[list] = static_cast<std::size_t>(std::lower_bound(ids.begin() + cursors[list], ids.end(), id) - ids.begin());
+				searching = cursors[list] < ids.size();
+				everywhere = searching && ids[cursors[list]] == id;
+			}
+
+			if (everywhere)
+			{
+				searching = consider(id);
+			}
+		}
+	}
+
+	std::size_t count = std::min(maxResults, ranked.size());
+	std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end());
+	for (std::size_t i = 0; i < count; i++)
+	{
+		results.push_back(ranked[i].second);
+	}
+
+	return ranked.size();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TrigramIndex::save(const std::filesystem::path& path) const
+{
+	// Removed names are kept as empty entries so that ids stay valid, lists are delta coded
+	std::vector<char> output(Magic, Magic + MagicSize);
+	Varint::write(output, this->m_names.size());
+	for (std::size_t id = 0; id < this->m_names.size(); id++)
+	{
+		Varint::write(output, this->m_alive.test(id) ? static_cast<sf::Uint64>(this->m_groups[id]) + 1 : 0);
+		Varint::write(output, this->m_names[id].size());
+		output.insert(output.end(), this->m_names[id].begin(), this->m_names[id].end());
+	}
+
+	Varint::write(output, this->m_postings.size());
+	for (const auto& [trigram, ids] : this->m_postings)
+	{
+		Varint::write(output, trigram);
+		Varint::write(output, ids.size());
+		sf::Uint32 previous = 0;
+		for (sf::Uint32 id : ids)
+		{
+			Varint::write(output, id - previous);
+			previous = id;
+		}
+	}
+
+	std::filesystem::path temporary = path;
+	temporary += ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		if (!file.write(output.data(), static_cast<std::streamsize>(output.size())))
+		{
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporary, path, error);
+	return !error;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TrigramIndex::load(const std::filesystem::path& path)
+{
+	clear();
+
+	MappedFile file;
+	if (!file.open(path) || file.getSize() < MagicSize || std::memcmp(file.getData(), Magic, MagicSize) != 0)
+	{
+		return false;
+	}
+
+	const sf::Uint8* data = reinterpret_cast<const sf::Uint8*>(file.getData()) + MagicSize;
+	const sf::Uint8* end = reinterpret_cast<const sf::Uint8*>(file.getData()) + file.getSize();
+	sf::Uint64 count = 0;
+	bool valid = Varint::read(data, end, count) && count < NoId && count <= static_cast<sf::Uint64>(end - data);
+	if (valid)
+	{
+		this->m_names.resize(static_cast<std::size_t>(count));
+		this->m_groups.resize(static_cast<std::size_t>(count));
+		this->m_alive.resize(static_cast<std::size_t>(count));
+	}
+
+	for (std::size_t id = 0; valid && id < this->m_names.size(); id++)
+	{
+		sf::Uint64 group = 0;
+		sf::Uint64 length = 0;
+		valid = Varint::read(data, end, group) && Varint::read(data, end, length) && length <= static_cast<sf::Uint64>(end - data);
+		if (valid)
+		{
+			this->m_names[id].assign(reinterpret_cast<const char*>(data), static_cast<std::size_t>(length));
+			this->m_groups[id] = static_cast<sf::Uint32>(group == 0 ? 0 : group - 1);
+			this->m_alive.set(id, group != 0);
+			data += length;
+		}
+	}
+
+	sf::Uint64 listCount = 0;
+	valid = valid && Varint::read(data, end, listCount);
+	for (sf::Uint64 list = 0; valid && list < listCount; list++)
+	{
+		// Ids have to be increasing and within the names read
+		sf::Uint64 trigram = 0;
+		sf::Uint64 size = 0;
+		valid = Varint::read(data, end, trigram) && trigram <= 0xFFFFFF && Varint::read(data, end, size) && size <= static_cast<sf::Uint64>(end - data);
+		std::vector<sf::Uint32>& ids = this->m_postings[static_cast<sf::Uint32>(trigram)];
+		ids.reserve(valid ? static_cast<std::size_t>(size) : 0);
+		sf::Uint64 id = 0;
+		for (sf::Uint64 i = 0; valid && i < size; i++)
+		{
+			sf::Uint64 delta = 0;
+			valid = Varint::read(data, end, delta) && (delta > 0 || i == 0) && (id += delta) < count;
+			ids.push_back(static_cast<sf::Uint32>(id));
+		}
+
+		this->m_entries += ids.size();
+	}
+
+	if (!valid || data != end)
+	{
+		clear();
+		return false;
+	}
+
+	for (std::size_t id = 0; id < this->m_names.size(); id++)
+	{
+		if (this->m_alive.test(id))
+		{
+			this->m_count++;
+		}
+		else
+		{
+			this->m_free.push_back(static_cast<sf::Uint32>(id));
+		}
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TrigramIndex::insert(sf::Uint32 id, const std::vector<sf::Uint32>& trigrams)
+{
+	// New ids are the largest, reused ones are inserted in place unless still listed
+	for (sf::Uint32 trigram : trigrams)
+	{
+		std::vector<sf::Uint32>& ids = this->m_postings[trigram];
+		if (ids.empty() || ids.back() < id)
+		{
+			ids.push_back(id);
+			this->m_entries++;
+			continue;
+		}
+
+		auto position = std::lower_bound(ids.begin(), ids.end(), id);
+		if (*position != id)
+		{
+			ids.insert(position, id);
+			this->m_entries++;
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void TrigramIndex::compact()
+{
+	if (this->m_stale < CompactMinimum || this->m_stale * 2 < this->m_entries)
+	{
+		return;
+	}
+
+	this->m_postings.clear();
+	this->m_entries = 0;
+	this->m_stale = 0;
+
+	std::vector<sf::Uint32> trigrams;
+	for (std::size_t id = this->m_alive.findNext(0); id < this->m_alive.getSize(); id = this->m_alive.findNext(id + 1))
+	{
+		collectTrigrams(this->m_names[id], trigrams);
+		insert(static_cast<sf::Uint32>(id), trigrams);
+	}
+}
+
+} //namespace le
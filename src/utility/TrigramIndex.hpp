@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_TRIGRAM_INDEX_HPP
+#define LEVEL_EDITOR_TRIGRAM_INDEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "BitSet.hpp"
+#include "Config.hpp"
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Config.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Substring search over a large set of names
+///
+/// Every name is split into its trigrams, the three byte
+/// sequences it contains, ignoring ASCII case. Each trigram lists
+/// the ids of the names containing it, sorted. A query is looked
+/// up by intersecting the lists of its trigrams, shortest first,
+/// and only the names left are compared with the query.
+///
+/// Lists are updated in place when names are added or renamed.
+/// Entries of removed or renamed names are left behind, they are
+/// filtered out by the comparison, until they make up half of the
+/// index and the lists are built again.
+///
+/// The names and the lists can be saved, loading them is faster
+/// than adding the names again.
+///
+////////////////////////////////////////////////////////////
+class TrigramIndex : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Id meaning no name
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr sf::Uint32 NoId = 0xFFFFFFFF;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	TrigramIndex();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a name
+	///
+	/// \param name  UTF-8 name
+	/// \param group Value kept with the name, such as what it names
+	///
+	/// \return Id of the name
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint32 add(const std::string& name, sf::Uint32 group);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the keys of localized strings not indexed yet
+	///
+	/// \param strings Localized strings
+	/// \param group   Value kept with the keys
+	///
+	////////////////////////////////////////////////////////////
+	void addKeys(const Strings& strings, sf::Uint32 group);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Change a name, keeping its id
+	///
+	/// \param id   Id of the name
+	/// \param name New UTF-8 name
+	///
+	////////////////////////////////////////////////////////////
+	void rename(sf::Uint32 id, const std::string& name);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove a name
+	///
+	/// \param id Id of the name
+	///
+	////////////////////////////////////////////////////////////
+	void remove(sf::Uint32 id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove every name
+	///
+	////////////////////////////////////////////////////////////
+	void clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the id of a name
+	///
+	/// \param name  UTF-8 name, compared exactly
+	/// \param group Value kept with the name
+	///
+	/// \return Id of the name, NoId if not indexed
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint32 find(const std::string& name, sf::Uint32 group) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a name
+	///
+	/// \param id Id of the name
+	///
+	////////////////////////////////////////////////////////////
+	const std::string& getName(sf::Uint32 id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the value kept with a name
+	///
+	/// \param id Id of the name
+	///
+	////////////////////////////////////////////////////////////
+	sf::Uint32 getGroup(sf::Uint32 id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of names
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the names containing a query
+	///
+	/// Names starting with the query come first, then names with
+	/// a word starting with it, shorter names first. Only the
+	/// first thousands of names matching are ranked.
+	///
+	/// \param query      UTF-8 text searched, ignoring ASCII case
+	/// \param maxResults Amount of ids returned at most
+	/// \param results    Ids of the best names, best first
+	///
+	/// \return Amount of names ranked
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t search(const std::string& query, std::size_t maxResults, std::vector<sf::Uint32>& results) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Write the names and lists to a file
+	///
+	/// \param path Path of the file
+	///
+	/// \return True if the file was written
+	///
+	////////////////////////////////////////////////////////////
+	bool save(const std::filesystem::path& path) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Replace the names and lists with those of a file
+	///
+	/// The index is left empty if the file cannot be read.
+	///
+	/// \param path Path of the file
+	///
+	/// \return True if the file was read
+	///
+	////////////////////////////////////////////////////////////
+	bool load(const std::filesystem::path& path);
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add an id to the lists of trigrams
+	///
+	/// \param id       Id of the name
+	/// \param trigrams Trigrams of the name
+	///
+	////////////////////////////////////////////////////////////
+	void insert(sf::Uint32 id, const std::vector<sf::Uint32>& trigrams);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Build the lists again once they are mostly stale
+	///
+	////////////////////////////////////////////////////////////
+	void compact();
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::vector<std::string>                                m_names;    //!< Name of every id
+	std::vector<sf::Uint32>                                 m_groups;   //!< Value kept with every id
+	BitSet                                                  m_alive;    //!< Bit per id in use
+	std::vector<sf::Uint32>                                 m_free;     //!< Ids of removed names, reused first
+	std::size_t                                             m_count;    //!< Amount of names
+	std::unordered_map<sf::Uint32, std::vector<sf::Uint32>> m_postings; //!< Sorted ids of the names containing every trigram
+	std::size_t                                             m_entries;  //!< Amount of ids in the lists
+	std::size_t                                             m_stale;    //!< Amount of ids left in lists of trigrams their name lost
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_TRIGRAM_INDEX_HPP
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "UpdateScheduler.hpp"
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+UpdateScheduler::UpdateScheduler() :
+m_active  (),
+m_removed (0),
+m_updating(false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+UpdateScheduler& UpdateScheduler::getDefault()
+{
+	static UpdateScheduler scheduler;
+	return scheduler;
+}
+
+
+////////////////////////////////////////////////////////////
+void UpdateScheduler::add(Updatable& updatable)
+{
+	if (updatable.m_scheduleIndex == NotScheduled)
+	{
+		updatable.m_scheduleIndex = this->m_active.size();
+		this->m_active.push_back(&updatable);
+	}
+}
+
+
+////////////////////////////////////////////////////////////
+void UpdateScheduler::remove(Updatable& updatable)
+{
+	std::size_t index = updatable.m_scheduleIndex;
+	if (index == NotScheduled)
+	{
+		return;
+	}
+
+	// During a pass the slot is only cleared, moving the last updatable into it could skip it
+	if (this->m_updating)
+	{
+		this->m_active[index] = nullptr;
+		this->m_removed++;
+	}
+	else
+	{
+		Updatable* last = this->m_active.back();
+		this->m_active[index] = last;
+		last->m_scheduleIndex = index;
+		this->m_active.pop_back();
+	}
+
+	updatable.m_scheduleIndex = NotScheduled;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t UpdateScheduler::getCount() const
+{
+	return this->m_active.size() - this->m_removed;
+}
+
+
+////////////////////////////////////////////////////////////
+void UpdateScheduler::update()
+{
+	if (this->m_updating)
+	{
+		return;
+	}
+
+	this->m_updating = true;
+	for (std::size_t i = 0; i < this->m_active.size(); i++)
+	{
+		if (this->m_active[i] != nullptr)
+		{
+			this->m_active[i]->update();
+		}
+	}
+
+	this->m_updating = false;
+	if (this->m_removed == 0)
+	{
+		return;
+	}
+
+	// The slots cleared during the pass are dropped, keeping the order of the others
+	std::size_t kept = 0;
+	for (Updatable* updatable : this->m_active)
+	{
+		if (updatable != nullptr)
+		{
+			updatable->m_scheduleIndex = kept;
+			this->m_active[kept++] = updatable;
+		}
+	}
+
+	this->m_active.resize(kept);
+	this->m_removed = 0;
+}
+
+} //namespace le
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_UPDATE_SCHEDULER_HPP
+#define LEVEL_EDITOR_UPDATE_SCHEDULER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../ui/interfaces/Updatable.hpp"
+#include <limits>
+#include <vector>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Active set of the updatables that need ticking
+///
+/// Updatables register themselves only while they have work to do,
+/// so the cost of a frame depends on the amount of active objects
+/// rather than on the amount of existing ones.
+///
+////////////////////////////////////////////////////////////
+class UpdateScheduler : sf::NonCopyable
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Index of an updatable that is not scheduled
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr std::size_t NotScheduled = std::numeric_limits<std::size_t>::max();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	UpdateScheduler();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the scheduler driven by the application's main loop
+	///
+	////////////////////////////////////////////////////////////
+	static UpdateScheduler& getDefault();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add an updatable to the active set
+	///
+	/// \param updatable Updatable to add
+	///
+	////////////////////////////////////////////////////////////
+	void add(Updatable& updatable);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove an updatable from the active set
+	///
+	/// \param updatable Updatable to remove
+	///
+	////////////////////////////////////////////////////////////
+	void remove(Updatable& updatable);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the amount of active updatables
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Update every active updatable
+	///
+	/// Updatables may add or remove themselves and others while
+	/// being updated. Updatables added during the pass are updated
+	/// within the same pass, those removed are no longer updated by
+	/// it and leave the active set once it ends.
+	///
+	////////////////////////////////////////////////////////////
+	void update();
+
+private:
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+	std::vector<Updatable*> m_active;   //!< Dense array of the scheduled updatables, null where one was removed during a pass
+	std::size_t             m_removed;  //!< Amount of updatables removed during the current pass
+	bool                    m_updating; //!< A pass is running
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_UPDATE_SCHEDULER_HPP
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Varint.hpp"
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+void Varint::write(std::vector<char>& output, sf::Uint64 value)
+{
+	for (; value >= 0x80; value >>= 7)
+	{
+		output.push_back(static_cast<char>(value | 0x80));
+	}
+
+	output.push_back(static_cast<char>(value));
+}
+
+
+////////////////////////////////////////////////////////////
+bool Varint::read(const sf::Uint8*& data, const sf::Uint8* end, sf::Uint64& value)
+{
+	value = 0;
+	for (unsigned int shift = 0; shift < 64 && data < end; shift += 7)
+	{
+		sf::Uint8 byte = *data++;
+		value |= static_cast<sf::Uint64>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint64 Varint::toZigzag(sf::Int64 value)
+{
+	// Small negative and positive differences both become small unsigned values
+	return value < 0 ? (static_cast<sf::Uint64>(-(value + 1)) << 1) | 1 : static_cast<sf::Uint64>(value) << 1;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Int64 Varint::fromZigzag(sf::Uint64 value)
+{
+	return (value & 1) ? -static_cast<sf::Int64>(value >> 1) - 1 : static_cast<sf::Int64>(value >> 1);
+}
+
+} //namespace le
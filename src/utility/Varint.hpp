@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef LEVEL_EDITOR_VARINT_HPP
+#define LEVEL_EDITOR_VARINT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <vector>
+#include <SFML/Config.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+/// \brief Variable length encoding of integers
+///
+/// Every byte holds seven bits of the value, lowest first, and
+/// its high bit tells whether more bytes follow. Small values
+/// take a single byte. Signed values are mapped to unsigned ones
+/// with zigzag encoding first, so that small negative values
+/// stay small too.
+///
+////////////////////////////////////////////////////////////
+class Varint
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Append a value to a buffer
+	///
+	/// \param output Buffer the value is appended to
+	/// \param value  Value to write
+	///
+	////////////////////////////////////////////////////////////
+	static void write(std::vector<char>& output, sf::Uint64 value);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Read a value and move past it
+	///
+	/// \param data  Start of the value, moved past it
+	/// \param end   End of the data
+	/// \param value Value read
+	///
+	/// \return False if the data ends before the value
+	///
+	////////////////////////////////////////////////////////////
+	static bool read(const sf::Uint8*& data, const sf::Uint8* end, sf::Uint64& value);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Map a signed value to an unsigned one
+	///
+	/// \param value Signed value
+	///
+	/// \return Twice the value if positive, twice its magnitude minus one otherwise
+	///
+	////////////////////////////////////////////////////////////
+	static sf::Uint64 toZigzag(sf::Int64 value);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Map an unsigned value back to the signed one it encodes
+	///
+	/// \param value Value returned by toZigzag
+	///
+	////////////////////////////////////////////////////////////
+	static sf::Int64 fromZigzag(sf::Uint64 value);
+};
+
+} //namespace le
+
+
+#endif // LEVEL_EDITOR_VARINT_HPP
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Tests.hpp"
+#include "../src/utility/TimerWheel.hpp"
+#include <cstdio>
+#include <functional>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Sleep.hpp>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+static bool updateUntil(TimerWheel& wheel, sf::Time limit, const std::function<bool()>& done)
+{
+	// The wheel is updated every millisecond, as the editor would between events
+	sf::Clock clock;
+	while (!done() && clock.getElapsedTime() < limit)
+	{
+		sf::sleep(sf::milliseconds(1));
+		wheel.update();
+	}
+
+	return done();
+}
+
+
+////////////////////////////////////////////////////////////
+static bool check(bool condition, const char* description)
+{
+	if (!condition)
+	{
+		printf("Failed: %s\n", description);
+	}
+
+	return condition;
+}
+
+
+////////////////////////////////////////////////////////////
+bool testTimerWheel()
+{
+	bool passed = true;
+
+	{
+		TimerWheel wheel;
+		bool raised = false;
+		wheel.setTimeout(sf::milliseconds(5), [&]() { raised = true; });
+		passed &= check(updateUntil(wheel, sf::milliseconds(100), [&]() { return raised; }), "a timeout is raised");
+		passed &= check(wheel.getPendingCount() == 0, "a raised timeout is no longer pending");
+	}
+
+	{
+		TimerWheel wheel;
+		bool raised = false;
+		TimerWheel::Id id = wheel.setTimeout(sf::milliseconds(5), [&]() { raised = true; });
+		wheel.cancel(id);
+		updateUntil(wheel, sf::milliseconds(20), []() { return false; });
+		passed &= check(!raised && !wheel.isPending(id), "a cancelled timeout is not raised");
+	}
+
+	{
+		// A timeout of 0 ms scheduled by a callback is due on the tick being raised
+		TimerWheel wheel;
+		bool scheduled = false;
+		bool raised = false;
+		wheel.setTimeout(sf::milliseconds(2), [&]()
+		{
+			wheel.setTimeout(sf::Time::Zero, [&]() { raised = true; });
+			scheduled = true;
+		});
+
+		updateUntil(wheel, sf::milliseconds(100), [&]() { return scheduled; });
+		passed &= check(updateUntil(wheel, sf::milliseconds(50), [&]() { return raised; }), "a timeout scheduled by a callback for the current tick is raised on the next one");
+	}
+
+	{
+		TimerWheel wheel;
+		int count = 0;
+		TimerWheel::Id id = wheel.setInterval(sf::milliseconds(2), [&]() { count++; });
+		passed &= check(updateUntil(wheel, sf::milliseconds(200), [&]() { return count >= 3; }), "an interval is raised repeatedly");
+		passed &= check(wheel.isPending(id), "an interval stays pending");
+	}
+
+	return passed;
+}
+
+} //namespace le
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2023 ZaBlazzingZeif
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Tests.hpp"
+#include "../src/utility/UpdateScheduler.hpp"
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+
+namespace le
+{
+////////////////////////////////////////////////////////////
+class CountingUpdatable : public Updatable
+{
+public:
+
+	void update() override
+	{
+		this->m_updates++;
+		if (this->m_onUpdate)
+		{
+			this->m_onUpdate();
+		}
+	}
+
+	int                   m_updates = 0; //!< Amount of times the updatable was updated
+	std::function<void()> m_onUpdate;    //!< Called on every update
+};
+
+
+////////////////////////////////////////////////////////////
+static bool check(bool condition, const char* description)
+{
+	if (!condition)
+	{
+		printf("Failed: %s\n", description);
+	}
+
+	return condition;
+}
+
+
+////////////////////////////////////////////////////////////
+bool testUpdateScheduler()
+{
+	UpdateScheduler& scheduler = UpdateScheduler::getDefault();
+	bool passed = true;
+
+	{
+		// The third removes the first, the last must still be updated by the same pass
+		std::vector<CountingUpdatable> updatables(5);
+		for (CountingUpdatable& updatable : updatables)
+		{
+			scheduler.add(updatable);
+		}
+
+		updatables[2].m_onUpdate = [&]() { scheduler.remove(updatables[0]); };
+		scheduler.update();
+		bool everyOther = updatables[1].m_updates == 1 && updatables[2].m_updates == 1 && updatables[3].m_updates == 1 && updatables[4].m_updates == 1;
+		passed &= check(everyOther, "removing an updatable during a pass skips none of the others");
+		passed &= check(scheduler.getCount() == 4 && !updatables[0].isScheduled(), "an updatable removed during a pass leaves the active set");
+
+		// The one removed before its turn is not updated
+		updatables[4].m_onUpdate = [&]() {};
+		updatables[1].m_onUpdate = [&]() { scheduler.remove(updatables[3]); };
+		scheduler.update();
+		passed &= check(updatables[3].m_updates == 1 && updatables[4].m_updates == 2, "an updatable removed before its turn is not updated");
+
+		for (CountingUpdatable& updatable : updatables)
+		{
+			scheduler.remove(updatable);
+		}
+	}
+
+	{
+		// Removing itself and adding another within a pass
+		std::vector<CountingUpdatable> updatables(3);
+		scheduler.add(updatables[0]);
+		scheduler.add(updatables[1]);
+		updatables[0].m_onUpdate = [&]()
+		{
+			scheduler.remove(updatables[0]);
+			scheduler.add(updatables[2]);
+		};
+
+		scheduler.update();
+		bool updated = updatables[0].m_updates == 1 && updatables[1].m_updates == 1 && updatables[2].m_updates == 1;
+		passed &= check(updated, "updatables added during a pass are updated by it");
+		passed &= check(scheduler.getCount() == 2 && updatables[1].isScheduled() && updatables[2].isScheduled(), "the active set holds the updatables left");
+
+		scheduler.update();
+		passed &= check(updatables[0].m_updates == 1 && updatables[1].m_updates == 2 && updatables[2].m_updates == 2, "the next pass updates the updatables left once");
+	}
+
+	passed &= check(scheduler.getCount() == 0, "destroyed updatables leave the active set");
+	return passed;
+}
+
+} //namespace le